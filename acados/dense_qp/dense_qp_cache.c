@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// external
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+#include "blasfeo/include/blasfeo_d_blas.h"
+// acados
+#include "acados/dense_qp/dense_qp_cache.h"
+#include "acados/dense_qp/dense_qp_common.h"
+#include "acados/utils/mem.h"
+
+
+
+static int dense_qp_cache_max_act(dense_qp_dims *dims)
+{
+    // linearly independent active constraints
+    int nc = dims->ne + dims->nb + dims->ng;
+    return nc < dims->nv ? nc : dims->nv;
+}
+
+
+
+acados_size_t dense_qp_cache_calculate_size(dense_qp_dims *dims, int size)
+{
+    int nv = dims->nv;
+    int ne = dims->ne;
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int max_act = dense_qp_cache_max_act(dims);
+
+    acados_size_t mem_size = sizeof(dense_qp_cache);
+
+    mem_size += size * sizeof(dense_qp_cache_entry);
+    mem_size += size * max_act * sizeof(int);  // idx_act
+    mem_size += nb * sizeof(int);  // idxb
+
+    mem_size += dense_qp_res_calculate_size(dims);
+    mem_size += dense_qp_res_workspace_calculate_size(dims);
+
+    mem_size += 3 * blasfeo_memsize_dmat(nv, nv);  // H L
+    mem_size += blasfeo_memsize_dmat(ne, nv);      // A
+    mem_size += blasfeo_memsize_dmat(nv, ng);      // Ct
+    mem_size += 2 * blasfeo_memsize_dvec(nv);      // h tmp_nv
+    mem_size += 2 * blasfeo_memsize_dvec(max_act); // rhs y
+    mem_size += size * blasfeo_memsize_dmat(nv, max_act);       // W
+    mem_size += size * blasfeo_memsize_dmat(max_act, max_act);  // LS
+
+    mem_size += 2 * 8 + 64;  // align
+    make_int_multiple_of(8, &mem_size);
+
+    return mem_size;
+}
+
+
+
+dense_qp_cache *dense_qp_cache_assign(dense_qp_dims *dims, int size, void *raw_memory)
+{
+    int nv = dims->nv;
+    int ne = dims->ne;
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int max_act = dense_qp_cache_max_act(dims);
+
+    char *c_ptr = (char *) raw_memory;
+
+    dense_qp_cache *cache = (dense_qp_cache *) c_ptr;
+    c_ptr += sizeof(dense_qp_cache);
+
+    cache->entries = (dense_qp_cache_entry *) c_ptr;
+    c_ptr += size * sizeof(dense_qp_cache_entry);
+
+    align_char_to(8, &c_ptr);
+    cache->res = dense_qp_res_assign(dims, c_ptr);
+    c_ptr += dense_qp_res_calculate_size(dims);
+
+    cache->res_ws = dense_qp_res_workspace_assign(dims, c_ptr);
+    c_ptr += dense_qp_res_workspace_calculate_size(dims);
+
+    align_char_to(64, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nv, nv, &cache->H, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nv, nv, &cache->L, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(ne, nv, &cache->A, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nv, ng, &cache->Ct, &c_ptr);
+    for (int k = 0; k < size; k++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nv, max_act, &cache->entries[k].W, &c_ptr);
+        assign_and_advance_blasfeo_dmat_mem(max_act, max_act, &cache->entries[k].LS, &c_ptr);
+    }
+    assign_and_advance_blasfeo_dvec_mem(nv, &cache->h, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(nv, &cache->tmp_nv, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(max_act, &cache->rhs, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(max_act, &cache->y, &c_ptr);
+
+    for (int k = 0; k < size; k++)
+        assign_and_advance_int(max_act, &cache->entries[k].idx_act, &c_ptr);
+    assign_and_advance_int(nb, &cache->idxb, &c_ptr);
+
+    cache->size = size;
+    cache->num_entries = 0;
+    cache->max_act = max_act;
+    cache->tol = 1e-8;
+    cache->valid = false;
+    cache->hits = 0;
+    cache->misses = 0;
+
+    assert((char *) raw_memory + dense_qp_cache_calculate_size(dims, size) >= c_ptr);
+
+    return cache;
+}
+
+
+
+// returns true if the data matrices of qp_in equal the ones the cache was built for
+static bool dense_qp_cache_data_unchanged(dense_qp_cache *cache, dense_qp_in *qp_in)
+{
+    int nv = qp_in->dim->nv;
+    int ne = qp_in->dim->ne;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+
+    for (int jj = 0; jj < nv; jj++)
+        for (int ii = jj; ii < nv; ii++)
+            if (BLASFEO_DMATEL(qp_in->Hv, ii, jj) != BLASFEO_DMATEL(&cache->H, ii, jj))
+                return false;
+    for (int jj = 0; jj < nv; jj++)
+        for (int ii = 0; ii < ne; ii++)
+            if (BLASFEO_DMATEL(qp_in->A, ii, jj) != BLASFEO_DMATEL(&cache->A, ii, jj))
+                return false;
+    for (int jj = 0; jj < ng; jj++)
+        for (int ii = 0; ii < nv; ii++)
+            if (BLASFEO_DMATEL(qp_in->Ct, ii, jj) != BLASFEO_DMATEL(&cache->Ct, ii, jj))
+                return false;
+    for (int ii = 0; ii < nb; ii++)
+        if (qp_in->idxb[ii] != cache->idxb[ii])
+            return false;
+
+    return true;
+}
+
+
+
+// stores the data matrices of qp_in and factorizes the Hessian, clears all entries
+static void dense_qp_cache_reset(dense_qp_cache *cache, dense_qp_in *qp_in)
+{
+    int nv = qp_in->dim->nv;
+    int ne = qp_in->dim->ne;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+
+    blasfeo_dgecp(nv, nv, qp_in->Hv, 0, 0, &cache->H, 0, 0);
+    blasfeo_dgecp(ne, nv, qp_in->A, 0, 0, &cache->A, 0, 0);
+    blasfeo_dgecp(nv, ng, qp_in->Ct, 0, 0, &cache->Ct, 0, 0);
+    for (int ii = 0; ii < nb; ii++)
+        cache->idxb[ii] = qp_in->idxb[ii];
+
+    cache->num_entries = 0;
+
+    // the Schur complement approach needs a positive definite Hessian
+    blasfeo_dpotrf_l(nv, &cache->H, 0, 0, &cache->L, 0, 0);
+    cache->valid = true;
+    for (int ii = 0; ii < nv; ii++)
+    {
+        double diag = BLASFEO_DMATEL(&cache->L, ii, ii);
+        if (!(diag > 0.0) || isinf(diag))
+            cache->valid = false;
+    }
+}
+
+
+
+// moves entry k to the front
+static void dense_qp_cache_move_to_front(dense_qp_cache *cache, int k)
+{
+    dense_qp_cache_entry entry = cache->entries[k];
+    for (int jj = k; jj > 0; jj--)
+        cache->entries[jj] = cache->entries[jj-1];
+    cache->entries[0] = entry;
+}
+
+
+
+static bool dense_qp_cache_try_entry(dense_qp_cache *cache, dense_qp_cache_entry *entry,
+                                     dense_qp_in *qp_in, dense_qp_out *qp_out)
+{
+    int nv = qp_in->dim->nv;
+    int ne = qp_in->dim->ne;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+    int nact = entry->nact;
+    double tol = cache->tol;
+
+    // rhs of the active constraints
+    for (int k = 0; k < nact; k++)
+    {
+        int idx = entry->idx_act[k];
+        if (idx < ne)
+        {
+            BLASFEO_DVECEL(&cache->rhs, k) = BLASFEO_DVECEL(qp_in->b, idx);
+        }
+        else if (idx < ne+nb+ng)
+        {
+            if (BLASFEO_DVECEL(qp_in->d_mask, idx-ne) == 0.0)
+                return false;
+            BLASFEO_DVECEL(&cache->rhs, k) = BLASFEO_DVECEL(qp_in->d, idx-ne);
+        }
+        else
+        {
+            if (BLASFEO_DVECEL(qp_in->d_mask, idx-ne) == 0.0)
+                return false;
+            // upper bounds are stored negated
+            BLASFEO_DVECEL(&cache->rhs, k) = -BLASFEO_DVECEL(qp_in->d, idx-ne);
+        }
+    }
+
+    // multipliers: W' W y = c + W' h
+    blasfeo_dgemv_t(nv, nact, 1.0, &entry->W, 0, 0, &cache->h, 0, 1.0, &cache->rhs, 0, &cache->rhs, 0);
+    blasfeo_dtrsv_lnn(nact, &entry->LS, 0, 0, &cache->rhs, 0, &cache->y, 0);
+    blasfeo_dtrsv_ltn(nact, &entry->LS, 0, 0, &cache->y, 0, &cache->y, 0);
+
+    // predicted optimality: sign of the inequality multipliers
+    for (int k = 0; k < nact; k++)
+    {
+        int idx = entry->idx_act[k];
+        double y = BLASFEO_DVECEL(&cache->y, k);
+        if ((idx >= ne && idx < ne+nb+ng && y < -tol) || (idx >= ne+nb+ng && y > tol))
+            return false;
+    }
+
+    // primal solution: x = L^{-T} (W y - h)
+    blasfeo_dgemv_n(nv, nact, 1.0, &entry->W, 0, 0, &cache->y, 0, -1.0, &cache->h, 0, &cache->tmp_nv, 0);
+    blasfeo_dtrsv_ltn(nv, &cache->L, 0, 0, &cache->tmp_nv, 0, qp_out->v, 0);
+
+    // predicted feasibility
+    dense_qp_compute_t(qp_in, qp_out);
+    for (int ii = 0; ii < 2*nb+2*ng; ii++)
+    {
+        if (BLASFEO_DVECEL(qp_in->d_mask, ii) != 0.0 && BLASFEO_DVECEL(qp_out->t, ii) < -tol)
+            return false;
+    }
+
+    // dual solution
+    blasfeo_dvecse(2*nb+2*ng, 0.0, qp_out->lam, 0);
+    for (int k = 0; k < nact; k++)
+    {
+        int idx = entry->idx_act[k];
+        double y = BLASFEO_DVECEL(&cache->y, k);
+        if (idx < ne)
+            BLASFEO_DVECEL(qp_out->pi, idx) = y;
+        else if (idx < ne+nb+ng)
+            BLASFEO_DVECEL(qp_out->lam, idx-ne) = y > 0.0 ? y : 0.0;
+        else
+            BLASFEO_DVECEL(qp_out->lam, idx-ne) = y < 0.0 ? -y : 0.0;
+    }
+
+    // validation on the KKT residuals
+    qp_info *info = (qp_info *) qp_out->misc;
+    info->t_computed = 1;
+    double res[4];
+    dense_qp_res_compute(qp_in, qp_out, cache->res, cache->res_ws);
+    dense_qp_res_compute_nrm_inf(cache->res, res);
+
+    return res[0] <= tol && res[1] <= tol && res[2] <= tol && res[3] <= tol;
+}
+
+
+
+bool dense_qp_cache_lookup(dense_qp_cache *cache, dense_qp_in *qp_in, dense_qp_out *qp_out)
+{
+    if (qp_in->dim->ns > 0)
+        return false;
+
+    if (!cache->valid || !dense_qp_cache_data_unchanged(cache, qp_in))
+    {
+        dense_qp_cache_reset(cache, qp_in);
+        cache->misses++;
+        return false;
+    }
+
+    // h = L^{-1} g, shared by all entries
+    blasfeo_dtrsv_lnn(qp_in->dim->nv, &cache->L, 0, 0, qp_in->gz, 0, &cache->h, 0);
+
+    for (int k = 0; k < cache->num_entries; k++)
+    {
+        if (dense_qp_cache_try_entry(cache, cache->entries+k, qp_in, qp_out))
+        {
+            dense_qp_cache_move_to_front(cache, k);
+            cache->hits++;
+            return true;
+        }
+    }
+
+    cache->misses++;
+    return false;
+}
+
+
+
+// an entry that was partially overwritten by a rejected insertion is removed
+static void dense_qp_cache_drop_slot(dense_qp_cache *cache, int slot)
+{
+    if (slot < cache->num_entries)
+        cache->num_entries--;
+}
+
+
+
+void dense_qp_cache_insert(dense_qp_cache *cache, dense_qp_in *qp_in, dense_qp_out *qp_out)
+{
+    int nv = qp_in->dim->nv;
+    int ne = qp_in->dim->ne;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+
+    if (qp_in->dim->ns > 0 || !cache->valid || cache->size == 0)
+        return;
+
+    // take the least recently used slot, it is moved to the front once it is filled
+    int slot = cache->num_entries < cache->size ? cache->num_entries : cache->size-1;
+    dense_qp_cache_entry *entry = cache->entries+slot;
+
+    // active set: constraints with multiplier larger than slack
+    int nact = 0;
+    for (int jj = 0; jj < ne; jj++)
+    {
+        if (nact >= cache->max_act)
+        {
+            dense_qp_cache_drop_slot(cache, slot);
+            return;
+        }
+        entry->idx_act[nact++] = jj;
+    }
+    for (int ii = 0; ii < 2*(nb+ng); ii++)
+    {
+        if (BLASFEO_DVECEL(qp_in->d_mask, ii) != 0.0 &&
+            BLASFEO_DVECEL(qp_out->lam, ii) > BLASFEO_DVECEL(qp_out->t, ii))
+        {
+            if (nact >= cache->max_act)
+            {
+                dense_qp_cache_drop_slot(cache, slot);
+                return;
+            }
+            entry->idx_act[nact++] = ne+ii;
+        }
+    }
+
+    // FNV-1a hash of the active set
+    unsigned int hash = 2166136261u;
+    for (int k = 0; k < nact; k++)
+    {
+        hash ^= (unsigned int) entry->idx_act[k];
+        hash *= 16777619u;
+    }
+
+    // skip active sets already in the cache
+    for (int k = 0; k < cache->num_entries; k++)
+    {
+        dense_qp_cache_entry *other = cache->entries+k;
+        if (k != slot && other->hash == hash && other->nact == nact &&
+            !memcmp(other->idx_act, entry->idx_act, nact*sizeof(int)))
+        {
+            dense_qp_cache_drop_slot(cache, slot);
+            return;
+        }
+    }
+
+    // active constraint matrix M'
+    blasfeo_dgese(nv, nact, 0.0, &entry->W, 0, 0);
+    for (int k = 0; k < nact; k++)
+    {
+        int idx = entry->idx_act[k];
+        if (idx < ne)
+        {
+            for (int ii = 0; ii < nv; ii++)
+                BLASFEO_DMATEL(&entry->W, ii, k) = BLASFEO_DMATEL(qp_in->A, idx, ii);
+        }
+        else
+        {
+            int ic = (idx-ne) % (nb+ng);
+            if (ic < nb)
+                BLASFEO_DMATEL(&entry->W, qp_in->idxb[ic], k) = 1.0;
+            else
+                blasfeo_dgecp(nv, 1, qp_in->Ct, 0, ic-nb, &entry->W, 0, k);
+        }
+    }
+
+    // W = L^{-1} M', LS = chol(W' W)
+    blasfeo_dtrsm_llnn(nv, nact, 1.0, &cache->L, 0, 0, &entry->W, 0, 0, &entry->W, 0, 0);
+    blasfeo_dgemm_tn(nact, nact, nv, 1.0, &entry->W, 0, 0, &entry->W, 0, 0, 0.0,
+                     &entry->LS, 0, 0, &entry->LS, 0, 0);
+    blasfeo_dpotrf_l(nact, &entry->LS, 0, 0, &entry->LS, 0, 0);
+    for (int k = 0; k < nact; k++)
+    {
+        // linearly dependent active constraints
+        double diag = BLASFEO_DMATEL(&entry->LS, k, k);
+        if (!(diag > 0.0) || isinf(diag))
+        {
+            dense_qp_cache_drop_slot(cache, slot);
+            return;
+        }
+    }
+
+    entry->nact = nact;
+    entry->hash = hash;
+    if (slot == cache->num_entries)
+        cache->num_entries++;
+    dense_qp_cache_move_to_front(cache, slot);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_DENSE_QP_DENSE_QP_CACHE_H_
+#define ACADOS_DENSE_QP_DENSE_QP_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// blasfeo
+#include "blasfeo/include/blasfeo_common.h"
+// acados
+#include "acados/dense_qp/dense_qp_common.h"
+#include "acados/utils/types.h"
+
+
+
+// Cache of optimal active sets of dense QPs with constant data matrices, e.g. fully condensed linear MPC.
+// For each active set, the Schur complement of the KKT system is stored factorized, such that a cached
+// active set is tried with a few triangular solves and accepted if the resulting primal-dual pair
+// satisfies the KKT conditions of the current QP. QPs with soft constraints are not cached.
+
+typedef struct
+{
+    unsigned int hash;
+    int nact;       // number of active constraints, including the equalities
+    int *idx_act;   // j < ne: equality j; ne+i: lower bound of constraint i; ne+nb+ng+i: upper bound of i
+    struct blasfeo_dmat W;   // L^{-1} M', M active constraint matrix
+    struct blasfeo_dmat LS;  // cholesky factor of W' W
+} dense_qp_cache_entry;
+
+
+
+typedef struct
+{
+    dense_qp_cache_entry *entries;  // ordered from most to least recently used
+    int size;
+    int num_entries;
+    int max_act;
+    double tol;  // tolerance on the KKT residuals of a cached solution
+
+    // data matrices the factorizations are valid for
+    struct blasfeo_dmat H;
+    struct blasfeo_dmat A;
+    struct blasfeo_dmat Ct;
+    int *idxb;
+    struct blasfeo_dmat L;  // cholesky factor of H
+    bool valid;
+
+    // workspace
+    struct blasfeo_dvec h;
+    struct blasfeo_dvec tmp_nv;
+    struct blasfeo_dvec rhs;
+    struct blasfeo_dvec y;
+    dense_qp_res *res;
+    dense_qp_res_ws *res_ws;
+
+    // statistics
+    int hits;
+    int misses;
+} dense_qp_cache;
+
+
+
+//
+acados_size_t dense_qp_cache_calculate_size(dense_qp_dims *dims, int size);
+//
+dense_qp_cache *dense_qp_cache_assign(dense_qp_dims *dims, int size, void *raw_memory);
+// tries the cached active sets on qp_in, returns true and the solution in qp_out on a hit
+bool dense_qp_cache_lookup(dense_qp_cache *cache, dense_qp_in *qp_in, dense_qp_out *qp_out);
+// stores the active set of the optimal solution qp_out, to be called after dense_qp_cache_lookup on the same qp_in
+void dense_qp_cache_insert(dense_qp_cache *cache, dense_qp_in *qp_in, dense_qp_out *qp_out);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_DENSE_QP_DENSE_QP_CACHE_H_
@@ -293,6 +293,22 @@ dense_qp_res_ws *dense_qp_res_workspace_assign(dense_qp_dims *dims, void *raw_me
 
 
 
+void dense_qp_out_set_zero(dense_qp_out *qp_out)
+{
+    int nv = qp_out->dim->nv;
+    int ne = qp_out->dim->ne;
+    int nb = qp_out->dim->nb;
+    int ng = qp_out->dim->ng;
+    int ns = qp_out->dim->ns;
+
+    blasfeo_dvecse(nv+2*ns, 0.0, qp_out->v, 0);
+    blasfeo_dvecse(ne, 0.0, qp_out->pi, 0);
+    blasfeo_dvecse(2*(nb+ng+ns), 0.0, qp_out->lam, 0);
+    blasfeo_dvecse(2*(nb+ng+ns), 0.0, qp_out->t, 0);
+}
+
+
+
 void dense_qp_compute_t(dense_qp_in *qp_in, dense_qp_out *qp_out)
 {
     int nvd = qp_in->dim->nv;
@@ -655,3 +671,81 @@ void dense_qp_unstack_slacks(dense_qp_out *in, dense_qp_in *qp_out, dense_qp_out
 
     return;
 }
+
+
+
+void dense_qp_working_set_get(dense_qp_in *qp_in, dense_qp_out *qp_out, int *ws)
+{
+    int nv = qp_in->dim->nv;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+
+    for (int ii = 0; ii < nv+ng; ii++)
+        ws[ii] = 0;
+
+    // bounds are stored by variable index
+    for (int ii = 0; ii < nb; ii++)
+    {
+        if (BLASFEO_DVECEL(qp_out->lam, ii) > 0.0)
+            ws[qp_in->idxb[ii]] = -1;
+        else if (BLASFEO_DVECEL(qp_out->lam, nb+ng+ii) > 0.0)
+            ws[qp_in->idxb[ii]] = 1;
+    }
+
+    // general constraints by row
+    for (int ii = 0; ii < ng; ii++)
+    {
+        if (BLASFEO_DVECEL(qp_out->lam, nb+ii) > 0.0)
+            ws[nv+ii] = -1;
+        else if (BLASFEO_DVECEL(qp_out->lam, 2*nb+ng+ii) > 0.0)
+            ws[nv+ii] = 1;
+    }
+
+    return;
+}
+
+
+
+int dense_qp_working_set_map(dense_qp_in *qp_in, int *ws)
+{
+    int nv = qp_in->dim->nv;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+
+    int ii, idx;
+    int ndrop = 0;
+
+    // mark active bounds as pending, confirm the ones that qp_in still has
+    for (ii = 0; ii < nv; ii++)
+        ws[ii] *= 2;
+
+    for (ii = 0; ii < nb; ii++)
+    {
+        idx = qp_in->idxb[ii];
+        if (ws[idx] == -2 && BLASFEO_DVECEL(qp_in->d_mask, ii) != 0.0)
+            ws[idx] = -1;
+        else if (ws[idx] == 2 && BLASFEO_DVECEL(qp_in->d_mask, nb+ng+ii) != 0.0)
+            ws[idx] = 1;
+    }
+
+    for (ii = 0; ii < nv; ii++)
+    {
+        if (ws[ii] == -2 || ws[ii] == 2)
+        {
+            ws[ii] = 0;
+            ndrop++;
+        }
+    }
+
+    for (ii = 0; ii < ng; ii++)
+    {
+        if ((ws[nv+ii] == -1 && BLASFEO_DVECEL(qp_in->d_mask, nb+ii) == 0.0) ||
+            (ws[nv+ii] == 1 && BLASFEO_DVECEL(qp_in->d_mask, 2*nb+ng+ii) == 0.0))
+        {
+            ws[nv+ii] = 0;
+            ndrop++;
+        }
+    }
+
+    return ndrop;
+}
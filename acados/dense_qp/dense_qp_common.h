@@ -68,6 +68,9 @@ typedef struct
     int (*evaluate)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
     void (*solver_get)(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
     void (*memory_reset)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
+    // resets the warm-start state, i.e. qp_out and iterates or working sets kept in the memory,
+    // but keeps the solver setup, e.g. factorizations and allocated solver workspaces
+    void (*memory_reset_warm_start)(void *config, void *qp_out, void *opts, void *mem);
     void (*eval_sens)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
     void (*terminate)(void *config, void *mem, void *work);
 } qp_solver_config;
@@ -118,6 +121,8 @@ acados_size_t dense_qp_out_calculate_size(dense_qp_dims *dims);
 dense_qp_out *dense_qp_out_assign(dense_qp_dims *dims, void *raw_memory);
 //
 void dense_qp_out_get(dense_qp_out *out, const char *field, void *value);
+//
+void dense_qp_out_set_zero(dense_qp_out *qp_out);
 
 /* res */
 //
@@ -142,6 +147,12 @@ void dense_qp_stack_slacks_dims(dense_qp_dims *in, dense_qp_dims *out);
 void dense_qp_stack_slacks(dense_qp_in *in, dense_qp_in *out);
 //
 void dense_qp_unstack_slacks(dense_qp_out *in, dense_qp_in *qp_out, dense_qp_out *out);
+//
+// working set in active-set solver layout [nv bounds by variable; ng general constraints by row],
+// entries: -1 lower active, +1 upper active, 0 inactive
+void dense_qp_working_set_get(dense_qp_in *qp_in, dense_qp_out *qp_out, int *ws);
+// drop entries of ws that are not constraints of qp_in, returns number of dropped entries
+int dense_qp_working_set_map(dense_qp_in *qp_in, int *ws);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -97,6 +97,8 @@ void dense_qp_daqp_opts_initialize_default(void *config_, dense_qp_dims *dims, v
     dense_qp_daqp_opts *opts = (dense_qp_daqp_opts *) opts_;
     daqp_default_settings(opts->daqp_opts);
     opts->warm_start=1;
+    opts->cache_size = 0;
+    opts->cache_tol = 1e-8;
     return;
 }
 
@@ -141,6 +143,24 @@ void dense_qp_daqp_opts_set(void *config_, void *opts_, const char *field, void
         int *warm_start = value;
         opts->warm_start = *warm_start;
     }
+    else if (!strcmp(field, "cache_size"))
+    {
+        int *cache_size = value;
+        opts->cache_size = *cache_size;
+    }
+    else if (!strcmp(field, "cache_tol"))
+    {
+        double *cache_tol = value;
+        opts->cache_tol = *cache_tol;
+    }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: dense_qp_daqp_opts_set: wrong field: %s\n", field);
@@ -196,6 +216,8 @@ static acados_size_t daqp_workspace_calculate_size(int n, int m, int ms, int ns)
 
 acados_size_t dense_qp_daqp_memory_calculate_size(void *config_, dense_qp_dims *dims, void *opts_)
 {
+    dense_qp_daqp_opts *opts = opts_;
+
     int n = dims->nv;
     int m = dims->nv + dims->ng + dims->ne;
     int ms = dims->nv;
@@ -213,6 +235,12 @@ acados_size_t dense_qp_daqp_memory_calculate_size(void *config_, dense_qp_dims *
     size += m  * 1 * sizeof(int); // idxdaqp_to_idxs;
 
     size += ns * 6 * sizeof(c_float); // Zl,Zu,zl,zu,d_ls,d_us
+
+    size += (n + dims->ng) * sizeof(int); // ws
+
+    if (opts->cache_size > 0)
+        size += dense_qp_cache_calculate_size(dims, opts->cache_size);
+
     make_int_multiple_of(8, &size);
 
     return size;
@@ -342,6 +370,7 @@ static void *daqp_workspace_assign(int n, int m, int ms, int ns, void *raw_memor
 void *dense_qp_daqp_memory_assign(void *config_, dense_qp_dims *dims, void *opts_,
                                      void *raw_memory)
 {
+    dense_qp_daqp_opts *opts = opts_;
     dense_qp_daqp_memory *mem;
 
     int n = dims->nv;
@@ -400,6 +429,20 @@ void *dense_qp_daqp_memory_assign(void *config_, dense_qp_dims *dims, void *opts
     mem->d_us = (c_float *) c_ptr;
     c_ptr += ns * 1 * sizeof(c_float);
 
+    mem->ws = (int *) c_ptr;
+    c_ptr += (n + dims->ng) * sizeof(int);
+    mem->ws_valid = 0;
+
+    if (opts->cache_size > 0)
+    {
+        mem->cache = dense_qp_cache_assign(dims, opts->cache_size, c_ptr);
+        c_ptr += dense_qp_cache_calculate_size(dims, opts->cache_size);
+    }
+    else
+    {
+        mem->cache = NULL;
+    }
+
     assert((char *) raw_memory + dense_qp_daqp_memory_calculate_size(config_, dims, opts_) >=
            c_ptr);
 
@@ -423,6 +466,11 @@ void dense_qp_daqp_memory_get(void *config_, void *mem_, const char *field, void
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if (!strcmp(field, "cache_hits"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->cache == NULL ? 0 : mem->cache->hits;
+    }
     else
     {
         printf("\nerror: dense_qp_daqp_memory_get: field %s not available\n", field);
@@ -701,6 +749,34 @@ static void dense_qp_daqp_fill_output(dense_qp_daqp_memory *mem, const dense_qp_
 
 
 
+// seed the DAQP working set with the previous one, mapped to the constraints of qp_in;
+// this replaces the active flags left over in sense, which are stale after a cache hit
+// and may refer to constraints that are no longer present
+static void dense_qp_daqp_seed_working_set(dense_qp_in *qp_in, dense_qp_daqp_memory *mem)
+{
+    DAQPWorkspace *work = mem->daqp_work;
+    int nv = qp_in->dim->nv;
+    int ng = qp_in->dim->ng;
+    int *ws = mem->ws;
+
+    dense_qp_working_set_map(qp_in, ws);
+
+    for (int ii = 0; ii < nv+ng; ii++)
+    {
+        SET_INACTIVE(ii);
+        if (ws[ii] != 0 && !(work->sense[ii] & IMMUTABLE))
+        {
+            SET_ACTIVE(ii);
+            if (ws[ii] < 0)
+                SET_LOWER(ii);
+            else
+                SET_UPPER(ii);
+        }
+    }
+}
+
+
+
 int dense_qp_daqp(void* config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void *opts_, void *memory_, void *work_)
 {
     qp_info *info = (qp_info *) qp_out->misc;
@@ -716,6 +792,32 @@ int dense_qp_daqp(void* config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void
     dense_qp_daqp_opts *opts = (dense_qp_daqp_opts *) opts_;
     dense_qp_daqp_memory *memory = (dense_qp_daqp_memory *) memory_;
 
+    // the cache is allocated at memory creation
+    if ((opts->cache_size > 0 ? opts->cache_size : 0) != (memory->cache == NULL ? 0 : memory->cache->size))
+    {
+        printf("\nerror: dense_qp_daqp: cache_size has to be set before memory creation, got %d, allocated %d.\n",
+               opts->cache_size, memory->cache == NULL ? 0 : memory->cache->size);
+        exit(1);
+    }
+
+    // try cached active sets
+    if (memory->cache != NULL)
+    {
+        memory->cache->tol = opts->cache_tol;
+        if (dense_qp_cache_lookup(memory->cache, qp_in, qp_out))
+        {
+            info->interface_time = acados_toc(&interface_timer);
+            info->solve_QP_time = 0.0;
+            info->total_time = acados_toc(&tot_timer);
+            info->num_iter = 0;
+            memory->time_qp_solver_call = 0.0;
+            memory->iter = 0;
+            dense_qp_working_set_get(qp_in, qp_out, memory->ws);
+            memory->ws_valid = 1;
+            return ACADOS_SUCCESS;
+        }
+    }
+
     // Move data into daqp workspace
     dense_qp_daqp_update_memory(qp_in,opts,memory);
     info->interface_time = acados_toc(&interface_timer);
@@ -738,6 +840,12 @@ int dense_qp_daqp(void* config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void
     // solve LDP
     if (opts->warm_start==1)
         activate_constraints(work);
+    else if (opts->warm_start==3)
+    {
+        if (memory->ws_valid)
+            dense_qp_daqp_seed_working_set(qp_in, memory);
+        activate_constraints(work);
+    }
 
     // TODO: shift active set? - not in SQP but would be nice as an option in SQP_RTI.
 
@@ -770,6 +878,14 @@ int dense_qp_daqp(void* config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void
     // NOTE: There are also:
     // EXIT_INFEASIBLE, EXIT_CYCLE, EXIT_UNBOUNDED, EXIT_NONCONVEX, EXIT_OVERDETERMINED_INITIAL
 
+    if (memory->cache != NULL && acados_status == ACADOS_SUCCESS)
+        dense_qp_cache_insert(memory->cache, qp_in, qp_out);
+
+    // working set for the next warm start
+    memory->ws_valid = acados_status == ACADOS_SUCCESS;
+    if (memory->ws_valid)
+        dense_qp_working_set_get(qp_in, qp_out, memory->ws);
+
     return acados_status;
 }
 
@@ -786,6 +902,17 @@ void dense_qp_daqp_memory_reset(void *config, void *qp_in, void *qp_out, void *o
     exit(1);
 }
 
+
+
+void dense_qp_daqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    dense_qp_daqp_memory *mem = mem_;
+
+    dense_qp_out_set_zero(qp_out_);
+    deactivate_constraints(mem->daqp_work);
+    mem->ws_valid = 0;
+}
+
 void dense_qp_daqp_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     printf("\nerror: dense_qp_daqp_solver_get: not implemented yet\n");
@@ -822,6 +949,7 @@ void dense_qp_daqp_config_initialize_default(void *config_)
     config->eval_sens = &dense_qp_daqp_eval_sens;
     config->evaluate = (int (*)(void *, void *, void *, void *, void *, void *)) & dense_qp_daqp;
     config->memory_reset = &dense_qp_daqp_memory_reset;
+    config->memory_reset_warm_start = &dense_qp_daqp_memory_reset_warm_start;
     config->solver_get = &dense_qp_daqp_solver_get;
     config->terminate = &dense_qp_daqp_terminate;
 
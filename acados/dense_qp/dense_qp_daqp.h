@@ -43,6 +43,7 @@ extern "C" {
 #include "daqp/include/types.h"
 
 // acados
+#include "acados/dense_qp/dense_qp_cache.h"
 #include "acados/dense_qp/dense_qp_common.h"
 #include "acados/utils/types.h"
 
@@ -50,7 +51,9 @@ extern "C" {
 typedef struct dense_qp_daqp_opts_
 {
     DAQPSettings* daqp_opts;
-    int warm_start;
+    int warm_start;     // 1: active set of the last solve; 3: working set transfer, see dense_qp_working_set_map
+    int cache_size;     // number of cached optimal active sets, 0: no cache; fixed at memory creation
+    double cache_tol;   // KKT tolerance for accepting a cached active set
 } dense_qp_daqp_opts;
 
 
@@ -73,6 +76,9 @@ typedef struct dense_qp_daqp_memory_
     double time_qp_solver_call;
     int iter;
     DAQPWorkspace * daqp_work;
+    dense_qp_cache *cache;
+    int *ws;        // working set of the last solve, see dense_qp_working_set_get
+    int ws_valid;
 
 } dense_qp_daqp_memory;
 
@@ -101,6 +107,8 @@ void dense_qp_daqp_eval_sens(void *config_, void *qp_in, void *qp_out, void *opt
 //
 void dense_qp_daqp_memory_reset(void *config_, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
 //
+void dense_qp_daqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void dense_qp_daqp_config_initialize_default(void *config_);
 //
 void dense_qp_daqp_memory_reset(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
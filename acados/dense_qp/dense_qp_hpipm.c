@@ -37,6 +37,10 @@
 #include "hpipm/include/hpipm_d_dense_qp.h"
 #include "hpipm/include/hpipm_d_dense_qp_ipm.h"
 #include "hpipm/include/hpipm_d_dense_qp_sol.h"
+#include "hpipm/include/hpipm_s_dense_qp.h"
+#include "hpipm/include/hpipm_s_dense_qp_dim.h"
+#include "hpipm/include/hpipm_s_dense_qp_ipm.h"
+#include "hpipm/include/hpipm_s_dense_qp_sol.h"
 // acados
 #include "acados/dense_qp/dense_qp_common.h"
 #include "acados/dense_qp/dense_qp_hpipm.h"
@@ -45,10 +49,104 @@
 
 
 
+/************************************************
+ * precision conversion
+ ************************************************/
+
+static void cvt_d2s_mat(int m, int n, struct blasfeo_dmat *A, struct blasfeo_smat *sA)
+{
+    for (int jj = 0; jj < n; jj++)
+        for (int ii = 0; ii < m; ii++)
+            BLASFEO_SMATEL(sA, ii, jj) = (float) BLASFEO_DMATEL(A, ii, jj);
+}
+
+
+
+static void cvt_d2s_vec(int m, struct blasfeo_dvec *x, struct blasfeo_svec *sx)
+{
+    for (int ii = 0; ii < m; ii++)
+        BLASFEO_SVECEL(sx, ii) = (float) BLASFEO_DVECEL(x, ii);
+}
+
+
+
+static void cvt_s2d_vec(int m, struct blasfeo_svec *sx, struct blasfeo_dvec *x)
+{
+    for (int ii = 0; ii < m; ii++)
+        BLASFEO_DVECEL(x, ii) = (double) BLASFEO_SVECEL(sx, ii);
+}
+
+
+
+static void dense_qp_hpipm_cvt_d2s_qp(dense_qp_in *qp_in, struct s_dense_qp *qp_single)
+{
+    int nv = qp_in->dim->nv;
+    int ne = qp_in->dim->ne;
+    int nb = qp_in->dim->nb;
+    int ng = qp_in->dim->ng;
+    int ns = qp_in->dim->ns;
+
+    cvt_d2s_mat(nv+1, nv, qp_in->Hv, qp_single->Hv);
+    cvt_d2s_mat(ne, nv, qp_in->A, qp_single->A);
+    cvt_d2s_mat(nv, ng, qp_in->Ct, qp_single->Ct);
+    cvt_d2s_vec(nv+2*ns, qp_in->gz, qp_single->gz);
+    cvt_d2s_vec(ne, qp_in->b, qp_single->b);
+    cvt_d2s_vec(2*nb+2*ng+2*ns, qp_in->d, qp_single->d);
+    cvt_d2s_vec(2*nb+2*ng+2*ns, qp_in->d_mask, qp_single->d_mask);
+    cvt_d2s_vec(2*nb+2*ng+2*ns, qp_in->m, qp_single->m);
+    cvt_d2s_vec(2*ns, qp_in->Z, qp_single->Z);
+
+    for (int ii = 0; ii < nb; ii++)
+        qp_single->idxb[ii] = qp_in->idxb[ii];
+    for (int ii = 0; ii < nb+ng; ii++)
+        qp_single->idxs_rev[ii] = qp_in->idxs_rev[ii];
+}
+
+
+
+static void dense_qp_hpipm_cvt_d2s_sol(dense_qp_dims *dims, dense_qp_out *qp_out, struct s_dense_qp_sol *sol_single)
+{
+    int ni = 2*dims->nb+2*dims->ng+2*dims->ns;
+    cvt_d2s_vec(dims->nv+2*dims->ns, qp_out->v, sol_single->v);
+    cvt_d2s_vec(dims->ne, qp_out->pi, sol_single->pi);
+    cvt_d2s_vec(ni, qp_out->lam, sol_single->lam);
+    cvt_d2s_vec(ni, qp_out->t, sol_single->t);
+}
+
+
+
+static void dense_qp_hpipm_cvt_s2d_sol(dense_qp_dims *dims, struct s_dense_qp_sol *sol_single, dense_qp_out *qp_out)
+{
+    int ni = 2*dims->nb+2*dims->ng+2*dims->ns;
+    cvt_s2d_vec(dims->nv+2*dims->ns, sol_single->v, qp_out->v);
+    cvt_s2d_vec(dims->ne, sol_single->pi, qp_out->pi);
+    cvt_s2d_vec(ni, sol_single->lam, qp_out->lam);
+    cvt_s2d_vec(ni, sol_single->t, qp_out->t);
+}
+
+
+
 /************************************************
  * opts
  ************************************************/
 
+// size of the single precision arg, with the same dims as in dense_qp_hpipm_opts_assign
+static acados_size_t dense_qp_hpipm_single_opts_memsize(dense_qp_dims *dims)
+{
+    struct s_dense_qp_dim dim_single;
+    void *dim_single_mem = acados_calloc(1, s_dense_qp_dim_memsize());
+    s_dense_qp_dim_create(&dim_single, dim_single_mem);
+    s_dense_qp_dim_set_all(dims->nv, dims->ne, dims->nb, dims->ng, dims->nsb, dims->nsg, &dim_single);
+
+    acados_size_t size = s_dense_qp_ipm_arg_memsize(&dim_single);
+
+    free(dim_single_mem);
+
+    return size;
+}
+
+
+
 acados_size_t dense_qp_hpipm_opts_calculate_size(void *config_, void *dims_)
 {
     dense_qp_dims *dims = dims_;
@@ -59,6 +157,13 @@ acados_size_t dense_qp_hpipm_opts_calculate_size(void *config_, void *dims_)
     size += 8;  // align for d_dense_qp_ipm_arg
     size += d_dense_qp_ipm_arg_memsize(dims);
 
+    // mixed precision
+    size += sizeof(struct s_dense_qp_dim);
+    size += s_dense_qp_dim_memsize();
+    size += sizeof(struct s_dense_qp_ipm_arg);
+    size += dense_qp_hpipm_single_opts_memsize(dims);
+    size += 2 * 8;
+
     make_int_multiple_of(8, &size);
 
     return size;
@@ -84,6 +189,22 @@ void *dense_qp_hpipm_opts_assign(void *config_, void *dims_, void *raw_memory)
     d_dense_qp_ipm_arg_create(dims, opts->hpipm_opts, c_ptr);
     c_ptr += d_dense_qp_ipm_arg_memsize(dims);
 
+    // mixed precision
+    opts->dim_single = (struct s_dense_qp_dim *) c_ptr;
+    c_ptr += sizeof(struct s_dense_qp_dim);
+
+    opts->hpipm_opts_single = (struct s_dense_qp_ipm_arg *) c_ptr;
+    c_ptr += sizeof(struct s_dense_qp_ipm_arg);
+
+    align_char_to(8, &c_ptr);
+    s_dense_qp_dim_create(opts->dim_single, c_ptr);
+    c_ptr += s_dense_qp_dim_memsize();
+    s_dense_qp_dim_set_all(dims->nv, dims->ne, dims->nb, dims->ng, dims->nsb, dims->nsg, opts->dim_single);
+
+    align_char_to(8, &c_ptr);
+    s_dense_qp_ipm_arg_create(opts->dim_single, opts->hpipm_opts_single, c_ptr);
+    c_ptr += s_dense_qp_ipm_arg_memsize(opts->dim_single);
+
     assert((char *) raw_memory + dense_qp_hpipm_opts_calculate_size(config_, dims) >= c_ptr);
 
     return (void *) opts;
@@ -100,6 +221,16 @@ static void dense_qp_hpipm_opts_overwrite_mode_opts(dense_qp_hpipm_opts *opts)
     opts->hpipm_opts->stat_max = 50;
     opts->hpipm_opts->alpha_min = 1e-8;
     opts->hpipm_opts->mu0 = 1e0;
+
+    // single precision: tolerances close to float epsilon, the rest is left to the refinement
+    opts->hpipm_opts_single->res_g_max = 1e-4;
+    opts->hpipm_opts_single->res_b_max = 1e-4;
+    opts->hpipm_opts_single->res_d_max = 1e-4;
+    opts->hpipm_opts_single->res_m_max = 1e-4;
+    opts->hpipm_opts_single->iter_max = 50;
+    opts->hpipm_opts_single->stat_max = 50;
+    opts->hpipm_opts_single->alpha_min = 1e-8;
+    opts->hpipm_opts_single->mu0 = 1e0;
 }
 
 
@@ -108,9 +239,15 @@ void dense_qp_hpipm_opts_initialize_default(void *config_, void *dims_, void *op
     dense_qp_hpipm_opts *opts = opts_;
 
     d_dense_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts);
+    s_dense_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts_single);
     dense_qp_hpipm_opts_overwrite_mode_opts(opts);
 
     opts->print_level = 0;
+    opts->time_limit = 0.0;
+    opts->mixed_precision = 0;
+    opts->mixed_precision_refine_iter_max = 5;
+    opts->log_stat = 0;
+    opts->lhs_unchanged = 0;
 
     return;
 }
@@ -134,13 +271,25 @@ void dense_qp_hpipm_opts_set(void *config_, void *opts_, const char *field, void
     {
         mode = (const char *) value;
         if (!strcmp(mode, "BALANCE"))
+        {
             d_dense_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts);
+            s_dense_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "SPEED"))
+        {
             d_dense_qp_ipm_arg_set_default(SPEED, opts->hpipm_opts);
+            s_dense_qp_ipm_arg_set_default(SPEED, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "SPEED_ABS"))
+        {
             d_dense_qp_ipm_arg_set_default(SPEED_ABS, opts->hpipm_opts);
+            s_dense_qp_ipm_arg_set_default(SPEED_ABS, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "ROBUST"))
+        {
             d_dense_qp_ipm_arg_set_default(ROBUST, opts->hpipm_opts);
+            s_dense_qp_ipm_arg_set_default(ROBUST, opts->hpipm_opts_single);
+        }
 
         dense_qp_hpipm_opts_overwrite_mode_opts(opts);
 
@@ -150,6 +299,47 @@ void dense_qp_hpipm_opts_set(void *config_, void *opts_, const char *field, void
         int* print_level = (int *) value;
         opts->print_level = *print_level;
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        double* time_limit = (double *) value;
+        opts->time_limit = *time_limit;
+    }
+    else if (!strcmp(field, "mixed_precision"))
+    {
+        int* mixed_precision = (int *) value;
+        opts->mixed_precision = *mixed_precision;
+    }
+    else if (!strcmp(field, "mixed_precision_refine_iter_max"))
+    {
+        int* refine_iter_max = (int *) value;
+        if (*refine_iter_max < 1)
+        {
+            printf("\nerror: dense_qp_hpipm_opts_set: mixed_precision_refine_iter_max must be >= 1, got %d.\n",
+                   *refine_iter_max);
+            exit(1);
+        }
+        opts->mixed_precision_refine_iter_max = *refine_iter_max;
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        int* lhs_unchanged = (int *) value;
+        opts->lhs_unchanged = *lhs_unchanged;
+    }
+    else if (!strcmp(field, "log_stat"))
+    {
+        int* log_stat = (int *) value;
+        opts->log_stat = *log_stat;
+    }
+    else if (!strcmp(field, "mixed_precision_tol"))
+    {
+        // tolerance of the single-precision IPM on all residuals
+        double* tol = (double *) value;
+        float tol_single = (float) *tol;
+        s_dense_qp_ipm_arg_set_tol_stat(&tol_single, opts->hpipm_opts_single);
+        s_dense_qp_ipm_arg_set_tol_eq(&tol_single, opts->hpipm_opts_single);
+        s_dense_qp_ipm_arg_set_tol_ineq(&tol_single, opts->hpipm_opts_single);
+        s_dense_qp_ipm_arg_set_tol_comp(&tol_single, opts->hpipm_opts_single);
+    }
     else
     {
         d_dense_qp_ipm_arg_set((char *) field, value, opts->hpipm_opts);
@@ -176,6 +366,22 @@ acados_size_t dense_qp_hpipm_memory_calculate_size(void *config_, void *dims_, v
 
     size += d_dense_qp_ipm_ws_memsize(dims, opts->hpipm_opts);
     size += 8;  // align d_dense_qp_ipm_ws
+
+    // mixed precision
+    if (opts->mixed_precision)
+    {
+        size += sizeof(struct s_dense_qp);
+        size += sizeof(struct s_dense_qp_sol);
+        size += sizeof(struct s_dense_qp_ipm_ws);
+        size += s_dense_qp_memsize(opts->dim_single);
+        size += s_dense_qp_sol_memsize(opts->dim_single);
+        size += s_dense_qp_ipm_ws_memsize(opts->dim_single, opts->hpipm_opts_single);
+        size += 3 * 8;
+    }
+
+    if (opts->log_stat)
+        size += (opts->hpipm_opts->iter_max + 1) * QP_STAT_N * sizeof(double) + 8;
+
     make_int_multiple_of(8, &size);
 
     return size;
@@ -205,6 +411,56 @@ void *dense_qp_hpipm_memory_assign(void *config_, void *dims_, void *opts_, void
     d_dense_qp_ipm_ws_create(dims, opts->hpipm_opts, ipm_workspace, c_ptr);
     c_ptr += ipm_workspace->memsize;
 
+    // mixed precision
+    if (opts->mixed_precision)
+    {
+        mem->qp_single = (struct s_dense_qp *) c_ptr;
+        c_ptr += sizeof(struct s_dense_qp);
+        mem->sol_single = (struct s_dense_qp_sol *) c_ptr;
+        c_ptr += sizeof(struct s_dense_qp_sol);
+        mem->hpipm_workspace_single = (struct s_dense_qp_ipm_ws *) c_ptr;
+        c_ptr += sizeof(struct s_dense_qp_ipm_ws);
+
+        align_char_to(8, &c_ptr);
+        s_dense_qp_create(opts->dim_single, mem->qp_single, c_ptr);
+        c_ptr += s_dense_qp_memsize(opts->dim_single);
+
+        align_char_to(8, &c_ptr);
+        s_dense_qp_sol_create(opts->dim_single, mem->sol_single, c_ptr);
+        c_ptr += s_dense_qp_sol_memsize(opts->dim_single);
+
+        align_char_to(8, &c_ptr);
+        s_dense_qp_ipm_ws_create(opts->dim_single, opts->hpipm_opts_single, mem->hpipm_workspace_single, c_ptr);
+        c_ptr += mem->hpipm_workspace_single->memsize;
+    }
+    else
+    {
+        mem->qp_single = NULL;
+        mem->sol_single = NULL;
+        mem->hpipm_workspace_single = NULL;
+    }
+    mem->iter_single = 0;
+    mem->mixed_precision_used = 0;
+
+    if (opts->log_stat)
+    {
+        mem->stat_max = opts->hpipm_opts->iter_max + 1;
+        align_char_to(8, &c_ptr);
+        assign_and_advance_double(mem->stat_max * QP_STAT_N, &mem->stat, &c_ptr);
+    }
+    else
+    {
+        mem->stat_max = 0;
+        mem->stat = NULL;
+    }
+    mem->stat_rows = 0;
+
+    mem->unconstrained = dims->nb + dims->ng + dims->ns + dims->ne == 0;
+    mem->fact_valid = 0;
+    mem->fact_reused = 0;
+
+    mem->time_per_iter = 0.0;
+
     assert((char *) raw_memory + dense_qp_hpipm_memory_calculate_size(config_, dims, opts) >= c_ptr);
 
     return mem;
@@ -227,6 +483,41 @@ void dense_qp_hpipm_memory_get(void *config_, void *mem_, const char *field, voi
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if (!strcmp(field, "iter_single"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->iter_single;
+    }
+    else if (!strcmp(field, "mixed_precision_used"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->mixed_precision_used;
+    }
+    else if (!strcmp(field, "stat"))
+    {
+        if (mem->stat == NULL)
+        {
+            printf("\nerror: dense_qp_hpipm_memory_get: option log_stat was not set\n");
+            exit(1);
+        }
+        double **tmp_ptr = value;
+        *tmp_ptr = mem->stat;
+    }
+    else if (!strcmp(field, "stat_m"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->stat_rows;
+    }
+    else if (!strcmp(field, "stat_n"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = QP_STAT_N;
+    }
+    else if (!strcmp(field, "fact_reused"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->fact_reused;
+    }
     else
     {
         printf("\nerror: dense_qp_hpipm_memory_get: field %s not available\n", field);
@@ -254,6 +545,81 @@ acados_size_t dense_qp_hpipm_workspace_calculate_size(void *config_, void *dims_
  * functions
  ************************************************/
 
+// single-precision IPM followed by a few double-precision IPM iterations warm-started from its solution,
+// returns true if the double-precision tolerances are met;
+// with time_limited, both IPMs share the iteration budget arg->iter_max
+static bool dense_qp_hpipm_solve_mixed_precision(dense_qp_in *qp_in, dense_qp_out *qp_out,
+                                                 dense_qp_hpipm_opts *opts, dense_qp_hpipm_memory *mem, int time_limited)
+{
+    struct d_dense_qp_ipm_arg *arg = opts->hpipm_opts;
+    struct s_dense_qp_ipm_arg *arg_single = opts->hpipm_opts_single;
+    int status_single, status;
+
+    dense_qp_hpipm_cvt_d2s_qp(qp_in, mem->qp_single);
+    arg_single->warm_start = arg->warm_start;
+    if (arg->warm_start)
+        dense_qp_hpipm_cvt_d2s_sol(qp_in->dim, qp_out, mem->sol_single);
+
+    s_dense_qp_ipm_solve(mem->qp_single, mem->sol_single, arg_single, mem->hpipm_workspace_single);
+    s_dense_qp_ipm_get_status(mem->hpipm_workspace_single, &status_single);
+    mem->iter_single = mem->hpipm_workspace_single->iter;
+
+    // MAXITER in single precision is still a useful starting point for the refinement
+    if (status_single != 0 && status_single != 1)
+        return false;
+
+    // refinement on the double-precision QP
+    dense_qp_hpipm_cvt_s2d_sol(qp_in->dim, mem->sol_single, qp_out);
+
+    int warm_start = arg->warm_start;
+    int iter_max = arg->iter_max;
+    arg->warm_start = 2;
+    arg->iter_max = opts->mixed_precision_refine_iter_max;
+    if (time_limited && iter_max - mem->iter_single < arg->iter_max)
+        arg->iter_max = iter_max - mem->iter_single < 1 ? 1 : iter_max - mem->iter_single;
+    d_dense_qp_ipm_solve(qp_in, qp_out, arg, mem->hpipm_workspace);
+    d_dense_qp_ipm_get_status(mem->hpipm_workspace, &status);
+    arg->warm_start = warm_start;
+    arg->iter_max = iter_max;
+
+    return status == 0;
+}
+
+
+
+// copy the relevant columns of the HPIPM statistics of the last (double-precision) IPM
+static void dense_qp_hpipm_log_stat(dense_qp_hpipm_memory *mem)
+{
+    double *stat;
+    int stat_m;
+    d_dense_qp_ipm_get_stat(mem->hpipm_workspace, &stat);
+    d_dense_qp_ipm_get_stat_m(mem->hpipm_workspace, &stat_m);
+
+    int n_row = mem->hpipm_workspace->iter + 1;
+    if (n_row > mem->stat_max)
+        n_row = mem->stat_max;
+
+    // HPIPM columns: alpha_aff, mu_aff, sigma, alpha_prim, alpha_dual, mu, res_stat, res_eq,
+    // res_ineq, res_comp, obj, lq fact, itref pred, itref corr, ...
+    for (int ii = 0; ii < n_row; ii++)
+    {
+        double *hpipm_row = stat + ii * stat_m;
+        double *row = mem->stat + ii * QP_STAT_N;
+        row[QP_STAT_ALPHA_PRIM] = hpipm_row[3];
+        row[QP_STAT_ALPHA_DUAL] = hpipm_row[4];
+        row[QP_STAT_MU] = hpipm_row[5];
+        row[QP_STAT_RES_STAT] = hpipm_row[6];
+        row[QP_STAT_RES_EQ] = hpipm_row[7];
+        row[QP_STAT_RES_INEQ] = hpipm_row[8];
+        row[QP_STAT_RES_COMP] = hpipm_row[9];
+        row[QP_STAT_ITREF_PRED] = hpipm_row[12];
+        row[QP_STAT_ITREF_CORR] = hpipm_row[13];
+    }
+    mem->stat_rows = n_row;
+}
+
+
+
 int dense_qp_hpipm(void *config, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
 {
     dense_qp_in *qp_in = qp_in_;
@@ -274,24 +640,83 @@ int dense_qp_hpipm(void *config, void *qp_in_, void *qp_out_, void *opts_, void
     int ns = qp_in->dim->ns;
     blasfeo_dvecse(nv+2*ns, 0.0, qp_out->v, 0);
 
+    // enforce time limit by capping the number of iterations
+    int iter_max = opts->hpipm_opts->iter_max;
+    int iter_max_single = opts->hpipm_opts_single->iter_max;
+    int time_limited = opts->time_limit > 0.0 && mem->time_per_iter > 0.0;
+    if (time_limited)
+    {
+        int iter_max_time = (int) (opts->time_limit / mem->time_per_iter);
+        if (iter_max_time < 1)
+            iter_max_time = 1;
+        opts->hpipm_opts->iter_max = iter_max_time < iter_max ? iter_max_time : iter_max;
+        opts->hpipm_opts_single->iter_max = iter_max_time < iter_max_single ? iter_max_time : iter_max_single;
+    }
+
+    // the single-precision workspace only exists if mixed_precision was set before memory creation
+    int mixed_precision = opts->mixed_precision && mem->qp_single != NULL;
+
     // solve ipm
     acados_tic(&qp_timer);
-    int hpipm_status;
-    d_dense_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
-    d_dense_qp_ipm_get_status(mem->hpipm_workspace, &hpipm_status);
+    int hpipm_status = 0;
+    mem->iter_single = 0;
+    mem->mixed_precision_used = 0;
+    mem->fact_reused = opts->lhs_unchanged && mem->fact_valid;
+    if (mem->fact_reused)
+    {
+        // without inequality constraints the solution is linear in the QP vectors:
+        // one KKT solve with the stored factorization, taking the QP itself as parametric QP
+        d_dense_qp_ipm_sens(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+        hpipm_status = 0;
+    }
+    else
+    {
+        if (mixed_precision)
+        {
+            mem->mixed_precision_used = dense_qp_hpipm_solve_mixed_precision(qp_in, qp_out, opts, mem, time_limited);
+        }
+        if (!mem->mixed_precision_used)
+        {
+            if (mixed_precision)
+            {
+                // refinement stalled, fall back to double precision with the remaining budget
+                if (time_limited)
+                {
+                    int iter_left = opts->hpipm_opts->iter_max - mem->iter_single;
+                    opts->hpipm_opts->iter_max = iter_left < 1 ? 1 : iter_left;
+                }
+                blasfeo_dvecse(nv+2*ns, 0.0, qp_out->v, 0);
+            }
+            d_dense_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+            d_dense_qp_ipm_get_status(mem->hpipm_workspace, &hpipm_status);
+        }
+        mem->fact_valid = mem->unconstrained && hpipm_status == 0;
+    }
+    opts->hpipm_opts->iter_max = iter_max;
+    opts->hpipm_opts_single->iter_max = iter_max_single;
 
     info->solve_QP_time = acados_toc(&qp_timer);
     info->interface_time = 0;  // there are no conversions for hpipm
     info->total_time = acados_toc(&tot_timer);
-    info->num_iter = mem->hpipm_workspace->iter;
+    info->num_iter = mem->fact_reused ? 0 : mem->iter_single + mem->hpipm_workspace->iter;
     info->t_computed = 1;
 
     mem->time_qp_solver_call = info->solve_QP_time;
-    mem->iter = mem->hpipm_workspace->iter;
+    mem->iter = info->num_iter;
+    if (mem->iter > 0)
+        mem->time_per_iter = mem->time_qp_solver_call / mem->iter;
+
+    if (opts->log_stat)
+    {
+        if (mem->fact_reused)
+            mem->stat_rows = 0;
+        else
+            dense_qp_hpipm_log_stat(mem);
+    }
 
 #ifndef BLASFEO_EXT_DEP_OFF
     // print HPIPM statistics:
-    if (opts->print_level > 0)
+    if (opts->print_level > 0 && !mem->fact_reused)
     {
         double *stat; d_dense_qp_ipm_get_stat(mem->hpipm_workspace, &stat);
         int stat_m; d_dense_qp_ipm_get_stat_m(mem->hpipm_workspace, &stat_m);
@@ -346,6 +771,13 @@ void dense_qp_hpipm_memory_reset(void *config, void *qp_in, void *qp_out, void *
     exit(1);
 }
 
+
+
+void dense_qp_hpipm_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    dense_qp_out_set_zero(qp_out_);
+}
+
 void dense_qp_hpipm_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     printf("\nerror: dense_qp_hpipm_solver_get: not implemented yet\n");
@@ -376,6 +808,7 @@ void dense_qp_hpipm_config_initialize_default(void *config_)
     config->evaluate = &dense_qp_hpipm;
     config->eval_sens = &dense_qp_hpipm_eval_sens;
     config->memory_reset = &dense_qp_hpipm_memory_reset;
+    config->memory_reset_warm_start = &dense_qp_hpipm_memory_reset_warm_start;
     config->solver_get = &dense_qp_hpipm_solver_get;
     config->terminate = &dense_qp_hpipm_terminate;
 
@@ -40,6 +40,10 @@ extern "C" {
 #include "hpipm/include/hpipm_d_dense_qp.h"
 #include "hpipm/include/hpipm_d_dense_qp_ipm.h"
 #include "hpipm/include/hpipm_d_dense_qp_sol.h"
+#include "hpipm/include/hpipm_s_dense_qp.h"
+#include "hpipm/include/hpipm_s_dense_qp_dim.h"
+#include "hpipm/include/hpipm_s_dense_qp_ipm.h"
+#include "hpipm/include/hpipm_s_dense_qp_sol.h"
 // acados
 #include "acados/dense_qp/dense_qp_common.h"
 #include "acados/utils/types.h"
@@ -50,6 +54,14 @@ typedef struct dense_qp_hpipm_opts_
 {
     struct d_dense_qp_ipm_arg *hpipm_opts;
     int print_level;
+    double time_limit;  // limit on solver time in seconds, enforced by capping iter_max; <= 0: no limit
+    // mixed precision: single-precision IPM, refined by a warm-started double-precision IPM
+    int mixed_precision;  // only effective if set before memory creation, double precision otherwise
+    int mixed_precision_refine_iter_max;  // double-precision iterations, falls back to a double-precision solve if exceeded
+    int log_stat;  // record per-iteration statistics of the (double-precision) IPM, see memory_get "stat"
+    int lhs_unchanged;  // set by the caller if the QP matrices equal those of the last call
+    struct s_dense_qp_dim *dim_single;
+    struct s_dense_qp_ipm_arg *hpipm_opts_single;
 } dense_qp_hpipm_opts;
 
 
@@ -58,8 +70,26 @@ typedef struct dense_qp_hpipm_memory_
 {
     struct d_dense_qp_ipm_ws *hpipm_workspace;
     double time_qp_solver_call;
+    double time_per_iter;  // measured in the last call, used for time_limit
     int iter;
 
+    // mixed precision, only allocated if opts->mixed_precision
+    struct s_dense_qp *qp_single;
+    struct s_dense_qp_sol *sol_single;
+    struct s_dense_qp_ipm_ws *hpipm_workspace_single;
+    int iter_single;  // single-precision iterations in the last call, included in iter
+    int mixed_precision_used;  // 0 if the last call fell back to (or was configured for) double precision
+
+    // per-iteration statistics, QP_STAT_N columns, only allocated if opts->log_stat
+    double *stat;
+    int stat_max;   // allocated rows
+    int stat_rows;  // rows filled in the last call: initial point and iterations
+
+    // factorization reuse for QPs without inequality constraints, see opts->lhs_unchanged
+    int unconstrained;  // the QP has no bounds, general constraints or slacks
+    int fact_valid;     // the workspace holds the KKT factorization of the last solved QP
+    int fact_reused;    // the last call reused the factorization
+
 } dense_qp_hpipm_memory;
 
 
@@ -87,6 +117,8 @@ void dense_qp_hpipm_config_initialize_default(void *config_);
 //
 void dense_qp_hpipm_memory_reset(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
 //
+void dense_qp_hpipm_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void dense_qp_hpipm_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
 
 
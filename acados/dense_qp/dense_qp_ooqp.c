@@ -371,6 +371,14 @@ void dense_qp_ooqp_opts_set(void *config_, void *opts_, const char *field, void
     {
         // TODO set solver warm start
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: dense_qp_ooqp_opts_set: wrong field: %s\n", field);
@@ -627,6 +635,13 @@ void dense_qp_ooqp_memory_reset(void *config, void *qp_in, void *qp_out, void *o
     exit(1);
 }
 
+
+
+void dense_qp_ooqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    dense_qp_out_set_zero(qp_out_);
+}
+
 void dense_qp_ooqp_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     printf("\nerror: dense_qp_ooqp_solver_get: not implemented yet\n");
@@ -659,6 +674,7 @@ void dense_qp_ooqp_config_initialize_default(void *config_)
     config->evaluate = (int (*)(void *, void *, void *, void *, void *, void *)) & dense_qp_ooqp;
     config->eval_sens = &dense_qp_ooqp_eval_sens;
     config->memory_reset = &dense_qp_ooqp_memory_reset;
+    config->memory_reset_warm_start = &dense_qp_ooqp_memory_reset_warm_start;
     config->solver_get = &dense_qp_ooqp_solver_get;
     config->terminate = &dense_qp_ooqp_terminate;
 }
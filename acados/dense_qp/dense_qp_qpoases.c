@@ -30,6 +30,7 @@
 
 
 // external
+#include <math.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
@@ -45,6 +46,7 @@
 #pragma clang diagnostic ignored "-Wunused-function"
 #include "qpOASES_e/QProblem.h"
 #include "qpOASES_e/QProblemB.h"
+#include "qpOASES_e/SQProblem.h"
 #pragma clang diagnostic pop
 #elif defined(__GNUC__)
 #if __GNUC__ >= 6
@@ -54,16 +56,19 @@
 #pragma GCC diagnostic ignored "-Wunused-function"
 #include "qpOASES_e/QProblem.h"
 #include "qpOASES_e/QProblemB.h"
+#include "qpOASES_e/SQProblem.h"
 #pragma GCC diagnostic pop
 #else
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #pragma GCC diagnostic ignored "-Wunused-function"
 #include "qpOASES_e/QProblem.h"
 #include "qpOASES_e/QProblemB.h"
+#include "qpOASES_e/SQProblem.h"
 #endif
 #else
 #include "qpOASES_e/QProblem.h"
 #include "qpOASES_e/QProblemB.h"
+#include "qpOASES_e/SQProblem.h"
 #endif
 
 // acados
@@ -121,6 +126,8 @@ void dense_qp_qpoases_opts_initialize_default(void *config_, dense_qp_dims *dims
     opts->set_acado_opts = 1;
     opts->compute_t = 1;
     opts->tolerance = 1e-4;
+    opts->cache_size = 0;
+    opts->cache_tol = 1e-8;
 
     return;
 }
@@ -178,9 +185,14 @@ void dense_qp_qpoases_opts_set(void *config_, void *opts_, const char *field, vo
             opts->warm_start = 1;
             opts->hotstart = 1;
         }
+        else if (*warm_start == 3)
+        {
+            opts->warm_start = 1;
+            opts->hotstart = 2;
+        }
         else
         {
-            printf("\ndense_qp_qpoases: setting warm_start: supported values are: 0 - cold, 1 - warm, 2 - hot\n");
+            printf("\ndense_qp_qpoases: setting warm_start: supported values are: 0 - cold, 1 - warm, 2 - hot, 3 - hot with changing matrices\n");
             exit(1);
         }
     }
@@ -189,6 +201,24 @@ void dense_qp_qpoases_opts_set(void *config_, void *opts_, const char *field, vo
         int *max_iter = value;
         opts->max_nwsr = *max_iter;
     }
+    else if (!strcmp(field, "cache_size"))
+    {
+        int *cache_size = value;
+        opts->cache_size = *cache_size;
+    }
+    else if (!strcmp(field, "cache_tol"))
+    {
+        double *cache_tol = value;
+        opts->cache_tol = *cache_tol;
+    }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: dense_qp_qpoases_opts_set: wrong field: %s\n", field);
@@ -206,6 +236,7 @@ void dense_qp_qpoases_opts_set(void *config_, void *opts_, const char *field, vo
 
 acados_size_t dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dims *dims, void *opts_)
 {
+    dense_qp_qpoases_opts *opts = opts_;
     dense_qp_dims dims_stacked;
 
     int nv  = dims->nv;
@@ -239,6 +270,7 @@ acados_size_t dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dim
     size += 1 * nb * sizeof(int);              // idxb
     size += 1 * nb2 * sizeof(int);             // idxb_stacked
     size += 1 * ns * sizeof(int);              // idxs
+    size += 1 * (nv + ng) * sizeof(int);       // ws
     size += 1 * nv2 * sizeof(double);          // prim_sol
     size += 1 * (nv2 + ng2) * sizeof(double);  // dual_sol
     size += 6 * ns * sizeof(double);           // Zl, Zu, zl, zu, d_ls, d_us
@@ -254,6 +286,9 @@ acados_size_t dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dim
     else  // QProblemB
         size += QProblemB_calculateMemorySize(nv);
 
+    if (opts->cache_size > 0)
+        size += dense_qp_cache_calculate_size(dims, opts->cache_size) + 8;
+
     make_int_multiple_of(8, &size);
 
     return size;
@@ -264,6 +299,7 @@ acados_size_t dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dim
 void *dense_qp_qpoases_memory_assign(void *config_, dense_qp_dims *dims, void *opts_,
                                      void *raw_memory)
 {
+    dense_qp_qpoases_opts *opts = opts_;
     dense_qp_qpoases_memory *mem;
     dense_qp_dims dims_stacked;
 
@@ -343,12 +379,27 @@ void *dense_qp_qpoases_memory_assign(void *config_, dense_qp_dims *dims, void *o
     assign_and_advance_int(nb, &mem->idxb, &c_ptr);
     assign_and_advance_int(nb2, &mem->idxb_stacked, &c_ptr);
     assign_and_advance_int(ns, &mem->idxs, &c_ptr);
+    assign_and_advance_int(nv + ng, &mem->ws, &c_ptr);
+    for (int ii = 0; ii < nv + ng; ii++)
+        mem->ws[ii] = 0;
+    mem->ws_valid = 0;
+
+    if (opts->cache_size > 0)
+    {
+        align_char_to(8, &c_ptr);
+        mem->cache = dense_qp_cache_assign(dims, opts->cache_size, c_ptr);
+        c_ptr += dense_qp_cache_calculate_size(dims, opts->cache_size);
+    }
+    else
+    {
+        mem->cache = NULL;
+    }
 
     assert((char *) raw_memory + dense_qp_qpoases_memory_calculate_size(config_, dims, opts_) >=
            c_ptr);
 
     // assign default values to fields stored in the memory
-    mem->first_it = 1;  // only used if hotstart (only constant data matrices) is enabled
+    mem->first_it = 1;  // only used if hotstart is enabled
 
     return mem;
 }
@@ -370,6 +421,11 @@ void dense_qp_qpoases_memory_get(void *config_, void *mem_, const char *field, v
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if (!strcmp(field, "cache_hits"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->cache == NULL ? 0 : mem->cache->hits;
+    }
     else
     {
         printf("\nerror: dense_qp_qpoases_memory_get: field %s not available\n", field);
@@ -397,6 +453,25 @@ acados_size_t dense_qp_qpoases_workspace_calculate_size(void *config_, dense_qp_
  * functions
  ************************************************/
 
+// dual guess for qpOASES from the mapped working set, the sign encodes the active side;
+// magnitudes are taken from the last dual solution where available
+static double *dense_qp_qpoases_guess_duals(dense_qp_qpoases_memory *mem, int n)
+{
+    double *dual_sol = mem->dual_sol;
+    for (int ii = 0; ii < n; ii++)
+    {
+        if (mem->ws[ii] == 0)
+            dual_sol[ii] = 0.0;
+        else if (dual_sol[ii] * mem->ws[ii] < 0.0)  // same side as in the last solution
+            dual_sol[ii] = -mem->ws[ii] * fabs(dual_sol[ii]);
+        else
+            dual_sol[ii] = -mem->ws[ii] * 1.0;
+    }
+    return dual_sol;
+}
+
+
+
 int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void *opts_,
                      void *memory_, void *work_)
 {
@@ -411,6 +486,35 @@ int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, vo
     dense_qp_qpoases_opts *opts = (dense_qp_qpoases_opts *) opts_;
     dense_qp_qpoases_memory *memory = (dense_qp_qpoases_memory *) memory_;
 
+    // the cache is allocated at memory creation
+    if ((opts->cache_size > 0 ? opts->cache_size : 0) != (memory->cache == NULL ? 0 : memory->cache->size))
+    {
+        printf("\nerror: dense_qp_qpoases: cache_size has to be set before memory creation, got %d, allocated %d.\n",
+               opts->cache_size, memory->cache == NULL ? 0 : memory->cache->size);
+        exit(1);
+    }
+
+    // try cached active sets
+    if (memory->cache != NULL)
+    {
+        memory->cache->tol = opts->cache_tol;
+        if (dense_qp_cache_lookup(memory->cache, qp_in, qp_out))
+        {
+            info->interface_time = acados_toc(&interface_timer);
+            info->solve_QP_time = 0.0;
+            info->total_time = acados_toc(&tot_timer);
+            info->num_iter = 0;
+            memory->time_qp_solver_call = 0.0;
+            memory->iter = 0;
+            dense_qp_working_set_get(qp_in, qp_out, memory->ws);
+            memory->ws_valid = 1;
+            // the working set inside qpOASES is not the one of this solution
+            if (opts->hotstart == 2)
+                memory->first_it = 1;
+            return ACADOS_SUCCESS;
+        }
+    }
+
     // extract qpoases data
     double *H = memory->H;
     double *HH = memory->HH;
@@ -572,6 +676,61 @@ int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, vo
             }
         }
     }
+    else if (opts->hotstart == 2 && ns == 0)
+    {  // working set transfer for changing data matrices, e.g. SQP with full condensing
+        // NOTE: the dense constraint layout is fixed by the (condensing) dimensions,
+        // the previous working set only has to be cleared of constraints no longer in qp_in
+        int ndrop = dense_qp_working_set_map(qp_in, memory->ws);
+        if (ng > 0)
+        {  // QProblem
+            qpoases_status = RET_HOTSTART_FAILED;
+            if (memory->first_it == 0 && ndrop == 0)
+            {
+                qpoases_status = SQProblem_hotstart(QP, H, g, C, d_lb, d_ub, d_lg0, d_ug0,
+                                                    &nwsr, &cputime);
+            }
+            if (qpoases_status != SUCCESSFUL_RETURN && qpoases_status != RET_MAX_NWSR_REACHED)
+            {
+                // initialize from the mapped working set instead
+                nwsr = opts->max_nwsr;
+                cputime = opts->max_cputime;
+                QProblemCON(QP, nv, ng, HST_POSDEF);
+                QProblem_setPrintLevel(QP, PL_MEDIUM);
+                if (opts->set_acado_opts)
+                {
+                    static Options options;
+                    Options_setToMPC(&options);
+                    options.terminationTolerance = opts->tolerance;
+                    QProblem_setOptions(QP, options);
+                }
+                qpoases_status = QProblem_initW(QP, H, g, C, d_lb, d_ub, d_lg0, d_ug0, &nwsr,
+                    &cputime, /* primal_sol */ NULL,
+                    memory->ws_valid ? dense_qp_qpoases_guess_duals(memory, nv + ng) : NULL,
+                    /* guessed bounds */ NULL, /* guessed constraints */ NULL, /* R */ NULL);
+                memory->first_it = 0;
+            }
+            QProblem_getPrimalSolution(QP, prim_sol);
+            QProblem_getDualSolution(QP, dual_sol);
+        }
+        else
+        {  // QProblemB, no matrix-changing hotstart available
+            QProblemBCON(QPB, nv, HST_POSDEF);
+            QProblemB_setPrintLevel(QPB, PL_MEDIUM);
+            if (opts->set_acado_opts)
+            {
+                static Options options;
+                Options_setToMPC(&options);
+                options.terminationTolerance = opts->tolerance;
+                QProblemB_setOptions(QPB, options);
+            }
+            qpoases_status = QProblemB_initW(QPB, H, g, d_lb, d_ub, &nwsr, &cputime,
+                /* primal_sol */ NULL,
+                memory->ws_valid ? dense_qp_qpoases_guess_duals(memory, nv) : NULL,
+                /* guessed bounds */ NULL, /* R */ NULL);
+            QProblemB_getPrimalSolution(QPB, prim_sol);
+            QProblemB_getDualSolution(QPB, dual_sol);
+        }
+    }
     else
     {  // hotstart = 0
         if (ng > 0 || ns > 0)
@@ -752,6 +911,23 @@ int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, vo
     int acados_status = qpoases_status;
     if (qpoases_status == SUCCESSFUL_RETURN) acados_status = ACADOS_SUCCESS;
     if (qpoases_status == RET_MAX_NWSR_REACHED) acados_status = ACADOS_MAXITER;
+
+    // working set for the next hotstart
+    memory->ws_valid = acados_status == ACADOS_SUCCESS;
+    if (memory->ws_valid)
+        dense_qp_working_set_get(qp_in, qp_out, memory->ws);
+    else if (opts->hotstart == 2)
+        memory->first_it = 1;
+
+    if (memory->cache != NULL && acados_status == ACADOS_SUCCESS)
+    {
+        if (!opts->compute_t)
+        {
+            dense_qp_compute_t(qp_in, qp_out);
+            info->t_computed = 1;
+        }
+        dense_qp_cache_insert(memory->cache, qp_in, qp_out);
+    }
     return acados_status;
 }
 
@@ -779,6 +955,19 @@ void dense_qp_qpoases_memory_reset(void *config, void *qp_in, void *qp_out, void
     exit(1);
 }
 
+
+
+void dense_qp_qpoases_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    dense_qp_qpoases_memory *mem = mem_;
+
+    dense_qp_out_set_zero(qp_out_);
+    // NOTE: with hotstart, the active set qpOASES keeps internally belongs to its setup and is kept
+    mem->ws_valid = 0;
+}
+
+
+
 void dense_qp_qpoases_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     printf("\nerror: dense_qp_qpoases_solver_get: not implemented yet\n");
@@ -813,6 +1002,7 @@ void dense_qp_qpoases_config_initialize_default(void *config_)
     // config->memory_reset = &dense_qp_qpoases_memory_reset;
     config->evaluate = (int (*)(void *, void *, void *, void *, void *, void *)) & dense_qp_qpoases;
     config->memory_reset = &dense_qp_qpoases_memory_reset;
+    config->memory_reset_warm_start = &dense_qp_qpoases_memory_reset_warm_start;
     config->solver_get = &dense_qp_qpoases_solver_get;
     config->terminate = &dense_qp_qpoases_terminate;
 
@@ -40,6 +40,7 @@ extern "C" {
 #include "blasfeo/include/blasfeo_common.h"
 
 // acados
+#include "acados/dense_qp/dense_qp_cache.h"
 #include "acados/dense_qp/dense_qp_common.h"
 #include "acados/utils/types.h"
 
@@ -49,11 +50,13 @@ typedef struct dense_qp_qpoases_opts_
     int max_nwsr;        // maximum number of working set recalculations
     int warm_start;      // warm start with dual_sol in memory
     int use_precomputed_cholesky;
-    int hotstart;  // this option requires constant data matrices! (eg linear MPC, inexact schemes
-                   // with frozen sensitivities)
+    int hotstart;  // 1: this option requires constant data matrices! (eg linear MPC, inexact schemes
+                   // with frozen sensitivities); 2: working set transfer with changing data matrices
     int set_acado_opts;  // use same options as in acado code generation
     int compute_t;       // compute t in qp_out (to have correct residuals in NLP)
     double tolerance;  // terminationTolerance
+    int cache_size;     // number of cached optimal active sets, 0: no cache; fixed at memory creation
+    double cache_tol;   // KKT tolerance for accepting a cached active set
 } dense_qp_qpoases_opts;
 
 typedef struct dense_qp_qpoases_memory_
@@ -94,6 +97,9 @@ typedef struct dense_qp_qpoases_memory_
     dense_qp_in *qp_stacked;
     double time_qp_solver_call; // equal to cputime
     int iter;
+    dense_qp_cache *cache;
+    int *ws;         // working set of the last solve, see dense_qp_working_set_get
+    int ws_valid;
 
 } dense_qp_qpoases_memory;
 
@@ -117,6 +123,8 @@ void dense_qp_qpoases_eval_sens(void *config_, void *qp_in, void *qp_out, void *
 //
 void dense_qp_qpoases_memory_reset(void *config_, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
 //
+void dense_qp_qpoases_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void dense_qp_qpoases_config_initialize_default(void *config_);
 //
 void dense_qp_qpoases_memory_reset(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
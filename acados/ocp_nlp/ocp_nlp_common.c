@@ -44,6 +44,7 @@
 // acados
 #include "acados/utils/mem.h"
 #include "acados/utils/print.h"
+#include "acados/utils/timing.h"
 // openmp
 #if defined(ACADOS_WITH_OPENMP)
 #include <omp.h>
@@ -96,6 +97,7 @@ ocp_nlp_config *ocp_nlp_config_assign(int N, void *raw_memory)
     c_ptr += sizeof(ocp_nlp_config);
 
     config->N = N;
+    config->update_variables = NULL;
 
     // qp solver
     config->qp_solver = ocp_qp_xcond_solver_config_assign(c_ptr);
@@ -1051,6 +1053,12 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     opts->step_length = 1.0;
     opts->levenberg_marquardt = 0.0;
     opts->log_primal_step_norm = 0;
+    opts->exact_hess_cost = 0;
+    opts->exact_hess_dyn = 0;
+    opts->exact_hess_constr = 0;
+    opts->hess_approx = HESS_APPROX_SUBMODULES;
+    opts->block_bfgs_memory = 0;
+    opts->reuse_qp_fact = 0;
 
     /* submodules opts */
     // qp solver
@@ -1083,6 +1091,7 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     opts->full_step_dual = 0;
     opts->line_search_use_sufficient_descent = 0;
     opts->globalization_use_SOC = 0;
+    opts->line_search_num_candidates = 1;
     opts->eps_sufficient_descent = 1e-4; // Leineweber1999: MUSCOD-I eps_T = 1e-4 (p.89); Note: eps_T = 0.1 originally proposed by Powell 1978 (Leineweber 1999, p. 53)
 
     opts->with_solution_sens_wrt_params = 0;
@@ -1199,6 +1208,17 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             double* eps_sufficient_descent = (double *) value;
             opts->eps_sufficient_descent = *eps_sufficient_descent;
         }
+        else if (!strcmp(field, "line_search_num_candidates"))
+        {
+            int* line_search_num_candidates = (int *) value;
+            if (*line_search_num_candidates < 1)
+            {
+                printf("\nerror: ocp_nlp_opts_set: line_search_num_candidates has to be positive, got %d.\n",
+                       *line_search_num_candidates);
+                exit(1);
+            }
+            opts->line_search_num_candidates = *line_search_num_candidates;
+        }
         else if (!strcmp(field, "full_step_dual"))
         {
             int* full_step_dual = (int *) value;
@@ -1265,6 +1285,10 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
         else if (!strcmp(field, "exact_hess"))
         {
             int N = config->N;
+            int* exact_hess = (int *) value;
+            opts->exact_hess_cost = *exact_hess;
+            opts->exact_hess_dyn = *exact_hess;
+            opts->exact_hess_constr = *exact_hess;
             // cost
             for (int i=0; i<=N; i++)
                 config->cost[i]->opts_set(config->cost[i], opts->cost[i], "exact_hess", value);
@@ -1281,12 +1305,16 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
         else if (!strcmp(field, "exact_hess_cost"))
         {
             int N = config->N;
+            int* exact_hess_cost = (int *) value;
+            opts->exact_hess_cost = *exact_hess_cost;
             for (int i=0; i<=N; i++)
                 config->cost[i]->opts_set(config->cost[i], opts->cost[i], "exact_hess", value);
         }
         else if (!strcmp(field, "exact_hess_dyn"))
         {
             int N = config->N;
+            int* exact_hess_dyn = (int *) value;
+            opts->exact_hess_dyn = *exact_hess_dyn;
             for (int i=0; i<N; i++)
                 config->dynamics[i]->opts_set(config->dynamics[i], opts->dynamics[i],
                                                "compute_hess", value);
@@ -1294,10 +1322,46 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
         else if (!strcmp(field, "exact_hess_constr"))
         {
             int N = config->N;
+            int* exact_hess_constr = (int *) value;
+            opts->exact_hess_constr = *exact_hess_constr;
             for (int i=0; i<=N; i++)
                 config->constraints[i]->opts_set(config->constraints[i], opts->constraints[i],
                                                   "compute_hess", value);
         }
+        else if (!strcmp(field, "hess_approx"))
+        {
+            char* hess_approx = (char *) value;
+            if (!strcmp(hess_approx, "submodules"))
+            {
+                opts->hess_approx = HESS_APPROX_SUBMODULES;
+            }
+            else if (!strcmp(hess_approx, "block_bfgs"))
+            {
+                opts->hess_approx = HESS_APPROX_BLOCK_BFGS;
+            }
+            else
+            {
+                printf("\nerror: ocp_nlp_opts_set: not supported value for hess_approx, got: %s\n",
+                       hess_approx);
+                exit(1);
+            }
+        }
+        else if (!strcmp(field, "block_bfgs_memory"))
+        {
+            int* block_bfgs_memory = (int *) value;
+            if (*block_bfgs_memory < 0)
+            {
+                printf("\nerror: ocp_nlp_opts_set: block_bfgs_memory must be non-negative, got: %d\n",
+                       *block_bfgs_memory);
+                exit(1);
+            }
+            opts->block_bfgs_memory = *block_bfgs_memory;
+        }
+        else if (!strcmp(field, "reuse_qp_fact"))
+        {
+            int* reuse_qp_fact = (int *) value;
+            opts->reuse_qp_fact = *reuse_qp_fact;
+        }
         else if (!strcmp(field, "log_primal_step_norm"))
         {
             int* log_primal_step_norm = (int *) value;
@@ -1484,6 +1548,38 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
     size += 1*blasfeo_memsize_dvec(2 * ni[N]);      // ineq_fun
     size += 1*blasfeo_memsize_dvec(nx[N] + nz[N]);  // sim_guess
 
+    if (opts->hess_approx == HESS_APPROX_BLOCK_BFGS)
+    {
+        int m = opts->block_bfgs_memory;
+        size += (N+1)*sizeof(struct blasfeo_dmat);       // block_bfgs_B
+        size += (4+2*m)*(N+1)*sizeof(struct blasfeo_dvec); // block_bfgs_S Y step grad grad_old tmp
+        size += 2*(N+1)*sizeof(int);                      // block_bfgs_num_pairs block_bfgs_head
+        size += 8;                                        // align
+        for (int i = 0; i <= N; i++)
+        {
+            size += blasfeo_memsize_dmat(nu[i]+nx[i], nu[i]+nx[i]);
+            size += (4+2*m)*blasfeo_memsize_dvec(nu[i]+nx[i]);
+        }
+    }
+
+    if (opts->reuse_qp_fact)
+    {
+        int *ng_qp = dims->qp_solver->orig_dims->ng;
+        int *ns_qp = dims->qp_solver->orig_dims->ns;
+        size += N*sizeof(struct blasfeo_dmat);       // qp_lhs_BAbt
+        size += 2*(N+1)*sizeof(struct blasfeo_dmat); // qp_lhs_RSQrq qp_lhs_DCt
+        size += (N+1)*sizeof(struct blasfeo_dvec);   // qp_lhs_Z
+        size += 8;                                   // align
+        for (int i = 0; i <= N; i++)
+        {
+            if (i < N)
+                size += blasfeo_memsize_dmat(nu[i]+nx[i], nx[i+1]);
+            size += blasfeo_memsize_dmat(nu[i]+nx[i], nu[i]+nx[i]);
+            size += blasfeo_memsize_dmat(nu[i]+nx[i], ng_qp[i]);
+            size += blasfeo_memsize_dvec(2*ns_qp[i]);
+        }
+    }
+
     size += 8;   // initial align
     size += 8;   // middle align
     size += 8;   // blasfeo_struct align
@@ -1610,6 +1706,34 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
         mem->set_sim_guess[i] = false;
     }
 
+    // block BFGS
+    int m_bfgs = opts->block_bfgs_memory;
+    if (opts->hess_approx == HESS_APPROX_BLOCK_BFGS)
+    {
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N+1, &mem->block_bfgs_B, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs((N+1)*m_bfgs, &mem->block_bfgs_S, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs((N+1)*m_bfgs, &mem->block_bfgs_Y, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->block_bfgs_step, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->block_bfgs_grad, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->block_bfgs_grad_old, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->block_bfgs_tmp, &c_ptr);
+        assign_and_advance_int(N+1, &mem->block_bfgs_num_pairs, &c_ptr);
+        assign_and_advance_int(N+1, &mem->block_bfgs_head, &c_ptr);
+    }
+
+    // QP lhs copies
+    int *ng_qp = dims->qp_solver->orig_dims->ng;
+    int *ns_qp = dims->qp_solver->orig_dims->ns;
+    if (opts->reuse_qp_fact)
+    {
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N, &mem->qp_lhs_BAbt, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N+1, &mem->qp_lhs_RSQrq, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N+1, &mem->qp_lhs_DCt, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->qp_lhs_Z, &c_ptr);
+    }
+
     // blasfeo_mem align
     align_char_to(64, &c_ptr);
 
@@ -1656,7 +1780,43 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
         blasfeo_dvecse(nx[i] + nz[i], 0.0, mem->sim_guess+i, 0);
         // printf("sim_guess i %d: %p\n", i, mem->sim_guess+i);
     }
+    // block BFGS
+    if (opts->hess_approx == HESS_APPROX_BLOCK_BFGS)
+    {
+        for (int i = 0; i <= N; i++)
+        {
+            assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nu[i]+nx[i], mem->block_bfgs_B+i, &c_ptr);
+            for (int k = 0; k < m_bfgs; k++)
+            {
+                assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_S+i*m_bfgs+k, &c_ptr);
+                assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_Y+i*m_bfgs+k, &c_ptr);
+            }
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_step+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_grad+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_grad_old+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->block_bfgs_tmp+i, &c_ptr);
+            mem->block_bfgs_num_pairs[i] = 0;
+            mem->block_bfgs_head[i] = 0;
+        }
+    }
+    mem->block_bfgs_valid = false;
+    // QP lhs copies
+    if (opts->reuse_qp_fact)
+    {
+        for (int i = 0; i <= N; i++)
+        {
+            if (i < N)
+                assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nx[i+1], mem->qp_lhs_BAbt+i, &c_ptr);
+            assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nu[i]+nx[i], mem->qp_lhs_RSQrq+i, &c_ptr);
+            assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], ng_qp[i], mem->qp_lhs_DCt+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(2*ns_qp[i], mem->qp_lhs_Z+i, &c_ptr);
+        }
+    }
+    mem->qp_lhs_valid = false;
+    mem->qp_lhs_unchanged = 0;
+
     mem->compute_hess = 1;
+    mem->time_budget_glob = 0.0;
 
     return mem;
 }
@@ -1732,6 +1892,16 @@ acados_size_t ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_d
     // doubles
     size += nv_max * sizeof(double); // tmp_nv_double
 
+    // merit line search candidates
+    int num_cand = opts->line_search_num_candidates;
+    size += num_cand*sizeof(struct blasfeo_dvec *); // ls_ux
+    size += (num_cand-1)*(N+1)*sizeof(struct blasfeo_dvec); // ls_ux[1:]
+    for (int i = 0; i <= N; i++)
+        size += (num_cand-1)*blasfeo_memsize_dvec(nv[i]);
+    size += 3*num_cand*(N+1)*sizeof(double); // merit_stage
+    size += num_cand*sizeof(double); // ls_merit
+    size += 8; // align
+
     // module workspace
     if (opts->reuse_workspace)
     {
@@ -1893,6 +2063,21 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
     c_ptr += ocp_nlp_out_calculate_size(config, dims);
 
     assign_and_advance_double(nv_max, &work->tmp_nv_double, &c_ptr);
+
+    // merit line search candidates
+    int num_cand = opts->line_search_num_candidates;
+    work->ls_num_candidates = num_cand;
+    assign_and_advance_double(3*num_cand*(N+1), &work->merit_stage, &c_ptr);
+    assign_and_advance_double(num_cand, &work->ls_merit, &c_ptr);
+    align_char_to(8, &c_ptr);
+    work->ls_ux = (struct blasfeo_dvec **) c_ptr;
+    c_ptr += num_cand*sizeof(struct blasfeo_dvec *);
+    work->ls_ux[0] = work->tmp_nlp_out->ux;
+    for (int c = 1; c < num_cand; c++)
+    {
+        assign_and_advance_blasfeo_dvec_structs(N+1, work->ls_ux+c, &c_ptr);
+    }
+
     // align for blasfeo mem
     align_char_to(64, &c_ptr);
 
@@ -1902,6 +2087,11 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
     assign_and_advance_blasfeo_dvec_mem(nx_max, &work->dxnext_dy, &c_ptr);
     assign_and_advance_blasfeo_dvec_mem(np_max, &work->tmp_np, &c_ptr);
     assign_and_advance_blasfeo_dvec_mem(np_max, &work->out_np, &c_ptr);
+    for (int c = 1; c < num_cand; c++)
+    {
+        for (int i = 0; i <= N; i++)
+            assign_and_advance_blasfeo_dvec_mem(nv[i], work->ls_ux[c]+i, &c_ptr);
+    }
 
     if (opts->reuse_workspace)
     {
@@ -2237,6 +2427,307 @@ void ocp_nlp_add_levenberg_marquardt_term(ocp_nlp_config *config, ocp_nlp_dims *
     } // else: do nothing
 }
 
+
+
+/************************************************
+ * quasi-Newton Hessian approximation
+ ************************************************/
+
+// B += alpha * x * x^T
+static void ocp_nlp_rank1_update(int n, double alpha, struct blasfeo_dvec *x, struct blasfeo_dmat *B)
+{
+    for (int j = 0; j < n; j++)
+    {
+        double tmp = alpha * BLASFEO_DVECEL(x, j);
+        for (int i = 0; i < n; i++)
+            BLASFEO_DMATEL(B, i, j) += tmp * BLASFEO_DVECEL(x, i);
+    }
+}
+
+
+
+int ocp_nlp_damped_bfgs_update(int n, struct blasfeo_dmat *B, struct blasfeo_dvec *s,
+    struct blasfeo_dvec *y, struct blasfeo_dvec *Bs)
+{
+    blasfeo_dgemv_n(n, n, 1.0, B, 0, 0, s, 0, 0.0, Bs, 0, Bs, 0);
+    double sBs = blasfeo_ddot(n, s, 0, Bs, 0);
+    double sy = blasfeo_ddot(n, s, 0, y, 0);
+    double ss = blasfeo_ddot(n, s, 0, s, 0);
+
+    // B not positive definite along s, e.g. indefinite exact Hessian
+    if (ss == 0.0 || sBs <= 0.0)
+        return 0;
+
+    // Powell damping: ensure s^T y >= 0.2 s^T B s, Nocedal2006 (18.15)
+    if (sy < 0.2 * sBs)
+    {
+        double theta = 0.8 * sBs / (sBs - sy);
+        blasfeo_dvecsc(n, theta, y, 0);
+        blasfeo_daxpy(n, 1.0 - theta, Bs, 0, y, 0, y, 0);
+        sy = blasfeo_ddot(n, s, 0, y, 0);
+    }
+    ocp_nlp_rank1_update(n, 1.0/sy, y, B);
+    ocp_nlp_rank1_update(n, -1.0/sBs, Bs, B);
+
+    return 1;
+}
+
+
+
+int ocp_nlp_sr1_update(int n, struct blasfeo_dmat *B, struct blasfeo_dvec *s,
+    struct blasfeo_dvec *y, struct blasfeo_dvec *r)
+{
+    double ss = blasfeo_ddot(n, s, 0, s, 0);
+    if (ss == 0.0)
+        return 0;
+
+    // r = y - B s
+    blasfeo_dgemv_n(n, n, -1.0, B, 0, 0, s, 0, 1.0, y, 0, r, 0);
+    double sr = blasfeo_ddot(n, s, 0, r, 0);
+    double rr = blasfeo_ddot(n, r, 0, r, 0);
+    // skip if denominator is small, Nocedal2006 (6.26)
+    if (fabs(sr) < 1e-8 * sqrt(ss * rr))
+        return 0;
+    ocp_nlp_rank1_update(n, 1.0/sr, r, B);
+
+    return 1;
+}
+
+
+
+// B = RSQrq, of which the submodules only fill the lower triangle; the updates need the full matrix
+void ocp_nlp_quasi_newton_copy_hess(int n, struct blasfeo_dmat *RSQrq, struct blasfeo_dmat *B)
+{
+    blasfeo_dgecp(n, n, RSQrq, 0, 0, B, 0, 0);
+    blasfeo_dtrtr_l(n, B, 0, 0, B, 0, 0);
+}
+
+
+
+// Stores the step s = alpha * p and the gradient of the Lagrangian at the current iterate w.r.t. the
+// multipliers of the next iterate, called before the iterate is updated.
+// The latter is recovered from the stationarity of the QP as solved (or as corrected by the
+// regularization module), i.e. including the Levenberg-Marquardt term and the regularization:
+//   RSQrq p + rq - adj(lam_qp) = 0  =>  grad L(x, lam_qp) = cost_grad - adj(lam_qp) = cost_grad - rq - RSQrq p.
+// Without full_step_dual, the next multipliers are (1 - alpha) * lam + alpha * lam_qp.
+// grad holds grad L(x, lam) on entry, tmp is workspace; all are arrays over the stages.
+void ocp_nlp_quasi_newton_store_step(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+    double alpha, struct blasfeo_dvec *grad, struct blasfeo_dvec *step, struct blasfeo_dvec *grad_old,
+    struct blasfeo_dvec *tmp)
+{
+    ocp_qp_in *qp_in = mem->qp_in;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    for (int i = 0; i <= N; i++)
+    {
+        int n = nu[i] + nx[i];
+        // s = alpha * p
+        blasfeo_dveccp(n, mem->qp_out->ux+i, 0, step+i, 0);
+        blasfeo_dvecsc(n, alpha, step+i, 0);
+        // tmp = cost_grad - rq - RSQrq p
+        blasfeo_dsymv_l(n, 1.0, qp_in->RSQrq+i, 0, 0, mem->qp_out->ux+i, 0, 1.0, qp_in->rqz+i, 0,
+                        tmp+i, 0);
+        blasfeo_daxpy(n, -1.0, tmp+i, 0, mem->cost_grad+i, 0, tmp+i, 0);
+        if (opts->full_step_dual)
+        {
+            // grad_old = grad L(x, lam_qp)
+            blasfeo_dveccp(n, tmp+i, 0, grad_old+i, 0);
+        }
+        else
+        {
+            // grad_old = (1 - alpha) * grad + alpha * grad L(x, lam_qp)
+            blasfeo_daxpby(n, 1.0-alpha, grad+i, 0, alpha, tmp+i, 0, grad_old+i, 0);
+        }
+    }
+}
+
+
+
+// L-BFGS: rebuild B from gamma * I and the stored pairs, oldest first, Nocedal2006 (7.20)
+static void ocp_nlp_block_bfgs_rebuild(int n, int m, int num_pairs, int head, struct blasfeo_dmat *B,
+    struct blasfeo_dvec *S, struct blasfeo_dvec *Y, struct blasfeo_dvec *Bs)
+{
+    int newest = (head + m - 1) % m;
+    double gamma = blasfeo_ddot(n, Y+newest, 0, Y+newest, 0) / blasfeo_ddot(n, S+newest, 0, Y+newest, 0);
+
+    blasfeo_dgese(n, n, 0.0, B, 0, 0);
+    blasfeo_ddiare(n, gamma, B, 0, 0);
+
+    for (int k = 0; k < num_pairs; k++)
+    {
+        int j = (head - num_pairs + k + m) % m;
+        // stored pairs are damped, hence s^T y > 0
+        blasfeo_dgemv_n(n, n, 1.0, B, 0, 0, S+j, 0, 0.0, Bs, 0, Bs, 0);
+        double sBs = blasfeo_ddot(n, S+j, 0, Bs, 0);
+        double sy = blasfeo_ddot(n, S+j, 0, Y+j, 0);
+        ocp_nlp_rank1_update(n, 1.0/sy, Y+j, B);
+        ocp_nlp_rank1_update(n, -1.0/sBs, Bs, B);
+    }
+}
+
+
+
+void ocp_nlp_block_bfgs_reset(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem)
+{
+    if (opts->hess_approx != HESS_APPROX_BLOCK_BFGS)
+        return;
+
+    for (int i = 0; i <= dims->N; i++)
+    {
+        mem->block_bfgs_num_pairs[i] = 0;
+        mem->block_bfgs_head[i] = 0;
+    }
+    mem->block_bfgs_valid = false;
+}
+
+
+
+void ocp_nlp_block_bfgs_update(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem)
+{
+    if (opts->hess_approx != HESS_APPROX_BLOCK_BFGS || !mem->compute_hess)
+        return;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int m = opts->block_bfgs_memory;
+
+    // the blocks are decoupled: each stage is updated from its own step and gradient difference
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        int n = nu[i] + nx[i];
+        struct blasfeo_dmat *B = mem->block_bfgs_B+i;
+        struct blasfeo_dvec *s = mem->block_bfgs_step+i;
+        struct blasfeo_dvec *y = mem->block_bfgs_grad_old+i;
+        struct blasfeo_dvec *tmp = mem->block_bfgs_tmp+i;
+
+        // gradient of the Lagrangian
+        blasfeo_daxpy(n, -1.0, mem->ineq_adj+i, 0, mem->cost_grad+i, 0, mem->block_bfgs_grad+i, 0);
+        blasfeo_daxpy(n, -1.0, mem->dyn_adj+i, 0, mem->block_bfgs_grad+i, 0, mem->block_bfgs_grad+i, 0);
+
+        if (!mem->block_bfgs_valid)
+        {
+            // initial approximation: Hessian from the submodules
+            ocp_nlp_quasi_newton_copy_hess(n, mem->qp_in->RSQrq+i, B);
+            continue;
+        }
+
+        // y = grad - grad_old, stored in grad_old
+        blasfeo_daxpy(n, -1.0, y, 0, mem->block_bfgs_grad+i, 0, y, 0);
+
+        int updated = ocp_nlp_damped_bfgs_update(n, B, s, y, tmp);
+        if (!updated)
+        {
+            // B not positive definite along s, e.g. zero Hessian contribution from the submodules:
+            // restart from a scaled identity if the curvature condition holds, Nocedal2006 (6.20)
+            double sy = blasfeo_ddot(n, s, 0, y, 0);
+            if (sy > 0.0)
+            {
+                blasfeo_dgese(n, n, 0.0, B, 0, 0);
+                blasfeo_ddiare(n, blasfeo_ddot(n, y, 0, y, 0) / sy, B, 0, 0);
+                mem->block_bfgs_num_pairs[i] = 0;
+                updated = ocp_nlp_damped_bfgs_update(n, B, s, y, tmp);
+            }
+        }
+
+        if (updated && m > 0)
+        {
+            // y holds the damped gradient difference
+            int head = mem->block_bfgs_head[i];
+            blasfeo_dveccp(n, s, 0, mem->block_bfgs_S+i*m+head, 0);
+            blasfeo_dveccp(n, y, 0, mem->block_bfgs_Y+i*m+head, 0);
+            mem->block_bfgs_head[i] = (head + 1) % m;
+            if (mem->block_bfgs_num_pairs[i] < m)
+                mem->block_bfgs_num_pairs[i]++;
+            ocp_nlp_block_bfgs_rebuild(n, m, mem->block_bfgs_num_pairs[i], mem->block_bfgs_head[i], B,
+                                       mem->block_bfgs_S+i*m, mem->block_bfgs_Y+i*m, tmp);
+        }
+
+        blasfeo_dgecp(n, n, B, 0, 0, mem->qp_in->RSQrq+i, 0, 0);
+    }
+}
+
+
+
+// stores the step and the gradient of the Lagrangian at the current iterate w.r.t. the new multipliers,
+// obtained from the stationarity condition of the QP
+void ocp_nlp_block_bfgs_store_step(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem, double alpha)
+{
+    if (opts->hess_approx != HESS_APPROX_BLOCK_BFGS)
+        return;
+
+    if (alpha <= 0.0)
+    {
+        mem->block_bfgs_valid = false;
+        return;
+    }
+
+    ocp_nlp_quasi_newton_store_step(dims, opts, mem, alpha, mem->block_bfgs_grad, mem->block_bfgs_step,
+                                    mem->block_bfgs_grad_old, mem->block_bfgs_tmp);
+    mem->block_bfgs_valid = true;
+}
+
+
+
+// compares A with its stored copy (only the lower triangle if lower) and updates the copy, returns 1 if equal
+static int ocp_nlp_qp_lhs_block_update(int m, int n, bool lower, struct blasfeo_dmat *A, struct blasfeo_dmat *A_prev)
+{
+    for (int jj = 0; jj < n; jj++)
+    {
+        for (int ii = lower ? jj : 0; ii < m; ii++)
+        {
+            if (BLASFEO_DMATEL(A, ii, jj) != BLASFEO_DMATEL(A_prev, ii, jj))
+            {
+                blasfeo_dgecp(m, n, A, 0, 0, A_prev, 0, 0);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+
+
+// dirty flag of the QP matrices: compares them with the ones of the previous call,
+// the result is passed to the QP solver as lhs_unchanged
+void ocp_nlp_qp_lhs_update(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem)
+{
+    ocp_qp_in *qp_in = mem->qp_in;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ng = qp_in->dim->ng;
+    int *ns = qp_in->dim->ns;
+
+    // no early exit, all copies have to be updated
+    int unchanged = mem->qp_lhs_valid;
+    for (int i = 0; i <= N; i++)
+    {
+        if (i < N)
+            unchanged &= ocp_nlp_qp_lhs_block_update(nu[i]+nx[i], nx[i+1], false, qp_in->BAbt+i, mem->qp_lhs_BAbt+i);
+        unchanged &= ocp_nlp_qp_lhs_block_update(nu[i]+nx[i], nu[i]+nx[i], true, qp_in->RSQrq+i, mem->qp_lhs_RSQrq+i);
+        unchanged &= ocp_nlp_qp_lhs_block_update(nu[i]+nx[i], ng[i], false, qp_in->DCt+i, mem->qp_lhs_DCt+i);
+        for (int j = 0; j < 2*ns[i]; j++)
+        {
+            if (BLASFEO_DVECEL(qp_in->Z+i, j) != BLASFEO_DVECEL(mem->qp_lhs_Z+i, j))
+            {
+                blasfeo_dveccp(2*ns[i], qp_in->Z+i, 0, mem->qp_lhs_Z+i, 0);
+                unchanged = 0;
+                break;
+            }
+        }
+    }
+    mem->qp_lhs_valid = true;
+    mem->qp_lhs_unchanged = unchanged;
+}
+
+
+
 void ocp_nlp_approximate_qp_matrices(ocp_nlp_config *config, ocp_nlp_dims *dims,
     ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
     ocp_nlp_workspace *work)
@@ -2633,102 +3124,128 @@ double ocp_nlp_compute_merit_gradient(ocp_nlp_config *config, ocp_nlp_dims *dims
 
 
 
-double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims,
-                                  ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
-                                  ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+static void ocp_nlp_evaluate_merit_stage(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                                  ocp_nlp_in *in, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+                                  ocp_nlp_workspace *work, struct blasfeo_dvec *ux, int i, double *merit_stage)
 {
-    /* computes merit function value at iterate: tmp_nlp_out, with weights: work->weight_merit_fun */
-    //int j;
-
+    /* evaluates the submodules of stage i at ux and stores the cost, dynamics and constraint
+     * contributions to the merit function in merit_stage[0:3] */
     int N = dims->N;
     int *nx = dims->nx;
     int *ni = dims->ni;
 
-    double merit_fun = 0.0;
+    double *tmp_fun;
+    double tmp;
+    struct blasfeo_dvec *tmp_fun_vec;
+
+    // set evaluation point
+    if (i < N)
+    {
+        config->dynamics[i]->memory_set_ux_ptr(ux+i, mem->dynamics[i]);
+        config->dynamics[i]->memory_set_ux1_ptr(ux+i+1, mem->dynamics[i]);
+    }
+    config->cost[i]->memory_set_ux_ptr(ux+i, mem->cost[i]);
+    config->constraints[i]->memory_set_ux_ptr(ux+i, mem->constraints[i]);
 
-    // set evaluation point to tmp_nlp_out
-    ocp_nlp_set_primal_variable_pointers_in_submodules(config, dims, in, work->tmp_nlp_out, mem);
     // compute fun value
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (int i=0; i<N; i++)
+    if (i < N)
     {
         // dynamics: Note has to be first, because cost_integration might be used.
         config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i], in->dynamics[i],
                                          opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
     }
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (int i=0; i<=N; i++)
+    // cost
+    config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i], opts->cost[i],
+                                mem->cost[i], work->cost[i]);
+    // constr
+    config->constraints[i]->compute_fun(config->constraints[i], dims->constraints[i],
+                                        in->constraints[i], opts->constraints[i],
+                                        mem->constraints[i], work->constraints[i]);
+
+    tmp_fun = config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
+    merit_stage[0] = *tmp_fun;
+
+    merit_stage[1] = 0.0;
+    if (i < N)
     {
-        // cost
-        config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i], opts->cost[i],
-                                    mem->cost[i], work->cost[i]);
+        tmp_fun_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+        for(int j=0; j<nx[i+1]; j++)
+        {
+            merit_stage[1] += fabs(BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j)) * fabs(BLASFEO_DVECEL(tmp_fun_vec, j));
+        }
     }
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (int i=0; i<=N; i++)
+
+    merit_stage[2] = 0.0;
+    tmp_fun_vec = config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
+    for (int j=0; j<2*ni[i]; j++)
     {
-        // constr
-        config->constraints[i]->compute_fun(config->constraints[i], dims->constraints[i],
-                                            in->constraints[i], opts->constraints[i],
-                                            mem->constraints[i], work->constraints[i]);
+        tmp = BLASFEO_DVECEL(tmp_fun_vec, j);
+        if (tmp > 0.0)
+        {
+            // tmp = constraint violation
+            merit_stage[2] += fabs(BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j)) * tmp;
+        }
     }
-    // reset evaluation point to SQP iterate
-    ocp_nlp_set_primal_variable_pointers_in_submodules(config, dims, in, out, mem);
+}
 
-    double *tmp_fun;
-    double tmp;
-    struct blasfeo_dvec *tmp_fun_vec;
 
-    double cost_fun = 0.0;
-    for(int i=0; i<=N; i++)
-    {
-        tmp_fun = config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
-        cost_fun += *tmp_fun;
-    }
 
-    double dyn_fun = 0.0;
-    for(int i=0; i<N; i++)
+static void ocp_nlp_evaluate_merit_fun_candidates(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                                  ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
+                                  ocp_nlp_memory *mem, ocp_nlp_workspace *work, int num_candidates)
+{
+    /* computes merit function values work->ls_merit[c] at iterates work->ls_ux[c], with weights: work->weight_merit_fun.
+     * Parallel map over stages, each stage evaluates all candidates; the reduction is done
+     * sequentially in stage order, such that the result does not depend on the number of threads. */
+    int N = dims->N;
+    double *merit_stage = work->merit_stage;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i=0; i<=N; i++)
     {
-        tmp_fun_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
-        // printf("\nMerit: dyn will multiply tmp_fun, weights %d\n", i);
-        // blasfeo_print_exp_tran_dvec(nx[i+1], tmp_fun_vec, 0);
-        // blasfeo_print_exp_tran_dvec(nx[i+1], work->weight_merit_fun->pi+i, 0);
-        for(int j=0; j<nx[i+1]; j++)
+        for (int c=0; c<num_candidates; c++)
         {
-//            printf("\n%e %e\n", fabs(BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j)), fabs(BLASFEO_DVECEL(tmp_fun_vec, j)));
-            dyn_fun += fabs(BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j)) * fabs(BLASFEO_DVECEL(tmp_fun_vec, j));
+            ocp_nlp_evaluate_merit_stage(config, dims, in, opts, mem, work, work->ls_ux[c], i,
+                                         merit_stage+3*(c*(N+1)+i));
         }
+        // reset evaluation point to SQP iterate
+        if (i < N)
+        {
+            config->dynamics[i]->memory_set_ux_ptr(out->ux+i, mem->dynamics[i]);
+            config->dynamics[i]->memory_set_ux1_ptr(out->ux+i+1, mem->dynamics[i]);
+        }
+        config->cost[i]->memory_set_ux_ptr(out->ux+i, mem->cost[i]);
+        config->constraints[i]->memory_set_ux_ptr(out->ux+i, mem->constraints[i]);
     }
 
-    double constr_fun = 0.0;
-    for(int i=0; i<=N; i++)
+    for (int c=0; c<num_candidates; c++)
     {
-//        printf("\ni %d\n", i);
-        tmp_fun_vec = config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
-//        blasfeo_print_exp_tran_dvec(2*ni[i], tmp_fun_vec, 0);
-//        blasfeo_print_exp_tran_dvec(2*ni[i], work->weight_merit_fun->lam+i, 0);
-        for (int j=0; j<2*ni[i]; j++)
+        double cost_fun = 0.0;
+        double dyn_fun = 0.0;
+        double constr_fun = 0.0;
+        for (int i=0; i<=N; i++)
         {
-            tmp = BLASFEO_DVECEL(tmp_fun_vec, j);
-            if (tmp > 0.0)
-            {
-                // tmp = constraint violation
-                // printf("IN merit fun: ineq i %d, j %d tmp_fun %e, multiplier %e\n", i, j, tmp, BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j));
-                constr_fun += fabs(BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j)) * tmp;
-            }
+            cost_fun += merit_stage[3*(c*(N+1)+i)+0];
+            dyn_fun += merit_stage[3*(c*(N+1)+i)+1];
+            constr_fun += merit_stage[3*(c*(N+1)+i)+2];
         }
+        work->ls_merit[c] = cost_fun + dyn_fun + constr_fun;
+        // printf("Merit fun: %e cost: %e dyn: %e constr: %e\n", work->ls_merit[c], cost_fun, dyn_fun, constr_fun);
     }
+}
 
-    merit_fun = cost_fun + dyn_fun + constr_fun;
 
-	// printf("Merit fun: %e cost: %e dyn: %e constr: %e\n", merit_fun, cost_fun, dyn_fun, constr_fun);
 
-    return merit_fun;
+double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                                  ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
+                                  ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+{
+    /* computes merit function value at iterate: tmp_nlp_out, with weights: work->weight_merit_fun */
+    work->ls_ux[0] = work->tmp_nlp_out->ux;
+    ocp_nlp_evaluate_merit_fun_candidates(config, dims, in, out, opts, mem, work, 1);
+    return work->ls_merit[0];
 }
 
 
@@ -2840,6 +3357,9 @@ int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *
     // {
     // }
 
+    acados_timer timer;
+    acados_tic(&timer);
+
     double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
 
     double reduction_factor = opts->alpha_reduction;
@@ -2878,32 +3398,63 @@ int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *
     //     break;
     // }
 
-    for (j=0; alpha*reduction_factor > opts->alpha_min; j++)
-    {
-        // tmp_nlp_out = out + alpha * qp_out
-        for (i = 0; i <= N; i++)
-            blasfeo_daxpy(nv[i], alpha, qp_out->ux+i, 0, out->ux+i, 0, work->tmp_nlp_out->ux+i, 0);
+    // candidates are evaluated in batches of line_search_num_candidates step sizes
+    int c, num_batch;
+    double alpha_c;
+    work->ls_ux[0] = work->tmp_nlp_out->ux;
 
-        merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
-        if (opts->print_level > 1)
+    for (j=0; alpha*reduction_factor > opts->alpha_min; )
+    {
+        // ls_ux[c] = out + alpha_c * qp_out
+        num_batch = 0;
+        alpha_c = alpha;
+        while (num_batch < work->ls_num_candidates &&
+               (num_batch == 0 || alpha_c*reduction_factor > opts->alpha_min))
         {
-            printf("backtracking %d alpha = %f, merit_fun1 = %e, merit_fun0 %e\n", j, alpha, merit_fun1, merit_fun0);
+            for (i = 0; i <= N; i++)
+                blasfeo_daxpy(nv[i], alpha_c, qp_out->ux+i, 0, out->ux+i, 0, work->ls_ux[num_batch]+i, 0);
+            alpha_c *= reduction_factor;
+            num_batch++;
         }
 
-        // if (merit_fun1 < merit_fun0 && merit_fun1 > max_next_merit_fun_val)
-        // {
-        //     printf("\nalpha %f would be accepted without sufficient descent condition", alpha);
-        // }
+        ocp_nlp_evaluate_merit_fun_candidates(config, dims, in, out, opts, mem, work, num_batch);
 
-        max_next_merit_fun_val = merit_fun0 + eps_sufficient_descent * dmerit_dy * alpha;
-        if ((merit_fun1 < max_next_merit_fun_val) && !isnan(merit_fun1) && !isinf(merit_fun1))
+        for (c = 0; c < num_batch; c++, j++)
         {
-            *alpha_reference = alpha;
-            return ACADOS_SUCCESS;
+            merit_fun1 = work->ls_merit[c];
+            if (opts->print_level > 1)
+            {
+                printf("backtracking %d alpha = %f, merit_fun1 = %e, merit_fun0 %e\n", j, alpha, merit_fun1, merit_fun0);
+            }
+
+            // if (merit_fun1 < merit_fun0 && merit_fun1 > max_next_merit_fun_val)
+            // {
+            //     printf("\nalpha %f would be accepted without sufficient descent condition", alpha);
+            // }
+
+            max_next_merit_fun_val = merit_fun0 + eps_sufficient_descent * dmerit_dy * alpha;
+            if ((merit_fun1 < max_next_merit_fun_val) && !isnan(merit_fun1) && !isinf(merit_fun1))
+            {
+                if (c > 0)
+                {
+                    // accepted trial iterate to tmp_nlp_out
+                    for (i = 0; i <= N; i++)
+                        blasfeo_dveccp(nv[i], work->ls_ux[c]+i, 0, work->tmp_nlp_out->ux+i, 0);
+                }
+                *alpha_reference = alpha;
+                return ACADOS_SUCCESS;
+            }
+            else
+            {
+                alpha *= reduction_factor;
+            }
         }
-        else
+
+        // stop backtracking if the time budget is exhausted, no step is taken
+        if (mem->time_budget_glob > 0.0 && acados_toc(&timer) >= mem->time_budget_glob)
         {
-            alpha *= reduction_factor;
+            *alpha_reference = 0.0;
+            return ACADOS_TIMEOUT;
         }
     }
 
@@ -2926,6 +3477,12 @@ void ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
             ocp_nlp_out *out_start, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
             ocp_nlp_out *out_destination, double alpha)
 {
+    if (config->update_variables != NULL)
+    {
+        config->update_variables(config, dims, in, out_start, opts, mem, work, out_destination, alpha);
+        return;
+    }
+
     int N = dims->N;
     int *nv = dims->nv;
     int *nx = dims->nx;
@@ -3251,12 +3808,15 @@ void ocp_nlp_cost_compute(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in
     double* tmp_cost = NULL;
     double total_cost = 0.0;
 
-    int cost_integration;
-
+    // stage-wise evaluation in parallel
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
     for (int i = 0; i <= N; i++)
     {
         if (i < N)
         {
+            int cost_integration;
             config->dynamics[i]->opts_get(config->dynamics[i], opts->dynamics[i], "cost_computation", &cost_integration);
 
             if (cost_integration)
@@ -3268,6 +3828,11 @@ void ocp_nlp_cost_compute(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in
 
         config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i],
                     opts->cost[i], mem->cost[i], work->cost[i]);
+    }
+
+    // sum up in stage order, independent of the number of threads
+    for (int i = 0; i <= N; i++)
+    {
         tmp_cost = config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
         // printf("cost at stage %d = %e, total = %e\n", i, *tmp_cost, total_cost);
         total_cost += *tmp_cost;
@@ -93,6 +93,8 @@ typedef struct ocp_nlp_config
     // prepare memory
     int (*precompute)(void *config, void *dims, void *nlp_in, void *nlp_out, void *opts_, void *mem, void *work);
     void (*memory_reset_qp_solver)(void *config, void *dims, void *nlp_in, void *nlp_out, void *opts_, void *mem, void *work);
+    // resets only the warm start of the QP solver and keeps its setup, see ocp_nlp_solver_prewarm
+    void (*memory_reset_qp_warm_start)(void *config, void *dims, void *opts_, void *mem);
     // initialize this struct with default values
     void (*config_initialize_default)(void *config);
     // general getter
@@ -101,6 +103,10 @@ typedef struct ocp_nlp_config
     void (*work_get)(void *config_, void *dims, void *work_, const char *field, void *return_value_);
     //
     void (*terminate)(void *config, void *mem, void *work);
+    // optional problem-specific replacement of ocp_nlp_update_variables_sqp, e.g. generated code
+    // with constant dimensions; NULL selects the generic implementation
+    void (*update_variables)(void *config, void *dims, void *in, void *out_start, void *opts, void *mem,
+                             void *work, void *out_destination, double alpha);
     // config structs of submodules
     ocp_qp_xcond_solver_config *qp_solver; // TODO rename xcond_solver
     ocp_nlp_dynamics_config **dynamics;
@@ -261,6 +267,13 @@ typedef enum
     FUNNEL_L1PEN_LINESEARCH
 } ocp_nlp_globalization_t;
 
+/// Hessian approximation types
+typedef enum
+{
+    HESS_APPROX_SUBMODULES,  // Hessian as computed by the cost, dynamics and constraints modules
+    HESS_APPROX_BLOCK_BFGS,  // stage-wise damped (L-)BFGS approximation of the Lagrangian Hessian
+} ocp_nlp_hess_approx_t;
+
 typedef struct ocp_nlp_opts
 {
     ocp_qp_xcond_solver_opts *qp_solver_opts; // xcond solver opts instead ???
@@ -275,7 +288,13 @@ typedef struct ocp_nlp_opts
     int print_level;
     int fixed_hess;
     int log_primal_step_norm; // compute and log the max norm of the primal steps
-
+    // exact Hessian contributions as set by the user, used to restore them after temporarily disabling
+    int exact_hess_cost;
+    int exact_hess_dyn;
+    int exact_hess_constr;
+    ocp_nlp_hess_approx_t hess_approx;
+    int block_bfgs_memory; // number of stored pairs for L-BFGS, 0: full damped BFGS on each block
+    int reuse_qp_fact; // skip condensing and, if supported by the QP solver, factorization of QP matrices equal to the previous ones
     // Flag for usage of adaptive levenberg marquardt strategy
     bool with_adaptive_levenberg_marquardt;
     double adaptive_levenberg_marquardt_lam;
@@ -290,6 +309,7 @@ typedef struct ocp_nlp_opts
     double alpha_min;
     double alpha_reduction;
     double eps_sufficient_descent;
+    int line_search_num_candidates; // number of backtracking step sizes evaluated at once
     int with_solution_sens_wrt_params;
     int with_value_sens_wrt_params;
 
@@ -366,12 +386,34 @@ typedef struct ocp_nlp_memory
     double cost_value;
     double qp_cost_value;
     int compute_hess;
+    double time_budget_glob; // remaining time for the line search, set by the solver; <= 0: no limit
 
     double adaptive_levenberg_marquardt_mu;
     double adaptive_levenberg_marquardt_mu_bar;
 
     bool *set_sim_guess; // indicate if there is new explicitly provided guess for integration variables
     struct blasfeo_dvec *sim_guess;
+
+    // block-wise quasi-Newton Hessian approximation, only allocated for HESS_APPROX_BLOCK_BFGS
+    struct blasfeo_dmat *block_bfgs_B;     // Hessian approximation per stage
+    struct blasfeo_dvec *block_bfgs_S;     // L-BFGS steps, (N+1) x block_bfgs_memory
+    struct blasfeo_dvec *block_bfgs_Y;     // L-BFGS damped gradient differences, (N+1) x block_bfgs_memory
+    struct blasfeo_dvec *block_bfgs_step;
+    struct blasfeo_dvec *block_bfgs_grad;
+    struct blasfeo_dvec *block_bfgs_grad_old;
+    struct blasfeo_dvec *block_bfgs_tmp;
+    int *block_bfgs_num_pairs;  // number of stored L-BFGS pairs per stage
+    int *block_bfgs_head;       // index of the next L-BFGS pair to be overwritten per stage
+    bool block_bfgs_valid;      // step and old gradient are available for an update
+
+    // QP matrices of the last comparison, only allocated if opts->reuse_qp_fact
+    struct blasfeo_dmat *qp_lhs_BAbt;
+    struct blasfeo_dmat *qp_lhs_RSQrq;
+    struct blasfeo_dmat *qp_lhs_DCt;
+    struct blasfeo_dvec *qp_lhs_Z;
+    bool qp_lhs_valid;     // the copies above hold the QP matrices of a previous iteration
+    int qp_lhs_unchanged;  // result of the last ocp_nlp_qp_lhs_update, passed to the QP solver as lhs_unchanged
+
     acados_size_t workspace_size;
 
 } ocp_nlp_memory;
@@ -412,6 +454,12 @@ typedef struct ocp_nlp_workspace
     // AS-RTI
     double *tmp_nv_double;
 
+    // merit line search: trial primal variables and merit contributions per candidate
+    int ls_num_candidates;       // number of candidates workspace is allocated for
+    struct blasfeo_dvec **ls_ux; // ls_ux[0] is tmp_nlp_out->ux
+    double *merit_stage;         // cost, dynamics, constraints per candidate and stage
+    double *ls_merit;
+
 } ocp_nlp_workspace;
 
 //
@@ -492,6 +540,26 @@ void ocp_nlp_common_eval_lagr_grad_p(ocp_nlp_config *config, ocp_nlp_dims *dims,
 void ocp_nlp_add_levenberg_marquardt_term(ocp_nlp_config *config, ocp_nlp_dims *dims,
     ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
     ocp_nlp_workspace *work, double alpha, int iter);
+//
+int ocp_nlp_damped_bfgs_update(int n, struct blasfeo_dmat *B, struct blasfeo_dvec *s,
+    struct blasfeo_dvec *y, struct blasfeo_dvec *Bs);
+//
+int ocp_nlp_sr1_update(int n, struct blasfeo_dmat *B, struct blasfeo_dvec *s,
+    struct blasfeo_dvec *y, struct blasfeo_dvec *r);
+//
+void ocp_nlp_quasi_newton_copy_hess(int n, struct blasfeo_dmat *RSQrq, struct blasfeo_dmat *B);
+//
+void ocp_nlp_quasi_newton_store_step(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+    double alpha, struct blasfeo_dvec *grad, struct blasfeo_dvec *step, struct blasfeo_dvec *grad_old,
+    struct blasfeo_dvec *tmp);
+//
+void ocp_nlp_block_bfgs_reset(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem);
+//
+void ocp_nlp_block_bfgs_update(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem);
+//
+void ocp_nlp_block_bfgs_store_step(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem, double alpha);
+//
+void ocp_nlp_qp_lhs_update(ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_memory *mem);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -32,6 +32,7 @@
 #include "acados/ocp_nlp/ocp_nlp_constraints_bgh.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -901,6 +902,69 @@ void ocp_nlp_constraints_bgh_model_get(void *config_, void *dims_,
 
 
 
+struct blasfeo_dvec *ocp_nlp_constraints_bgh_model_get_vec_ptr(void *config_, void *dims_, void *model_,
+                         const char *field, int *offset, int *size)
+{
+    ocp_nlp_constraints_bgh_dims *dims = (ocp_nlp_constraints_bgh_dims *) dims_;
+    ocp_nlp_constraints_bgh_model *model = (ocp_nlp_constraints_bgh_model *) model_;
+
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int nh = dims->nh;
+    int nbx = dims->nbx;
+    int nbu = dims->nbu;
+
+    // layout of d: [lb lg lh ub ug uh ls us]
+    if (!strcmp(field, "lbu"))
+    {
+        *offset = 0;
+        *size = nbu;
+    }
+    else if (!strcmp(field, "lbx"))
+    {
+        *offset = nbu;
+        *size = nbx;
+    }
+    else if (!strcmp(field, "lg"))
+    {
+        *offset = nb;
+        *size = ng;
+    }
+    else if (!strcmp(field, "lh"))
+    {
+        *offset = nb + ng;
+        *size = nh;
+    }
+    else if (!strcmp(field, "ubu"))
+    {
+        *offset = nb + ng + nh;
+        *size = nbu;
+    }
+    else if (!strcmp(field, "ubx"))
+    {
+        *offset = nb + ng + nh + nbu;
+        *size = nbx;
+    }
+    else if (!strcmp(field, "ug"))
+    {
+        *offset = 2*nb + ng + nh;
+        *size = ng;
+    }
+    else if (!strcmp(field, "uh"))
+    {
+        *offset = 2*nb + 2*ng + nh;
+        *size = nh;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    return &model->d;
+}
+
+
+
 /************************************************
  * options
  ************************************************/
@@ -937,6 +1001,9 @@ void ocp_nlp_constraints_bgh_opts_initialize_default(void *config_, void *dims_,
 
     opts->compute_adj = 1;
     opts->compute_hess = 0;
+    opts->lazy_jac_h = 0;
+    opts->lazy_jac_h_margin = 10.0;
+    opts->lazy_jac_h_max_age = 5;
 
     return;
 }
@@ -967,6 +1034,21 @@ void ocp_nlp_constraints_bgh_opts_set(void *config_, void *opts_, char *field, v
         int *compute_hess = value;
         opts->compute_hess = *compute_hess;
     }
+    else if(!strcmp(field, "lazy_jac_h"))
+    {
+        int *lazy_jac_h = value;
+        opts->lazy_jac_h = *lazy_jac_h;
+    }
+    else if(!strcmp(field, "lazy_jac_h_margin"))
+    {
+        double *lazy_jac_h_margin = value;
+        opts->lazy_jac_h_margin = *lazy_jac_h_margin;
+    }
+    else if(!strcmp(field, "lazy_jac_h_max_age"))
+    {
+        int *lazy_jac_h_max_age = value;
+        opts->lazy_jac_h_max_age = *lazy_jac_h_max_age;
+    }
     else if(!strcmp(field, "with_solution_sens_wrt_params"))
     {
         // do nothing for now
@@ -1008,6 +1090,11 @@ acados_size_t ocp_nlp_constraints_bgh_memory_calculate_size(void *config_, void
     size += 1 * blasfeo_memsize_dvec(2 * nb + 2 * ng + 2 * nh + 2 * ns);  // fun
     size += 1 * blasfeo_memsize_dvec(nu + nx + 2 * ns);                   // adj
     size += 1 * blasfeo_memsize_dvec(nb+ng+nh+ns);  // constr_eval_no_bounds
+    if (nh > 0)
+    {
+        size += 1 * blasfeo_memsize_dmat(nu+nx, nh);  // jac_h_tran
+        size += 1 * blasfeo_memsize_dvec(nu+nx);      // ux_prev
+    }
 
     size += 1 * 64;  // blasfeo_mem align
     size += 1 * 8;  // initial align
@@ -1049,6 +1136,17 @@ void *ocp_nlp_constraints_bgh_memory_assign(void *config_, void *dims_, void *op
     assign_and_advance_blasfeo_dvec_mem(nu + nx + 2 * ns, &memory->adj, &c_ptr);
     // constr_eval_no_bounds
     assign_and_advance_blasfeo_dvec_mem(nb+ng+nh+ns, &memory->constr_eval_no_bounds, &c_ptr);
+    if (nh > 0)
+    {
+        // jac_h_tran
+        assign_and_advance_blasfeo_dmat_mem(nu+nx, nh, &memory->jac_h_tran, &c_ptr);
+        // ux_prev
+        assign_and_advance_blasfeo_dvec_mem(nu+nx, &memory->ux_prev, &c_ptr);
+    }
+
+    memory->jac_h_age = -1;
+    memory->jac_h_eval_count = 0;
+    memory->jac_h_skip_count = 0;
 
     assert((char *) raw_memory +
                ocp_nlp_constraints_bgh_memory_calculate_size(config_, dims, opts_) >=
@@ -1167,6 +1265,30 @@ void ocp_nlp_constraints_bgh_memory_set_idxe_ptr(int *idxe, void *memory_)
 
 
 
+void ocp_nlp_constraints_bgh_memory_get(void *config_, void *dims_, void *memory_,
+                                        const char *field, void *value)
+{
+    ocp_nlp_constraints_bgh_memory *memory = memory_;
+
+    if (!strcmp(field, "jac_h_eval_count"))
+    {
+        int *int_value = value;
+        *int_value = memory->jac_h_eval_count;
+    }
+    else if (!strcmp(field, "jac_h_skip_count"))
+    {
+        int *int_value = value;
+        *int_value = memory->jac_h_skip_count;
+    }
+    else
+    {
+        printf("\nerror: field %s not available in ocp_nlp_constraints_bgh_memory_get\n", field);
+        exit(1);
+    }
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -1305,11 +1427,107 @@ void ocp_nlp_constraints_bgh_initialize(void *config_, void *dims_, void *model_
     // initialize general constraints matrix
     blasfeo_dgecp(nu + nx, ng, &model->DCt, 0, 0, memory->DCt, 0, 0);
 
+    // lazy Jacobian statistics
+    memory->jac_h_eval_count = 0;
+    memory->jac_h_skip_count = 0;
+
     return;
 }
 
 
 
+// Checks whether the Jacobian of h from a previous evaluation can be reused as a zero-order
+// approximation at the current iterate. As a side effect, h is evaluated at the current iterate
+// and stored in constr_eval_no_bounds.
+// The Jacobian is reused only if every nonlinear constraint of the stage has a margin to its
+// bounds larger than its first-order change predicted from the last step.
+static int ocp_nlp_constraints_bgh_jac_h_reusable(ocp_nlp_constraints_bgh_dims *dims,
+            ocp_nlp_constraints_bgh_model *model, ocp_nlp_constraints_bgh_opts *opts,
+            ocp_nlp_constraints_bgh_memory *memory)
+{
+    // extract dims
+    int nx = dims->nx;
+    int nu = dims->nu;
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int nh = dims->nh;
+
+    // safeguard: no valid Jacobian or Jacobian too old
+    if (memory->jac_h_age < 0 || memory->jac_h_age >= opts->lazy_jac_h_max_age ||
+        model->nl_constr_h_fun == NULL)
+    {
+        return 0;
+    }
+
+    ext_fun_arg_t ext_fun_type_in[3];
+    void *ext_fun_in[3];
+    ext_fun_arg_t ext_fun_type_out[1];
+    void *ext_fun_out[1];
+
+    struct blasfeo_dvec_args x_in;  // input x of external fun;
+    x_in.x = memory->ux;
+    x_in.xi = nu;
+
+    struct blasfeo_dvec_args u_in;  // input u of external fun;
+    u_in.x = memory->ux;
+    u_in.xi = 0;
+
+    struct blasfeo_dvec_args z_in;  // input z of external fun;
+    z_in.x = memory->z_alg;
+    z_in.xi = 0;
+
+    struct blasfeo_dvec_args fun_out;
+    fun_out.x = &memory->constr_eval_no_bounds;
+    fun_out.xi = nb + ng;
+
+    ext_fun_type_in[0] = BLASFEO_DVEC_ARGS;
+    ext_fun_in[0] = &x_in;
+    ext_fun_type_in[1] = BLASFEO_DVEC_ARGS;
+    ext_fun_in[1] = &u_in;
+    ext_fun_type_in[2] = BLASFEO_DVEC_ARGS;
+    ext_fun_in[2] = &z_in;
+
+    ext_fun_type_out[0] = BLASFEO_DVEC_ARGS;
+    ext_fun_out[0] = &fun_out;  // fun: nh
+
+    model->nl_constr_h_fun->evaluate(model->nl_constr_h_fun, ext_fun_type_in, ext_fun_in,
+                                     ext_fun_type_out, ext_fun_out);
+
+    // step norm wrt previous iterate
+    double step_norm = 0.0;
+    for (int i = 0; i < nu+nx; i++)
+    {
+        step_norm = fmax(step_norm,
+                fabs(BLASFEO_DVECEL(memory->ux, i) - BLASFEO_DVECEL(&memory->ux_prev, i)));
+    }
+
+    // classify constraints by their margin
+    for (int j = 0; j < nh; j++)
+    {
+        double h_j = BLASFEO_DVECEL(&memory->constr_eval_no_bounds, nb+ng+j);
+        double lh_j = BLASFEO_DVECEL(&model->d, nb+ng+j);
+        double uh_j = BLASFEO_DVECEL(&model->d, 2*(nb+ng)+nh+j);
+
+        double margin = ACADOS_INFTY;
+        if (lh_j > -ACADOS_INFTY)
+            margin = fmin(margin, h_j - lh_j);
+        if (uh_j < ACADOS_INFTY)
+            margin = fmin(margin, uh_j - h_j);
+
+        double jac_norm = 0.0;
+        for (int i = 0; i < nu+nx; i++)
+            jac_norm += fabs(BLASFEO_DMATEL(&memory->jac_h_tran, i, j));
+
+        // near active: refresh all Jacobians of this stage
+        if (margin <= opts->lazy_jac_h_margin * jac_norm * step_norm)
+            return 0;
+    }
+
+    return 1;
+}
+
+
+
 void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void *model_,
                                                 void *opts_, void *memory_, void *work_)
 {
@@ -1416,6 +1634,9 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
 
             model->nl_constr_h_fun_jac_hess->evaluate(model->nl_constr_h_fun_jac_hess,
                     ext_fun_type_in, ext_fun_in, ext_fun_type_out, ext_fun_out);
+            memory->jac_h_eval_count++;
+            // no lazy evaluation with exact Hessians
+            memory->jac_h_age = -1;
 
             // tmp_nv_nv += dzdxu^T * (hess_z * dzdxu)
             blasfeo_dgemm_nt(nz, nu+nx, nz, 1.0, &work->hess_z, 0, 0, memory->dzduxt, 0, 0,
@@ -1457,8 +1678,26 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
             ext_fun_type_out[2] = BLASFEO_DMAT_ARGS;
             ext_fun_out[2] = &jac_z_tran_out;  // jac_z': nz * nh
 
-            model->nl_constr_h_fun_jac->evaluate(model->nl_constr_h_fun_jac, ext_fun_type_in,
+            if (opts->lazy_jac_h && nz == 0 &&
+                ocp_nlp_constraints_bgh_jac_h_reusable(dims, model, opts, memory))
+            {
+                // zero-order approximation: reuse Jacobian from previous evaluation
+                blasfeo_dgecp(nu+nx, nh, &memory->jac_h_tran, 0, 0, memory->DCt, 0, ng);
+                memory->jac_h_age++;
+                memory->jac_h_skip_count++;
+            }
+            else
+            {
+                model->nl_constr_h_fun_jac->evaluate(model->nl_constr_h_fun_jac, ext_fun_type_in,
                                                     ext_fun_in, ext_fun_type_out, ext_fun_out);
+                memory->jac_h_eval_count++;
+
+                if (opts->lazy_jac_h && nz == 0)
+                {
+                    blasfeo_dgecp(nu+nx, nh, memory->DCt, 0, ng, &memory->jac_h_tran, 0, 0);
+                    memory->jac_h_age = 0;
+                }
+            }
 
             // expand h:
             // h(x, u, z) ~
@@ -1477,6 +1716,11 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
             // update DCt
             blasfeo_dgead(nu+nx, nh, 1.0, &work->tmp_nv_nh, 0, 0, memory->DCt, ng, 0);
         }
+
+        if (opts->lazy_jac_h)
+        {
+            blasfeo_dveccp(nu+nx, memory->ux, 0, &memory->ux_prev, 0);
+        }
     }
 
     // TODO: move this!
@@ -1698,6 +1942,7 @@ void ocp_nlp_constraints_bgh_config_initialize_default(void *config_, int stage)
     config->model_assign = &ocp_nlp_constraints_bgh_model_assign;
     config->model_set = &ocp_nlp_constraints_bgh_model_set;
     config->model_get = &ocp_nlp_constraints_bgh_model_get;
+    config->model_get_vec_ptr = &ocp_nlp_constraints_bgh_model_get_vec_ptr;
     config->opts_calculate_size = &ocp_nlp_constraints_bgh_opts_calculate_size;
     config->opts_assign = &ocp_nlp_constraints_bgh_opts_assign;
     config->opts_initialize_default = &ocp_nlp_constraints_bgh_opts_initialize_default;
@@ -1717,6 +1962,7 @@ void ocp_nlp_constraints_bgh_config_initialize_default(void *config_, int stage)
     config->memory_set_idxb_ptr = &ocp_nlp_constraints_bgh_memory_set_idxb_ptr;
     config->memory_set_idxs_rev_ptr = &ocp_nlp_constraints_bgh_memory_set_idxs_rev_ptr;
     config->memory_set_idxe_ptr = &ocp_nlp_constraints_bgh_memory_set_idxe_ptr;
+    config->memory_get = &ocp_nlp_constraints_bgh_memory_get;
     config->workspace_calculate_size = &ocp_nlp_constraints_bgh_workspace_calculate_size;
     config->initialize = &ocp_nlp_constraints_bgh_initialize;
     config->update_qp_matrices = &ocp_nlp_constraints_bgh_update_qp_matrices;
@@ -113,6 +113,9 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
 //
 void ocp_nlp_constraints_bgh_model_get(void *config_, void *dims_,
                          void *model_, const char *field, void *value);
+//
+struct blasfeo_dvec *ocp_nlp_constraints_bgh_model_get_vec_ptr(void *config_, void *dims_, void *model_,
+                         const char *field, int *offset, int *size);
 
 
 /************************************************
@@ -123,6 +126,12 @@ typedef struct
 {
     int compute_adj;
     int compute_hess;
+    // lazy evaluation of the Jacobian of h: reuse the last evaluated Jacobian at stages where
+    // all nonlinear constraints are far from active relative to the current step norm
+    int lazy_jac_h;
+    double lazy_jac_h_margin;  // constraint j is far from active if its margin exceeds
+                               // lazy_jac_h_margin * |grad h_j|_1 * |step|_inf
+    int lazy_jac_h_max_age;    // force full Jacobian evaluation after this many reuses
 } ocp_nlp_constraints_bgh_opts;
 
 //
@@ -157,6 +166,12 @@ typedef struct
     int *idxb;                   // pointer to idxb[ii] in qp_in
     int *idxs_rev;               // pointer to idxs_rev[ii] in qp_in
     int *idxe;                   // pointer to idxe[ii] in qp_in
+    // lazy Jacobian evaluation
+    struct blasfeo_dmat jac_h_tran;  // last evaluated Jacobian of h wrt [u; x], transposed
+    struct blasfeo_dvec ux_prev;     // ux at previous call of update_qp_matrices
+    int jac_h_age;                   // number of reuses of jac_h_tran, -1 if not valid
+    int jac_h_eval_count;            // number of Jacobian evaluations since initialize
+    int jac_h_skip_count;            // number of skipped Jacobian evaluations since initialize
 } ocp_nlp_constraints_bgh_memory;
 
 //
@@ -185,6 +200,9 @@ void ocp_nlp_constraints_bgh_memory_set_idxb_ptr(int *idxb, void *memory_);
 void ocp_nlp_constraints_bgh_memory_set_idxs_rev_ptr(int *idxs_rev, void *memory_);
 //
 void ocp_nlp_constraints_bgh_memory_set_idxe_ptr(int *idxe, void *memory_);
+//
+void ocp_nlp_constraints_bgh_memory_get(void *config_, void *dims_, void *memory_,
+                                        const char *field, void *value);
 
 
 
@@ -838,6 +838,69 @@ void ocp_nlp_constraints_bgp_model_get(void *config_, void *dims_,
 
 
 
+struct blasfeo_dvec *ocp_nlp_constraints_bgp_model_get_vec_ptr(void *config_, void *dims_, void *model_,
+                         const char *field, int *offset, int *size)
+{
+    ocp_nlp_constraints_bgp_dims *dims = (ocp_nlp_constraints_bgp_dims *) dims_;
+    ocp_nlp_constraints_bgp_model *model = (ocp_nlp_constraints_bgp_model *) model_;
+
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int nphi = dims->nphi;
+    int nbx = dims->nbx;
+    int nbu = dims->nbu;
+
+    // layout of d: [lb lg lphi ub ug uphi ls us]
+    if (!strcmp(field, "lbu"))
+    {
+        *offset = 0;
+        *size = nbu;
+    }
+    else if (!strcmp(field, "lbx"))
+    {
+        *offset = nbu;
+        *size = nbx;
+    }
+    else if (!strcmp(field, "lg"))
+    {
+        *offset = nb;
+        *size = ng;
+    }
+    else if (!strcmp(field, "lphi"))
+    {
+        *offset = nb + ng;
+        *size = nphi;
+    }
+    else if (!strcmp(field, "ubu"))
+    {
+        *offset = nb + ng + nphi;
+        *size = nbu;
+    }
+    else if (!strcmp(field, "ubx"))
+    {
+        *offset = nb + ng + nphi + nbu;
+        *size = nbx;
+    }
+    else if (!strcmp(field, "ug"))
+    {
+        *offset = 2*nb + ng + nphi;
+        *size = ng;
+    }
+    else if (!strcmp(field, "uphi"))
+    {
+        *offset = 2*nb + 2*ng + nphi;
+        *size = nphi;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    return &model->d;
+}
+
+
+
 /* options */
 
 acados_size_t ocp_nlp_constraints_bgp_opts_calculate_size(void *config_, void *dims_)
@@ -978,6 +1041,9 @@ void *ocp_nlp_constraints_bgp_memory_assign(void *config_, void *dims_, void *op
     // constr_eval_no_bounds
     assign_and_advance_blasfeo_dvec_mem(nb+ng+nphi+ns, &memory->constr_eval_no_bounds, &c_ptr);
 
+    memory->jac_h_eval_count = 0;
+    memory->jac_h_skip_count = 0;
+
     assert((char *) raw_memory +
                ocp_nlp_constraints_bgp_memory_calculate_size(config_, dims, opts_) >=
            c_ptr);
@@ -1093,6 +1159,30 @@ void ocp_nlp_constraints_bgp_memory_set_idxe_ptr(int *idxe, void *memory_)
 
 
 
+void ocp_nlp_constraints_bgp_memory_get(void *config_, void *dims_, void *memory_,
+                                        const char *field, void *value)
+{
+    ocp_nlp_constraints_bgp_memory *memory = memory_;
+
+    if (!strcmp(field, "jac_h_eval_count"))
+    {
+        int *int_value = value;
+        *int_value = memory->jac_h_eval_count;
+    }
+    else if (!strcmp(field, "jac_h_skip_count"))
+    {
+        int *int_value = value;
+        *int_value = memory->jac_h_skip_count;
+    }
+    else
+    {
+        printf("\nerror: field %s not available in ocp_nlp_constraints_bgp_memory_get\n", field);
+        exit(1);
+    }
+}
+
+
+
 /* workspace */
 
 acados_size_t ocp_nlp_constraints_bgp_workspace_calculate_size(void *config_, void *dims_, void *opts_)
@@ -1217,6 +1307,9 @@ void ocp_nlp_constraints_bgp_initialize(void *config_, void *dims_, void *model_
     // initialize general constraints matrix
     blasfeo_dgecp(nu + nx, ng, &model->DCt, 0, 0, memory->DCt, 0, 0);
 
+    memory->jac_h_eval_count = 0;
+    memory->jac_h_skip_count = 0;
+
     return;
 }
 
@@ -1318,6 +1411,7 @@ void ocp_nlp_constraints_bgp_update_qp_matrices(void *config_, void *dims_, void
         model->nl_constr_phi_o_r_fun_phi_jac_ux_z_phi_hess_r_jac_ux->evaluate(
                 model->nl_constr_phi_o_r_fun_phi_jac_ux_z_phi_hess_r_jac_ux,
                 ext_fun_type_in, ext_fun_in, ext_fun_type_out, ext_fun_out);
+        memory->jac_h_eval_count++;
 
         // expand phi:
         // phi(x, u, z) ~
@@ -1560,6 +1654,7 @@ void ocp_nlp_constraints_bgp_config_initialize_default(void *config_, int stage)
     config->model_assign = &ocp_nlp_constraints_bgp_model_assign;
     config->model_set = &ocp_nlp_constraints_bgp_model_set;
     config->model_get = &ocp_nlp_constraints_bgp_model_get;
+    config->model_get_vec_ptr = &ocp_nlp_constraints_bgp_model_get_vec_ptr;
     config->opts_calculate_size = &ocp_nlp_constraints_bgp_opts_calculate_size;
     config->opts_assign = &ocp_nlp_constraints_bgp_opts_assign;
     config->opts_initialize_default = &ocp_nlp_constraints_bgp_opts_initialize_default;
@@ -1579,6 +1674,7 @@ void ocp_nlp_constraints_bgp_config_initialize_default(void *config_, int stage)
     config->memory_set_idxb_ptr = &ocp_nlp_constraints_bgp_memory_set_idxb_ptr;
     config->memory_set_idxs_rev_ptr = &ocp_nlp_constraints_bgp_memory_set_idxs_rev_ptr;
     config->memory_set_idxe_ptr = &ocp_nlp_constraints_bgp_memory_set_idxe_ptr;
+    config->memory_get = &ocp_nlp_constraints_bgp_memory_get;
     config->workspace_calculate_size = &ocp_nlp_constraints_bgp_workspace_calculate_size;
     config->initialize = &ocp_nlp_constraints_bgp_initialize;
     config->update_qp_matrices = &ocp_nlp_constraints_bgp_update_qp_matrices;
@@ -106,6 +106,9 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
 //
 void ocp_nlp_constraints_bgp_model_get(void *config_, void *dims_,
                          void *model_, const char *field, void *value);
+//
+struct blasfeo_dvec *ocp_nlp_constraints_bgp_model_get_vec_ptr(void *config_, void *dims_, void *model_,
+                         const char *field, int *offset, int *size);
 
 /* options */
 
@@ -143,6 +146,8 @@ typedef struct
     int *idxb;                   // pointer to idxb[ii] in qp_in
     int *idxs_rev;                   // pointer to idxs_rev[ii] in qp_in
     int *idxe;                   // pointer to idxe[ii] in qp_in
+    int jac_h_eval_count;        // number of phi Jacobian evaluations since initialize
+    int jac_h_skip_count;        // always 0, bgp has no lazy Jacobian evaluation
 } ocp_nlp_constraints_bgp_memory;
 
 //
@@ -172,6 +177,9 @@ void ocp_nlp_constraints_bgp_memory_set_idxb_ptr(int *idxb, void *memory_);
 void ocp_nlp_constraints_bgp_memory_set_idxs_rev_ptr(int *idxs_rev, void *memory_);
 //
 void ocp_nlp_constraints_bgh_memory_set_idxe_ptr(int *idxe, void *memory_);
+//
+void ocp_nlp_constraints_bgp_memory_get(void *config_, void *dims_, void *memory_,
+                                        const char *field, void *value);
 
 /* workspace */
 
@@ -61,6 +61,9 @@ typedef struct
     void *(*model_assign)(void *config, void *dims, void *raw_memory);
     int (*model_set)(void *config_, void *dims_, void *model_, const char *field, void *value);
     void (*model_get)(void *config_, void *dims_, void *model_, const char *field, void *value);
+    // location of a vector-valued model field for direct access, NULL if not available
+    struct blasfeo_dvec *(*model_get_vec_ptr)(void *config_, void *dims_, void *model_,
+                                              const char *field, int *offset, int *size);
     acados_size_t (*opts_calculate_size)(void *config, void *dims);
     void *(*opts_assign)(void *config, void *dims, void *raw_memory);
     void (*opts_initialize_default)(void *config, void *dims, void *opts);
@@ -79,6 +82,7 @@ typedef struct
     void (*memory_set_idxb_ptr)(int *idxb, void *memory);
     void (*memory_set_idxs_rev_ptr)(int *idxs_rev, void *memory);
     void (*memory_set_idxe_ptr)(int *idxe, void *memory);
+    void (*memory_get)(void *config, void *dims, void *memory, const char *field, void *value);
     void *(*memory_assign)(void *config, void *dims, void *opts, void *raw_memory);
     acados_size_t (*workspace_calculate_size)(void *config, void *dims, void *opts);
     void (*initialize)(void *config, void *dims, void *model, void *opts, void *mem, void *work);
@@ -577,6 +577,15 @@ double *ocp_nlp_cost_ls_memory_get_fun_ptr(void *memory_)
 
 
 
+struct blasfeo_dvec *ocp_nlp_cost_ls_model_get_y_ref_ptr(void *in_)
+{
+    ocp_nlp_cost_ls_model *model = in_;
+
+    return &model->y_ref;
+}
+
+
+
 struct blasfeo_dvec *ocp_nlp_cost_ls_memory_get_grad_ptr(void *memory_)
 {
     ocp_nlp_cost_ls_memory *memory = memory_;
@@ -1043,6 +1052,7 @@ void ocp_nlp_cost_ls_config_initialize_default(void *config_, int stage)
     config->memory_assign = &ocp_nlp_cost_ls_memory_assign;
     config->memory_get_fun_ptr = &ocp_nlp_cost_ls_memory_get_fun_ptr;
     config->memory_get_grad_ptr = &ocp_nlp_cost_ls_memory_get_grad_ptr;
+    config->model_get_y_ref_ptr = &ocp_nlp_cost_ls_model_get_y_ref_ptr;
     config->memory_set_ux_ptr = &ocp_nlp_cost_ls_memory_set_ux_ptr;
     config->memory_set_z_alg_ptr = &ocp_nlp_cost_ls_memory_set_z_alg_ptr;
     config->memory_set_dzdux_tran_ptr = &ocp_nlp_cost_ls_memory_set_dzdux_tran_ptr;
@@ -182,6 +182,8 @@ double *ocp_nlp_cost_ls_memory_get_fun_ptr(void *memory_);
 //
 struct blasfeo_dvec *ocp_nlp_cost_ls_memory_get_grad_ptr(void *memory_);
 //
+struct blasfeo_dvec *ocp_nlp_cost_ls_model_get_y_ref_ptr(void *in_);
+//
 void ocp_nlp_cost_ls_memory_set_RSQrq_ptr(struct blasfeo_dmat *RSQrq, void *memory);
 //
 void ocp_nlp_cost_ls_memory_set_Z_ptr(struct blasfeo_dvec *Z, void *memory);
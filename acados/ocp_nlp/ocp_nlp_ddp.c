@@ -128,6 +128,9 @@ void ocp_nlp_ddp_opts_initialize_default(void *config_, void *dims_, void *opts_
     opts->linesearch_eta = 1e-6;
     opts->linesearch_minimum_step_size = 1e-17;
     opts->linesearch_step_size_reduction_factor = 0.5;
+    opts->linesearch_num_candidates = 1;
+
+    opts->num_shooting_segments = 1;
 
     // overwrite default submodules opts
 
@@ -251,6 +254,28 @@ void ocp_nlp_ddp_opts_set(void *config_, void *opts_, const char *field, void* v
             bool* eval_residual_at_max_iter = (bool *) value;
             opts->eval_residual_at_max_iter = *eval_residual_at_max_iter;
         }
+        else if (!strcmp(field, "linesearch_num_candidates"))
+        {
+            int* linesearch_num_candidates = (int *) value;
+            if (*linesearch_num_candidates < 1)
+            {
+                printf("\nerror: ocp_nlp_ddp_opts_set: linesearch_num_candidates has to be positive, got %d.\n",
+                       *linesearch_num_candidates);
+                exit(1);
+            }
+            opts->linesearch_num_candidates = *linesearch_num_candidates;
+        }
+        else if (!strcmp(field, "num_shooting_segments"))
+        {
+            int* num_shooting_segments = (int *) value;
+            if (*num_shooting_segments < 1)
+            {
+                printf("\nerror: ocp_nlp_ddp_opts_set: num_shooting_segments has to be positive, got %d.\n",
+                       *num_shooting_segments);
+                exit(1);
+            }
+            opts->num_shooting_segments = *num_shooting_segments;
+        }
         else
         {
             ocp_nlp_opts_set(config, nlp_opts, field, value);
@@ -313,11 +338,32 @@ acados_size_t ocp_nlp_ddp_memory_calculate_size(void *config_, void *dims_, void
         nx_max = nx_max > nx[i] ? nx_max : nx[i];
     }
 
-    size += 1*blasfeo_memsize_dmat(nu_max, nx_max); // K_mat
     size += nu_max * nx_max * sizeof(double); // tmp_nu_times_nx
 
-    size += 3*8;  // align
-    size += 64;
+    // feedback gains
+    size += N*sizeof(struct blasfeo_dmat); // K
+    size += N*sizeof(struct blasfeo_dvec); // k
+    for (int i = 0; i < N; i++)
+    {
+        size += blasfeo_memsize_dmat(nu[i], nx[i]); // K
+        size += blasfeo_memsize_dvec(nu[i]); // k
+    }
+
+    // line search candidates
+    int num_cand = opts->linesearch_num_candidates;
+    int num_seg = opts->num_shooting_segments;
+    size += num_cand*sizeof(ocp_nlp_out *); // ls_out
+    size += num_cand*num_seg*sizeof(struct blasfeo_dvec); // ls_tmp_nv
+    size += num_cand*sizeof(double); // ls_alpha
+    size += num_cand*num_seg*sizeof(double); // ls_cost
+    size += (num_cand-1)*ocp_nlp_out_calculate_size(config, dims); // ls_out[1:]
+    size += num_cand*num_seg*blasfeo_memsize_dvec(nu_max+nx_max); // ls_tmp_nv
+
+    // segment_start
+    size += (num_seg+1)*sizeof(int);
+
+    size += 5*8;  // align
+    size += 2*64;
 
     make_int_multiple_of(8, &size);
 
@@ -356,10 +402,6 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->nlp_mem = ocp_nlp_memory_assign(config, dims, nlp_opts, c_ptr);
     c_ptr += ocp_nlp_memory_calculate_size(config, dims, nlp_opts);
 
-    // blasfeo_mem align
-    align_char_to(64, &c_ptr);
-
-    // dzduxt
     int nu_max = 0;
     int nx_max = 0;
     for (int i = 0; i <= N; i++)
@@ -367,7 +409,49 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *r
         nu_max = nu_max > nu[i] ? nu_max : nu[i];
         nx_max = nx_max > nx[i] ? nx_max : nx[i];
     }
-    assign_and_advance_blasfeo_dmat_mem(nu_max, nx_max, &mem->K_mat, &c_ptr);
+
+    int num_cand = opts->linesearch_num_candidates;
+    int num_seg = opts->num_shooting_segments;
+
+    // K
+    assign_and_advance_blasfeo_dmat_structs(N, &mem->K, &c_ptr);
+    // k
+    assign_and_advance_blasfeo_dvec_structs(N, &mem->k, &c_ptr);
+    // ls_tmp_nv, one per rollout task
+    assign_and_advance_blasfeo_dvec_structs(num_cand*num_seg, &mem->ls_tmp_nv, &c_ptr);
+
+    mem->ls_num_candidates = num_cand;
+
+    // ls_out
+    align_char_to(8, &c_ptr);
+    mem->ls_out = (ocp_nlp_out **) c_ptr;
+    c_ptr += num_cand*sizeof(ocp_nlp_out *);
+    // ls_out[0] is set to the tmp_nlp_out of the workspace in each rollout
+    mem->ls_out[0] = NULL;
+    for (int c = 1; c < num_cand; c++)
+    {
+        mem->ls_out[c] = ocp_nlp_out_assign(config, dims, c_ptr);
+        c_ptr += ocp_nlp_out_calculate_size(config, dims);
+    }
+
+    // blasfeo_mem align
+    align_char_to(64, &c_ptr);
+
+    // K
+    for (int i = 0; i < N; i++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nu[i], nx[i], mem->K+i, &c_ptr);
+    }
+    // k
+    for (int i = 0; i < N; i++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nu[i], mem->k+i, &c_ptr);
+    }
+    // ls_tmp_nv
+    for (int task = 0; task < num_cand*num_seg; task++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nu_max+nx_max, mem->ls_tmp_nv+task, &c_ptr);
+    }
 
     // stat
     mem->stat = (double *) c_ptr;
@@ -381,6 +465,25 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->tmp_nu_times_nx = (double *) c_ptr;
     c_ptr += nu_max*nx_max*sizeof(double);
 
+    // ls_alpha
+    mem->ls_alpha = (double *) c_ptr;
+    c_ptr += num_cand*sizeof(double);
+
+    // ls_cost
+    mem->ls_cost = (double *) c_ptr;
+    c_ptr += num_cand*num_seg*sizeof(double);
+
+    // segment_start: horizon split into segments of (almost) equal length,
+    // the last segment additionally contains the terminal stage
+    mem->num_segments = num_seg;
+    mem->segment_start = (int *) c_ptr;
+    c_ptr += (num_seg+1)*sizeof(int);
+    for (int j = 0; j < num_seg; j++)
+    {
+        mem->segment_start[j] = (j*N)/num_seg;
+    }
+    mem->segment_start[num_seg] = N+1;
+
     mem->status = ACADOS_READY;
 
     align_char_to(8, &c_ptr);
@@ -472,95 +575,199 @@ static void ocp_nlp_ddp_reset_timers(ocp_nlp_ddp_memory *mem)
     mem->time_sim_ad = 0.0;
 }
 
-static void ocp_nlp_ddp_compute_trial_iterate(ocp_nlp_config *config, ocp_nlp_dims *dims,
-            ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem,
-            ocp_nlp_workspace *work, double alpha)
+static void ocp_nlp_ddp_get_feedback_gains(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem, ocp_nlp_workspace *work)
 {
-    /* computes trial iterate in tmp_nlp_out */
+    /* extracts K_i, k_i from the QP solver once per DDP iteration */
     int N = dims->N;
-    // int *nv = dims->nv;
     int *nx = dims->nx;
     int *nu = dims->nu;
-    int *ni = dims->ni;
-    int *nz = dims->nz;
 
     ocp_nlp_memory *mem = ddp_mem->nlp_mem;
-
-    struct blasfeo_dvec *tmp_vec;
-    ocp_nlp_out *tmp_nlp_out = work->tmp_nlp_out;
     ocp_qp_xcond_solver_config *xcond_solver_config = config->qp_solver;
 
-    // compute x_0
-    int i = 0;
-    blasfeo_daxpy(nx[i], alpha, mem->qp_out->ux + i, nu[i],
-                out->ux + i, nu[i], tmp_nlp_out->ux + i, nu[i]);
-
-    // compute u_i, x_{i+1}
-    for (i = 0; i < N; i++)
+    for (int i = 0; i < N; i++)
     {
-        /* step in primal variables */
-        // compute u   // (if i < N?)
-        /* u_i = \bar{u}_i + alpha * k_i + K_i * (x_i - \bar{x}_i) */
         // get K
         xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, mem->qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "K", i, ddp_mem->tmp_nu_times_nx, nu[i], nx[i]);
-        blasfeo_pack_dmat(nu[i], nx[i], ddp_mem->tmp_nu_times_nx, nu[i], &ddp_mem->K_mat, 0, 0);
+        blasfeo_pack_dmat(nu[i], nx[i], ddp_mem->tmp_nu_times_nx, nu[i], ddp_mem->K+i, 0, 0);
 
-        // get k = tmp_nv;
+        // get k
         xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, mem->qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "k", i, work->tmp_nv_double, nu[i], 1);
-        blasfeo_pack_dvec(nu[i], work->tmp_nv_double, 1, &work->tmp_nv, 0);
+        blasfeo_pack_dvec(nu[i], work->tmp_nv_double, 1, ddp_mem->k+i, 0);
+    }
+}
 
-        // compute delta_u = alpha * k_i + K_i * (x_i - \bar{x}_i)
+
+
+static void ocp_nlp_ddp_forward_stage(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem,
+            ocp_nlp_workspace *work, ocp_nlp_out *trial_out, struct blasfeo_dvec *tmp_nv,
+            double alpha, int i, bool propagate, double *cost)
+{
+    /* given x_i in trial_out, computes u_i and, if propagate, x_{i+1};
+     * adds the stage cost to *cost if cost != NULL */
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    ocp_nlp_memory *mem = ddp_mem->nlp_mem;
+    struct blasfeo_dvec *tmp_vec;
+    double *tmp_fun;
+
+    if (i < N)
+    {
+        /* u_i = \bar{u}_i + alpha * k_i + K_i * (x_i - \bar{x}_i) */
         // tmp_nv[nu:] = (x_i - \bar{x}_i)
-        blasfeo_daxpby(nx[i], -1.0, out->ux+i, nu[i], 1.0, tmp_nlp_out->ux+i, nu[i], &work->tmp_nv, nu[i]);
-        blasfeo_dgemv_n(nu[i], nx[i], 1.0, &ddp_mem->K_mat, 0, 0, &work->tmp_nv, nu[i], alpha, &work->tmp_nv, 0, &work->tmp_nv, 0);
-        blasfeo_daxpby(nu[i], 1.0, out->ux+i, 0, 1.0, &work->tmp_nv, 0, tmp_nlp_out->ux+i, 0);
+        blasfeo_daxpby(nx[i], -1.0, out->ux+i, nu[i], 1.0, trial_out->ux+i, nu[i], tmp_nv, nu[i]);
+        blasfeo_dgemv_n(nu[i], nx[i], 1.0, ddp_mem->K+i, 0, 0, tmp_nv, nu[i], alpha, ddp_mem->k+i, 0, tmp_nv, 0);
+        blasfeo_daxpby(nu[i], 1.0, out->ux+i, 0, 1.0, tmp_nv, 0, trial_out->ux+i, 0);
 
-        // evalutate dynamics
-        // x_{i+1} = f_dyn_i(x_i, u_i)
-        config->dynamics[i]->memory_set_ux_ptr(tmp_nlp_out->ux+i, mem->dynamics[i]);
-        config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i],
-            in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
-        config->dynamics[i]->memory_set_ux_ptr(out->ux+i, mem->dynamics[i]);
+        if (propagate)
+        {
+            // evalutate dynamics
+            // x_{i+1} = f_dyn_i(x_i, u_i)
+            config->dynamics[i]->memory_set_ux_ptr(trial_out->ux+i, mem->dynamics[i]);
+            config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i],
+                in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+            config->dynamics[i]->memory_set_ux_ptr(out->ux+i, mem->dynamics[i]);
+
+            // f_dyn_i(x_i, u_i) - x_{i+1}
+            // NOTE/TODO: store function output in dynamics module instead?
+            tmp_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+            blasfeo_daxpby(nx[i+1], 1.0, tmp_vec, 0, 1.0, out->ux+i+1, nu[i+1], trial_out->ux+i+1, nu[i+1]);
+        }
+    }
 
-        // f_dyn_i(x_i, u_i) - x_{i+1}
-        // NOTE/TODO: store function output in dynamics module instead?
-        tmp_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
-        blasfeo_daxpby(nx[i+1], 1.0, tmp_vec, 0, 1.0, out->ux+i+1, nu[i+1], tmp_nlp_out->ux+i+1, nu[i+1]);
+    if (cost != NULL)
+    {
+        config->cost[i]->memory_set_ux_ptr(trial_out->ux+i, mem->cost[i]);
+        config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i], opts->cost[i],
+                                     mem->cost[i], work->cost[i]);
+        config->cost[i]->memory_set_ux_ptr(out->ux+i, mem->cost[i]);
+        tmp_fun = config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
+        *cost += *tmp_fun;
     }
+}
+
+
+
+static void ocp_nlp_ddp_rollout(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem,
+            ocp_nlp_workspace *work, int num_candidates, bool eval_cost)
+{
+    /* forward rollout of the primal trial iterates ls_out[c] for the step sizes ls_alpha[c].
+     * Each segment starts from the linear step \bar{x} + alpha * dx of the QP solution, such that
+     * the defects at the segment boundaries are closed over the iterations.
+     * Segments and candidates are processed as a wavefront: in step t, candidate c rolls out
+     * the (t-c)-th stage of each segment, such that no dynamics or cost module is evaluated by
+     * two threads at the same time. */
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    ocp_nlp_memory *mem = ddp_mem->nlp_mem;
+    int num_seg = ddp_mem->num_segments;
+    int *segment_start = ddp_mem->segment_start;
+    int num_tasks = num_candidates*num_seg;
+
+    int max_len = 0;
+    for (int j = 0; j < num_seg; j++)
+    {
+        int len = segment_start[j+1] - segment_start[j];
+        max_len = max_len > len ? max_len : len;
+    }
+
+    for (int task = 0; task < num_tasks; task++)
+        ddp_mem->ls_cost[task] = 0.0;
 
-    for (i = 0; i < N+1; i++)
+    for (int t = 0; t < max_len + num_candidates - 1; t++)
+    {
+#if defined(ACADOS_WITH_OPENMP)
+        #pragma omp parallel for if(num_tasks > 1)
+#endif
+        for (int task = 0; task < num_tasks; task++)
+        {
+            int c = task / num_seg;
+            int j = task % num_seg;
+            int i = segment_start[j] + t - c;
+            if (i < segment_start[j] || i >= segment_start[j+1])
+                continue;
+
+            ocp_nlp_out *trial_out = ddp_mem->ls_out[c];
+            double alpha = ddp_mem->ls_alpha[c];
+
+            if (i == segment_start[j])
+            {
+                // x_i = \bar{x}_i + alpha * dx_i
+                blasfeo_daxpy(nx[i], alpha, mem->qp_out->ux+i, nu[i],
+                              out->ux+i, nu[i], trial_out->ux+i, nu[i]);
+            }
+
+            ocp_nlp_ddp_forward_stage(config, dims, in, out, opts, ddp_mem, work, trial_out,
+                ddp_mem->ls_tmp_nv+task, alpha, i, i+1 < segment_start[j+1],
+                eval_cost ? ddp_mem->ls_cost+task : NULL);
+        }
+    }
+}
+
+
+
+static void ocp_nlp_ddp_update_duals_and_z(ocp_nlp_dims *dims, ocp_nlp_out *out,
+            ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem, ocp_nlp_out *trial_out, double alpha)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ni = dims->ni;
+    int *nz = dims->nz;
+
+    ocp_nlp_memory *mem = ddp_mem->nlp_mem;
+
+    for (int i = 0; i < N+1; i++)
     {
         // update dual variables
         if (opts->full_step_dual)
         {
-            blasfeo_dveccp(2*ni[i], mem->qp_out->lam+i, 0, tmp_nlp_out->lam+i, 0);
+            blasfeo_dveccp(2*ni[i], mem->qp_out->lam+i, 0, trial_out->lam+i, 0);
             if (i < N)
             {
-                blasfeo_dveccp(nx[i+1], mem->qp_out->pi+i, 0, tmp_nlp_out->pi+i, 0);
+                blasfeo_dveccp(nx[i+1], mem->qp_out->pi+i, 0, trial_out->pi+i, 0);
             }
         }
         else
         {
             // update duals with alpha step
-            blasfeo_dvecsc(2*ni[i], 1.0-alpha, tmp_nlp_out->lam+i, 0);
-            blasfeo_daxpy(2*ni[i], alpha, mem->qp_out->lam+i, 0, tmp_nlp_out->lam+i, 0, tmp_nlp_out->lam+i, 0);
+            blasfeo_daxpby(2*ni[i], alpha, mem->qp_out->lam+i, 0, 1.0-alpha, out->lam+i, 0, trial_out->lam+i, 0);
             if (i < N)
             {
-                blasfeo_dvecsc(nx[i+1], 1.0-alpha, tmp_nlp_out->pi+i, 0);
-                blasfeo_daxpy(nx[i+1], alpha, mem->qp_out->pi+i, 0, tmp_nlp_out->pi+i, 0, tmp_nlp_out->pi+i, 0);
+                blasfeo_daxpby(nx[i+1], alpha, mem->qp_out->pi+i, 0, 1.0-alpha, out->pi+i, 0, trial_out->pi+i, 0);
             }
         }
 
         // linear update of algebraic variables using state and input sensitivity
         if (i < N)
         {
-            // tmp_nlp_out->z = mem->z_alg + alpha * dzdux * qp_out->ux
+            // trial_out->z = mem->z_alg + alpha * dzdux * qp_out->ux
             blasfeo_dgemv_t(nu[i]+nx[i], nz[i], alpha, mem->dzduxt+i, 0, 0,
-                    mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, tmp_nlp_out->z+i, 0);
+                    mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, trial_out->z+i, 0);
         }
     }
 }
 
+
+
+static void ocp_nlp_ddp_compute_trial_iterate(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_ddp_memory *ddp_mem,
+            ocp_nlp_workspace *work, double alpha)
+{
+    /* computes trial iterate in tmp_nlp_out */
+    ddp_mem->ls_out[0] = work->tmp_nlp_out;
+    ddp_mem->ls_alpha[0] = alpha;
+
+    ocp_nlp_ddp_rollout(config, dims, in, out, opts, ddp_mem, work, 1, false);
+    ocp_nlp_ddp_update_duals_and_z(dims, out, opts, ddp_mem, work->tmp_nlp_out, alpha);
+}
+
 /************************************************
  * output functions
  ************************************************/
@@ -681,6 +888,26 @@ static bool check_termination(int ddp_iter, ocp_nlp_res *nlp_res, ocp_nlp_ddp_me
  * functions
  ************************************************/
 
+// num_shooting_segments and linesearch_num_candidates size the memory,
+// hence they can not be changed after its creation
+static void ocp_nlp_ddp_check_memory_opts(ocp_nlp_ddp_opts *opts, ocp_nlp_ddp_memory *mem)
+{
+    if (opts->num_shooting_segments != mem->num_segments)
+    {
+        printf("\nerror: ocp_nlp_ddp: num_shooting_segments changed from %d to %d after solver creation.\n",
+               mem->num_segments, opts->num_shooting_segments);
+        exit(1);
+    }
+    if (opts->linesearch_num_candidates != mem->ls_num_candidates)
+    {
+        printf("\nerror: ocp_nlp_ddp: linesearch_num_candidates changed from %d to %d after solver creation.\n",
+               mem->ls_num_candidates, opts->linesearch_num_candidates);
+        exit(1);
+    }
+}
+
+
+
 // MAIN OPTIMIZATION ROUTINE
 int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_)
@@ -716,6 +943,8 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     mem->alpha = 0.0;
     mem->step_norm = 0.0;
 
+    ocp_nlp_ddp_check_memory_opts(opts, mem);
+
 #if defined(ACADOS_WITH_OPENMP)
     // backup number of threads
     int num_threads_bkp = omp_get_num_threads();
@@ -786,8 +1015,13 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             mem->stat[mem->stat_n*ddp_iter+3] = reg_param_memory;
         }
 
+        if (mem->num_segments > 1)
+        {
+            // multiple shooting: take full steps as long as the defects between the segments are open
+            infeasible_initial_guess = nlp_res->inf_norm_res_eq > opts->tol_eq;
+        }
         // Check if initial guess was infeasible
-        if ((infeasible_initial_guess == true) && (nlp_res->inf_norm_res_eq > opts->tol_eq))
+        else if ((infeasible_initial_guess == true) && (nlp_res->inf_norm_res_eq > opts->tol_eq))
         {
             if (nlp_opts->print_level > 0)
             {
@@ -919,6 +1153,9 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             return mem->status;
         }
 
+        // extract feedback law for the forward rollouts
+        ocp_nlp_ddp_get_feedback_gains(config, dims, nlp_opts, mem, nlp_work);
+
         // Compute the optimal QP objective function value
         nlp_mem->qp_cost_value = ocp_nlp_ddp_compute_qp_objective_value(dims, qp_in, qp_out,nlp_work, nlp_mem);
 
@@ -1024,57 +1261,49 @@ int ocp_nlp_ddp_backtracking_line_search(void *config_, void *dims_, void *nlp_i
 
     // evaluate the objective of the QP (as predicted reduction)
     // double qp_cost = compute_qp_cost
-    int N = dims->N;
+    int num_seg = mem->num_segments;
     double pred = -nlp_mem->qp_cost_value;
     double alpha = 1.0;
     double trial_cost;
     double negative_ared;
-    double *tmp_fun;
 
-    int i;
+    int c, j, num_batch;
+
+    mem->ls_out[0] = nlp_work->tmp_nlp_out;
 
     while (true)
     {
-        // Do the DDP forward sweep to get the trial iterate
-        ocp_nlp_ddp_compute_trial_iterate(config, dims, nlp_in, nlp_out, nlp_opts, mem, nlp_work, alpha);
-
-        ///////////////////////////////////////////////////////////////////////
-        // Evaluate cost function at trial iterate
-        // set evaluation point to tmp_nlp_out
-        ocp_nlp_set_primal_variable_pointers_in_submodules(config, dims, nlp_in, nlp_work->tmp_nlp_out, nlp_mem);
-        // compute fun value
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-        for (i=0; i<=N; i++)
-        {
-            // cost
-            config->cost[i]->compute_fun(config->cost[i], dims->cost[i], nlp_in->cost[i], nlp_opts->cost[i],
-                                        nlp_mem->cost[i], nlp_work->cost[i]);
-        }
-        ocp_nlp_set_primal_variable_pointers_in_submodules(config, dims, nlp_in, nlp_out, nlp_mem);
-        trial_cost = 0.0;
-        for(i=0; i<=N; i++)
+        // next batch of step sizes alpha, alpha*factor, ...
+        num_batch = 0;
+        while (num_batch < mem->ls_num_candidates &&
+               (num_batch == 0 || alpha >= opts->linesearch_minimum_step_size))
         {
-            tmp_fun = config->cost[i]->memory_get_fun_ptr(nlp_mem->cost[i]);
-            trial_cost += *tmp_fun;
+            mem->ls_alpha[num_batch] = alpha;
+            alpha *= opts->linesearch_step_size_reduction_factor;
+            num_batch++;
         }
 
-        negative_ared = trial_cost - nlp_mem->cost_value;
-        // Check Armijo sufficient decrease condition
-        if (negative_ared <= fmin(-opts->linesearch_eta*alpha* fmax(pred, 0) + 1e-18, 0))
-        {
-            // IF step accepted: update x
-            // reset evaluation point to SQP iterate
-            // copy_ocp_nlp_out(dims, work->nlp_work->tmp_nlp_out, nlp_out);
-            mem->alpha = alpha;
-            nlp_mem->cost_value = trial_cost;
-            return 1;
-        }
-        else
+        // Do the DDP forward sweeps to get the trial iterates and their cost
+        ocp_nlp_ddp_rollout(config, dims, nlp_in, nlp_out, nlp_opts, mem, nlp_work, num_batch, true);
+
+        // accept the first candidate that satisfies the Armijo sufficient decrease condition
+        for (c = 0; c < num_batch; c++)
         {
-            // Reduce step size
-            alpha *= opts->linesearch_step_size_reduction_factor;
+            trial_cost = 0.0;
+            for (j = 0; j < num_seg; j++)
+                trial_cost += mem->ls_cost[c*num_seg+j];
+
+            negative_ared = trial_cost - nlp_mem->cost_value;
+            if (negative_ared <= fmin(-opts->linesearch_eta*mem->ls_alpha[c]* fmax(pred, 0) + 1e-18, 0))
+            {
+                // IF step accepted: trial iterate in tmp_nlp_out
+                if (c > 0)
+                    copy_ocp_nlp_out(dims, mem->ls_out[c], nlp_work->tmp_nlp_out);
+                ocp_nlp_ddp_update_duals_and_z(dims, nlp_out, nlp_opts, mem, nlp_work->tmp_nlp_out, mem->ls_alpha[c]);
+                mem->alpha = mem->ls_alpha[c];
+                nlp_mem->cost_value = trial_cost;
+                return 1;
+            }
         }
 
         if (alpha < opts->linesearch_minimum_step_size)
@@ -1104,6 +1333,18 @@ void ocp_nlp_ddp_memory_reset_qp_solver(void *config_, void *dims_, void *nlp_in
         nlp_mem->qp_solver_mem, nlp_work->qp_work);
 }
 
+void ocp_nlp_ddp_memory_reset_qp_warm_start(void *config_, void *dims_, void *opts_, void *mem_)
+{
+    ocp_nlp_config *config = config_;
+    ocp_nlp_ddp_opts *opts = opts_;
+    ocp_nlp_ddp_memory *mem = mem_;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    ocp_qp_out_set_zero(nlp_mem->qp_out);
+    config->qp_solver->memory_reset_warm_start(config->qp_solver,
+        opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem);
+}
+
 
 int ocp_nlp_ddp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_)
@@ -1118,6 +1359,12 @@ int ocp_nlp_ddp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_
 
     nlp_mem->workspace_size = ocp_nlp_workspace_calculate_size(config, dims, opts->nlp_opts);
 
+    if (opts->nlp_opts->hess_approx != HESS_APPROX_SUBMODULES)
+    {
+        printf("\nerror: ocp_nlp_ddp_precompute: block BFGS Hessian approximation only supported with SQP.\n");
+        exit(1);
+    }
+
     ocp_nlp_ddp_workspace *work = work_;
     ocp_nlp_ddp_cast_workspace(config, dims, opts, mem, work);
     ocp_nlp_workspace *nlp_work = work->nlp_work;
@@ -1144,6 +1391,15 @@ int ocp_nlp_ddp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_
         }
     }
 
+    // the segment arrays are sized at memory creation
+    ocp_nlp_ddp_check_memory_opts(opts, mem);
+    if (mem->num_segments > N)
+    {
+        printf("ocp_nlp_ddp: num_shooting_segments > N not supported, got %d > %d.\n",
+               mem->num_segments, N);
+        exit(1);
+    }
+
     return ocp_nlp_precompute_common(config, dims, nlp_in, nlp_out, opts->nlp_opts, nlp_mem, nlp_work);
 }
 
@@ -1341,6 +1597,12 @@ void ocp_nlp_ddp_get(void *config_, void *dims_, void *mem_, const char *field,
         config->qp_solver->memory_get(config->qp_solver,
             mem->nlp_mem->qp_solver_mem, "iter", return_value_);
     }
+    else if (!strcmp("qp_stat", field) || !strcmp("qp_stat_m", field) || !strcmp("qp_stat_n", field))
+    {
+        // per-iteration statistics of the last QP solve, QP solver option log_stat
+        config->qp_solver->memory_get(config->qp_solver,
+            mem->nlp_mem->qp_solver_mem, field + 3, return_value_);
+    }
     else if (!strcmp("qp_status", field))
     {
         config->qp_solver->memory_get(config->qp_solver,
@@ -1441,6 +1703,7 @@ void ocp_nlp_ddp_config_initialize_default(void *config_)
     config->workspace_calculate_size = &ocp_nlp_ddp_workspace_calculate_size;
     config->evaluate = &ocp_nlp_ddp;
     config->memory_reset_qp_solver = &ocp_nlp_ddp_memory_reset_qp_solver;
+    config->memory_reset_qp_warm_start = &ocp_nlp_ddp_memory_reset_qp_warm_start;
     config->eval_param_sens = &ocp_nlp_ddp_eval_param_sens;
     config->eval_lagr_grad_p = &ocp_nlp_ddp_eval_lagr_grad_p;
     config->config_initialize_default = &ocp_nlp_ddp_config_initialize_default;
@@ -72,6 +72,10 @@ typedef struct
     double linesearch_eta;
     double linesearch_minimum_step_size;
     double linesearch_step_size_reduction_factor;
+    int linesearch_num_candidates; // number of step sizes rolled out concurrently in the line search; fixed at solver creation
+
+    // multiple shooting
+    int num_shooting_segments; // number of horizon segments rolled out in parallel, 1: single shooting DDP; fixed at solver creation
 
 } ocp_nlp_ddp_opts;
 
@@ -121,7 +125,19 @@ typedef struct
 
     // ddp specific memory
     double *tmp_nu_times_nx;
-    struct blasfeo_dmat K_mat;
+    struct blasfeo_dmat *K; // feedback gains of the current QP solution
+    struct blasfeo_dvec *k; // feedforward terms of the current QP solution
+
+    // line search candidates
+    int ls_num_candidates;    // number of candidates memory is allocated for
+    ocp_nlp_out **ls_out;     // trial iterates, ls_out[0] is the tmp_nlp_out of the nlp workspace
+    struct blasfeo_dvec *ls_tmp_nv; // scratch per candidate and segment
+    double *ls_alpha;
+    double *ls_cost;          // cost per candidate and segment
+
+    // multiple shooting
+    int num_segments;
+    int *segment_start;       // first stage of each segment, segment_start[num_segments] = N+1
 
     // regularization for Levenberg-Marquardt
     double step_norm;
@@ -135,6 +151,8 @@ void *ocp_nlp_ddp_memory_assign(void *config, void *dims, void *opts_, void *raw
 //
 void ocp_nlp_ddp_memory_reset_qp_solver(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     void *opts_, void *mem_, void *work_);
+//
+void ocp_nlp_ddp_memory_reset_qp_warm_start(void *config_, void *dims_, void *opts_, void *mem_);
 
 
 /************************************************
@@ -791,13 +791,25 @@ void ocp_nlp_dynamics_cont_update_qp_matrices(void *config_, void *dims_, void *
     }
 
     // initialize seeds
-    // TODO fix dims if nx!=nx1 !!!!!!!!!!!!!!!!!
-    // set S_forw = [eye(nx), zeros(nx x nu)]
-    for(jj = 0; jj < nx1 * (nx + nu); jj++)
-        work->sim_in->S_forw[jj] = 0.0;
-    for(jj = 0; jj < nx1; jj++)
-        work->sim_in->S_forw[jj * (nx + 1)] = 1.0;
+    // S_forw = [eye(nx), zeros(nx x nu)], only flagged, the integrators do not read in->S_forw
     work->sim_in->identity_seed = true;
+    // write sensitivities transposed directly into BAbt, dzduxt
+    bool sens_tran = nx1 == nx;
+    if (sens_tran)
+    {
+        work->sim_out->S_forw_tran = mem->BAbt;
+        if (nz > 0)
+            work->sim_out->S_algebraic_tran = mem->dzduxt;
+    }
+    else
+    {
+        // TODO fix dims if nx!=nx1 !!!!!!!!!!!!!!!!!
+        for(jj = 0; jj < nx1 * (nx + nu); jj++)
+            work->sim_in->S_forw[jj] = 0.0;
+        for(jj = 0; jj < nx1; jj++)
+            work->sim_in->S_forw[jj * (nx + 1)] = 1.0;
+        work->sim_in->identity_seed = false;
+    }
 
     // adjoint seed
     for(jj = 0; jj < nx + nu; jj++)
@@ -809,13 +821,16 @@ void ocp_nlp_dynamics_cont_update_qp_matrices(void *config_, void *dims_, void *
             mem->sim_solver, work->sim_solver);
 
 
-    // B
-    blasfeo_pack_tran_dmat(nx1, nu, work->sim_out->S_forw + nx1 * nx, nx1, mem->BAbt, 0, 0);
-    // A
-    blasfeo_pack_tran_dmat(nx1, nx, work->sim_out->S_forw + 0, nx1, mem->BAbt, nu, 0);
-    // dzduxt
-    blasfeo_pack_tran_dmat(nz, nu, work->sim_out->S_algebraic + nx*nz, nz, mem->dzduxt, 0, 0);
-    blasfeo_pack_tran_dmat(nz, nx, work->sim_out->S_algebraic + 0, nz, mem->dzduxt, nu, 0);
+    if (!sens_tran)
+    {
+        // B
+        blasfeo_pack_tran_dmat(nx1, nu, work->sim_out->S_forw + nx1 * nx, nx1, mem->BAbt, 0, 0);
+        // A
+        blasfeo_pack_tran_dmat(nx1, nx, work->sim_out->S_forw + 0, nx1, mem->BAbt, nu, 0);
+        // dzduxt
+        blasfeo_pack_tran_dmat(nz, nu, work->sim_out->S_algebraic + nx*nz, nz, mem->dzduxt, 0, 0);
+        blasfeo_pack_tran_dmat(nz, nx, work->sim_out->S_algebraic + 0, nz, mem->dzduxt, nu, 0);
+    }
     // blasfeo_print_dmat(nx + nu, nz, mem->dzduxt, 0, 0);
 
     // function
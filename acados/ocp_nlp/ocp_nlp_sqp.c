@@ -127,6 +127,11 @@ void ocp_nlp_sqp_opts_initialize_default(void *config_, void *dims_, void *opts_
     opts->warm_start_first_qp = false;
     opts->rti_phase = 0;
     opts->eval_residual_at_max_iter = false;
+    opts->timeout_budget = 0.0;
+    opts->hess_reuse_period = 1;
+    opts->hess_reuse_update = HESS_UPDATE_DAMPED_BFGS;
+    opts->hess_reuse_max_contraction = 0.5;
+    opts->soc_speculative = false;
 
     // funnel method opts
     opts->funnel_initialization_increase_factor = 15.0;
@@ -264,6 +269,36 @@ void ocp_nlp_sqp_opts_set(void *config_, void *opts_, const char *field, void* v
             bool* eval_residual_at_max_iter = (bool *) value;
             opts->eval_residual_at_max_iter = *eval_residual_at_max_iter;
         }
+        else if (!strcmp(field, "timeout_budget"))
+        {
+            double* timeout_budget = (double *) value;
+            opts->timeout_budget = *timeout_budget;
+        }
+        else if (!strcmp(field, "hess_reuse_period"))
+        {
+            int* hess_reuse_period = (int *) value;
+            opts->hess_reuse_period = *hess_reuse_period;
+        }
+        else if (!strcmp(field, "hess_reuse_update"))
+        {
+            int* hess_reuse_update = (int *) value;
+            if (*hess_reuse_update != HESS_UPDATE_DAMPED_BFGS && *hess_reuse_update != HESS_UPDATE_SR1)
+            {
+                printf("\nerror: ocp_nlp_sqp_opts_set: invalid value for hess_reuse_update field, got %d.\n", *hess_reuse_update);
+                exit(1);
+            }
+            opts->hess_reuse_update = *hess_reuse_update;
+        }
+        else if (!strcmp(field, "hess_reuse_max_contraction"))
+        {
+            double* hess_reuse_max_contraction = (double *) value;
+            opts->hess_reuse_max_contraction = *hess_reuse_max_contraction;
+        }
+        else if (!strcmp(field, "soc_speculative"))
+        {
+            bool* soc_speculative = (bool *) value;
+            opts->soc_speculative = *soc_speculative;
+        }
         else if (!strcmp(field, "funnel_initialization_increase_factor"))
         {
             double* funnel_initialization_increase_factor = (double *) value;
@@ -380,6 +415,30 @@ acados_size_t ocp_nlp_sqp_memory_calculate_size(void *config_, void *dims_, void
         stat_n += 4;
     size += stat_n*stat_m*sizeof(double);
 
+    // Hessian reuse
+    if (opts->hess_reuse_period > 1)
+    {
+        int N = dims->N;
+        int *nx = dims->nx;
+        int *nu = dims->nu;
+
+        size += (N+1)*sizeof(struct blasfeo_dmat);   // hess_qn
+        size += 4*(N+1)*sizeof(struct blasfeo_dvec); // hess_qn_step hess_qn_grad hess_qn_grad_old hess_qn_tmp
+        for (int i = 0; i <= N; i++)
+        {
+            size += blasfeo_memsize_dmat(nu[i]+nx[i], nu[i]+nx[i]);
+            size += 4*blasfeo_memsize_dvec(nu[i]+nx[i]);
+        }
+        size += 64;  // blasfeo_mem align
+    }
+
+    // speculative second-order correction
+    if (opts->soc_speculative)
+    {
+        size += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+        size += config->qp_solver->memory_calculate_size(config->qp_solver, dims->qp_solver, nlp_opts->qp_solver_opts);
+    }
+
     size += 3*8;  // align
 
     make_int_multiple_of(8, &size);
@@ -433,8 +492,59 @@ void *ocp_nlp_sqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
         mem->stat_n += 4;
     c_ptr += mem->stat_m*mem->stat_n*sizeof(double);
 
+    // Hessian reuse
+    if (opts->hess_reuse_period > 1)
+    {
+        int N = dims->N;
+        int *nx = dims->nx;
+        int *nu = dims->nu;
+
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N+1, &mem->hess_qn, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->hess_qn_step, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->hess_qn_grad, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->hess_qn_grad_old, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N+1, &mem->hess_qn_tmp, &c_ptr);
+
+        align_char_to(64, &c_ptr);
+        for (int i = 0; i <= N; i++)
+        {
+            assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nu[i]+nx[i], mem->hess_qn+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->hess_qn_step+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->hess_qn_grad+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->hess_qn_grad_old+i, &c_ptr);
+            assign_and_advance_blasfeo_dvec_mem(nu[i]+nx[i], mem->hess_qn_tmp+i, &c_ptr);
+        }
+    }
+    mem->hess_reuse_count = 0;
+    mem->hess_reuse_valid = false;
+    mem->hess_reuse_exact_next = false;
+    mem->hess_reuse_res_prev = 0.0;
+
+    // speculative second-order correction
+    if (opts->soc_speculative)
+    {
+        align_char_to(8, &c_ptr);
+        mem->soc_qp_out = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
+        c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+
+        align_char_to(8, &c_ptr);
+        mem->soc_qp_solver_mem = config->qp_solver->memory_assign(config->qp_solver, dims->qp_solver,
+                                                                  nlp_opts->qp_solver_opts, c_ptr);
+        c_ptr += config->qp_solver->memory_calculate_size(config->qp_solver, dims->qp_solver, nlp_opts->qp_solver_opts);
+    }
+    else
+    {
+        mem->soc_qp_out = NULL;
+        mem->soc_qp_solver_mem = NULL;
+    }
+
     mem->status = ACADOS_READY;
 
+    mem->timeout_time_iter = 0.0;
+    mem->timeout_time_qp = 0.0;
+    mem->timeout_time_iter_sum = 0.0;
+
     align_char_to(8, &c_ptr);
 
     assert((char *) raw_memory + ocp_nlp_sqp_memory_calculate_size(config, dims, opts) >= c_ptr);
@@ -684,49 +794,75 @@ static int ocp_nlp_line_search_merit_check_full_step(ocp_nlp_config *config, ocp
 }
 
 
-static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
-            ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work, int sqp_iter)
+/************************************************
+ * timeout
+ ************************************************/
+
+// predicts the duration of one more SQP iteration from the timing history
+static double ocp_nlp_sqp_timeout_predict_time_iter(ocp_nlp_sqp_memory *mem, int n_iter)
 {
-    int ii;
-    int N = dims->N;
+    if (n_iter == 0)
+    {
+        // last iteration of the previous call
+        return mem->timeout_time_iter;
+    }
+    return fmax(mem->timeout_time_iter, mem->timeout_time_iter_sum / n_iter);
+}
 
-    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
-    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
-    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
 
-    ocp_nlp_workspace *nlp_work = work->nlp_work;
 
-    ocp_qp_in *qp_in = nlp_mem->qp_in;
-    ocp_qp_out *qp_out = nlp_mem->qp_out;
-    qp_info *qp_info_;
-    // NOTE: following Waechter2006:
-    // Do SOC
-    // 1. if "the first trial step size alpha_k,0 has been rejected and
-    // 2. if the infeasibility would have increased when accepting the previous step
-    // NOTE: the "and" is interpreted as an "or" in the current implementation
+static int ocp_nlp_sqp_timeout_exit(ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem,
+    int sqp_iter, acados_timer *timer0)
+{
+    if (opts->nlp_opts->print_level > 0)
+    {
+        printf("Stopped: Time budget exhausted, returning last accepted iterate.\n");
+    }
+    mem->status = ACADOS_TIMEOUT;
+    mem->sqp_iter = sqp_iter;
+    mem->time_tot = acados_toc(timer0);
+    return mem->status;
+}
 
-    // preliminary line search
-    int line_search_status = ocp_nlp_line_search_merit_check_full_step(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, sqp_iter);
 
-    // return bool do_line_search;
-    if (line_search_status == ACADOS_NAN_DETECTED)
-    {
-        // do line search but no SOC.
+
+// checks the remaining globalization time budget right before a SOC QP solve and passes it on to
+// the QP solver as time limit; returns false and sets status ACADOS_TIMEOUT if it is exhausted
+static bool ocp_nlp_sqp_soc_check_time_budget(ocp_nlp_config *config, ocp_nlp_sqp_opts *opts,
+    ocp_nlp_sqp_memory *mem, acados_timer *timer, int sqp_iter)
+{
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+
+    if (nlp_mem->time_budget_glob <= 0.0)
         return true;
-    }
-    else if (line_search_status == ACADOS_SUCCESS)
+
+    double time_remaining = nlp_mem->time_budget_glob - acados_toc(timer);
+    if (time_remaining <= 0.0)
     {
-        mem->alpha = 1.0;
+        mem->status = ACADOS_TIMEOUT;
+        mem->sqp_iter = sqp_iter;
         return false;
     }
-    // else perform SOC (below)
 
-    // Second Order Correction (SOC): following Nocedal2006: p.557, eq. (18.51) -- (18.56)
-    // Paragraph: APPROACH III: S l1 QP (SEQUENTIAL l1 QUADRATIC PROGRAMMING),
-    // Section 18.8 TRUST-REGION SQP METHODS
-    //   - just no trust region radius here.
-    if (nlp_opts->print_level > 0)
-        printf("ocp_nlp_sqp: performing SOC, since prelim. line search returned %d\n\n", line_search_status);
+    // QP solvers without time limit ignore the option
+    qp_solver->opts_set(qp_solver, opts->nlp_opts->qp_solver_opts, "time_limit", &time_remaining);
+
+    return true;
+}
+
+
+
+static void ocp_nlp_soc_update_qp_rhs(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_memory *nlp_mem, ocp_nlp_workspace *nlp_work)
+{
+    // sets the QP rhs of the SOC QP, assumes the submodules are evaluated at the full step
+    int ii;
+    int N = dims->N;
+
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+    ocp_qp_out *qp_out = nlp_mem->qp_out;
+
     int *nb = qp_in->dim->nb;
     int *ng = qp_in->dim->ng;
     int *nx = dims->nx;
@@ -735,10 +871,6 @@ static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims,
     // int *nv = dims->nv;
     // int *ni = dims->ni;
 
-    /* evaluate constraints & dynamics at new step */
-    // NOTE: setting up the new iterate and evaluating is not needed here,
-    //   since this evaluation was perfomed just before this call in the early terminated line search.
-
     // NOTE: similar to ocp_nlp_evaluate_merit_fun
     // update QP rhs
     // d_i = c_i(x_k + p_k) - \nabla c_i(x_k)^T * p_k
@@ -771,11 +903,11 @@ static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims,
         // general linear / linearized!
         // tmp_ni = D * u + C * x
         blasfeo_dgemv_t(nu[ii]+nx[ii], ng[ii], 1.0, qp_in->DCt+ii, 0, 0, qp_out->ux+ii, 0,
-                        0.0, &work->nlp_work->tmp_ni, 0, &work->nlp_work->tmp_ni, 0);
+                        0.0, &nlp_work->tmp_ni, 0, &nlp_work->tmp_ni, 0);
         // d[nb:nb+ng] += tmp_ni (lower)
-        blasfeo_dvecad(ng[ii], 1.0, &work->nlp_work->tmp_ni, 0, qp_in->d+ii, nb[ii]);
+        blasfeo_dvecad(ng[ii], 1.0, &nlp_work->tmp_ni, 0, qp_in->d+ii, nb[ii]);
         // d[nb:nb+ng] -= tmp_ni
-        blasfeo_dvecad(ng[ii], -1.0, &work->nlp_work->tmp_ni, 0, qp_in->d+ii, 2*nb[ii]+ng[ii]);
+        blasfeo_dvecad(ng[ii], -1.0, &nlp_work->tmp_ni, 0, qp_in->d+ii, 2*nb[ii]+ng[ii]);
 
         // add slack contributions
         // d[nb:nb+ng] += slack[idx]
@@ -801,22 +933,20 @@ static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims,
         // printf("SOC: qp_in->d final value\n");
         // blasfeo_print_exp_dvec(2*nb[ii]+2*ng[ii], qp_in->d+ii, 0);
     }
+}
 
-    if (nlp_opts->print_level > 3)
-    {
-        printf("\n\nSQP: SOC ocp_qp_in at iteration %d\n", sqp_iter);
-        print_ocp_qp_in(qp_in);
-    }
 
-#if defined(ACADOS_DEBUG_SQP_PRINT_QPS_TO_FILE)
-    ocp_nlp_sqp_dump_qp_in_to_file(qp_in, sqp_iter, 1);
-#endif
 
-    // solve QP
-    // acados_tic(&timer1);
-    int qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, qp_in, qp_out,
-                                    opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem, nlp_work->qp_work);
-    // NOTE: QP is not timed, since this computation time is attributed to globalization.
+static bool ocp_nlp_soc_qp_postprocess(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work,
+            int sqp_iter, int qp_status)
+{
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+    ocp_qp_out *qp_out = nlp_mem->qp_out;
+    qp_info *qp_info_;
 
     // compute correct dual solution in case of Hessian regularization
     config->regularize->correct_dual_sol(config->regularize, dims->regularize,
@@ -874,6 +1004,233 @@ static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims,
     return true;
 }
 
+
+
+#if defined(ACADOS_WITH_OPENMP)
+// variant of ocp_nlp_soc_line_search, which solves the SOC QP concurrently with the merit function evaluation
+// at the current iterate and discards its solution if the full step is accepted.
+static bool ocp_nlp_soc_line_search_speculative(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+            ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work, int sqp_iter)
+{
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+
+    ocp_nlp_workspace *nlp_work = work->nlp_work;
+
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+    ocp_qp_out *qp_out = nlp_mem->qp_out;
+    ocp_qp_out *soc_qp_out = mem->soc_qp_out;
+    ocp_qp_in *rhs_bkp = nlp_work->tmp_qp_in;
+
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    acados_timer timer;
+    acados_tic(&timer);
+
+    /* modify/initialize merit function weights, as in ocp_nlp_line_search_merit_check_full_step */
+    if (sqp_iter==0)
+    {
+        merit_backtracking_initialize_weights(dims, nlp_work->weight_merit_fun, qp_out);
+    }
+    else
+    {
+        copy_multipliers_nlp_to_qp(dims, nlp_work->weight_merit_fun, nlp_work->tmp_qp_out);
+        merit_backtracking_update_weights(dims, nlp_work->weight_merit_fun, qp_out);
+    }
+
+    // full step: the SOC QP rhs depends on the function values at x + p
+    for (int i = 0; i <= N; i++)
+        blasfeo_daxpy(nv[i], 1.0, qp_out->ux+i, 0, nlp_out->ux+i, 0, nlp_work->tmp_nlp_out->ux+i, 0);
+    double merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+    double violation_step = ocp_nlp_get_violation_inf_norm(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+
+    // no time left for the SOC QP
+    if (!ocp_nlp_sqp_soc_check_time_budget(config, opts, mem, &timer, sqp_iter))
+    {
+        if (sqp_iter != 0)
+            copy_multipliers_qp_to_nlp(dims, nlp_work->tmp_qp_out, nlp_work->weight_merit_fun);
+        return false;
+    }
+
+    // backup the QP rhs modified by the SOC
+    for (int i = 0; i <= N; i++)
+    {
+        if (i < N)
+            blasfeo_dveccp(nx[i+1], qp_in->b+i, 0, rhs_bkp->b+i, 0);
+        blasfeo_dveccp(2*nb[i]+2*ng[i], qp_in->d+i, 0, rhs_bkp->d+i, 0);
+    }
+    ocp_nlp_soc_update_qp_rhs(config, dims, nlp_mem, nlp_work);
+
+    if (nlp_opts->print_level > 3)
+    {
+        printf("\n\nSQP: SOC ocp_qp_in at iteration %d\n", sqp_iter);
+        print_ocp_qp_in(qp_in);
+    }
+
+    double merit_fun0 = 0.0;
+    double violation_current = 0.0;
+    int qp_status = ACADOS_SUCCESS;
+
+    int max_levels_bkp = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+    #pragma omp parallel sections num_threads(2)
+    {
+        #pragma omp section
+        {
+            // SOC QP, only the rhs differs from the QP solved before; it has its own QP solver memory,
+            // such that the next iteration is warm started from the regular QP also if the SOC is discarded
+            qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, qp_in, soc_qp_out,
+                                nlp_opts->qp_solver_opts, mem->soc_qp_solver_mem, nlp_work->qp_work);
+        }
+        #pragma omp section
+        {
+            // merit function at the current iterate, stages are evaluated by the remaining threads
+            omp_set_num_threads(nlp_opts->num_threads > 2 ? nlp_opts->num_threads-1 : 1);
+            for (int i = 0; i <= N; i++)
+                blasfeo_dveccp(nv[i], nlp_out->ux+i, 0, nlp_work->tmp_nlp_out->ux+i, 0);
+            merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+            violation_current = ocp_nlp_get_violation_inf_norm(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+        }
+    }
+    omp_set_max_active_levels(max_levels_bkp);
+
+    if (nlp_opts->print_level > 0)
+    {
+        printf("\npreliminary line_search: merit0 %e, merit1 %e; viol_current %e, viol_step %e\n", merit_fun0, merit_fun1, violation_current, violation_step);
+    }
+
+    bool nan_detected = isnan(merit_fun1) || isinf(merit_fun1);
+    bool full_step = merit_fun1 < merit_fun0 && violation_step < violation_current;
+    if (nan_detected || full_step)
+    {
+        // discard SOC, restore QP rhs
+        for (int i = 0; i <= N; i++)
+        {
+            if (i < N)
+                blasfeo_dveccp(nx[i+1], rhs_bkp->b+i, 0, qp_in->b+i, 0);
+            blasfeo_dveccp(2*nb[i]+2*ng[i], rhs_bkp->d+i, 0, qp_in->d+i, 0);
+        }
+    }
+    if (nan_detected)
+    {
+        // do line search but no SOC
+        if (sqp_iter != 0)
+            copy_multipliers_qp_to_nlp(dims, nlp_work->tmp_qp_out, nlp_work->weight_merit_fun);
+        return true;
+    }
+    else if (full_step)
+    {
+        mem->alpha = 1.0;
+        return false;
+    }
+
+    // reset merit function weights
+    if (sqp_iter != 0)
+        copy_multipliers_qp_to_nlp(dims, nlp_work->tmp_qp_out, nlp_work->weight_merit_fun);
+
+    if (nlp_mem->time_budget_glob > 0.0 && acados_toc(&timer) >= nlp_mem->time_budget_glob)
+    {
+        // no time left for line search
+        mem->status = ACADOS_TIMEOUT;
+        mem->sqp_iter = sqp_iter;
+        return false;
+    }
+
+    if (nlp_opts->print_level > 0)
+        printf("ocp_nlp_sqp: performing SOC, since prelim. line search returned %d\n\n", ACADOS_MINSTEP);
+
+    d_ocp_qp_sol_copy_all(soc_qp_out, qp_out);
+    *((qp_info *) qp_out->misc) = *((qp_info *) soc_qp_out->misc);
+
+    return ocp_nlp_soc_qp_postprocess(config, dims, opts, mem, work, sqp_iter, qp_status);
+}
+#endif
+
+
+
+static bool ocp_nlp_soc_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+            ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work, int sqp_iter)
+{
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+
+    ocp_nlp_workspace *nlp_work = work->nlp_work;
+
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+    ocp_qp_out *qp_out = nlp_mem->qp_out;
+
+#if defined(ACADOS_WITH_OPENMP)
+    if (opts->soc_speculative && nlp_opts->num_threads > 1)
+        return ocp_nlp_soc_line_search_speculative(config, dims, nlp_in, nlp_out, opts, mem, work, sqp_iter);
+#endif
+
+    acados_timer timer;
+    acados_tic(&timer);
+    // NOTE: following Waechter2006:
+    // Do SOC
+    // 1. if "the first trial step size alpha_k,0 has been rejected and
+    // 2. if the infeasibility would have increased when accepting the previous step
+    // NOTE: the "and" is interpreted as an "or" in the current implementation
+
+    // preliminary line search
+    int line_search_status = ocp_nlp_line_search_merit_check_full_step(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, sqp_iter);
+
+    // return bool do_line_search;
+    if (line_search_status == ACADOS_NAN_DETECTED)
+    {
+        // do line search but no SOC.
+        return true;
+    }
+    else if (line_search_status == ACADOS_SUCCESS)
+    {
+        mem->alpha = 1.0;
+        return false;
+    }
+    // else perform SOC (below)
+
+    // Second Order Correction (SOC): following Nocedal2006: p.557, eq. (18.51) -- (18.56)
+    // Paragraph: APPROACH III: S l1 QP (SEQUENTIAL l1 QUADRATIC PROGRAMMING),
+    // Section 18.8 TRUST-REGION SQP METHODS
+    //   - just no trust region radius here.
+    if (nlp_opts->print_level > 0)
+        printf("ocp_nlp_sqp: performing SOC, since prelim. line search returned %d\n\n", line_search_status);
+
+    /* evaluate constraints & dynamics at new step */
+    // NOTE: setting up the new iterate and evaluating is not needed here,
+    //   since this evaluation was perfomed just before this call in the early terminated line search.
+    ocp_nlp_soc_update_qp_rhs(config, dims, nlp_mem, nlp_work);
+
+    if (nlp_opts->print_level > 3)
+    {
+        printf("\n\nSQP: SOC ocp_qp_in at iteration %d\n", sqp_iter);
+        print_ocp_qp_in(qp_in);
+    }
+
+#if defined(ACADOS_DEBUG_SQP_PRINT_QPS_TO_FILE)
+    ocp_nlp_sqp_dump_qp_in_to_file(qp_in, sqp_iter, 1);
+#endif
+
+    // no time left for the SOC QP
+    if (!ocp_nlp_sqp_soc_check_time_budget(config, opts, mem, &timer, sqp_iter))
+        return false;
+
+    // solve QP
+    // acados_tic(&timer1);
+    int qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, qp_in, qp_out,
+                                    opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem, nlp_work->qp_work);
+    // NOTE: QP is not timed, since this computation time is attributed to globalization.
+
+    return ocp_nlp_soc_qp_postprocess(config, dims, opts, mem, work, sqp_iter, qp_status);
+}
+
+
 static void ocp_nlp_sqp_reset_timers(ocp_nlp_sqp_memory *mem)
 {
     mem->time_qp_sol = 0.0;
@@ -887,6 +1244,103 @@ static void ocp_nlp_sqp_reset_timers(ocp_nlp_sqp_memory *mem)
     mem->time_sim_ad = 0.0;
 }
 
+/************************************************
+ * Hessian reuse
+ ************************************************/
+
+// enables or disables the exact Hessian contributions of the submodules, as configured by the user
+static void ocp_nlp_sqp_set_exact_hess(ocp_nlp_config *config, ocp_nlp_opts *nlp_opts, bool enable)
+{
+    int N = config->N;
+    int value = enable ? 1 : 0;
+
+    // only touch the contributions that are turned on
+    if (nlp_opts->exact_hess_cost)
+    {
+        for (int i = 0; i <= N; i++)
+            config->cost[i]->opts_set(config->cost[i], nlp_opts->cost[i], "exact_hess", &value);
+    }
+    if (nlp_opts->exact_hess_dyn)
+    {
+        for (int i = 0; i < N; i++)
+            config->dynamics[i]->opts_set(config->dynamics[i], nlp_opts->dynamics[i], "compute_hess", &value);
+    }
+    if (nlp_opts->exact_hess_constr)
+    {
+        for (int i = 0; i <= N; i++)
+            config->constraints[i]->opts_set(config->constraints[i], nlp_opts->constraints[i], "compute_hess", &value);
+    }
+}
+
+
+
+// called after the QP matrices are computed: stores the exact Hessian or replaces it by the updated one
+static void ocp_nlp_sqp_hess_reuse(ocp_nlp_dims *dims, ocp_nlp_sqp_opts *opts,
+    ocp_nlp_sqp_memory *mem, bool quasi_newton)
+{
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        int n = nu[i] + nx[i];
+        // gradient of the Lagrangian
+        blasfeo_daxpy(n, -1.0, nlp_mem->ineq_adj+i, 0, nlp_mem->cost_grad+i, 0, mem->hess_qn_grad+i, 0);
+        blasfeo_daxpy(n, -1.0, nlp_mem->dyn_adj+i, 0, mem->hess_qn_grad+i, 0, mem->hess_qn_grad+i, 0);
+
+        if (quasi_newton)
+        {
+            // y = grad - grad_old, stored in grad_old
+            blasfeo_daxpy(n, -1.0, mem->hess_qn_grad_old+i, 0, mem->hess_qn_grad+i, 0, mem->hess_qn_grad_old+i, 0);
+            if (opts->hess_reuse_update == HESS_UPDATE_SR1)
+                ocp_nlp_sr1_update(n, mem->hess_qn+i, mem->hess_qn_step+i, mem->hess_qn_grad_old+i,
+                                   mem->hess_qn_tmp+i);
+            else
+                ocp_nlp_damped_bfgs_update(n, mem->hess_qn+i, mem->hess_qn_step+i, mem->hess_qn_grad_old+i,
+                                           mem->hess_qn_tmp+i);
+            blasfeo_dgecp(n, n, mem->hess_qn+i, 0, 0, nlp_mem->qp_in->RSQrq+i, 0, 0);
+        }
+        else
+        {
+            ocp_nlp_quasi_newton_copy_hess(n, nlp_mem->qp_in->RSQrq+i, mem->hess_qn+i);
+        }
+    }
+
+    if (quasi_newton)
+    {
+        mem->hess_reuse_count++;
+    }
+    else
+    {
+        mem->hess_reuse_count = 0;
+        mem->hess_reuse_exact_next = false;
+    }
+}
+
+
+
+// called before the iterate is updated: stores step and gradient difference for the next update
+static void ocp_nlp_sqp_hess_reuse_store_step(ocp_nlp_dims *dims, ocp_nlp_opts *nlp_opts,
+    ocp_nlp_sqp_memory *mem, double alpha)
+{
+    if (alpha <= 0.0)
+    {
+        mem->hess_reuse_valid = false;
+        return;
+    }
+
+    ocp_nlp_quasi_newton_store_step(dims, nlp_opts, mem->nlp_mem, alpha, mem->hess_qn_grad,
+                                    mem->hess_qn_step, mem->hess_qn_grad_old, mem->hess_qn_tmp);
+    mem->hess_reuse_valid = true;
+}
+
+
+
 static double get_l1_infeasibility(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_sqp_memory *mem)
 {
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
@@ -1423,6 +1877,21 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     mem->funnel_iter_type = '-';
     mem->status = ACADOS_SUCCESS;
 
+    // time budget
+    double time_iter_start = 0.0;
+    double time_limit = 0.0;
+    mem->timeout_time_iter_sum = 0.0;
+    nlp_mem->time_budget_glob = 0.0;
+
+    // Hessian reuse
+    bool hess_reuse = opts->hess_reuse_period > 1;
+    mem->hess_reuse_count = 0;
+    mem->hess_reuse_valid = false;
+    mem->hess_reuse_exact_next = false;
+    ocp_nlp_block_bfgs_reset(dims, nlp_opts, nlp_mem);
+    // reset, may be set from previous call; QP solvers without time limit ignore the option
+    qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "time_limit", &time_limit);
+
 #if defined(ACADOS_WITH_OPENMP)
     // backup number of threads
     int num_threads_bkp = omp_get_num_threads();
@@ -1456,7 +1925,22 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             /* Prepare the QP data */
             // linearize NLP and update QP matrices
             acados_tic(&timer1);
+            bool hess_qn_step = hess_reuse && mem->hess_reuse_valid && !mem->hess_reuse_exact_next &&
+                                mem->hess_reuse_count < opts->hess_reuse_period - 1;
+            if (hess_qn_step)
+            {
+                ocp_nlp_sqp_set_exact_hess(config, nlp_opts, false);
+            }
             ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+            if (hess_qn_step)
+            {
+                ocp_nlp_sqp_set_exact_hess(config, nlp_opts, true);
+            }
+            if (hess_reuse)
+            {
+                ocp_nlp_sqp_hess_reuse(dims, opts, mem, hess_qn_step);
+            }
+            ocp_nlp_block_bfgs_update(dims, nlp_opts, nlp_mem);
             if (nlp_opts->with_adaptive_levenberg_marquardt || nlp_opts->globalization != FIXED_STEP)
             {
                 ocp_nlp_get_cost_value_from_submodules(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
@@ -1482,6 +1966,17 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             ocp_nlp_res_compute(dims, nlp_in, nlp_out, nlp_res, nlp_mem);
             ocp_nlp_res_get_inf_norm(nlp_res, &nlp_out->inf_norm_res);
 
+            // evaluate exact Hessian in next iteration if convergence is slow
+            if (hess_reuse)
+            {
+                if (mem->hess_reuse_count > 0 &&
+                    nlp_out->inf_norm_res > opts->hess_reuse_max_contraction * mem->hess_reuse_res_prev)
+                {
+                    mem->hess_reuse_exact_next = true;
+                }
+                mem->hess_reuse_res_prev = nlp_out->inf_norm_res;
+            }
+
             if (nlp_opts->globalization == FUNNEL_L1PEN_LINESEARCH && sqp_iter == 0)
             {
                 mem->l1_infeasibility = get_l1_infeasibility(config, dims, mem);
@@ -1535,6 +2030,35 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             return mem->status;
         }
 
+        // Time budget: stop if one more iteration is not expected to fit
+        if (opts->timeout_budget > 0.0)
+        {
+            double time_elapsed = acados_toc(&timer0);
+            if (sqp_iter > 0)
+            {
+                mem->timeout_time_iter = time_elapsed - time_iter_start;
+                mem->timeout_time_iter_sum += mem->timeout_time_iter;
+            }
+            time_iter_start = time_elapsed;
+
+            double time_remaining = opts->timeout_budget - time_elapsed;
+            if (time_remaining <= 0.0 ||
+                time_remaining < ocp_nlp_sqp_timeout_predict_time_iter(mem, sqp_iter))
+            {
+#if defined(ACADOS_WITH_OPENMP)
+                // restore number of threads
+                omp_set_num_threads(num_threads_bkp);
+#endif
+                return ocp_nlp_sqp_timeout_exit(opts, mem, sqp_iter, &timer0);
+            }
+
+            // QP gets the remaining time except for the expected rest of the iteration
+            time_limit = time_remaining - (mem->timeout_time_iter - mem->timeout_time_qp);
+            if (time_limit <= 0.0)
+                time_limit = time_remaining;
+            qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "time_limit", &time_limit);
+        }
+
 
         /* solve QP */
         // (typically) no warm start at first iteration
@@ -1554,11 +2078,18 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 #if defined(ACADOS_DEBUG_SQP_PRINT_QPS_TO_FILE)
         ocp_nlp_sqp_dump_qp_in_to_file(qp_in, sqp_iter, 0);
 #endif
+        // skip condensing and factorization of unchanged QP matrices
+        if (nlp_opts->reuse_qp_fact)
+        {
+            ocp_nlp_qp_lhs_update(dims, nlp_opts, nlp_mem);
+            qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "lhs_unchanged", &nlp_mem->qp_lhs_unchanged);
+        }
         // solve qp
         acados_tic(&timer1);
         qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, qp_in, qp_out,
                                         nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem, nlp_work->qp_work);
-        mem->time_qp_sol += acados_toc(&timer1);
+        mem->timeout_time_qp = acados_toc(&timer1);
+        mem->time_qp_sol += mem->timeout_time_qp;
 
         qp_solver->memory_get(qp_solver, nlp_mem->qp_solver_mem, "time_qp_solver_call", &tmp_time);
         mem->time_qp_solver_call += tmp_time;
@@ -1577,6 +2108,12 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             config->qp_solver->opts_set(config->qp_solver, nlp_opts->qp_solver_opts,
                                         "warm_start", &opts->qp_warm_start);
         }
+        // QPs solved elsewhere, e.g. the SOC QP, are always condensed and factorized
+        if (nlp_opts->reuse_qp_fact)
+        {
+            int tmp_int = 0;
+            qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "lhs_unchanged", &tmp_int);
+        }
 
         if (nlp_opts->print_level > 3)
         {
@@ -1658,6 +2195,18 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         /* end solve QP */
 
         /* globalization */
+        if (opts->timeout_budget > 0.0)
+        {
+            nlp_mem->time_budget_glob = opts->timeout_budget - acados_toc(&timer0);
+            if (nlp_mem->time_budget_glob <= 0.0)
+            {
+#if defined(ACADOS_WITH_OPENMP)
+                // restore number of threads
+                omp_set_num_threads(num_threads_bkp);
+#endif
+                return ocp_nlp_sqp_timeout_exit(opts, mem, sqp_iter, &timer0);
+            }
+        }
         // NOTE on timings: currently all within globalization is accounted for within time_glob.
         //   QP solver times could be also attributed there alternatively. Cleanest would be to save them seperately.
         acados_tic(&timer1);
@@ -1671,6 +2220,9 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 // in case line search fails, we do not want to copy trial iterates!
                 copy_ocp_nlp_out(dims, work->nlp_work->tmp_nlp_out, nlp_out);
             }
+            // Hessian reuse and block BFGS not supported with funnel: restart from the submodule Hessian
+            mem->hess_reuse_valid = false;
+            nlp_mem->block_bfgs_valid = false;
             mem->time_glob += acados_toc(&timer1);
         }
         else
@@ -1679,7 +2231,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             if (nlp_opts->globalization_use_SOC && nlp_opts->globalization == MERIT_BACKTRACKING)
             {
                 do_line_search = ocp_nlp_soc_line_search(config, dims, nlp_in, nlp_out, opts, mem, work, sqp_iter);
-                if (mem->status == ACADOS_QP_FAILURE)
+                if (mem->status == ACADOS_QP_FAILURE || mem->status == ACADOS_TIMEOUT)
                 {
 #if defined(ACADOS_WITH_OPENMP)
                     // restore number of threads
@@ -1693,16 +2245,35 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             if (do_line_search)
             {
                 int line_search_status;
+                if (opts->timeout_budget > 0.0)
+                {
+                    nlp_mem->time_budget_glob = opts->timeout_budget - acados_toc(&timer0);
+                }
                 line_search_status = ocp_nlp_line_search(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, sqp_iter, &mem->alpha);
                 if (line_search_status == ACADOS_NAN_DETECTED)
                 {
                     mem->status = ACADOS_NAN_DETECTED;
                     return mem->status;
                 }
+                if (line_search_status == ACADOS_TIMEOUT)
+                {
+#if defined(ACADOS_WITH_OPENMP)
+                    // restore number of threads
+                    omp_set_num_threads(num_threads_bkp);
+#endif
+                    mem->time_glob += acados_toc(&timer1);
+                    return ocp_nlp_sqp_timeout_exit(opts, mem, sqp_iter, &timer0);
+                }
             }
             mem->time_glob += acados_toc(&timer1);
             mem->stat[mem->stat_n*(sqp_iter+1)+6] = mem->alpha;
 
+            if (hess_reuse)
+            {
+                ocp_nlp_sqp_hess_reuse_store_step(dims, nlp_opts, mem, mem->alpha);
+            }
+            ocp_nlp_block_bfgs_store_step(dims, nlp_opts, nlp_mem, mem->alpha);
+
             // update variables
             ocp_nlp_update_variables_sqp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, nlp_out, mem->alpha);
         }
@@ -1767,6 +2338,25 @@ void ocp_nlp_sqp_memory_reset_qp_solver(void *config_, void *dims_, void *nlp_in
     config->qp_solver->memory_reset(qp_solver, dims->qp_solver,
         nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
         nlp_mem->qp_solver_mem, nlp_work->qp_work);
+    if (mem->soc_qp_solver_mem != NULL)
+        config->qp_solver->memory_reset(qp_solver, dims->qp_solver,
+            nlp_mem->qp_in, mem->soc_qp_out, opts->nlp_opts->qp_solver_opts,
+            mem->soc_qp_solver_mem, nlp_work->qp_work);
+}
+
+void ocp_nlp_sqp_memory_reset_qp_warm_start(void *config_, void *dims_, void *opts_, void *mem_)
+{
+    ocp_nlp_config *config = config_;
+    ocp_nlp_sqp_opts *opts = opts_;
+    ocp_nlp_sqp_memory *mem = mem_;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    ocp_qp_out_set_zero(nlp_mem->qp_out);
+    config->qp_solver->memory_reset_warm_start(config->qp_solver,
+        opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem);
+    if (mem->soc_qp_solver_mem != NULL)
+        config->qp_solver->memory_reset_warm_start(config->qp_solver,
+            opts->nlp_opts->qp_solver_opts, mem->soc_qp_solver_mem);
 }
 
 
@@ -1783,6 +2373,12 @@ int ocp_nlp_sqp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_
 
     nlp_mem->workspace_size = ocp_nlp_workspace_calculate_size(config, dims, opts->nlp_opts);
 
+    if (opts->nlp_opts->hess_approx == HESS_APPROX_BLOCK_BFGS && opts->hess_reuse_period > 1)
+    {
+        printf("\nerror: ocp_nlp_sqp_precompute: hess_reuse_period > 1 not supported with block BFGS Hessian approximation.\n");
+        exit(1);
+    }
+
     ocp_nlp_sqp_workspace *work = work_;
     ocp_nlp_sqp_cast_workspace(config, dims, opts, mem, work);
     ocp_nlp_workspace *nlp_work = work->nlp_work;
@@ -2004,6 +2600,12 @@ void ocp_nlp_sqp_get(void *config_, void *dims_, void *mem_, const char *field,
         config->qp_solver->memory_get(config->qp_solver,
             mem->nlp_mem->qp_solver_mem, "iter", return_value_);
     }
+    else if (!strcmp("qp_stat", field) || !strcmp("qp_stat_m", field) || !strcmp("qp_stat_n", field))
+    {
+        // per-iteration statistics of the last QP solve, QP solver option log_stat
+        config->qp_solver->memory_get(config->qp_solver,
+            mem->nlp_mem->qp_solver_mem, field + 3, return_value_);
+    }
     else if (!strcmp("qp_status", field))
     {
         config->qp_solver->memory_get(config->qp_solver,
@@ -2089,6 +2691,8 @@ void ocp_nlp_sqp_terminate(void *config_, void *mem_, void *work_)
     ocp_nlp_sqp_workspace *work = work_;
 
     config->qp_solver->terminate(config->qp_solver, mem->nlp_mem->qp_solver_mem, work->nlp_work->qp_work);
+    if (mem->soc_qp_solver_mem != NULL)
+        config->qp_solver->terminate(config->qp_solver, mem->soc_qp_solver_mem, work->nlp_work->qp_work);
 }
 
 
@@ -2107,6 +2711,7 @@ void ocp_nlp_sqp_config_initialize_default(void *config_)
     config->workspace_calculate_size = &ocp_nlp_sqp_workspace_calculate_size;
     config->evaluate = &ocp_nlp_sqp;
     config->memory_reset_qp_solver = &ocp_nlp_sqp_memory_reset_qp_solver;
+    config->memory_reset_qp_warm_start = &ocp_nlp_sqp_memory_reset_qp_warm_start;
     config->eval_param_sens = &ocp_nlp_sqp_eval_param_sens;
     config->eval_lagr_grad_p = &ocp_nlp_sqp_eval_lagr_grad_p;
     config->config_initialize_default = &ocp_nlp_sqp_config_initialize_default;
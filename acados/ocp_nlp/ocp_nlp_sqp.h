@@ -53,6 +53,13 @@ extern "C" {
  * options
  ************************************************/
 
+// quasi-Newton update of reused Hessian blocks
+typedef enum
+{
+    HESS_UPDATE_DAMPED_BFGS,
+    HESS_UPDATE_SR1,
+} ocp_nlp_sqp_hess_update_t;
+
 typedef struct
 {
     ocp_nlp_opts *nlp_opts;
@@ -69,6 +76,16 @@ typedef struct
     bool warm_start_first_qp; // to set qp_warm_start in first iteration
     int rti_phase;       // only phase 0 at the moment
     bool eval_residual_at_max_iter; // if convergence should be checked after last iterations or only throw max_iter reached
+    double timeout_budget; // time budget per call in seconds, exceeding it returns the last accepted iterate; <= 0: no limit
+
+    // Hessian reuse: evaluate exact Hessians only every hess_reuse_period iterations, quasi-Newton updates in between
+    int hess_reuse_period; // <= 1: Hessian is evaluated in every iteration
+    ocp_nlp_sqp_hess_update_t hess_reuse_update;
+    double hess_reuse_max_contraction; // evaluate exact Hessian next if KKT residual contracts by less than this factor
+
+    // solve the second-order correction QP concurrently with the merit evaluation at the current iterate (OpenMP only),
+    // in a separate QP solver memory
+    bool soc_speculative;
 
     // Funnel globalization related options
     double funnel_initialization_increase_factor; // for multiplication with initial infeasibility
@@ -132,6 +149,26 @@ typedef struct
 
     double step_norm;
 
+    // timing history for timeout_budget
+    double timeout_time_iter;    // duration of the last SQP iteration
+    double timeout_time_qp;      // duration of the QP solution in the last SQP iteration
+    double timeout_time_iter_sum; // sum of iteration durations in the current call
+
+    // Hessian reuse, stage-wise on the nu+nx block of RSQrq
+    struct blasfeo_dmat *hess_qn;         // reused Hessian, without Levenberg-Marquardt term
+    struct blasfeo_dvec *hess_qn_step;    // last primal step
+    struct blasfeo_dvec *hess_qn_grad;    // gradient of the Lagrangian at the current iterate
+    struct blasfeo_dvec *hess_qn_grad_old; // gradient of the Lagrangian at the previous iterate, new multipliers
+    struct blasfeo_dvec *hess_qn_tmp;
+    int hess_reuse_count;   // quasi-Newton iterations since last exact Hessian
+    bool hess_reuse_valid;  // step and gradient of the previous iteration are available
+    bool hess_reuse_exact_next;
+    double hess_reuse_res_prev;
+
+    // second-order correction QP solution and QP solver memory of the speculative line search
+    ocp_qp_out *soc_qp_out;
+    ocp_qp_xcond_solver_memory *soc_qp_solver_mem;
+
     double funnel_width;
     char funnel_iter_type;
     bool funnel_penalty_mode;
@@ -147,6 +184,8 @@ void *ocp_nlp_sqp_memory_assign(void *config, void *dims, void *opts_, void *raw
 //
 void ocp_nlp_sqp_memory_reset_qp_solver(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     void *opts_, void *mem_, void *work_);
+//
+void ocp_nlp_sqp_memory_reset_qp_warm_start(void *config_, void *dims_, void *opts_, void *mem_);
 
 
 /************************************************
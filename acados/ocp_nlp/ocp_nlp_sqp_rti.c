@@ -40,6 +40,9 @@
 #if defined(ACADOS_WITH_OPENMP)
 #include <omp.h>
 #endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 // blasfeo
 #include "blasfeo/include/blasfeo_d_aux.h"
@@ -119,6 +122,7 @@ void ocp_nlp_sqp_rti_opts_initialize_default(void *config_,
     opts->as_rti_advancement_strategy = SIMULATE_ADVANCE;
     opts->as_rti_iter = 0;
     opts->rti_log_residuals = 0;
+    opts->rti_pipelining = 0;
 
     return;
 }
@@ -207,6 +211,11 @@ void ocp_nlp_sqp_rti_opts_set(void *config_, void *opts_,
             int* rti_log_residuals = (int *) value;
             opts->rti_log_residuals = *rti_log_residuals;
         }
+        else if (!strcmp(field, "rti_pipelining"))
+        {
+            int* rti_pipelining = (int *) value;
+            opts->rti_pipelining = *rti_pipelining;
+        }
         else if (!strcmp(field, "as_rti_level"))
         {
             int* as_rti_level = (int *) value;
@@ -269,6 +278,14 @@ acados_size_t ocp_nlp_sqp_rti_memory_calculate_size(void *config_,
         stat_n += 4;  // qp_res
     size += stat_n*stat_m*sizeof(double);
 
+    if (opts->rti_pipelining)
+    {
+        // second nlp mem
+        size += ocp_nlp_memory_calculate_size(config, dims, nlp_opts);
+        // linearization points and staging
+        size += 3 * ocp_nlp_out_calculate_size(config, dims);
+    }
+
     size += 8;  // initial align
 
     make_int_multiple_of(8, &size);
@@ -313,6 +330,31 @@ void *ocp_nlp_sqp_rti_memory_assign(void *config_, void *dims_,
         mem->stat[i] = 0.0;
     }
 
+    // pipelined RTI
+    mem->pipeline_nlp_mem[0] = mem->nlp_mem;
+    mem->pipeline_nlp_mem[1] = NULL;
+    mem->pipeline_lin_point[0] = NULL;
+    mem->pipeline_lin_point[1] = NULL;
+    mem->pipeline_staging = NULL;
+    if (opts->rti_pipelining)
+    {
+        mem->pipeline_nlp_mem[1] = ocp_nlp_memory_assign(config, dims, nlp_opts, c_ptr);
+        c_ptr += ocp_nlp_memory_calculate_size(config, dims, nlp_opts);
+
+        for (int i=0; i<2; i++)
+        {
+            mem->pipeline_lin_point[i] = ocp_nlp_out_assign(config, dims, c_ptr);
+            c_ptr += ocp_nlp_out_calculate_size(config, dims);
+        }
+        mem->pipeline_staging = ocp_nlp_out_assign(config, dims, c_ptr);
+        c_ptr += ocp_nlp_out_calculate_size(config, dims);
+    }
+    mem->pipeline_front = 0;
+    mem->pipeline_back_state = RTI_PIPELINE_IDLE;
+    mem->pipeline_staging_state = RTI_PIPELINE_IDLE;
+    mem->pipeline_front_prepared = false;
+    mem->pipeline_staging_valid = false;
+
     mem->status = ACADOS_READY;
     mem->is_first_call = true;
 
@@ -352,6 +394,12 @@ acados_size_t ocp_nlp_sqp_rti_workspace_calculate_size(void *config_,
         size += ocp_qp_res_workspace_calculate_size(dims->qp_solver->orig_dims);
     }
 
+    if (opts->rti_pipelining)
+    {
+        // nlp workspace of second buffer
+        size += ocp_nlp_workspace_calculate_size(config, dims, nlp_opts);
+    }
+
     return size;
 }
 
@@ -362,7 +410,7 @@ static void ocp_nlp_sqp_rti_cast_workspace(
     ocp_nlp_sqp_rti_memory *mem, ocp_nlp_sqp_rti_workspace *work)
 {
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
-    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_nlp_memory *nlp_mem = mem->pipeline_nlp_mem[0];
 
     // sqp
     char *c_ptr = (char *) work;
@@ -386,6 +434,15 @@ static void ocp_nlp_sqp_rti_cast_workspace(
             dims->qp_solver->orig_dims);
     }
 
+    work->pipeline_nlp_work[0] = work->nlp_work;
+    work->pipeline_nlp_work[1] = NULL;
+    if (opts->rti_pipelining)
+    {
+        work->pipeline_nlp_work[1] = ocp_nlp_workspace_assign(
+            config, dims, nlp_opts, mem->pipeline_nlp_mem[1], c_ptr);
+        c_ptr += ocp_nlp_workspace_calculate_size(config, dims, nlp_opts);
+    }
+
     assert((char *) work + ocp_nlp_sqp_rti_workspace_calculate_size(config,
         dims, opts) >= c_ptr);
 
@@ -492,6 +549,15 @@ static void prepare_full_residual_computation(ocp_nlp_config *config,
  * functions
  ************************************************/
 
+// reuse of unchanged QP matrices is restricted to standard RTI,
+// the AS-RTI variants solve additional QPs with other matrices in between
+static bool ocp_nlp_sqp_rti_reuse_qp_fact(ocp_nlp_sqp_rti_opts *opts)
+{
+    return opts->nlp_opts->reuse_qp_fact && opts->as_rti_level == STANDARD_RTI;
+}
+
+
+
 static void ocp_nlp_sqp_rti_preparation_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
     ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem, ocp_nlp_sqp_rti_workspace *work)
 {
@@ -528,11 +594,16 @@ static void ocp_nlp_sqp_rti_preparation_step(ocp_nlp_config *config, ocp_nlp_dim
         config->regularize->regularize_lhs(config->regularize,
             dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
         mem->time_reg += acados_toc(&timer1);
-        // condense lhs
+        // condense lhs, skipped if the QP matrices are unchanged
         acados_tic(&timer1);
-        qp_solver->condense_lhs(qp_solver, dims->qp_solver,
-            nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
-            nlp_mem->qp_solver_mem, nlp_work->qp_work);
+        if (ocp_nlp_sqp_rti_reuse_qp_fact(opts))
+            ocp_nlp_qp_lhs_update(dims, nlp_opts, nlp_mem);
+        if (!nlp_mem->qp_lhs_unchanged)
+        {
+            qp_solver->condense_lhs(qp_solver, dims->qp_solver,
+                nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
+                nlp_mem->qp_solver_mem, nlp_work->qp_work);
+        }
         mem->time_qp_sol += acados_toc(&timer1);
     }
 #if defined(ACADOS_WITH_OPENMP)
@@ -558,10 +629,20 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     int qp_status, line_search_status;
     double tmp_time;
 
+    // with pipelining, the QP was linearized at the linearization point of the front buffer
+    // and its left hand side is always prepared by a separate preparation phase
+    ocp_nlp_out *lin_point = nlp_out;
+    rti_phase_t rti_phase = opts->rti_phase;
+    if (opts->rti_pipelining)
+    {
+        lin_point = mem->pipeline_lin_point[mem->pipeline_front];
+        rti_phase = FEEDBACK;
+    }
+
     // update QP rhs for SQP (step prim var, abs dual var)
     acados_tic(&timer1);
     ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
-        nlp_out, nlp_opts, nlp_mem, nlp_work);
+        lin_point, nlp_opts, nlp_mem, nlp_work);
     mem->time_lin += acados_toc(&timer1);
 
     if (opts->rti_log_residuals)
@@ -573,17 +654,19 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
 
     // regularization
     acados_tic(&timer1);
-    if (opts->rti_phase == FEEDBACK)
+    if (rti_phase == FEEDBACK)
     {
         // finish regularization
         config->regularize->regularize_rhs(config->regularize,
             dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
     }
-    else if (opts->rti_phase == PREPARATION_AND_FEEDBACK)
+    else if (rti_phase == PREPARATION_AND_FEEDBACK)
     {
         // full regularization
         config->regularize->regularize(config->regularize,
             dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        if (ocp_nlp_sqp_rti_reuse_qp_fact(opts))
+            ocp_nlp_qp_lhs_update(dims, nlp_opts, nlp_mem);
     }
     else
     {
@@ -596,22 +679,29 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
         print_ocp_qp_in(nlp_mem->qp_in);
     }
 
-    if (!opts->warm_start_first_qp)
+    // NOTE: with pipelining, this is done once in precompute, as both buffers share the QP opts
+    if (!opts->warm_start_first_qp && !opts->rti_pipelining)
     {
         int tmp_int = 0;
         config->qp_solver->opts_set(config->qp_solver,
             opts->nlp_opts->qp_solver_opts, "warm_start", &tmp_int);
     }
 
+    // skip the factorization (and condensing) of unchanged QP matrices
+    if (ocp_nlp_sqp_rti_reuse_qp_fact(opts))
+    {
+        qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "lhs_unchanged", &nlp_mem->qp_lhs_unchanged);
+    }
+
     // solve QP
     acados_tic(&timer1);
-    if (opts->rti_phase == FEEDBACK)
+    if (rti_phase == FEEDBACK)
     {
         qp_status = qp_solver->condense_rhs_and_solve(qp_solver, dims->qp_solver,
             nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
             nlp_mem->qp_solver_mem, nlp_work->qp_work);
     }
-    else if (opts->rti_phase == PREPARATION_AND_FEEDBACK)
+    else if (rti_phase == PREPARATION_AND_FEEDBACK)
     {
         qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver,
             nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
@@ -619,6 +709,11 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     }
     // add qp timings
     mem->time_qp_sol += acados_toc(&timer1);
+    if (ocp_nlp_sqp_rti_reuse_qp_fact(opts))
+    {
+        int tmp_int = 0;
+        qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "lhs_unchanged", &tmp_int);
+    }
     // NOTE: timings within qp solver are added internally (lhs+rhs)
     qp_solver->memory_get(qp_solver, nlp_mem->qp_solver_mem, "time_qp_solver_call", &tmp_time);
     mem->time_qp_solver_call += tmp_time;
@@ -669,7 +764,7 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     // globalization
     acados_tic(&timer1);
     // TODO: not clear if line search should be called with sqp_iter==0 in RTI;
-    line_search_status = ocp_nlp_line_search(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, 1, &alpha);
+    line_search_status = ocp_nlp_line_search(config, dims, nlp_in, lin_point, nlp_opts, nlp_mem, nlp_work, 1, &alpha);
     mem->time_glob += acados_toc(&timer1);
     if (line_search_status == ACADOS_NAN_DETECTED)
     {
@@ -678,7 +773,7 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     }
 
     // update variables
-    ocp_nlp_update_variables_sqp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, nlp_out, alpha);
+    ocp_nlp_update_variables_sqp(config, dims, nlp_in, lin_point, nlp_opts, nlp_mem, nlp_work, nlp_out, alpha);
     mem->status = ACADOS_SUCCESS;
 
     if (opts->rti_log_residuals)
@@ -1226,6 +1321,252 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
 }
 
 
+/***************************
+ * pipelined RTI functionality
+****************************/
+
+// The buffer states guard the buffers: a successful compare-and-swap acquires, i.e. the
+// buffer writes of the previous owner are visible afterwards, and releasing a buffer via
+// rti_pipeline_release orders all writes to it before the state change.
+static bool rti_pipeline_compare_and_swap(volatile long *state, long expected, long desired)
+{
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchange(state, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(state, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+
+static void rti_pipeline_release(volatile long *state, long desired)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchange(state, desired);
+#else
+    __atomic_store_n(state, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+
+
+static void rti_pipeline_sanity_checks(ocp_nlp_sqp_rti_opts *opts)
+{
+    if (opts->as_rti_level != STANDARD_RTI)
+    {
+        printf("ocp_nlp_sqp_rti: rti_pipelining not supported with AS-RTI (opts->as_rti_level != STANDARD_RTI).\n\n");
+        exit(1);
+    }
+    if (opts->rti_log_residuals)
+    {
+        printf("ocp_nlp_sqp_rti: rti_pipelining not supported with rti_log_residuals.\n\n");
+        exit(1);
+    }
+    if (opts->nlp_opts->globalization != FIXED_STEP)
+    {
+        printf("ocp_nlp_sqp_rti: rti_pipelining only supported with globalization FIXED_STEP.\n\n");
+        exit(1);
+    }
+}
+
+
+
+static void rti_pipeline_reset(ocp_nlp_sqp_rti_memory *mem)
+{
+    mem->pipeline_front_prepared = false;
+    mem->pipeline_staging_valid = false;
+    rti_pipeline_release(&mem->pipeline_back_state, RTI_PIPELINE_IDLE);
+    rti_pipeline_release(&mem->pipeline_staging_state, RTI_PIPELINE_IDLE);
+}
+
+
+
+// linearizes the NLP at the latest feedback result into the back buffer;
+// only touches the back buffer, the staging iterate and mem->time_preparation
+static void ocp_nlp_sqp_rti_pipelined_preparation_step(ocp_nlp_config *config, ocp_nlp_dims *dims,
+    ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem,
+    ocp_nlp_sqp_rti_workspace *work)
+{
+    acados_timer timer;
+    acados_tic(&timer);
+
+    // claim back buffer; nothing to do if it holds a QP that was not consumed yet
+    if (!rti_pipeline_compare_and_swap(&mem->pipeline_back_state, RTI_PIPELINE_IDLE, RTI_PIPELINE_BUSY))
+        return;
+
+    int back = 1 - mem->pipeline_front;
+    ocp_nlp_memory *nlp_mem = mem->pipeline_nlp_mem[back];
+    ocp_nlp_workspace *nlp_work = work->pipeline_nlp_work[back];
+    ocp_nlp_out *lin_point = mem->pipeline_lin_point[back];
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+
+    // fetch linearization point: latest feedback result if available, initial guess otherwise
+    while (!rti_pipeline_compare_and_swap(&mem->pipeline_staging_state, RTI_PIPELINE_IDLE, RTI_PIPELINE_BUSY))
+        ;
+    if (!mem->pipeline_staging_valid)
+    {
+        copy_ocp_nlp_out(dims, nlp_out, mem->pipeline_staging);
+        mem->pipeline_staging_valid = true;
+    }
+    copy_ocp_nlp_out(dims, mem->pipeline_staging, lin_point);
+    rti_pipeline_release(&mem->pipeline_staging_state, RTI_PIPELINE_IDLE);
+
+    // prepare submodules
+    ocp_nlp_initialize_submodules(config, dims, nlp_in, lin_point, nlp_opts, nlp_mem, nlp_work);
+
+    // linearize NLP and update QP matrices
+    ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, lin_point, nlp_opts, nlp_mem, nlp_work);
+    ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, lin_point, nlp_opts, nlp_mem, nlp_work, 1.0, 0);
+
+    // regularize Hessian
+    config->regularize->regularize_lhs(config->regularize,
+        dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
+
+    // condense lhs, skipped if the QP matrices of this buffer are unchanged
+    if (ocp_nlp_sqp_rti_reuse_qp_fact(opts))
+        ocp_nlp_qp_lhs_update(dims, nlp_opts, nlp_mem);
+    if (!nlp_mem->qp_lhs_unchanged)
+    {
+        qp_solver->condense_lhs(qp_solver, dims->qp_solver,
+            nlp_mem->qp_in, nlp_mem->qp_out, nlp_opts->qp_solver_opts,
+            nlp_mem->qp_solver_mem, nlp_work->qp_work);
+    }
+
+    mem->time_preparation = acados_toc(&timer);
+
+    // publish back buffer
+    rti_pipeline_release(&mem->pipeline_back_state, RTI_PIPELINE_READY);
+}
+
+
+
+static void ocp_nlp_sqp_rti_pipelined_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *dims,
+    ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem,
+    ocp_nlp_sqp_rti_workspace *work)
+{
+    acados_timer timer;
+    acados_tic(&timer);
+
+    // swap buffers if a new QP has been prepared
+    if (rti_pipeline_compare_and_swap(&mem->pipeline_back_state, RTI_PIPELINE_READY, RTI_PIPELINE_BUSY))
+    {
+        mem->pipeline_front = 1 - mem->pipeline_front;
+        mem->nlp_mem = mem->pipeline_nlp_mem[mem->pipeline_front];
+        work->nlp_work = work->pipeline_nlp_work[mem->pipeline_front];
+        mem->pipeline_front_prepared = true;
+        rti_pipeline_release(&mem->pipeline_back_state, RTI_PIPELINE_IDLE);
+    }
+
+    if (!mem->pipeline_front_prepared)
+    {
+#ifndef ACADOS_SILENT
+        printf("\nSQP_RTI: pipelined feedback called before any preparation phase was completed.\n");
+#endif
+        mem->status = ACADOS_READY;
+        return;
+    }
+
+    reset_stats_and_sub_timers(mem);
+    ocp_nlp_sqp_rti_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+
+    // pass iterate on to the next preparation, unless it is currently reading it
+    if (rti_pipeline_compare_and_swap(&mem->pipeline_staging_state, RTI_PIPELINE_IDLE, RTI_PIPELINE_BUSY))
+    {
+        copy_ocp_nlp_out(dims, nlp_out, mem->pipeline_staging);
+        mem->pipeline_staging_valid = true;
+        rti_pipeline_release(&mem->pipeline_staging_state, RTI_PIPELINE_IDLE);
+    }
+
+    mem->time_feedback = acados_toc(&timer);
+}
+
+
+
+int ocp_nlp_sqp_rti_pipelined_preparation(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
+    void *opts_, void *mem_, void *work_)
+{
+    ocp_nlp_sqp_rti_opts *opts = opts_;
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    if (!opts->rti_pipelining)
+    {
+        printf("ocp_nlp_sqp_rti_pipelined_preparation: option rti_pipelining must be set before creating the solver.\n");
+        exit(1);
+    }
+
+    ocp_nlp_sqp_rti_pipelined_preparation_step(config_, dims_, nlp_in_, nlp_out_, opts, mem, work_);
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+int ocp_nlp_sqp_rti_pipelined_feedback(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
+    void *opts_, void *mem_, void *work_)
+{
+    ocp_nlp_sqp_rti_opts *opts = opts_;
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    if (!opts->rti_pipelining)
+    {
+        printf("ocp_nlp_sqp_rti_pipelined_feedback: option rti_pipelining must be set before creating the solver.\n");
+        exit(1);
+    }
+
+    ocp_nlp_sqp_rti_pipelined_feedback_step(config_, dims_, nlp_in_, nlp_out_, opts, mem, work_);
+    mem->time_tot = mem->time_feedback;
+
+    return mem->status;
+}
+
+
+
+static int ocp_nlp_sqp_rti_pipelined(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+    ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem,
+    ocp_nlp_sqp_rti_workspace *work)
+{
+    acados_timer timer;
+    acados_tic(&timer);
+
+    if (opts->rti_phase == PREPARATION)
+    {
+        ocp_nlp_sqp_rti_pipelined_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+    }
+    else if (opts->rti_phase == FEEDBACK)
+    {
+        ocp_nlp_sqp_rti_pipelined_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+    }
+    else if (!mem->pipeline_front_prepared)
+    {
+        // first call: nothing to overlap with yet
+        ocp_nlp_sqp_rti_pipelined_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+        ocp_nlp_sqp_rti_pipelined_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+    }
+    else
+    {
+        // feedback on the prepared QP, overlapped with preparing the next one
+#if defined(ACADOS_WITH_OPENMP)
+        #pragma omp parallel sections num_threads(2)
+        {
+            #pragma omp section
+            ocp_nlp_sqp_rti_pipelined_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+            #pragma omp section
+            ocp_nlp_sqp_rti_pipelined_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+        }
+#else
+        ocp_nlp_sqp_rti_pipelined_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+        ocp_nlp_sqp_rti_pipelined_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
+#endif
+    }
+    mem->time_tot = acados_toc(&timer);
+
+    return mem->status;
+}
+
+
+
 int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     void *opts_, void *mem_, void *work_)
 {
@@ -1241,6 +1582,9 @@ int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     ocp_nlp_sqp_rti_workspace *work = work_;
     // ocp_nlp_sqp_rti_cast_workspace(config, dims, opts, mem, work);
 
+    if (opts->rti_pipelining)
+        return ocp_nlp_sqp_rti_pipelined(config, dims, nlp_in, nlp_out, opts, mem, work);
+
     int rti_phase = opts->rti_phase;
 
     if (rti_phase == FEEDBACK)
@@ -1298,6 +1642,44 @@ void ocp_nlp_sqp_rti_memory_reset_qp_solver(void *config_, void *dims_, void *nl
     config->qp_solver->memory_reset(qp_solver, dims->qp_solver,
         nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
         nlp_mem->qp_solver_mem, nlp_work->qp_work);
+
+    if (opts->rti_pipelining)
+    {
+        // reset other buffer and invalidate prepared QPs
+        int back = 1 - mem->pipeline_front;
+        nlp_mem = mem->pipeline_nlp_mem[back];
+        nlp_work = work->pipeline_nlp_work[back];
+        config->qp_solver->memory_reset(qp_solver, dims->qp_solver,
+            nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
+            nlp_mem->qp_solver_mem, nlp_work->qp_work);
+        rti_pipeline_reset(mem);
+    }
+}
+
+
+
+void ocp_nlp_sqp_rti_memory_reset_qp_warm_start(void *config_, void *dims_, void *opts_, void *mem_)
+{
+    ocp_nlp_config *config = config_;
+    ocp_nlp_sqp_rti_opts *opts = opts_;
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    mem->is_first_call = true;
+
+    ocp_qp_out_set_zero(nlp_mem->qp_out);
+    config->qp_solver->memory_reset_warm_start(config->qp_solver,
+        opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem);
+
+    if (opts->rti_pipelining)
+    {
+        // other buffer, invalidate prepared QPs
+        nlp_mem = mem->pipeline_nlp_mem[1 - mem->pipeline_front];
+        ocp_qp_out_set_zero(nlp_mem->qp_out);
+        config->qp_solver->memory_reset_warm_start(config->qp_solver,
+            opts->nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem);
+        rti_pipeline_reset(mem);
+    }
 }
 
 
@@ -1314,11 +1696,45 @@ int ocp_nlp_sqp_rti_precompute(void *config_, void *dims_, void *nlp_in_,
 
     nlp_mem->workspace_size = ocp_nlp_workspace_calculate_size(config, dims, opts->nlp_opts);
 
+    if (opts->nlp_opts->hess_approx != HESS_APPROX_SUBMODULES)
+    {
+        printf("\nerror: ocp_nlp_sqp_rti_precompute: block BFGS Hessian approximation only supported with SQP.\n");
+        exit(1);
+    }
+
     ocp_nlp_sqp_rti_workspace *work = work_;
     ocp_nlp_sqp_rti_cast_workspace(config, dims, opts, mem, work);
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
-    return ocp_nlp_precompute_common(config, dims, nlp_in, nlp_out, opts->nlp_opts, nlp_mem, nlp_work);
+    if (!opts->rti_pipelining)
+        return ocp_nlp_precompute_common(config, dims, nlp_in, nlp_out, opts->nlp_opts, nlp_mem, nlp_work);
+
+    rti_pipeline_sanity_checks(opts);
+
+    // each buffer is linearized at its own copy of the iterate
+    mem->pipeline_front = 0;
+    mem->nlp_mem = mem->pipeline_nlp_mem[0];
+    work->nlp_work = work->pipeline_nlp_work[0];
+    int status = ACADOS_SUCCESS;
+    for (int i = 0; i < 2; i++)
+    {
+        mem->pipeline_nlp_mem[i]->workspace_size = nlp_mem->workspace_size;
+        copy_ocp_nlp_out(dims, nlp_out, mem->pipeline_lin_point[i]);
+        status = ocp_nlp_precompute_common(config, dims, nlp_in, mem->pipeline_lin_point[i],
+            opts->nlp_opts, mem->pipeline_nlp_mem[i], work->pipeline_nlp_work[i]);
+        if (status != ACADOS_SUCCESS)
+            return status;
+    }
+    rti_pipeline_reset(mem);
+
+    if (!opts->warm_start_first_qp)
+    {
+        int tmp_int = 0;
+        config->qp_solver->opts_set(config->qp_solver,
+            opts->nlp_opts->qp_solver_opts, "warm_start", &tmp_int);
+    }
+
+    return status;
 }
 
 
@@ -1516,6 +1932,18 @@ void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
         config->qp_solver->memory_get(config->qp_solver,
             mem->nlp_mem->qp_solver_mem, "iter", return_value_);
     }
+    else if (!strcmp("qp_stat", field) || !strcmp("qp_stat_m", field) || !strcmp("qp_stat_n", field))
+    {
+        // per-iteration statistics of the last QP solve, QP solver option log_stat
+        config->qp_solver->memory_get(config->qp_solver,
+            mem->nlp_mem->qp_solver_mem, field + 3, return_value_);
+    }
+    else if (!strcmp("qp_num_setup", field))
+    {
+        // number of setups of the QP solver workspace, e.g. OSQP
+        config->qp_solver->memory_get(config->qp_solver,
+            mem->nlp_mem->qp_solver_mem, field + 3, return_value_);
+    }
     else if (!strcmp("qp_status", field))
     {
         config->qp_solver->memory_get(config->qp_solver,
@@ -1618,6 +2046,7 @@ void ocp_nlp_sqp_rti_config_initialize_default(void *config_)
     config->workspace_calculate_size = &ocp_nlp_sqp_rti_workspace_calculate_size;
     config->evaluate = &ocp_nlp_sqp_rti;
     config->memory_reset_qp_solver = &ocp_nlp_sqp_rti_memory_reset_qp_solver;
+    config->memory_reset_qp_warm_start = &ocp_nlp_sqp_rti_memory_reset_qp_warm_start;
     config->eval_param_sens = &ocp_nlp_sqp_rti_eval_param_sens;
     config->eval_lagr_grad_p = &ocp_nlp_sqp_rti_eval_lagr_grad_p;
     config->config_initialize_default = &ocp_nlp_sqp_rti_config_initialize_default;
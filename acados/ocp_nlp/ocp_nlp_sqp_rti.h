@@ -76,6 +76,13 @@ typedef enum
     STANDARD_RTI, // 4
 } as_rti_level_t;
 
+typedef enum
+{
+    RTI_PIPELINE_IDLE, // = 0, buffer free
+    RTI_PIPELINE_BUSY, // = 1, buffer in use by preparation or swap
+    RTI_PIPELINE_READY, // = 2, buffer prepared, to be swapped in by the next feedback
+} rti_pipeline_state_t;
+
 typedef struct
 {
     ocp_nlp_opts *nlp_opts;
@@ -88,6 +95,7 @@ typedef struct
     as_rti_advancement_strategy_t as_rti_advancement_strategy;
     int as_rti_iter;
     int rti_log_residuals;
+    int rti_pipelining;       // double-buffered RTI: preparation of the next sample overlaps with feedback
 
 } ocp_nlp_sqp_rti_opts;
 
@@ -137,6 +145,16 @@ typedef struct
     int status;
     bool is_first_call;
 
+    // pipelined RTI: buffer 0 is nlp_mem as allocated, nlp_mem points to the current front buffer
+    ocp_nlp_memory *pipeline_nlp_mem[2];
+    ocp_nlp_out *pipeline_lin_point[2];  // linearization point of each buffer
+    ocp_nlp_out *pipeline_staging;       // last feedback result, read by the next preparation
+    int pipeline_front;                  // index of the buffer used by the feedback phase
+    volatile long pipeline_back_state;   // state of the back buffer, see rti_pipeline_state_t
+    volatile long pipeline_staging_state;
+    bool pipeline_front_prepared;
+    bool pipeline_staging_valid;
+
 } ocp_nlp_sqp_rti_memory;
 
 //
@@ -159,6 +177,9 @@ typedef struct
     ocp_qp_res *qp_res;
     ocp_qp_res_ws *qp_res_ws;
 
+    // pipelined RTI: workspace of each buffer, nlp_work points to the current front buffer
+    ocp_nlp_workspace *pipeline_nlp_work[2];
+
 } ocp_nlp_sqp_rti_workspace;
 
 //
@@ -180,6 +201,15 @@ int ocp_nlp_sqp_rti_precompute(void *config_, void *dims_,
 //
 void ocp_nlp_sqp_rti_eval_lagr_grad_p(void *config_, void *dims_, void *nlp_in_, void *opts_,
     void *mem_, void *work_, const char *field, void *grad_p);
+// Pipelined RTI (opts->rti_pipelining): the two phases can be called concurrently from two threads.
+// The preparation linearizes at the last available feedback result on the back buffer,
+// the feedback solves the QP of the front buffer and swaps in the back buffer once it is prepared.
+// NOTE: nlp_in must not be modified during a preparation, except for the constraint bounds.
+int ocp_nlp_sqp_rti_pipelined_preparation(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
+    void *opts_, void *mem_, void *work_);
+//
+int ocp_nlp_sqp_rti_pipelined_feedback(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
+    void *opts_, void *mem_, void *work_);
 
 
 #ifdef __cplusplus
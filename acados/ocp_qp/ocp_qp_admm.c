@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// external
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+#include "blasfeo/include/blasfeo_d_blas.h"
+// hpipm
+#include "hpipm/include/hpipm_d_ocp_qp.h"
+#include "hpipm/include/hpipm_d_ocp_qp_ipm.h"
+#include "hpipm/include/hpipm_d_ocp_qp_sol.h"
+// acados
+#include "acados/ocp_qp/ocp_qp_admm.h"
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/utils/mem.h"
+#include "acados/utils/timing.h"
+#include "acados/utils/types.h"
+
+
+
+/************************************************
+ * opts
+ ************************************************/
+
+// subproblem: dynamics only, the constraints enter through the penalty terms
+static void ocp_qp_admm_set_dims_eq(void *config_, ocp_qp_dims *dims, ocp_qp_dims *dims_eq)
+{
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        ocp_qp_dims_set(config_, dims_eq, ii, "nx", &dims->nx[ii]);
+        ocp_qp_dims_set(config_, dims_eq, ii, "nu", &dims->nu[ii]);
+    }
+}
+
+
+
+// size of the subproblem arg, with the same dims as in ocp_qp_admm_opts_assign
+static acados_size_t ocp_qp_admm_kkt_opts_memsize(void *config_, ocp_qp_dims *dims)
+{
+    void *dims_eq_mem = acados_calloc(1, ocp_qp_dims_calculate_size(dims->N));
+    ocp_qp_dims *dims_eq = ocp_qp_dims_assign(dims->N, dims_eq_mem);
+    ocp_qp_admm_set_dims_eq(config_, dims, dims_eq);
+
+    acados_size_t size = d_ocp_qp_ipm_arg_memsize(dims_eq);
+
+    free(dims_eq_mem);
+
+    return size;
+}
+
+
+
+acados_size_t ocp_qp_admm_opts_calculate_size(void *config_, void *dims_)
+{
+    ocp_qp_dims *dims = dims_;
+
+    acados_size_t size = 0;
+    size += sizeof(ocp_qp_admm_opts);
+
+    size += ocp_qp_dims_calculate_size(dims->N);
+    size += sizeof(struct d_ocp_qp_ipm_arg);
+    size += ocp_qp_admm_kkt_opts_memsize(config_, dims);
+
+    size += 2 * 8;
+    make_int_multiple_of(8, &size);
+
+    return size;
+}
+
+
+
+void *ocp_qp_admm_opts_assign(void *config_, void *dims_, void *raw_memory)
+{
+    ocp_qp_dims *dims = dims_;
+    ocp_qp_admm_opts *opts;
+
+    char *c_ptr = (char *) raw_memory;
+
+    opts = (ocp_qp_admm_opts *) c_ptr;
+    c_ptr += sizeof(ocp_qp_admm_opts);
+
+    align_char_to(8, &c_ptr);
+    opts->dims_eq = ocp_qp_dims_assign(dims->N, c_ptr);
+    c_ptr += ocp_qp_dims_calculate_size(dims->N);
+    ocp_qp_admm_set_dims_eq(config_, dims, opts->dims_eq);
+
+    opts->kkt_opts = (struct d_ocp_qp_ipm_arg *) c_ptr;
+    c_ptr += sizeof(struct d_ocp_qp_ipm_arg);
+
+    align_char_to(8, &c_ptr);
+    d_ocp_qp_ipm_arg_create(opts->dims_eq, opts->kkt_opts, c_ptr);
+    c_ptr += d_ocp_qp_ipm_arg_memsize(opts->dims_eq);
+
+    assert((char *) raw_memory + ocp_qp_admm_opts_calculate_size(config_, dims) >= c_ptr);
+
+    return (void *) opts;
+}
+
+
+
+void ocp_qp_admm_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    ocp_qp_admm_opts *opts = opts_;
+
+    // without constraints HPIPM factorizes and solves the KKT system once
+    d_ocp_qp_ipm_arg_set_default(SPEED, opts->kkt_opts);
+
+    opts->rho = 1e-1;
+    opts->rho_eq_scale = 1e3;
+    opts->sigma = 1e-6;
+    opts->alpha = 1.6;
+    opts->iter_max = 4000;
+    opts->check_termination = 10;
+    opts->tol_stat = 1e-6;
+    opts->tol_eq = 1e-6;
+    opts->tol_ineq = 1e-6;
+    opts->tol_comp = 1e-6;
+    opts->warm_start = 0;
+    opts->time_limit = 0.0;
+    opts->print_level = 0;
+
+    return;
+}
+
+
+
+void ocp_qp_admm_opts_update(void *config_, void *dims_, void *opts_)
+{
+    return;
+}
+
+
+
+void ocp_qp_admm_opts_set(void *config_, void *opts_, const char *field, void *value)
+{
+    ocp_qp_admm_opts *opts = opts_;
+
+    if (!strcmp(field, "rho"))
+    {
+        double *rho = value;
+        if (*rho <= 0.0)
+        {
+            printf("\nerror: ocp_qp_admm_opts_set: rho must be positive, got %e.\n", *rho);
+            exit(1);
+        }
+        opts->rho = *rho;
+    }
+    else if (!strcmp(field, "rho_eq_scale"))
+    {
+        double *rho_eq_scale = value;
+        opts->rho_eq_scale = *rho_eq_scale;
+    }
+    else if (!strcmp(field, "sigma"))
+    {
+        double *sigma = value;
+        opts->sigma = *sigma;
+    }
+    else if (!strcmp(field, "alpha"))
+    {
+        double *alpha = value;
+        if (*alpha <= 0.0 || *alpha >= 2.0)
+        {
+            printf("\nerror: ocp_qp_admm_opts_set: alpha must be in (0, 2), got %e.\n", *alpha);
+            exit(1);
+        }
+        opts->alpha = *alpha;
+    }
+    else if (!strcmp(field, "iter_max"))
+    {
+        int *iter_max = value;
+        opts->iter_max = *iter_max;
+    }
+    else if (!strcmp(field, "check_termination"))
+    {
+        int *check_termination = value;
+        if (*check_termination < 1)
+        {
+            printf("\nerror: ocp_qp_admm_opts_set: check_termination must be >= 1, got %d.\n",
+                   *check_termination);
+            exit(1);
+        }
+        opts->check_termination = *check_termination;
+    }
+    else if (!strcmp(field, "tol_stat"))
+    {
+        double *tol = value;
+        opts->tol_stat = *tol;
+    }
+    else if (!strcmp(field, "tol_eq"))
+    {
+        double *tol = value;
+        opts->tol_eq = *tol;
+    }
+    else if (!strcmp(field, "tol_ineq"))
+    {
+        double *tol = value;
+        opts->tol_ineq = *tol;
+    }
+    else if (!strcmp(field, "tol_comp"))
+    {
+        double *tol = value;
+        opts->tol_comp = *tol;
+    }
+    else if (!strcmp(field, "warm_start"))
+    {
+        int *warm_start = value;
+        opts->warm_start = *warm_start;
+    }
+    else if (!strcmp(field, "time_limit"))
+    {
+        double *time_limit = value;
+        opts->time_limit = *time_limit;
+    }
+    else if (!strcmp(field, "print_level"))
+    {
+        int *print_level = value;
+        opts->print_level = *print_level;
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
+    else
+    {
+        printf("\nerror: ocp_qp_admm_opts_set: wrong field: %s\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+acados_size_t ocp_qp_admm_memory_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    ocp_qp_dims *dims = dims_;
+    ocp_qp_admm_opts *opts = opts_;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+    int *ns = dims->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        if (ns[ii] > 0)
+        {
+            printf("\nerror: ocp_qp_admm: soft constraints are not supported, got ns[%d] = %d.\n",
+                   ii, ns[ii]);
+            exit(1);
+        }
+    }
+
+    acados_size_t size = 0;
+    size += sizeof(ocp_qp_admm_memory);
+
+    size += ocp_qp_in_calculate_size(opts->dims_eq);
+    size += ocp_qp_out_calculate_size(opts->dims_eq);
+    size += sizeof(struct d_ocp_qp_ipm_ws);
+    size += d_ocp_qp_ipm_ws_memsize(opts->dims_eq, opts->kkt_opts);
+
+    size += ocp_qp_res_calculate_size(dims);
+    size += ocp_qp_res_workspace_calculate_size(dims);
+
+    size += 7 * (N + 1) * sizeof(struct blasfeo_dvec);  // ux, z, v, y, lb, ub, rho
+    size += 1 * (N + 1) * sizeof(struct blasfeo_dmat);  // DCt_rho
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        size += 1 * blasfeo_memsize_dvec(nu[ii] + nx[ii]);       // ux
+        size += 6 * blasfeo_memsize_dvec(nb[ii] + ng[ii]);       // z, v, y, lb, ub, rho
+        size += 1 * blasfeo_memsize_dmat(nu[ii] + nx[ii], ng[ii]);  // DCt_rho
+    }
+
+    size += 4 * 8 + 64;
+    make_int_multiple_of(8, &size);
+
+    return size;
+}
+
+
+
+void *ocp_qp_admm_memory_assign(void *config_, void *dims_, void *opts_, void *raw_memory)
+{
+    ocp_qp_dims *dims = dims_;
+    ocp_qp_admm_opts *opts = opts_;
+    ocp_qp_admm_memory *mem;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+
+    // char pointer
+    char *c_ptr = (char *) raw_memory;
+
+    mem = (ocp_qp_admm_memory *) c_ptr;
+    c_ptr += sizeof(ocp_qp_admm_memory);
+
+    align_char_to(8, &c_ptr);
+    mem->qp_eq = ocp_qp_in_assign(opts->dims_eq, c_ptr);
+    c_ptr += ocp_qp_in_calculate_size(opts->dims_eq);
+
+    align_char_to(8, &c_ptr);
+    mem->sol_eq = ocp_qp_out_assign(opts->dims_eq, c_ptr);
+    c_ptr += ocp_qp_out_calculate_size(opts->dims_eq);
+
+    align_char_to(8, &c_ptr);
+    mem->kkt_ws = (struct d_ocp_qp_ipm_ws *) c_ptr;
+    c_ptr += sizeof(struct d_ocp_qp_ipm_ws);
+
+    align_char_to(8, &c_ptr);
+    d_ocp_qp_ipm_ws_create(opts->dims_eq, opts->kkt_opts, mem->kkt_ws, c_ptr);
+    c_ptr += mem->kkt_ws->memsize;
+
+    align_char_to(8, &c_ptr);
+    mem->qp_res = ocp_qp_res_assign(dims, c_ptr);
+    c_ptr += ocp_qp_res_calculate_size(dims);
+
+    align_char_to(8, &c_ptr);
+    mem->qp_res_ws = ocp_qp_res_workspace_assign(dims, c_ptr);
+    c_ptr += ocp_qp_res_workspace_calculate_size(dims);
+
+    align_char_to(8, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->ux, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->z, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->v, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->y, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->lb, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->ub, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->rho, &c_ptr);
+    assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->DCt_rho, &c_ptr);
+
+    align_char_to(64, &c_ptr);
+    for (int ii = 0; ii <= N; ii++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nu[ii] + nx[ii], ng[ii], mem->DCt_rho + ii, &c_ptr);
+    }
+    for (int ii = 0; ii <= N; ii++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nu[ii] + nx[ii], mem->ux + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->z + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->v + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->y + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->lb + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->ub + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nb[ii] + ng[ii], mem->rho + ii, &c_ptr);
+    }
+
+    mem->has_iterate = 0;
+    for (int ii = 0; ii < 4; ii++)
+        mem->res[ii] = 0.0;
+    mem->time_qp_solver_call = 0.0;
+    mem->iter = 0;
+    mem->status = 0;
+
+    assert((char *) raw_memory + ocp_qp_admm_memory_calculate_size(config_, dims, opts_) >= c_ptr);
+
+    return mem;
+}
+
+
+
+void ocp_qp_admm_memory_get(void *config_, void *mem_, const char *field, void* value)
+{
+    ocp_qp_admm_memory *mem = mem_;
+
+    if (!strcmp(field, "time_qp_solver_call"))
+    {
+        double *tmp_ptr = value;
+        *tmp_ptr = mem->time_qp_solver_call;
+    }
+    else if (!strcmp(field, "iter"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->iter;
+    }
+    else if (!strcmp(field, "status"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->status;
+    }
+    else if (!strcmp(field, "res"))
+    {
+        double *tmp_ptr = value;
+        for (int ii = 0; ii < 4; ii++)
+            tmp_ptr[ii] = mem->res[ii];
+    }
+    else
+    {
+        printf("\nerror: ocp_qp_admm_memory_get: field %s not available\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * workspace
+ ************************************************/
+
+acados_size_t ocp_qp_admm_workspace_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    return 0;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+// z = G * ux, with G stacking the bound selection and the general constraint matrix
+static void ocp_qp_admm_constr_eval(ocp_qp_in *qp_in, int stage, struct blasfeo_dvec *ux,
+                                    struct blasfeo_dvec *z)
+{
+    int nv = qp_in->dim->nu[stage] + qp_in->dim->nx[stage];
+    int nb = qp_in->dim->nb[stage];
+    int ng = qp_in->dim->ng[stage];
+
+    blasfeo_dvecex_sp(nb, 1.0, qp_in->idxb[stage], ux, 0, z, 0);
+    blasfeo_dgemv_t(nv, ng, 1.0, qp_in->DCt + stage, 0, 0, ux, 0, 0.0, z, nb, z, nb);
+}
+
+
+
+// bounds and penalty parameters of the stacked constraints, penalized Hessian and dynamics of the subproblem
+static void ocp_qp_admm_setup_stage(ocp_qp_in *qp_in, int stage, ocp_qp_admm_opts *opts,
+                                    ocp_qp_admm_memory *mem)
+{
+    int nv = qp_in->dim->nu[stage] + qp_in->dim->nx[stage];
+    int nx1 = stage < qp_in->dim->N ? qp_in->dim->nx[stage + 1] : 0;
+    int nb = qp_in->dim->nb[stage];
+    int ng = qp_in->dim->ng[stage];
+    int nc = nb + ng;
+    int *idxb = qp_in->idxb[stage];
+
+    struct blasfeo_dvec *d = qp_in->d + stage;
+    struct blasfeo_dvec *d_mask = qp_in->d_mask + stage;
+    struct blasfeo_dvec *lb = mem->lb + stage;
+    struct blasfeo_dvec *ub = mem->ub + stage;
+    struct blasfeo_dvec *rho = mem->rho + stage;
+    struct blasfeo_dmat *RSQrq_eq = mem->qp_eq->RSQrq + stage;
+
+    // upper bounds are stored with negative sign
+    for (int jj = 0; jj < nc; jj++)
+    {
+        BLASFEO_DVECEL(lb, jj) = BLASFEO_DVECEL(d_mask, jj) != 0.0 ?
+                                 BLASFEO_DVECEL(d, jj) : -ACADOS_INFTY;
+        BLASFEO_DVECEL(ub, jj) = BLASFEO_DVECEL(d_mask, nc + jj) != 0.0 ?
+                                 -BLASFEO_DVECEL(d, nc + jj) : ACADOS_INFTY;
+        BLASFEO_DVECEL(rho, jj) = BLASFEO_DVECEL(ub, jj) - BLASFEO_DVECEL(lb, jj) < 1e-8 ?
+                                  opts->rho_eq_scale * opts->rho : opts->rho;
+    }
+
+    // RSQrq + sigma I + G' diag(rho) G
+    blasfeo_dgecp(nv, nv, qp_in->RSQrq + stage, 0, 0, RSQrq_eq, 0, 0);
+    blasfeo_ddiare(nv, opts->sigma, RSQrq_eq, 0, 0);
+    for (int jj = 0; jj < nb; jj++)
+    {
+        BLASFEO_DMATEL(RSQrq_eq, idxb[jj], idxb[jj]) += BLASFEO_DVECEL(rho, jj);
+    }
+    for (int jj = 0; jj < ng; jj++)
+    {
+        blasfeo_dgecpsc(nv, 1, BLASFEO_DVECEL(rho, nb + jj), qp_in->DCt + stage, 0, jj,
+                        mem->DCt_rho + stage, 0, jj);
+    }
+    blasfeo_dsyrk_ln(nv, ng, 1.0, mem->DCt_rho + stage, 0, 0, qp_in->DCt + stage, 0, 0,
+                     1.0, RSQrq_eq, 0, 0, RSQrq_eq, 0, 0);
+    mem->qp_eq->diag_H_flag[stage] = 0;
+
+    if (stage < qp_in->dim->N)
+    {
+        blasfeo_dgecp(nv + 1, nx1, qp_in->BAbt + stage, 0, 0, mem->qp_eq->BAbt + stage, 0, 0);
+        blasfeo_dveccp(nx1, qp_in->b + stage, 0, mem->qp_eq->b + stage, 0);
+    }
+}
+
+
+
+// gradient of the subproblem: rqz - sigma * ux + G' * (y - rho .* v)
+static void ocp_qp_admm_gradient_stage(ocp_qp_in *qp_in, int stage, ocp_qp_admm_opts *opts,
+                                       ocp_qp_admm_memory *mem)
+{
+    int nv = qp_in->dim->nu[stage] + qp_in->dim->nx[stage];
+    int nb = qp_in->dim->nb[stage];
+    int ng = qp_in->dim->ng[stage];
+
+    struct blasfeo_dvec *rqz_eq = mem->qp_eq->rqz + stage;
+    struct blasfeo_dvec *z = mem->z + stage;
+
+    // z is free until the next constraint evaluation
+    for (int jj = 0; jj < nb + ng; jj++)
+    {
+        BLASFEO_DVECEL(z, jj) = BLASFEO_DVECEL(mem->y + stage, jj)
+                              - BLASFEO_DVECEL(mem->rho + stage, jj) * BLASFEO_DVECEL(mem->v + stage, jj);
+    }
+
+    blasfeo_daxpy(nv, -opts->sigma, mem->ux + stage, 0, qp_in->rqz + stage, 0, rqz_eq, 0);
+    blasfeo_dvecad_sp(nb, 1.0, z, 0, qp_in->idxb[stage], rqz_eq, 0);
+    blasfeo_dgemv_n(nv, ng, 1.0, qp_in->DCt + stage, 0, 0, z, nb, 1.0, rqz_eq, 0, rqz_eq, 0);
+    blasfeo_drowin(nv, 1.0, rqz_eq, 0, mem->qp_eq->RSQrq + stage, nv, 0);
+}
+
+
+
+// relaxation, projection on the bounds and multiplier update
+static void ocp_qp_admm_update_stage(ocp_qp_in *qp_in, int stage, ocp_qp_admm_opts *opts,
+                                     ocp_qp_admm_memory *mem)
+{
+    int nv = qp_in->dim->nu[stage] + qp_in->dim->nx[stage];
+    int nc = qp_in->dim->nb[stage] + qp_in->dim->ng[stage];
+    double alpha = opts->alpha;
+
+    struct blasfeo_dvec *z = mem->z + stage;
+    struct blasfeo_dvec *v = mem->v + stage;
+    struct blasfeo_dvec *y = mem->y + stage;
+
+    ocp_qp_admm_constr_eval(qp_in, stage, mem->sol_eq->ux + stage, z);
+    blasfeo_daxpby(nv, alpha, mem->sol_eq->ux + stage, 0, 1.0 - alpha, mem->ux + stage, 0, mem->ux + stage, 0);
+
+    double z_relax, v_new, rho;
+    for (int jj = 0; jj < nc; jj++)
+    {
+        rho = BLASFEO_DVECEL(mem->rho + stage, jj);
+        z_relax = alpha * BLASFEO_DVECEL(z, jj) + (1.0 - alpha) * BLASFEO_DVECEL(v, jj);
+        v_new = z_relax + BLASFEO_DVECEL(y, jj) / rho;
+        v_new = fmax(BLASFEO_DVECEL(mem->lb + stage, jj), fmin(BLASFEO_DVECEL(mem->ub + stage, jj), v_new));
+        BLASFEO_DVECEL(y, jj) += rho * (z_relax - v_new);
+        BLASFEO_DVECEL(v, jj) = v_new;
+    }
+}
+
+
+
+// initial iterate according to opts->warm_start
+static void ocp_qp_admm_init_stage(ocp_qp_in *qp_in, ocp_qp_out *qp_out, int stage,
+                                   ocp_qp_admm_opts *opts, ocp_qp_admm_memory *mem)
+{
+    int nv = qp_in->dim->nu[stage] + qp_in->dim->nx[stage];
+    int nc = qp_in->dim->nb[stage] + qp_in->dim->ng[stage];
+
+    if (opts->warm_start == 1)
+    {
+        blasfeo_dveccp(nv, qp_out->ux + stage, 0, mem->ux + stage, 0);
+        // y = lam_ub - lam_lb
+        blasfeo_daxpy(nc, -1.0, qp_out->lam + stage, 0, qp_out->lam + stage, nc, mem->y + stage, 0);
+        ocp_qp_admm_constr_eval(qp_in, stage, mem->ux + stage, mem->v + stage);
+        for (int jj = 0; jj < nc; jj++)
+        {
+            BLASFEO_DVECEL(mem->v + stage, jj) = fmax(BLASFEO_DVECEL(mem->lb + stage, jj),
+                fmin(BLASFEO_DVECEL(mem->ub + stage, jj), BLASFEO_DVECEL(mem->v + stage, jj)));
+        }
+    }
+    else if (opts->warm_start == 0 || !mem->has_iterate)
+    {
+        blasfeo_dvecse(nv, 0.0, mem->ux + stage, 0);
+        blasfeo_dvecse(nc, 0.0, mem->v + stage, 0);
+        blasfeo_dvecse(nc, 0.0, mem->y + stage, 0);
+    }
+}
+
+
+
+// writes the iterate to qp_out and evaluates the residuals of the original QP;
+// the inequality residual is the distance of the constraint values to the bounds
+static void ocp_qp_admm_residuals(ocp_qp_in *qp_in, ocp_qp_out *qp_out, ocp_qp_admm_memory *mem)
+{
+    int N = qp_in->dim->N;
+    int *nx = qp_in->dim->nx;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    qp_info *info = qp_out->misc;
+    double tmp, res_ineq = 0.0;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nc = nb[ii] + ng[ii];
+        blasfeo_dveccp(nu[ii] + nx[ii], mem->ux + ii, 0, qp_out->ux + ii, 0);
+        if (ii < N)
+            blasfeo_dveccp(nx[ii + 1], mem->sol_eq->pi + ii, 0, qp_out->pi + ii, 0);
+        for (int jj = 0; jj < nc; jj++)
+        {
+            BLASFEO_DVECEL(qp_out->lam + ii, jj) = fmax(-BLASFEO_DVECEL(mem->y + ii, jj), 0.0);
+            BLASFEO_DVECEL(qp_out->lam + ii, nc + jj) = fmax(BLASFEO_DVECEL(mem->y + ii, jj), 0.0);
+        }
+        // z is free until the next constraint evaluation
+        ocp_qp_admm_constr_eval(qp_in, ii, mem->ux + ii, mem->z + ii);
+        blasfeo_daxpy(nc, -1.0, mem->v + ii, 0, mem->z + ii, 0, mem->z + ii, 0);
+    }
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        blasfeo_dvecnrm_inf(nb[ii] + ng[ii], mem->z + ii, 0, &tmp);
+        res_ineq = tmp > res_ineq ? tmp : res_ineq;
+    }
+
+    ocp_qp_compute_t(qp_in, qp_out);
+    info->t_computed = 1;
+    ocp_qp_res_compute(qp_in, qp_out, mem->qp_res, mem->qp_res_ws);
+    ocp_qp_res_compute_nrm_inf(mem->qp_res, mem->res);
+    // the slacks of the original QP are consistent by construction
+    mem->res[2] = res_ineq;
+}
+
+
+
+int ocp_qp_admm(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
+{
+    ocp_qp_in *qp_in = qp_in_;
+    ocp_qp_out *qp_out = qp_out_;
+
+    qp_info *info = qp_out->misc;
+    acados_timer tot_timer;
+
+    acados_tic(&tot_timer);
+    // cast data structures
+    ocp_qp_admm_opts *opts = opts_;
+    ocp_qp_admm_memory *mem = mem_;
+
+    int N = qp_in->dim->N;
+
+    // stage-wise setup of the subproblem and of the initial iterate
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int ii = 0; ii <= N; ii++)
+    {
+        ocp_qp_admm_setup_stage(qp_in, ii, opts, mem);
+        ocp_qp_admm_init_stage(qp_in, qp_out, ii, opts, mem);
+    }
+
+    int kkt_status = 0;
+    int checked = 0;
+    mem->status = 1;
+    mem->iter = 0;
+    while (mem->iter < opts->iter_max)
+    {
+#if defined(ACADOS_WITH_OPENMP)
+        #pragma omp parallel for
+#endif
+        for (int ii = 0; ii <= N; ii++)
+        {
+            ocp_qp_admm_gradient_stage(qp_in, ii, opts, mem);
+        }
+
+        // Riccati recursion on the subproblem: its Hessian is constant within the call,
+        // so the factorization of the first iteration is reused for all further KKT solves
+        if (mem->iter == 0)
+        {
+            d_ocp_qp_ipm_solve(mem->qp_eq, mem->sol_eq, opts->kkt_opts, mem->kkt_ws);
+            d_ocp_qp_ipm_get_status(mem->kkt_ws, &kkt_status);
+            if (kkt_status != 0)
+            {
+                mem->status = ACADOS_QP_FAILURE;
+                break;
+            }
+        }
+        else
+        {
+            d_ocp_qp_ipm_sens(mem->qp_eq, mem->sol_eq, opts->kkt_opts, mem->kkt_ws);
+        }
+
+#if defined(ACADOS_WITH_OPENMP)
+        #pragma omp parallel for
+#endif
+        for (int ii = 0; ii <= N; ii++)
+        {
+            ocp_qp_admm_update_stage(qp_in, ii, opts, mem);
+        }
+        mem->iter++;
+        mem->has_iterate = 1;
+
+        checked = 0;
+        if (mem->iter % opts->check_termination == 0)
+        {
+            ocp_qp_admm_residuals(qp_in, qp_out, mem);
+            checked = 1;
+
+            if (opts->print_level > 0)
+            {
+                printf("ocp_qp_admm: iter %4d\tres_stat %e\tres_eq %e\tres_ineq %e\tres_comp %e\n",
+                       mem->iter, mem->res[0], mem->res[1], mem->res[2], mem->res[3]);
+            }
+            if (mem->res[0] <= opts->tol_stat && mem->res[1] <= opts->tol_eq &&
+                mem->res[2] <= opts->tol_ineq && mem->res[3] <= opts->tol_comp)
+            {
+                mem->status = 0;
+                break;
+            }
+        }
+
+        if (opts->time_limit > 0.0 && acados_toc(&tot_timer) > opts->time_limit)
+            break;
+    }
+
+    if (!checked && mem->status != ACADOS_QP_FAILURE)
+        ocp_qp_admm_residuals(qp_in, qp_out, mem);
+
+    info->solve_QP_time = acados_toc(&tot_timer);
+    info->interface_time = 0;
+    info->total_time = info->solve_QP_time;
+    info->num_iter = mem->iter;
+    info->t_computed = 1;
+
+    mem->time_qp_solver_call = info->solve_QP_time;
+
+    // check exit conditions
+    int acados_status = mem->status;
+    if (mem->status == 0) acados_status = ACADOS_SUCCESS;
+    if (mem->status == 1) acados_status = ACADOS_MAXITER;
+
+    return acados_status;
+}
+
+
+
+void ocp_qp_admm_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
+{
+    ocp_qp_admm_memory *mem = mem_;
+
+    mem->has_iterate = 0;
+}
+
+
+
+void ocp_qp_admm_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    ocp_qp_admm_memory *mem = mem_;
+
+    ocp_qp_out_set_zero(qp_out_);
+    mem->has_iterate = 0;
+}
+
+
+
+void ocp_qp_admm_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
+{
+    printf("\nerror: ocp_qp_admm_solver_get: not implemented yet\n");
+    exit(1);
+}
+
+
+
+void ocp_qp_admm_eval_sens(void *config_, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_)
+{
+    printf("\nerror: ocp_qp_admm_eval_sens: not implemented yet\n");
+    exit(1);
+}
+
+
+
+void ocp_qp_admm_terminate(void *config_, void *mem_, void *work_)
+{
+    return;
+}
+
+
+
+void ocp_qp_admm_config_initialize_default(void *config_)
+{
+    qp_solver_config *config = config_;
+
+    config->dims_set = &ocp_qp_dims_set;
+    config->opts_calculate_size = &ocp_qp_admm_opts_calculate_size;
+    config->opts_assign = &ocp_qp_admm_opts_assign;
+    config->opts_initialize_default = &ocp_qp_admm_opts_initialize_default;
+    config->opts_update = &ocp_qp_admm_opts_update;
+    config->opts_set = &ocp_qp_admm_opts_set;
+    config->memory_calculate_size = &ocp_qp_admm_memory_calculate_size;
+    config->memory_assign = &ocp_qp_admm_memory_assign;
+    config->memory_get = &ocp_qp_admm_memory_get;
+    config->workspace_calculate_size = &ocp_qp_admm_workspace_calculate_size;
+    config->evaluate = &ocp_qp_admm;
+    config->solver_get = &ocp_qp_admm_solver_get;
+    config->memory_reset = &ocp_qp_admm_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_admm_memory_reset_warm_start;
+    config->eval_sens = &ocp_qp_admm_eval_sens;
+    config->terminate = &ocp_qp_admm_terminate;
+
+    return;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_OCP_QP_OCP_QP_ADMM_H_
+#define ACADOS_OCP_QP_OCP_QP_ADMM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// hpipm
+#include "hpipm/include/hpipm_d_ocp_qp_ipm.h"
+// acados
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/utils/types.h"
+
+
+
+// struct of arguments to the solver
+typedef struct ocp_qp_admm_opts_
+{
+    ocp_qp_dims *dims_eq;  // dimensions of the equality constrained subproblem: nx, nu, no constraints
+    struct d_ocp_qp_ipm_arg *kkt_opts;  // arguments of the Riccati solve of the subproblem
+    double rho;  // penalty parameter of the inequality constraints
+    double rho_eq_scale;  // penalty scaling for equality constraints, i.e. lower bound == upper bound
+    double sigma;  // proximal regularization of the primal variables
+    double alpha;  // over-relaxation parameter in (0, 2)
+    int iter_max;
+    int check_termination;  // residuals are evaluated every check_termination iterations
+    double tol_stat;
+    double tol_eq;
+    double tol_ineq;
+    double tol_comp;
+    int warm_start;  // 0: cold start, 1: primal-dual guess from qp_out, 2: last iterate of the previous call
+    double time_limit;  // limit on solver time in seconds, checked after every iteration; <= 0: no limit
+    int print_level;
+} ocp_qp_admm_opts;
+
+
+
+// struct of the solver memory
+typedef struct ocp_qp_admm_memory_
+{
+    // equality constrained subproblem, its Hessian contains the penalty terms
+    ocp_qp_in *qp_eq;
+    ocp_qp_out *sol_eq;
+    struct d_ocp_qp_ipm_ws *kkt_ws;
+
+    // residuals of the original QP
+    ocp_qp_res *qp_res;
+    ocp_qp_res_ws *qp_res_ws;
+
+    // iterates, constraints are stacked as [bounds; general constraints] per stage
+    struct blasfeo_dvec *ux;  // primal variables
+    struct blasfeo_dvec *z;   // constraint values
+    struct blasfeo_dvec *v;   // constraint values projected on the bounds
+    struct blasfeo_dvec *y;   // constraint multipliers
+    struct blasfeo_dvec *lb;  // lower bounds, -ACADOS_INFTY if masked
+    struct blasfeo_dvec *ub;  // upper bounds, ACADOS_INFTY if masked
+    struct blasfeo_dvec *rho;  // penalty parameter per constraint
+    struct blasfeo_dmat *DCt_rho;  // general constraint matrix scaled by the penalty parameters
+
+    int has_iterate;  // ux, v, y hold the iterate of a previous call
+
+    double res[4];  // stationarity, equality, inequality, complementarity residuals of the last check
+    double time_qp_solver_call;
+    int iter;
+    int status;
+
+} ocp_qp_admm_memory;
+
+
+
+//
+acados_size_t ocp_qp_admm_opts_calculate_size(void *config, void *dims);
+//
+void *ocp_qp_admm_opts_assign(void *config, void *dims, void *raw_memory);
+//
+void ocp_qp_admm_opts_initialize_default(void *config, void *dims, void *opts_);
+//
+void ocp_qp_admm_opts_update(void *config, void *dims, void *opts_);
+//
+void ocp_qp_admm_opts_set(void *config_, void *opts_, const char *field, void *value);
+//
+acados_size_t ocp_qp_admm_memory_calculate_size(void *config, void *dims, void *opts_);
+//
+void *ocp_qp_admm_memory_assign(void *config, void *dims, void *opts_, void *raw_memory);
+//
+void ocp_qp_admm_memory_get(void *config_, void *mem_, const char *field, void* value);
+//
+acados_size_t ocp_qp_admm_workspace_calculate_size(void *config, void *dims, void *opts_);
+//
+int ocp_qp_admm(void *config, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
+//
+void ocp_qp_admm_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_);
+//
+void ocp_qp_admm_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
+void ocp_qp_admm_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
+//
+void ocp_qp_admm_eval_sens(void *config, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
+//
+void ocp_qp_admm_terminate(void *config, void *mem_, void *work_);
+//
+void ocp_qp_admm_config_initialize_default(void *config);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_OCP_QP_OCP_QP_ADMM_H_
@@ -272,6 +272,28 @@ double ocp_qp_out_compute_primal_nrm_inf(ocp_qp_out* qp_out)
 
 
 
+void ocp_qp_out_set_zero(ocp_qp_out *qp_out)
+{
+    ocp_qp_dims *dims = qp_out->dim;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+    int *ns = dims->ns;
+
+    for (int i = 0; i <= N; i++)
+    {
+        blasfeo_dvecse(nx[i]+nu[i]+2*ns[i], 0.0, qp_out->ux+i, 0);
+        blasfeo_dvecse(2*(nb[i]+ng[i]+ns[i]), 0.0, qp_out->lam+i, 0);
+        blasfeo_dvecse(2*(nb[i]+ng[i]+ns[i]), 0.0, qp_out->t+i, 0);
+        if (i < N)
+            blasfeo_dvecse(nx[i+1], 0.0, qp_out->pi+i, 0);
+    }
+}
+
+
+
 /************************************************
  * res
  ************************************************/
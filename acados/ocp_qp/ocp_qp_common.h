@@ -71,6 +71,9 @@ typedef struct
     int (*evaluate)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
     void (*solver_get)(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
     void (*memory_reset)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
+    // resets the warm-start state, i.e. qp_out and iterates or working sets kept in the memory,
+    // but keeps the solver setup, e.g. factorizations and allocated solver workspaces
+    void (*memory_reset_warm_start)(void *config, void *qp_out, void *opts, void *mem);
     void (*eval_sens)(void *config, void *qp_in, void *qp_out, void *opts, void *mem, void *work);
     void (*terminate)(void *config, void *mem, void *work);
 } qp_solver_config;
@@ -154,6 +157,8 @@ acados_size_t ocp_qp_out_calculate_size(ocp_qp_dims *dims);
 ocp_qp_out *ocp_qp_out_assign(ocp_qp_dims *dims, void *raw_memory);
 //
 double ocp_qp_out_compute_primal_nrm_inf(ocp_qp_out* qp_out);
+//
+void ocp_qp_out_set_zero(ocp_qp_out *qp_out);
 
 /* res */
 //
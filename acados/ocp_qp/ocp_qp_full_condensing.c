@@ -33,8 +33,14 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+#include "blasfeo/include/blasfeo_d_blas.h"
+
 // hpipm
 #include "hpipm/include/hpipm_d_cond.h"
+#include "hpipm/include/hpipm_d_cond_aux.h"
 #include "hpipm/include/hpipm_d_dense_qp.h"
 #include "hpipm/include/hpipm_d_dense_qp_ipm.h"
 #include "hpipm/include/hpipm_d_dense_qp_sol.h"
@@ -243,6 +249,9 @@ void ocp_qp_full_condensing_opts_initialize_default(void *dims_, void *opts_)
     d_ocp_qp_reduce_eq_dof_arg_set_comp_dual_sol_ineq(&tmp_i1, opts->hpipm_red_opts);
 
     opts->mem_qp_in = 1;
+    opts->incremental = 0;
+    opts->hess_alg = 0;
+    opts->l2_size = 256*1024;
 
     return;
 }
@@ -254,6 +263,9 @@ void ocp_qp_full_condensing_opts_update(void *dims_, void *opts_)
     ocp_qp_full_condensing_opts *opts = opts_;
 
     // hpipm_cond_opts
+    // NOTE: the stage-wise update of the condensed qp is only available without factorization
+    if (opts->incremental)
+        opts->ric_alg = 0;
     d_cond_qp_arg_set_ric_alg(opts->ric_alg, opts->hpipm_cond_opts);
 
     return;
@@ -283,6 +295,31 @@ void ocp_qp_full_condensing_opts_set(void *opts_, const char *field, void* value
         d_ocp_qp_reduce_eq_dof_arg_set_comp_dual_sol_eq(tmp_ptr, opts->hpipm_red_opts);
         d_ocp_qp_reduce_eq_dof_arg_set_comp_dual_sol_ineq(tmp_ptr, opts->hpipm_red_opts);
     }
+    else if(!strcmp(field, "incremental"))
+    {
+        int *tmp_ptr = value;
+        opts->incremental = *tmp_ptr;
+        if (opts->incremental)
+        {
+            opts->ric_alg = 0;
+            d_cond_qp_arg_set_ric_alg(opts->ric_alg, opts->hpipm_cond_opts);
+        }
+    }
+    else if(!strcmp(field, "hess_alg"))
+    {
+        int *tmp_ptr = value;
+        if (*tmp_ptr < 0 || *tmp_ptr > 2)
+        {
+            printf("\nerror: ocp_qp_full_condensing_opts_set: hess_alg must be 0, 1 or 2, got %d\n", *tmp_ptr);
+            exit(1);
+        }
+        opts->hess_alg = *tmp_ptr;
+    }
+    else if(!strcmp(field, "l2_size"))
+    {
+        int *tmp_ptr = value;
+        opts->l2_size = *tmp_ptr;
+    }
     else
     {
         printf("\nerror: field %s not available in ocp_qp_full_condensing_opts_set\n", field);
@@ -299,6 +336,63 @@ void ocp_qp_full_condensing_opts_set(void *opts_, const char *field, void* value
  * memory
  ************************************************/
 
+// resolves hess_alg for the dims of the reduced qp, returns 1 for blocked condensing
+static int ocp_qp_full_condensing_use_blocked(ocp_qp_dims *dims, ocp_qp_full_condensing_opts *opts)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    // the incremental update needs the hpipm condensing workspace
+    if (opts->incremental || opts->hess_alg == 0)
+        return 0;
+    if (opts->hess_alg == 1)
+        return 1;
+
+    // hess_alg 2: blocked if the matrix Gamma streamed by the hpipm Hessian condensing exceeds L2
+    acados_size_t gamma_size = 0;
+    int nu_tmp = 0;
+    for (int ii = 0; ii < N; ii++)
+    {
+        nu_tmp += nu[ii];
+        gamma_size += (nu_tmp + nx[0] + 1) * nx[ii+1];
+    }
+
+    return gamma_size * sizeof(double) > (acados_size_t) opts->l2_size;
+}
+
+
+
+// number of Hessian block rows per segment, such that the running products of the segment
+// and one stage BAbt_j fit in L2
+static int ocp_qp_full_condensing_blocked_seg_size(ocp_qp_dims *dims, int l2_size)
+{
+    int N = dims->N;
+    int nx_max = 0;
+    int nu_max = 0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        nx_max = dims->nx[ii] > nx_max ? dims->nx[ii] : nx_max;
+        nu_max = dims->nu[ii] > nu_max ? dims->nu[ii] : nu_max;
+    }
+
+    long row_size = 2 * nu_max * nx_max * sizeof(double);
+    long stage_size = (nu_max + nx_max + 1) * nx_max * sizeof(double);
+
+    long n_seg = N + 1;
+    if (row_size > 0)
+        n_seg = (l2_size - stage_size) / row_size;
+
+    if (n_seg < 1)
+        n_seg = 1;
+    if (n_seg > N + 1)
+        n_seg = N + 1;
+
+    return (int) n_seg;
+}
+
+
+
 acados_size_t ocp_qp_full_condensing_memory_calculate_size(void *dims_, void *opts_)
 {
     ocp_qp_full_condensing_dims *dims = dims_;
@@ -329,6 +423,44 @@ acados_size_t ocp_qp_full_condensing_memory_calculate_size(void *dims_, void *op
     size += sizeof(struct d_ocp_qp_reduce_eq_dof_ws);
     size += d_ocp_qp_reduce_eq_dof_ws_memsize(dims->orig_dims);
 
+    if (opts->incremental)
+    {
+        size += ocp_qp_in_calculate_size(dims->red_dims);
+        size += (dims->red_dims->N + 1) * sizeof(int);
+    }
+
+    if (ocp_qp_full_condensing_use_blocked(dims->red_dims, opts))
+    {
+        int N = dims->red_dims->N;
+        int *nx = dims->red_dims->nx;
+        int *nu = dims->red_dims->nu;
+        int nx_max = 0;
+        int nux_max = 0;
+        for (int ii = 0; ii <= N; ii++)
+        {
+            nx_max = nx[ii] > nx_max ? nx[ii] : nx_max;
+            nux_max = nu[ii] + nx[ii] > nux_max ? nu[ii] + nx[ii] : nux_max;
+        }
+
+        size += (N + 2) * sizeof(int); // blk_idx
+        size += (3 * (N + 1) + 4) * sizeof(struct blasfeo_dmat); // D, F, F_tmp, P, W, M
+        size += (N + 1 + 4) * sizeof(struct blasfeo_dvec); // c, lam, tmp
+
+        for (int ii = 0; ii <= N; ii++)
+        {
+            size += blasfeo_memsize_dmat(nu[ii], nx[ii]); // D
+            size += 2 * blasfeo_memsize_dmat(nu[ii], nx_max); // F, F_tmp
+            size += blasfeo_memsize_dvec(nx[ii]); // c
+        }
+        size += 2 * blasfeo_memsize_dmat(nx_max, nx_max); // P
+        size += blasfeo_memsize_dmat(nux_max, nux_max); // W
+        size += blasfeo_memsize_dmat(nux_max, nx_max); // M
+        size += 2 * blasfeo_memsize_dvec(nx_max); // lam
+        size += 2 * blasfeo_memsize_dvec(nux_max); // tmp
+
+        size += 8 + 64;
+    }
+
     size += 2*8;
 
     return size;
@@ -382,6 +514,83 @@ void *ocp_qp_full_condensing_memory_assign(void *dims_, void *opts_, void *raw_m
 
     mem->qp_out_info = (qp_info *) mem->fcond_qp_out->misc;
 
+    if (opts->incremental)
+    {
+        mem->red_qp_lhs = ocp_qp_in_assign(dims->red_dims, c_ptr);
+        c_ptr += ocp_qp_in_calculate_size(dims->red_dims);
+
+        assign_and_advance_int(dims->red_dims->N + 1, &mem->idxc, &c_ptr);
+    }
+    else
+    {
+        mem->red_qp_lhs = NULL;
+        mem->idxc = NULL;
+    }
+    mem->lhs_valid = 0;
+    mem->n_stages_cond = 0;
+
+    mem->blocked = ocp_qp_full_condensing_use_blocked(dims->red_dims, opts);
+    mem->hess_alg = opts->hess_alg;
+    mem->l2_size = opts->l2_size;
+    if (mem->blocked)
+    {
+        int N = dims->red_dims->N;
+        int *nx = dims->red_dims->nx;
+        int *nu = dims->red_dims->nu;
+        int nx_max = 0;
+        int nux_max = 0;
+        for (int ii = 0; ii <= N; ii++)
+        {
+            nx_max = nx[ii] > nx_max ? nx[ii] : nx_max;
+            nux_max = nu[ii] + nx[ii] > nux_max ? nu[ii] + nx[ii] : nux_max;
+        }
+
+        assign_and_advance_int(N + 2, &mem->blk_idx, &c_ptr);
+
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->blk_D, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->blk_F, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->blk_F_tmp, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(2, &mem->blk_P, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(1, &mem->blk_W, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(1, &mem->blk_M, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->blk_c, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(2, &mem->blk_lam, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(2, &mem->blk_tmp, &c_ptr);
+
+        align_char_to(64, &c_ptr);
+        for (int ii = 0; ii <= N; ii++)
+        {
+            assign_and_advance_blasfeo_dmat_mem(nu[ii], nx[ii], mem->blk_D + ii, &c_ptr);
+            assign_and_advance_blasfeo_dmat_mem(nu[ii], nx_max, mem->blk_F + ii, &c_ptr);
+            assign_and_advance_blasfeo_dmat_mem(nu[ii], nx_max, mem->blk_F_tmp + ii, &c_ptr);
+        }
+        assign_and_advance_blasfeo_dmat_mem(nx_max, nx_max, mem->blk_P + 0, &c_ptr);
+        assign_and_advance_blasfeo_dmat_mem(nx_max, nx_max, mem->blk_P + 1, &c_ptr);
+        assign_and_advance_blasfeo_dmat_mem(nux_max, nux_max, mem->blk_W, &c_ptr);
+        assign_and_advance_blasfeo_dmat_mem(nux_max, nx_max, mem->blk_M, &c_ptr);
+
+        for (int ii = 0; ii <= N; ii++)
+            assign_and_advance_blasfeo_dvec_mem(nx[ii], mem->blk_c + ii, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nx_max, mem->blk_lam + 0, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nx_max, mem->blk_lam + 1, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nux_max, mem->blk_tmp + 0, &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nux_max, mem->blk_tmp + 1, &c_ptr);
+
+        // condensed variables ordered as [u_N, ..., u_0, x_0], as in hpipm
+        mem->blk_idx[N] = 0;
+        for (int ii = N - 1; ii >= 0; ii--)
+            mem->blk_idx[ii] = mem->blk_idx[ii+1] + nu[ii+1];
+        mem->blk_idx[N+1] = mem->blk_idx[0] + nu[0];
+
+        mem->n_seg = ocp_qp_full_condensing_blocked_seg_size(dims->red_dims, opts->l2_size);
+    }
+    else
+    {
+        mem->blk_idx = NULL;
+        mem->n_seg = 0;
+    }
+
     assert((char *) raw_memory + ocp_qp_full_condensing_memory_calculate_size(dims, opts) >= c_ptr);
 
     return mem;
@@ -413,6 +622,11 @@ void ocp_qp_full_condensing_memory_get(void *config_, void *mem_, const char *fi
         double *ptr = value;
         *ptr = mem->time_qp_xcond;
     }
+    else if (!strcmp(field, "n_stages_cond"))
+    {
+        int *ptr = value;
+        *ptr = mem->n_stages_cond;
+    }
     else
     {
         printf("\nerror: ocp_qp_full_condensing_memory_get: field %s not available\n", field);
@@ -442,6 +656,273 @@ acados_size_t ocp_qp_full_condensing_workspace_calculate_size(void *dims_, void
  * functions
  ************************************************/
 
+static int dmat_equal(int m, int n, struct blasfeo_dmat *A, struct blasfeo_dmat *B)
+{
+    for (int jj = 0; jj < n; jj++)
+        for (int ii = 0; ii < m; ii++)
+            if (BLASFEO_DMATEL(A, ii, jj) != BLASFEO_DMATEL(B, ii, jj))
+                return 0;
+    return 1;
+}
+
+
+
+static int dmat_equal_lower(int n, struct blasfeo_dmat *A, struct blasfeo_dmat *B)
+{
+    for (int jj = 0; jj < n; jj++)
+        for (int ii = jj; ii < n; ii++)
+            if (BLASFEO_DMATEL(A, ii, jj) != BLASFEO_DMATEL(B, ii, jj))
+                return 0;
+    return 1;
+}
+
+
+
+// compares the lhs (BAbt, RSQrq, DCt, Z, idxb, idxs_rev) of all stages of qp against the stored one in lhs,
+// marks the changed stages in idxc and stores their data; returns the number of changed stages
+static int ocp_qp_full_condensing_mark_changed_stages(ocp_qp_in *qp, ocp_qp_in *lhs, int *idxc, int lhs_valid)
+{
+    int N = qp->dim->N;
+    int *nx = qp->dim->nx;
+    int *nu = qp->dim->nu;
+    int *nb = qp->dim->nb;
+    int *ng = qp->dim->ng;
+    int *ns = qp->dim->ns;
+
+    int ii, jj;
+    int n_changed = 0;
+
+    for (ii = 0; ii <= N; ii++)
+    {
+        int changed = !lhs_valid;
+
+        if (!changed && ii < N)
+            changed = !dmat_equal(nu[ii]+nx[ii], nx[ii+1], qp->BAbt+ii, lhs->BAbt+ii);
+        if (!changed)
+            changed = !dmat_equal_lower(nu[ii]+nx[ii], qp->RSQrq+ii, lhs->RSQrq+ii);
+        if (!changed)
+            changed = !dmat_equal(nu[ii]+nx[ii], ng[ii], qp->DCt+ii, lhs->DCt+ii);
+        for (jj = 0; jj < 2*ns[ii] && !changed; jj++)
+            changed = BLASFEO_DVECEL(qp->Z+ii, jj) != BLASFEO_DVECEL(lhs->Z+ii, jj);
+        for (jj = 0; jj < nb[ii] && !changed; jj++)
+            changed = qp->idxb[ii][jj] != lhs->idxb[ii][jj];
+        for (jj = 0; jj < nb[ii]+ng[ii] && !changed; jj++)
+            changed = qp->idxs_rev[ii][jj] != lhs->idxs_rev[ii][jj];
+
+        idxc[ii] = changed;
+        if (changed)
+        {
+            if (ii < N)
+                blasfeo_dgecp(nu[ii]+nx[ii], nx[ii+1], qp->BAbt+ii, 0, 0, lhs->BAbt+ii, 0, 0);
+            blasfeo_dgecp(nu[ii]+nx[ii], nu[ii]+nx[ii], qp->RSQrq+ii, 0, 0, lhs->RSQrq+ii, 0, 0);
+            blasfeo_dgecp(nu[ii]+nx[ii], ng[ii], qp->DCt+ii, 0, 0, lhs->DCt+ii, 0, 0);
+            blasfeo_dveccp(2*ns[ii], qp->Z+ii, 0, lhs->Z+ii, 0);
+            for (jj = 0; jj < nb[ii]; jj++)
+                lhs->idxb[ii][jj] = qp->idxb[ii][jj];
+            for (jj = 0; jj < nb[ii]+ng[ii]; jj++)
+                lhs->idxs_rev[ii][jj] = qp->idxs_rev[ii][jj];
+            n_changed++;
+        }
+    }
+
+    return n_changed;
+}
+
+
+
+// hess_alg and l2_size fix the blocked Hessian condensing and its memory at memory creation
+static void ocp_qp_full_condensing_check_memory_opts(ocp_qp_full_condensing_opts *opts,
+                ocp_qp_full_condensing_memory *mem)
+{
+    if (opts->hess_alg != mem->hess_alg || opts->l2_size != mem->l2_size)
+    {
+        printf("\nerror: ocp_qp_full_condensing: hess_alg and l2_size have to be set before memory creation.\n");
+        exit(1);
+    }
+}
+
+
+
+// condense the lhs, only the stages that changed since the last call are recondensed
+static void ocp_qp_full_condensing_cond_lhs_incremental(dense_qp_in *fcond_qp_in,
+                ocp_qp_full_condensing_opts *opts, ocp_qp_full_condensing_memory *mem)
+{
+    // the stored lhs is only allocated if incremental was set before memory creation
+    if (mem->red_qp_lhs == NULL)
+    {
+        printf("\nerror: ocp_qp_full_condensing: incremental has to be set before memory creation.\n");
+        exit(1);
+    }
+
+    mem->n_stages_cond = ocp_qp_full_condensing_mark_changed_stages(mem->red_qp, mem->red_qp_lhs,
+                                                                    mem->idxc, mem->lhs_valid);
+
+    if (!mem->lhs_valid)
+    {
+        d_cond_qp_cond_lhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
+        mem->lhs_valid = 1;
+    }
+    else if (mem->n_stages_cond > 0)
+    {
+        d_cond_qp_update(mem->idxc, mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
+    }
+    // else: condensed lhs and condensing workspace are still valid
+
+    return;
+}
+
+
+
+// Hessian of the fully condensed qp by the backward recursion P_N = Q_N, W_k = RSQ_k + BAbt_k P_{k+1} BAbt_k',
+// with R_k + B_k' P_{k+1} B_k, D_k' and P_k the blocks of W_k; block (i,j), j < i, is D_i A_{i-1} ... A_{j+1} B_j.
+// The matrix Gamma is not read. The block rows are swept in segments of n_seg rows, such that each BAbt_j
+// is applied to all running products of a segment while it is in cache.
+static void ocp_qp_full_condensing_blocked_hess(ocp_qp_in *qp, dense_qp_in *fcond_qp_in,
+                                                ocp_qp_full_condensing_memory *mem)
+{
+    int N = qp->dim->N;
+    int *nx = qp->dim->nx;
+    int *nu = qp->dim->nu;
+    int *idx = mem->blk_idx;
+
+    struct blasfeo_dmat *Hv = fcond_qp_in->Hv;
+    struct blasfeo_dmat *P = mem->blk_P;
+    struct blasfeo_dmat *W = mem->blk_W;
+    struct blasfeo_dmat *M = mem->blk_M;
+    struct blasfeo_dmat *F = mem->blk_F;
+    struct blasfeo_dmat *F_tmp = mem->blk_F_tmp;
+    struct blasfeo_dmat tmp_mat;
+
+    int ii, jj, i0, i1, nux;
+
+    // diagonal blocks and D_k
+    for (ii = N; ii >= 0; ii--)
+    {
+        nux = nu[ii] + nx[ii];
+        blasfeo_dgecp(nux, nux, qp->RSQrq+ii, 0, 0, W, 0, 0);
+        blasfeo_dtrtr_l(nux, W, 0, 0, W, 0, 0);
+        if (ii < N)
+        {
+            blasfeo_dgemm_nn(nux, nx[ii+1], nx[ii+1], 1.0, qp->BAbt+ii, 0, 0, P+(ii+1)%2, 0, 0,
+                             0.0, M, 0, 0, M, 0, 0);
+            blasfeo_dgemm_nt(nux, nux, nx[ii+1], 1.0, M, 0, 0, qp->BAbt+ii, 0, 0, 1.0, W, 0, 0, W, 0, 0);
+        }
+        blasfeo_dtrcp_l(nu[ii], W, 0, 0, Hv, idx[ii], idx[ii]);
+        blasfeo_dgetr(nx[ii], nu[ii], W, nu[ii], 0, mem->blk_D+ii, 0, 0);
+        blasfeo_dgecp(nx[ii], nx[ii], W, nu[ii], nu[ii], P+ii%2, 0, 0);
+    }
+    blasfeo_dtrcp_l(nx[0], P+0, 0, 0, Hv, idx[N+1], idx[N+1]);
+
+    // off-diagonal blocks, segment of block rows i1, ..., i0
+    for (i0 = N; i0 >= 0; i0 -= mem->n_seg)
+    {
+        i1 = i0 - mem->n_seg + 1 > 0 ? i0 - mem->n_seg + 1 : 0;
+
+        for (ii = i1; ii <= i0; ii++)
+            blasfeo_dgecp(nu[ii], nx[ii], mem->blk_D+ii, 0, 0, F+ii, 0, 0);
+
+        for (jj = i0 - 1; jj >= 0; jj--)
+        {
+            for (ii = jj + 1 > i1 ? jj + 1 : i1; ii <= i0; ii++)
+            {
+                // lower triangle block (j,i) is B_j' F_i'
+                blasfeo_dgemm_nt(nu[jj], nu[ii], nx[jj+1], 1.0, qp->BAbt+jj, 0, 0, F+ii, 0, 0,
+                                 0.0, Hv, idx[jj], idx[ii], Hv, idx[jj], idx[ii]);
+                // F_i = F_i A_j
+                blasfeo_dgemm_nt(nu[ii], nx[jj], nx[jj+1], 1.0, F+ii, 0, 0, qp->BAbt+jj, nu[jj], 0,
+                                 0.0, F_tmp+ii, 0, 0, F_tmp+ii, 0, 0);
+                tmp_mat = F[ii];
+                F[ii] = F_tmp[ii];
+                F_tmp[ii] = tmp_mat;
+            }
+        }
+
+        // block (x_0,i)
+        for (ii = i1; ii <= i0; ii++)
+            blasfeo_dgetr(nu[ii], nx[0], F+ii, 0, 0, Hv, idx[N+1], idx[ii]);
+    }
+
+    // upper triangle, as hpipm condensing
+    blasfeo_dtrtr_l(idx[N+1] + nx[0], Hv, 0, 0, Hv, 0, 0);
+
+    return;
+}
+
+
+
+// gradient of the fully condensed qp: forward sweep of the state offsets c_{k+1} = A_k c_k + b_k, c_0 = 0,
+// backward sweep of lam_k = q_k + Q_k c_k + A_k' lam_{k+1}; the gradient of u_k is r_k + S_k c_k + B_k' lam_{k+1}
+static void ocp_qp_full_condensing_blocked_grad(ocp_qp_in *qp, dense_qp_in *fcond_qp_in,
+                                                ocp_qp_full_condensing_memory *mem)
+{
+    int N = qp->dim->N;
+    int *nx = qp->dim->nx;
+    int *nu = qp->dim->nu;
+    int *idx = mem->blk_idx;
+
+    struct blasfeo_dvec *c = mem->blk_c;
+    struct blasfeo_dvec *lam = mem->blk_lam;
+    struct blasfeo_dvec *tmp = mem->blk_tmp;
+
+    int ii, nux;
+
+    blasfeo_dvecse(nx[0], 0.0, c+0, 0);
+    for (ii = 0; ii < N; ii++)
+        blasfeo_dgemv_t(nx[ii], nx[ii+1], 1.0, qp->BAbt+ii, nu[ii], 0, c+ii, 0, 1.0, qp->b+ii, 0, c+ii+1, 0);
+
+    for (ii = N; ii >= 0; ii--)
+    {
+        nux = nu[ii] + nx[ii];
+        blasfeo_dvecse(nu[ii], 0.0, tmp+0, 0);
+        blasfeo_dveccp(nx[ii], c+ii, 0, tmp+0, nu[ii]);
+        blasfeo_dsymv_l(nux, 1.0, qp->RSQrq+ii, 0, 0, tmp+0, 0, 1.0, qp->rqz+ii, 0, tmp+1, 0);
+        if (ii < N)
+            blasfeo_dgemv_n(nux, nx[ii+1], 1.0, qp->BAbt+ii, 0, 0, lam+(ii+1)%2, 0, 1.0, tmp+1, 0, tmp+1, 0);
+        blasfeo_dveccp(nu[ii], tmp+1, 0, fcond_qp_in->gz, idx[ii]);
+        blasfeo_dveccp(nx[ii], tmp+1, nu[ii], lam+ii%2, 0);
+    }
+    blasfeo_dveccp(nx[0], lam+0, 0, fcond_qp_in->gz, idx[N+1]);
+
+    return;
+}
+
+
+
+// blocked condensing: hpipm condenses dynamics and constraints, Hessian and gradient are computed above
+static void ocp_qp_full_condensing_cond_blocked(int cond_lhs, int cond_rhs, dense_qp_in *fcond_qp_in,
+                ocp_qp_full_condensing_opts *opts, ocp_qp_full_condensing_memory *mem)
+{
+    ocp_qp_in *red_qp = mem->red_qp;
+    struct d_cond_qp_arg *cond_arg = opts->hpipm_cond_opts;
+    struct d_cond_qp_ws *cond_ws = mem->hpipm_cond_work;
+
+    if (cond_lhs && cond_rhs)
+    {
+        d_cond_BAbt(red_qp, NULL, NULL, cond_arg, cond_ws);
+        ocp_qp_full_condensing_blocked_hess(red_qp, fcond_qp_in, mem);
+        ocp_qp_full_condensing_blocked_grad(red_qp, fcond_qp_in, mem);
+        d_cond_DCtd(red_qp, fcond_qp_in->idxb, fcond_qp_in->Ct, fcond_qp_in->d, fcond_qp_in->d_mask,
+                    fcond_qp_in->idxs_rev, fcond_qp_in->Z, fcond_qp_in->gz, cond_arg, cond_ws);
+    }
+    else if (cond_lhs)
+    {
+        d_cond_BAt(red_qp, NULL, cond_arg, cond_ws);
+        ocp_qp_full_condensing_blocked_hess(red_qp, fcond_qp_in, mem);
+        d_cond_DCt(red_qp, fcond_qp_in->idxb, fcond_qp_in->Ct, fcond_qp_in->idxs_rev, fcond_qp_in->Z,
+                   cond_arg, cond_ws);
+    }
+    else
+    {
+        d_cond_b(red_qp, NULL, cond_arg, cond_ws);
+        ocp_qp_full_condensing_blocked_grad(red_qp, fcond_qp_in, mem);
+        d_cond_d(red_qp, fcond_qp_in->d, fcond_qp_in->d_mask, fcond_qp_in->gz, cond_arg, cond_ws);
+    }
+
+    return;
+}
+
+
+
 int ocp_qp_full_condensing(void *qp_in_, void *fcond_qp_in_, void *opts_, void *mem_, void *work_)
 {
     ocp_qp_in *qp_in = qp_in_;
@@ -454,6 +935,8 @@ int ocp_qp_full_condensing(void *qp_in_, void *fcond_qp_in_, void *opts_, void *
     // save pointer to ocp_qp_in in memory (needed for expansion)
     mem->ptr_qp_in = qp_in;
 
+    ocp_qp_full_condensing_check_memory_opts(opts, mem);
+
     // start timer
     acados_tic(&timer);
 
@@ -470,6 +953,20 @@ int ocp_qp_full_condensing(void *qp_in_, void *fcond_qp_in_, void *opts_, void *
     if (opts->cond_hess == 0)
     {
         // condense gradient only
+        if (mem->blocked)
+            ocp_qp_full_condensing_cond_blocked(0, 1, fcond_qp_in, opts, mem);
+        else
+            d_cond_qp_cond_rhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
+    }
+    else if (mem->blocked)
+    {
+        // condense gradient and Hessian, blocked backward recursion
+        ocp_qp_full_condensing_cond_blocked(1, 1, fcond_qp_in, opts, mem);
+    }
+    else if (opts->incremental)
+    {
+        // condense Hessian of changed stages, then gradient
+        ocp_qp_full_condensing_cond_lhs_incremental(fcond_qp_in, opts, mem);
         d_cond_qp_cond_rhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
     }
     else
@@ -497,6 +994,8 @@ int ocp_qp_full_condensing_condense_lhs(void *qp_in_, void *fcond_qp_in_, void *
     // save pointer to ocp_qp_in in memory (needed for expansion)
     mem->ptr_qp_in = qp_in;
 
+    ocp_qp_full_condensing_check_memory_opts(opts, mem);
+
     // start timer
     acados_tic(&timer);
 
@@ -504,7 +1003,12 @@ int ocp_qp_full_condensing_condense_lhs(void *qp_in_, void *fcond_qp_in_, void *
     d_ocp_qp_reduce_eq_dof_lhs(qp_in, mem->red_qp, opts->hpipm_red_opts, mem->hpipm_red_work);
 
     // condense Hessian
-    d_cond_qp_cond_lhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
+    if (opts->incremental)
+        ocp_qp_full_condensing_cond_lhs_incremental(fcond_qp_in, opts, mem);
+    else if (mem->blocked)
+        ocp_qp_full_condensing_cond_blocked(1, 0, fcond_qp_in, opts, mem);
+    else
+        d_cond_qp_cond_lhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
 
     // stop timer
     mem->time_qp_xcond = acados_toc(&timer);
@@ -529,11 +1033,16 @@ int ocp_qp_full_condensing_condense_rhs(void *qp_in_, void *fcond_qp_in_, void *
     // save pointer to ocp_qp_in in memory (needed for expansion)
     mem->ptr_qp_in = qp_in;
 
+    ocp_qp_full_condensing_check_memory_opts(opts, mem);
+
     // reduce eq constr DOF
     d_ocp_qp_reduce_eq_dof_rhs(qp_in, mem->red_qp, opts->hpipm_red_opts, mem->hpipm_red_work);
 
     // condense gradient only
-    d_cond_qp_cond_rhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
+    if (mem->blocked)
+        ocp_qp_full_condensing_cond_blocked(0, 1, fcond_qp_in, opts, mem);
+    else
+        d_cond_qp_cond_rhs(mem->red_qp, fcond_qp_in, opts->hpipm_cond_opts, mem->hpipm_cond_work);
 
     // stop timer
     mem->time_qp_xcond += acados_toc(&timer);
@@ -63,6 +63,9 @@ typedef struct ocp_qp_full_condensing_opts_
     int expand_dual_sol; // 0 primal sol only, 1 primal + dual sol
     int ric_alg;
     int mem_qp_in; // allocate qp_in in memory
+    int incremental; // 1: update condensed lhs only for stages whose data changed (uses ric_alg = 0); set before memory creation
+    int hess_alg; // 0 hpipm condensing, 1 blocked backward condensing of Hessian and gradient, 2 choose by problem size; set before memory creation
+    int l2_size; // L2 cache size in bytes, sets the segment length of hess_alg 1 and the choice of hess_alg 2; set before memory creation
 } ocp_qp_full_condensing_opts;
 
 
@@ -80,6 +83,26 @@ typedef struct ocp_qp_full_condensing_memory_
     ocp_qp_in *ptr_qp_in;
     qp_info *qp_out_info; // info in fcond_qp_in
     double time_qp_xcond;
+    // incremental condensing
+    ocp_qp_in *red_qp_lhs; // lhs of the reduced qp at the last condensing
+    int *idxc; // stages with changed lhs
+    int lhs_valid;
+    int n_stages_cond; // number of stages recondensed in the last call
+    // blocked Hessian condensing
+    int blocked; // hess_alg resolved for the reduced qp dims
+    int hess_alg; // opts at memory creation
+    int l2_size;
+    int n_seg; // number of Hessian block rows per segment
+    int *blk_idx; // offset of u_k in the condensed variables, x_0 at blk_idx[N+1]
+    struct blasfeo_dmat *blk_D; // D_k = S_k + B_k' P_{k+1} A_k
+    struct blasfeo_dmat *blk_F; // D_i A_{i-1} ... A_j, one per block row
+    struct blasfeo_dmat *blk_F_tmp;
+    struct blasfeo_dmat *blk_P; // 2, cost-to-go Hessian of the states
+    struct blasfeo_dmat *blk_W; // RSQ_k + BAbt_k P_{k+1} BAbt_k'
+    struct blasfeo_dmat *blk_M; // BAbt_k P_{k+1}
+    struct blasfeo_dvec *blk_c; // state offset, x_k = c_k for zero condensed variables
+    struct blasfeo_dvec *blk_lam; // 2, cost-to-go gradient of the states
+    struct blasfeo_dvec *blk_tmp; // 2
 } ocp_qp_full_condensing_memory;
 
 
@@ -37,6 +37,10 @@
 #include "hpipm/include/hpipm_d_ocp_qp.h"
 #include "hpipm/include/hpipm_d_ocp_qp_ipm.h"
 #include "hpipm/include/hpipm_d_ocp_qp_sol.h"
+#include "hpipm/include/hpipm_s_ocp_qp.h"
+#include "hpipm/include/hpipm_s_ocp_qp_dim.h"
+#include "hpipm/include/hpipm_s_ocp_qp_ipm.h"
+#include "hpipm/include/hpipm_s_ocp_qp_sol.h"
 
 // uncomment to codegen QP
 // #include "hpipm/include/hpipm_d_ocp_qp_utils.h"
@@ -51,10 +55,155 @@
 
 
 
+/************************************************
+ * precision conversion
+ ************************************************/
+
+static void ocp_qp_hpipm_cvt_d2s_dim(ocp_qp_dims *dims, struct s_ocp_qp_dim *dim_single)
+{
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        s_ocp_qp_dim_set("nx", ii, dims->nx[ii], dim_single);
+        s_ocp_qp_dim_set("nu", ii, dims->nu[ii], dim_single);
+        s_ocp_qp_dim_set("nbx", ii, dims->nbx[ii], dim_single);
+        s_ocp_qp_dim_set("nbu", ii, dims->nbu[ii], dim_single);
+        s_ocp_qp_dim_set("ng", ii, dims->ng[ii], dim_single);
+        s_ocp_qp_dim_set("nsbx", ii, dims->nsbx[ii], dim_single);
+        s_ocp_qp_dim_set("nsbu", ii, dims->nsbu[ii], dim_single);
+        s_ocp_qp_dim_set("nsg", ii, dims->nsg[ii], dim_single);
+        s_ocp_qp_dim_set("nbxe", ii, dims->nbxe[ii], dim_single);
+        s_ocp_qp_dim_set("nbue", ii, dims->nbue[ii], dim_single);
+        s_ocp_qp_dim_set("nge", ii, dims->nge[ii], dim_single);
+    }
+}
+
+
+
+static void cvt_d2s_mat(int m, int n, struct blasfeo_dmat *A, struct blasfeo_smat *sA)
+{
+    for (int jj = 0; jj < n; jj++)
+        for (int ii = 0; ii < m; ii++)
+            BLASFEO_SMATEL(sA, ii, jj) = (float) BLASFEO_DMATEL(A, ii, jj);
+}
+
+
+
+static void cvt_d2s_vec(int m, struct blasfeo_dvec *x, struct blasfeo_svec *sx)
+{
+    for (int ii = 0; ii < m; ii++)
+        BLASFEO_SVECEL(sx, ii) = (float) BLASFEO_DVECEL(x, ii);
+}
+
+
+
+static void cvt_s2d_vec(int m, struct blasfeo_svec *sx, struct blasfeo_dvec *x)
+{
+    for (int ii = 0; ii < m; ii++)
+        BLASFEO_DVECEL(x, ii) = (double) BLASFEO_SVECEL(sx, ii);
+}
+
+
+
+static void ocp_qp_hpipm_cvt_d2s_qp(ocp_qp_in *qp_in, struct s_ocp_qp *qp_single)
+{
+    ocp_qp_dims *dims = qp_in->dim;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+    int *ns = dims->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        if (ii < N)
+        {
+            cvt_d2s_mat(nu[ii]+nx[ii]+1, nx[ii+1], qp_in->BAbt+ii, qp_single->BAbt+ii);
+            cvt_d2s_vec(nx[ii+1], qp_in->b+ii, qp_single->b+ii);
+        }
+        cvt_d2s_mat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], qp_in->RSQrq+ii, qp_single->RSQrq+ii);
+        cvt_d2s_vec(nu[ii]+nx[ii]+2*ns[ii], qp_in->rqz+ii, qp_single->rqz+ii);
+        cvt_d2s_mat(nu[ii]+nx[ii], ng[ii], qp_in->DCt+ii, qp_single->DCt+ii);
+        cvt_d2s_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], qp_in->d+ii, qp_single->d+ii);
+        cvt_d2s_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], qp_in->d_mask+ii, qp_single->d_mask+ii);
+        cvt_d2s_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], qp_in->m+ii, qp_single->m+ii);
+        cvt_d2s_vec(2*ns[ii], qp_in->Z+ii, qp_single->Z+ii);
+
+        for (int jj = 0; jj < nb[ii]; jj++)
+            qp_single->idxb[ii][jj] = qp_in->idxb[ii][jj];
+        for (int jj = 0; jj < nb[ii]+ng[ii]; jj++)
+            qp_single->idxs_rev[ii][jj] = qp_in->idxs_rev[ii][jj];
+        for (int jj = 0; jj < dims->nbxe[ii]+dims->nbue[ii]+dims->nge[ii]; jj++)
+            qp_single->idxe[ii][jj] = qp_in->idxe[ii][jj];
+        qp_single->diag_H_flag[ii] = qp_in->diag_H_flag[ii];
+    }
+}
+
+
+
+static void ocp_qp_hpipm_cvt_d2s_sol(ocp_qp_dims *dims, ocp_qp_out *qp_out, struct s_ocp_qp_sol *sol_single)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+    int *ns = dims->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        cvt_d2s_vec(nu[ii]+nx[ii]+2*ns[ii], qp_out->ux+ii, sol_single->ux+ii);
+        if (ii < N)
+            cvt_d2s_vec(nx[ii+1], qp_out->pi+ii, sol_single->pi+ii);
+        cvt_d2s_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], qp_out->lam+ii, sol_single->lam+ii);
+        cvt_d2s_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], qp_out->t+ii, sol_single->t+ii);
+    }
+}
+
+
+
+static void ocp_qp_hpipm_cvt_s2d_sol(ocp_qp_dims *dims, struct s_ocp_qp_sol *sol_single, ocp_qp_out *qp_out)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+    int *ns = dims->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        cvt_s2d_vec(nu[ii]+nx[ii]+2*ns[ii], sol_single->ux+ii, qp_out->ux+ii);
+        if (ii < N)
+            cvt_s2d_vec(nx[ii+1], sol_single->pi+ii, qp_out->pi+ii);
+        cvt_s2d_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], sol_single->lam+ii, qp_out->lam+ii);
+        cvt_s2d_vec(2*nb[ii]+2*ng[ii]+2*ns[ii], sol_single->t+ii, qp_out->t+ii);
+    }
+}
+
+
+
 /************************************************
  * opts
  ************************************************/
 
+// size of the single precision arg, with the same dims as in ocp_qp_hpipm_opts_assign
+static acados_size_t ocp_qp_hpipm_single_opts_memsize(ocp_qp_dims *dims)
+{
+    struct s_ocp_qp_dim dim_single;
+    void *dim_single_mem = acados_calloc(1, s_ocp_qp_dim_memsize(dims->N));
+    s_ocp_qp_dim_create(dims->N, &dim_single, dim_single_mem);
+    ocp_qp_hpipm_cvt_d2s_dim(dims, &dim_single);
+
+    acados_size_t size = s_ocp_qp_ipm_arg_memsize(&dim_single);
+
+    free(dim_single_mem);
+
+    return size;
+}
+
+
+
 acados_size_t ocp_qp_hpipm_opts_calculate_size(void *config_, void *dims_)
 {
     ocp_qp_dims *dims = dims_;
@@ -64,7 +213,13 @@ acados_size_t ocp_qp_hpipm_opts_calculate_size(void *config_, void *dims_)
     size += sizeof(struct d_ocp_qp_ipm_arg);
     size += d_ocp_qp_ipm_arg_memsize(dims);
 
-    size += 1 * 8;
+    // mixed precision
+    size += sizeof(struct s_ocp_qp_dim);
+    size += s_ocp_qp_dim_memsize(dims->N);
+    size += sizeof(struct s_ocp_qp_ipm_arg);
+    size += ocp_qp_hpipm_single_opts_memsize(dims);
+
+    size += 3 * 8;
     make_int_multiple_of(8, &size);
 
     return size;
@@ -91,6 +246,22 @@ void *ocp_qp_hpipm_opts_assign(void *config_, void *dims_, void *raw_memory)
     d_ocp_qp_ipm_arg_create(dims, opts->hpipm_opts, c_ptr);
     c_ptr += d_ocp_qp_ipm_arg_memsize(dims);
 
+    // mixed precision
+    opts->dim_single = (struct s_ocp_qp_dim *) c_ptr;
+    c_ptr += sizeof(struct s_ocp_qp_dim);
+
+    opts->hpipm_opts_single = (struct s_ocp_qp_ipm_arg *) c_ptr;
+    c_ptr += sizeof(struct s_ocp_qp_ipm_arg);
+
+    align_char_to(8, &c_ptr);
+    s_ocp_qp_dim_create(dims->N, opts->dim_single, c_ptr);
+    c_ptr += s_ocp_qp_dim_memsize(dims->N);
+    ocp_qp_hpipm_cvt_d2s_dim(dims, opts->dim_single);
+
+    align_char_to(8, &c_ptr);
+    s_ocp_qp_ipm_arg_create(opts->dim_single, opts->hpipm_opts_single, c_ptr);
+    c_ptr += s_ocp_qp_ipm_arg_memsize(opts->dim_single);
+
     assert((char *) raw_memory + ocp_qp_hpipm_opts_calculate_size(config_, dims) >= c_ptr);
 
     return (void *) opts;
@@ -109,6 +280,16 @@ static void ocp_qp_hpipm_opts_overwrite_mode_opts(ocp_qp_hpipm_opts *opts)
     opts->hpipm_opts->alpha_min = 1e-8;
     opts->hpipm_opts->mu0 = 1e0;
     opts->hpipm_opts->var_init_scheme = 1;
+
+    // single precision: tolerances close to float epsilon, the rest is left to the refinement
+    opts->hpipm_opts_single->res_g_max = 1e-4;
+    opts->hpipm_opts_single->res_b_max = 1e-4;
+    opts->hpipm_opts_single->res_d_max = 1e-4;
+    opts->hpipm_opts_single->res_m_max = 1e-4;
+    opts->hpipm_opts_single->iter_max = 50;
+    opts->hpipm_opts_single->stat_max = 50;
+    opts->hpipm_opts_single->alpha_min = 1e-8;
+    opts->hpipm_opts_single->mu0 = 1e0;
 }
 
 
@@ -119,9 +300,15 @@ void ocp_qp_hpipm_opts_initialize_default(void *config_, void *dims_, void *opts
 
 //    d_ocp_qp_ipm_arg_set_default(SPEED, opts->hpipm_opts);
     d_ocp_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts);
+    s_ocp_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts_single);
 
     ocp_qp_hpipm_opts_overwrite_mode_opts(opts);
     opts->print_level = 0;
+    opts->time_limit = 0.0;
+    opts->mixed_precision = 0;
+    opts->mixed_precision_refine_iter_max = 5;
+    opts->log_stat = 0;
+    opts->lhs_unchanged = 0;
 
     return;
 }
@@ -146,13 +333,25 @@ void ocp_qp_hpipm_opts_set(void *config_, void *opts_, const char *field, void *
     {
         mode = (const char *) value;
         if (!strcmp(mode, "BALANCE"))
+        {
             d_ocp_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts);
+            s_ocp_qp_ipm_arg_set_default(BALANCE, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "SPEED"))
+        {
             d_ocp_qp_ipm_arg_set_default(SPEED, opts->hpipm_opts);
+            s_ocp_qp_ipm_arg_set_default(SPEED, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "SPEED_ABS"))
+        {
             d_ocp_qp_ipm_arg_set_default(SPEED_ABS, opts->hpipm_opts);
+            s_ocp_qp_ipm_arg_set_default(SPEED_ABS, opts->hpipm_opts_single);
+        }
         else if (!strcmp(mode, "ROBUST"))
+        {
             d_ocp_qp_ipm_arg_set_default(ROBUST, opts->hpipm_opts);
+            s_ocp_qp_ipm_arg_set_default(ROBUST, opts->hpipm_opts_single);
+        }
 
         ocp_qp_hpipm_opts_overwrite_mode_opts(opts);
 
@@ -162,6 +361,47 @@ void ocp_qp_hpipm_opts_set(void *config_, void *opts_, const char *field, void *
         int* print_level = (int *) value;
         opts->print_level = *print_level;
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        double* time_limit = (double *) value;
+        opts->time_limit = *time_limit;
+    }
+    else if (!strcmp(field, "mixed_precision"))
+    {
+        int* mixed_precision = (int *) value;
+        opts->mixed_precision = *mixed_precision;
+    }
+    else if (!strcmp(field, "mixed_precision_refine_iter_max"))
+    {
+        int* refine_iter_max = (int *) value;
+        if (*refine_iter_max < 1)
+        {
+            printf("\nerror: ocp_qp_hpipm_opts_set: mixed_precision_refine_iter_max must be >= 1, got %d.\n",
+                   *refine_iter_max);
+            exit(1);
+        }
+        opts->mixed_precision_refine_iter_max = *refine_iter_max;
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        int* lhs_unchanged = (int *) value;
+        opts->lhs_unchanged = *lhs_unchanged;
+    }
+    else if (!strcmp(field, "log_stat"))
+    {
+        int* log_stat = (int *) value;
+        opts->log_stat = *log_stat;
+    }
+    else if (!strcmp(field, "mixed_precision_tol"))
+    {
+        // tolerance of the single-precision IPM on all residuals
+        double* tol = (double *) value;
+        float tol_single = (float) *tol;
+        s_ocp_qp_ipm_arg_set_tol_stat(&tol_single, opts->hpipm_opts_single);
+        s_ocp_qp_ipm_arg_set_tol_eq(&tol_single, opts->hpipm_opts_single);
+        s_ocp_qp_ipm_arg_set_tol_ineq(&tol_single, opts->hpipm_opts_single);
+        s_ocp_qp_ipm_arg_set_tol_comp(&tol_single, opts->hpipm_opts_single);
+    }
     else
     {
         d_ocp_qp_ipm_arg_set((char *) field, value, opts->hpipm_opts);
@@ -188,6 +428,21 @@ acados_size_t ocp_qp_hpipm_memory_calculate_size(void *config_, void *dims_, voi
 
     size += d_ocp_qp_ipm_ws_memsize(dims, opts->hpipm_opts);
 
+    // mixed precision
+    if (opts->mixed_precision)
+    {
+        size += sizeof(struct s_ocp_qp);
+        size += sizeof(struct s_ocp_qp_sol);
+        size += sizeof(struct s_ocp_qp_ipm_ws);
+        size += s_ocp_qp_memsize(opts->dim_single);
+        size += s_ocp_qp_sol_memsize(opts->dim_single);
+        size += s_ocp_qp_ipm_ws_memsize(opts->dim_single, opts->hpipm_opts_single);
+        size += 3 * 8;
+    }
+
+    if (opts->log_stat)
+        size += (opts->hpipm_opts->iter_max + 1) * QP_STAT_N * sizeof(double) + 8;
+
     size += 1 * 8;
     make_int_multiple_of(8, &size);
 
@@ -220,6 +475,59 @@ void *ocp_qp_hpipm_memory_assign(void *config_, void *dims_, void *opts_, void *
     d_ocp_qp_ipm_ws_create(dims, opts->hpipm_opts, ipm_workspace, c_ptr);
     c_ptr += ipm_workspace->memsize;
 
+    // mixed precision
+    if (opts->mixed_precision)
+    {
+        mem->qp_single = (struct s_ocp_qp *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp);
+        mem->sol_single = (struct s_ocp_qp_sol *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_sol);
+        mem->hpipm_workspace_single = (struct s_ocp_qp_ipm_ws *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_ipm_ws);
+
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_create(opts->dim_single, mem->qp_single, c_ptr);
+        c_ptr += s_ocp_qp_memsize(opts->dim_single);
+
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_sol_create(opts->dim_single, mem->sol_single, c_ptr);
+        c_ptr += s_ocp_qp_sol_memsize(opts->dim_single);
+
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_ipm_ws_create(opts->dim_single, opts->hpipm_opts_single, mem->hpipm_workspace_single, c_ptr);
+        c_ptr += mem->hpipm_workspace_single->memsize;
+    }
+    else
+    {
+        mem->qp_single = NULL;
+        mem->sol_single = NULL;
+        mem->hpipm_workspace_single = NULL;
+    }
+    mem->iter_single = 0;
+    mem->mixed_precision_used = 0;
+
+    if (opts->log_stat)
+    {
+        mem->stat_max = opts->hpipm_opts->iter_max + 1;
+        align_char_to(8, &c_ptr);
+        assign_and_advance_double(mem->stat_max * QP_STAT_N, &mem->stat, &c_ptr);
+    }
+    else
+    {
+        mem->stat_max = 0;
+        mem->stat = NULL;
+    }
+    mem->stat_rows = 0;
+
+    int nc = 0;
+    for (int ii = 0; ii <= dims->N; ii++)
+        nc += dims->nb[ii] + dims->ng[ii] + dims->ns[ii];
+    mem->unconstrained = nc == 0;
+    mem->fact_valid = 0;
+    mem->fact_reused = 0;
+
+    mem->time_per_iter = 0.0;
+
     assert((char *) raw_memory + ocp_qp_hpipm_memory_calculate_size(config_, dims, opts_) >= c_ptr);
 
     return mem;
@@ -247,6 +555,41 @@ void ocp_qp_hpipm_memory_get(void *config_, void *mem_, const char *field, void*
         int *tmp_ptr = value;
         *tmp_ptr = mem->status;
     }
+    else if (!strcmp(field, "iter_single"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->iter_single;
+    }
+    else if (!strcmp(field, "mixed_precision_used"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->mixed_precision_used;
+    }
+    else if (!strcmp(field, "stat"))
+    {
+        if (mem->stat == NULL)
+        {
+            printf("\nerror: ocp_qp_hpipm_memory_get: option log_stat was not set\n");
+            exit(1);
+        }
+        double **tmp_ptr = value;
+        *tmp_ptr = mem->stat;
+    }
+    else if (!strcmp(field, "stat_m"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->stat_rows;
+    }
+    else if (!strcmp(field, "stat_n"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = QP_STAT_N;
+    }
+    else if (!strcmp(field, "fact_reused"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->fact_reused;
+    }
     else
     {
         printf("\nerror: ocp_qp_hpipm_memory_get: field %s not available\n", field);
@@ -274,6 +617,81 @@ acados_size_t ocp_qp_hpipm_workspace_calculate_size(void *config_, void *dims_,
  * functions
  ************************************************/
 
+// single-precision IPM followed by a few double-precision IPM iterations warm-started from its solution,
+// returns true if the double-precision tolerances are met;
+// with time_limited, both IPMs share the iteration budget arg->iter_max
+static bool ocp_qp_hpipm_solve_mixed_precision(ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                               ocp_qp_hpipm_opts *opts, ocp_qp_hpipm_memory *mem, int time_limited)
+{
+    struct d_ocp_qp_ipm_arg *arg = opts->hpipm_opts;
+    struct s_ocp_qp_ipm_arg *arg_single = opts->hpipm_opts_single;
+    int status_single;
+
+    ocp_qp_hpipm_cvt_d2s_qp(qp_in, mem->qp_single);
+    arg_single->warm_start = arg->warm_start;
+    if (arg->warm_start)
+        ocp_qp_hpipm_cvt_d2s_sol(qp_in->dim, qp_out, mem->sol_single);
+
+    s_ocp_qp_ipm_solve(mem->qp_single, mem->sol_single, arg_single, mem->hpipm_workspace_single);
+    s_ocp_qp_ipm_get_status(mem->hpipm_workspace_single, &status_single);
+    mem->iter_single = mem->hpipm_workspace_single->iter;
+
+    // MAXITER in single precision is still a useful starting point for the refinement
+    if (status_single != 0 && status_single != 1)
+        return false;
+
+    // refinement on the double-precision QP
+    ocp_qp_hpipm_cvt_s2d_sol(qp_in->dim, mem->sol_single, qp_out);
+
+    int warm_start = arg->warm_start;
+    int iter_max = arg->iter_max;
+    arg->warm_start = 2;
+    arg->iter_max = opts->mixed_precision_refine_iter_max;
+    if (time_limited && iter_max - mem->iter_single < arg->iter_max)
+        arg->iter_max = iter_max - mem->iter_single < 1 ? 1 : iter_max - mem->iter_single;
+    d_ocp_qp_ipm_solve(qp_in, qp_out, arg, mem->hpipm_workspace);
+    d_ocp_qp_ipm_get_status(mem->hpipm_workspace, &mem->status);
+    arg->warm_start = warm_start;
+    arg->iter_max = iter_max;
+
+    return mem->status == 0;
+}
+
+
+
+// copy the relevant columns of the HPIPM statistics of the last (double-precision) IPM
+static void ocp_qp_hpipm_log_stat(ocp_qp_hpipm_memory *mem)
+{
+    double *stat;
+    int stat_m;
+    d_ocp_qp_ipm_get_stat(mem->hpipm_workspace, &stat);
+    d_ocp_qp_ipm_get_stat_m(mem->hpipm_workspace, &stat_m);
+
+    int n_row = mem->hpipm_workspace->iter + 1;
+    if (n_row > mem->stat_max)
+        n_row = mem->stat_max;
+
+    // HPIPM columns: alpha_aff, mu_aff, sigma, alpha_prim, alpha_dual, mu, res_stat, res_eq,
+    // res_ineq, res_comp, obj, lq fact, itref pred, itref corr, ...
+    for (int ii = 0; ii < n_row; ii++)
+    {
+        double *hpipm_row = stat + ii * stat_m;
+        double *row = mem->stat + ii * QP_STAT_N;
+        row[QP_STAT_ALPHA_PRIM] = hpipm_row[3];
+        row[QP_STAT_ALPHA_DUAL] = hpipm_row[4];
+        row[QP_STAT_MU] = hpipm_row[5];
+        row[QP_STAT_RES_STAT] = hpipm_row[6];
+        row[QP_STAT_RES_EQ] = hpipm_row[7];
+        row[QP_STAT_RES_INEQ] = hpipm_row[8];
+        row[QP_STAT_RES_COMP] = hpipm_row[9];
+        row[QP_STAT_ITREF_PRED] = hpipm_row[12];
+        row[QP_STAT_ITREF_CORR] = hpipm_row[13];
+    }
+    mem->stat_rows = n_row;
+}
+
+
+
 int ocp_qp_hpipm(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
 {
     ocp_qp_in *qp_in = qp_in_;
@@ -299,11 +717,63 @@ int ocp_qp_hpipm(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *
         blasfeo_dvecse(nu[ii]+nx[ii]+2*ns[ii], 0.0, qp_out->ux+ii, 0);
     }
 
+    // enforce time limit by capping the number of iterations
+    int iter_max = opts->hpipm_opts->iter_max;
+    int iter_max_single = opts->hpipm_opts_single->iter_max;
+    int time_limited = opts->time_limit > 0.0 && mem->time_per_iter > 0.0;
+    if (time_limited)
+    {
+        int iter_max_time = (int) (opts->time_limit / mem->time_per_iter);
+        if (iter_max_time < 1)
+            iter_max_time = 1;
+        opts->hpipm_opts->iter_max = iter_max_time < iter_max ? iter_max_time : iter_max;
+        opts->hpipm_opts_single->iter_max = iter_max_time < iter_max_single ? iter_max_time : iter_max_single;
+    }
+
+    // the single-precision workspace only exists if mixed_precision was set before memory creation
+    int mixed_precision = opts->mixed_precision && mem->qp_single != NULL;
+
     // solve ipm
     acados_tic(&qp_timer);
     // print_ocp_qp_in(qp_in);
-    d_ocp_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
-    d_ocp_qp_ipm_get_status(mem->hpipm_workspace, &mem->status);
+    mem->iter_single = 0;
+    mem->mixed_precision_used = 0;
+    mem->fact_reused = opts->lhs_unchanged && mem->fact_valid;
+    if (mem->fact_reused)
+    {
+        // without inequality constraints the solution is linear in the QP vectors:
+        // one KKT solve with the stored factorization, taking the QP itself as parametric QP
+        d_ocp_qp_ipm_sens(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+        mem->status = 0;
+    }
+    else
+    {
+        if (mixed_precision)
+        {
+            mem->mixed_precision_used = ocp_qp_hpipm_solve_mixed_precision(qp_in, qp_out, opts, mem, time_limited);
+        }
+        if (!mem->mixed_precision_used)
+        {
+            if (mixed_precision)
+            {
+                // refinement stalled, fall back to double precision with the remaining budget
+                if (time_limited)
+                {
+                    int iter_left = opts->hpipm_opts->iter_max - mem->iter_single;
+                    opts->hpipm_opts->iter_max = iter_left < 1 ? 1 : iter_left;
+                }
+                for(ii=0; ii<=N; ii++)
+                {
+                    blasfeo_dvecse(nu[ii]+nx[ii]+2*ns[ii], 0.0, qp_out->ux+ii, 0);
+                }
+            }
+            d_ocp_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+            d_ocp_qp_ipm_get_status(mem->hpipm_workspace, &mem->status);
+        }
+        mem->fact_valid = mem->unconstrained && mem->status == 0;
+    }
+    opts->hpipm_opts->iter_max = iter_max;
+    opts->hpipm_opts_single->iter_max = iter_max_single;
 
     /* use this to send some QPs to Gianluca :) */
     // printf("\ncodegen HPIPM QP\n");
@@ -314,15 +784,25 @@ int ocp_qp_hpipm(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *
     info->solve_QP_time = acados_toc(&qp_timer);
     info->interface_time = 0;  // there are no conversions for hpipm
     info->total_time = acados_toc(&tot_timer);
-    info->num_iter = mem->hpipm_workspace->iter;
+    info->num_iter = mem->fact_reused ? 0 : mem->iter_single + mem->hpipm_workspace->iter;
     info->t_computed = 1;
 
     mem->time_qp_solver_call = info->solve_QP_time;
-    mem->iter = mem->hpipm_workspace->iter;
+    mem->iter = info->num_iter;
+    if (mem->iter > 0)
+        mem->time_per_iter = mem->time_qp_solver_call / mem->iter;
+
+    if (opts->log_stat)
+    {
+        if (mem->fact_reused)
+            mem->stat_rows = 0;
+        else
+            ocp_qp_hpipm_log_stat(mem);
+    }
 
     // print HPIPM statistics:
 #ifndef BLASFEO_EXT_DEP_OFF
-    if (opts->print_level > 0)
+    if (opts->print_level > 0 && !mem->fact_reused)
     {
         double *stat; d_ocp_qp_ipm_get_stat(mem->hpipm_workspace, &stat);
         int stat_m; d_ocp_qp_ipm_get_stat_m(mem->hpipm_workspace, &stat_m);
@@ -350,6 +830,14 @@ void ocp_qp_hpipm_memory_reset(void *config_, void *qp_in_, void *qp_out_, void
     ocp_qp_hpipm_memory_assign(config_, qp_in->dim, opts_, mem_);
 }
 
+
+
+void ocp_qp_hpipm_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    // the warm start of HPIPM is taken from qp_out, the setup and the factorization cache are kept
+    ocp_qp_out_set_zero(qp_out_);
+}
+
 void ocp_qp_hpipm_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     ocp_qp_in *qp_in = qp_in_;
@@ -466,6 +954,7 @@ void ocp_qp_hpipm_config_initialize_default(void *config_)
     config->evaluate = &ocp_qp_hpipm;
     config->solver_get = &ocp_qp_hpipm_solver_get;
     config->memory_reset = &ocp_qp_hpipm_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_hpipm_memory_reset_warm_start;
     config->eval_sens = &ocp_qp_hpipm_eval_sens;
     config->terminate = &ocp_qp_hpipm_terminate;
 
@@ -142,6 +142,14 @@ void ocp_qp_hpmpc_opts_set(void *config_, void *opts_, const char *field, void *
         int *tmp_ptr = value;
         opts->warm_start = *tmp_ptr;
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: ocp_qp_hpmpc_opts_set: wrong field: %s\n", field);
@@ -366,6 +374,13 @@ void ocp_qp_hpmpc_memory_reset(void *config_, void *qp_in_, void *qp_out_, void
 
 
 
+void ocp_qp_hpmpc_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    ocp_qp_out_set_zero(qp_out_);
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -605,6 +620,7 @@ void ocp_qp_hpmpc_config_initialize_default(void *config_)
     config->evaluate = &ocp_qp_hpmpc;
     config->eval_sens = &ocp_qp_hpmpc_eval_sens;
     config->memory_reset = &ocp_qp_hpmpc_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_hpmpc_memory_reset_warm_start;
     config->solver_get = &ocp_qp_hpmpc_solver_get;
     config->terminate = &ocp_qp_hpmpc_terminate;
 
@@ -118,6 +118,8 @@ int ocp_qp_hpmpc(void *config_, void *qp_in, void *qp_out, void *opts_, void *me
 //
 void ocp_qp_hpmpc_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_);
 //
+void ocp_qp_hpmpc_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void ocp_qp_hpmpc_eval_sens(void *config_, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
 //
 void ocp_qp_hpmpc_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
@@ -885,6 +885,14 @@ void ocp_qp_ooqp_opts_set(void *config_, void *opts_, const char *field, void *v
     {
         // TODO set solver warm start
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: ocp_qp_ooqp_opts_set: wrong field: %s\n", field);
@@ -1034,6 +1042,13 @@ void ocp_qp_ooqp_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *
 }
 
 
+
+void ocp_qp_ooqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    ocp_qp_out_set_zero(qp_out_);
+}
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -1200,6 +1215,7 @@ void ocp_qp_ooqp_config_initialize_default(void *config_)
     config->evaluate = (int (*)(void *, void *, void *, void *, void *, void *)) & ocp_qp_ooqp;
     config->eval_sens = &ocp_qp_ooqp_eval_sens;
     config->memory_reset = &ocp_qp_ooqp_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_ooqp_memory_reset_warm_start;
     config->solver_get = &ocp_qp_ooqp_solver_get;
     config->terminate = &ocp_qp_ooqp_terminate;
 
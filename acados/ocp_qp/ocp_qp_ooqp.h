@@ -137,6 +137,8 @@ void ocp_qp_ooqp_eval_sens(void *config_, void *qp_in, void *qp_out, void *opts_
 //
 void ocp_qp_ooqp_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_);
 //
+void ocp_qp_ooqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void ocp_qp_ooqp_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
 //
 void ocp_qp_ooqp_config_initialize_default(void *config_);
@@ -1059,6 +1059,14 @@ void ocp_qp_osqp_opts_set(void *config_, void *opts_, const char *field, void *v
         opts->osqp_opts->warm_start = *tmp_ptr;
         // printf("\nwarm start %d\n", opts->osqp_opts->warm_start);
     }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: ocp_qp_osqp_opts_set: wrong field: %s\n", field);
@@ -1486,6 +1494,7 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->P_nnzmax = P_nnzmax;
     mem->A_nnzmax = A_nnzmax;
     mem->first_run = 1;
+    mem->num_setup = 0;
 
     align_char_to(8, &c_ptr);
 
@@ -1571,6 +1580,11 @@ void ocp_qp_osqp_memory_get(void *config_, void *mem_, const char *field, void*
         int *tmp_ptr = value;
         *tmp_ptr = mem->status;
     }
+    else if (!strcmp(field, "num_setup"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_setup;
+    }
     else
     {
         printf("\nerror: ocp_qp_osqp_memory_get: field %s not available\n", field);
@@ -1592,6 +1606,30 @@ void ocp_qp_osqp_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *
 
 
 
+void ocp_qp_osqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    ocp_qp_osqp_memory *mem = mem_;
+
+    ocp_qp_out_set_zero(qp_out_);
+
+    // keep the OSQP setup, i.e. first_run = 0, but drop the iterate it warm starts from
+    if (!mem->first_run)
+    {
+        OSQPWorkspace *work = mem->osqp_work;
+        int n = work->data->n;
+        int m = work->data->m;
+        for (int ii = 0; ii < n; ii++)
+            work->x[ii] = 0.0;
+        for (int ii = 0; ii < m; ii++)
+        {
+            work->y[ii] = 0.0;
+            work->z[ii] = 0.0;
+        }
+    }
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -1735,6 +1773,7 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
         // mem->osqp_work = osqp_setup(mem->osqp_data, opts->osqp_opts);
         osqp_init_data(mem->osqp_data, opts->osqp_opts, mem->osqp_work);
         mem->first_run = 0;
+        mem->num_setup++;
     }
 
     // check settings:
@@ -1811,6 +1850,7 @@ void ocp_qp_osqp_config_initialize_default(void *config_)
     config->terminate = &ocp_qp_osqp_terminate;
     config->eval_sens = &ocp_qp_osqp_eval_sens;
     config->memory_reset = &ocp_qp_osqp_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_osqp_memory_reset_warm_start;
     config->solver_get = &ocp_qp_osqp_solver_get;
 
     return;
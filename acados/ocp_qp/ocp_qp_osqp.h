@@ -69,6 +69,7 @@ typedef struct ocp_qp_osqp_memory_
 
     OSQPData *osqp_data;
     OSQPWorkspace *osqp_work;
+    int num_setup;  // number of setups of the OSQP workspace
 
     double time_qp_solver_call;
     int iter;
@@ -96,6 +97,8 @@ void ocp_qp_osqp_eval_sens(void *config_, void *qp_in, void *qp_out, void *opts_
 //
 void ocp_qp_osqp_memory_reset(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_);
 //
+void ocp_qp_osqp_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_);
+//
 void ocp_qp_osqp_solver_get(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
 //
 void ocp_qp_osqp_config_initialize_default(void *config);
@@ -40,6 +40,7 @@
 #include "hpipm/include/hpipm_d_ocp_qp_red.h"
 // hpipm
 #include "hpipm/include/hpipm_d_cond.h"
+#include "hpipm/include/hpipm_d_cond_aux.h"
 #include "hpipm/include/hpipm_d_dense_qp.h"
 #include "hpipm/include/hpipm_d_dense_qp_sol.h"
 #include "hpipm/include/hpipm_d_ocp_qp.h"
@@ -260,6 +261,7 @@ void ocp_qp_partial_condensing_opts_initialize_default(void *dims_, void *opts_)
     d_ocp_qp_reduce_eq_dof_arg_set_alias_unchanged(&tmp_i1, opts->hpipm_red_opts);
 
     opts->mem_qp_in = 1;
+    opts->parallel = 0;
 
     return;
 }
@@ -311,6 +313,11 @@ void ocp_qp_partial_condensing_opts_set(void *opts_, const char *field, void* va
         }
         opts->block_size_was_set = true;
     }
+    else if(!strcmp(field, "parallel"))
+    {
+        int *tmp_ptr = value;
+        opts->parallel = *tmp_ptr;
+    }
     // TODO dual_sol ???
     else
     {
@@ -390,6 +397,9 @@ acados_size_t ocp_qp_partial_condensing_memory_calculate_size(void *dims_, void
     size += sizeof(struct d_ocp_qp_reduce_eq_dof_ws);
     size += d_ocp_qp_reduce_eq_dof_ws_memsize(dims->orig_dims);
 
+    // block_size, block_start
+    size += 2 * (opts->N2 + 1) * sizeof(int);
+
     size += 2*8;
     make_int_multiple_of(8, &size);
 
@@ -443,6 +453,16 @@ void *ocp_qp_partial_condensing_memory_assign(void *dims_, void *opts_, void *ra
 
     mem->qp_out_info = (qp_info *) mem->pcond_qp_out->misc;
 
+    assign_and_advance_int(opts->N2 + 1, &mem->block_size, &c_ptr);
+    assign_and_advance_int(opts->N2 + 1, &mem->block_start, &c_ptr);
+    int N_tmp = 0;
+    for (int ii = 0; ii <= opts->N2; ii++)
+    {
+        mem->block_size[ii] = dims->block_size[ii];
+        mem->block_start[ii] = N_tmp;
+        N_tmp += dims->block_size[ii];
+    }
+
     assert((char *) raw_memory + ocp_qp_partial_condensing_memory_calculate_size(dims, opts) >= c_ptr);
 
     return mem;
@@ -501,6 +521,137 @@ acados_size_t ocp_qp_partial_condensing_workspace_calculate_size(void *dims_, vo
  * functions
  ************************************************/
 
+// alias the stages of block ii of qp as OCP QP of horizon block_size[ii], as in HPIPM's partial condensing
+static void ocp_qp_partial_condensing_alias_block(ocp_qp_in *qp, int ii, ocp_qp_partial_condensing_memory *mem,
+                                                  ocp_qp_dims *block_dim, ocp_qp_in *block_qp)
+{
+    ocp_qp_dims *dim = qp->dim;
+    int N_tmp = mem->block_start[ii];
+
+    *block_dim = *dim;
+    block_dim->N = mem->block_size[ii];
+    block_dim->nx = dim->nx + N_tmp;
+    block_dim->nu = dim->nu + N_tmp;
+    block_dim->nbx = dim->nbx + N_tmp;
+    block_dim->nbu = dim->nbu + N_tmp;
+    block_dim->nb = dim->nb + N_tmp;
+    block_dim->ng = dim->ng + N_tmp;
+    block_dim->nsbx = dim->nsbx + N_tmp;
+    block_dim->nsbu = dim->nsbu + N_tmp;
+    block_dim->nsg = dim->nsg + N_tmp;
+    block_dim->ns = dim->ns + N_tmp;
+    block_dim->nbxe = dim->nbxe + N_tmp;
+    block_dim->nbue = dim->nbue + N_tmp;
+    block_dim->nge = dim->nge + N_tmp;
+
+    *block_qp = *qp;
+    block_qp->dim = block_dim;
+    block_qp->idxb = qp->idxb + N_tmp;
+    block_qp->BAbt = qp->BAbt + N_tmp;
+    block_qp->b = qp->b + N_tmp;
+    block_qp->RSQrq = qp->RSQrq + N_tmp;
+    block_qp->rqz = qp->rqz + N_tmp;
+    block_qp->DCt = qp->DCt + N_tmp;
+    block_qp->d = qp->d + N_tmp;
+    block_qp->d_mask = qp->d_mask + N_tmp;
+    block_qp->m = qp->m + N_tmp;
+    block_qp->Z = qp->Z + N_tmp;
+    block_qp->idxs_rev = qp->idxs_rev + N_tmp;
+    block_qp->idxe = qp->idxe + N_tmp;
+    block_qp->diag_H_flag = qp->diag_H_flag + N_tmp;
+}
+
+
+
+// condensing of the blocks, which are independent: each has its own HPIPM condensing workspace and
+// writes only its own stage of pcond_qp_in, so the result does not depend on the number of threads
+static void ocp_qp_partial_condensing_blocks(ocp_qp_in *red_qp, ocp_qp_in *pcond_qp_in, int cond_lhs, int cond_rhs,
+                                             ocp_qp_partial_condensing_opts *opts, ocp_qp_partial_condensing_memory *mem)
+{
+    struct d_cond_qp_arg *cond_arg = opts->hpipm_pcond_opts->cond_arg;
+    struct d_cond_qp_ws *cond_ws = mem->hpipm_pcond_work->cond_workspace;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int ii = 0; ii <= opts->N2; ii++)
+    {
+        ocp_qp_dims block_dim;
+        ocp_qp_in block_qp;
+        ocp_qp_partial_condensing_alias_block(red_qp, ii, mem, &block_dim, &block_qp);
+
+        if (cond_lhs && cond_rhs)
+        {
+            d_cond_BAbt(&block_qp, pcond_qp_in->BAbt+ii, pcond_qp_in->b+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_RSQrq(&block_qp, pcond_qp_in->RSQrq+ii, pcond_qp_in->rqz+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_DCtd(&block_qp, pcond_qp_in->idxb[ii], pcond_qp_in->DCt+ii, pcond_qp_in->d+ii,
+                        pcond_qp_in->d_mask+ii, pcond_qp_in->idxs_rev[ii], pcond_qp_in->Z+ii,
+                        pcond_qp_in->rqz+ii, cond_arg+ii, cond_ws+ii);
+        }
+        else if (cond_lhs)
+        {
+            d_cond_BAt(&block_qp, pcond_qp_in->BAbt+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_RSQ(&block_qp, pcond_qp_in->RSQrq+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_DCt(&block_qp, pcond_qp_in->idxb[ii], pcond_qp_in->DCt+ii, pcond_qp_in->idxs_rev[ii],
+                       pcond_qp_in->Z+ii, cond_arg+ii, cond_ws+ii);
+        }
+        else
+        {
+            d_cond_b(&block_qp, pcond_qp_in->b+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_rq(&block_qp, pcond_qp_in->rqz+ii, cond_arg+ii, cond_ws+ii);
+            d_cond_d(&block_qp, pcond_qp_in->d+ii, pcond_qp_in->d_mask+ii, pcond_qp_in->rqz+ii,
+                     cond_arg+ii, cond_ws+ii);
+        }
+    }
+}
+
+
+
+// expansion of the blocks, see ocp_qp_partial_condensing_blocks
+static void ocp_qp_partial_expansion_blocks(ocp_qp_in *red_qp, ocp_qp_out *pcond_qp_out, ocp_qp_out *red_sol,
+                                            ocp_qp_partial_condensing_opts *opts, ocp_qp_partial_condensing_memory *mem)
+{
+    struct d_cond_qp_arg *cond_arg = opts->hpipm_pcond_opts->cond_arg;
+    struct d_cond_qp_ws *cond_ws = mem->hpipm_pcond_work->cond_workspace;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int ii = 0; ii <= opts->N2; ii++)
+    {
+        int N_tmp = mem->block_start[ii];
+
+        ocp_qp_dims block_dim;
+        ocp_qp_in block_qp;
+        ocp_qp_partial_condensing_alias_block(red_qp, ii, mem, &block_dim, &block_qp);
+
+        ocp_qp_out block_sol = *red_sol;
+        block_sol.dim = &block_dim;
+        block_sol.ux = red_sol->ux + N_tmp;
+        block_sol.pi = red_sol->pi + N_tmp;
+        block_sol.lam = red_sol->lam + N_tmp;
+        block_sol.t = red_sol->t + N_tmp;
+
+        // stage ii of the partially condensed solution as dense QP solution of the block
+        struct d_dense_qp_dim dense_dim = {0};
+        d_cond_qp_compute_dim(&block_dim, &dense_dim);
+
+        struct d_dense_qp_sol dense_sol = {0};
+        dense_sol.dim = &dense_dim;
+        dense_sol.v = pcond_qp_out->ux + ii;
+        dense_sol.pi = pcond_qp_out->pi + ii;
+        dense_sol.lam = pcond_qp_out->lam + ii;
+        dense_sol.t = pcond_qp_out->t + ii;
+
+        if (cond_arg[ii].comp_dual_sol_eq == 0)
+            d_expand_primal_sol(&block_qp, &dense_sol, &block_sol, cond_arg+ii, cond_ws+ii);
+        else
+            d_expand_sol(&block_qp, &dense_sol, &block_sol, cond_arg+ii, cond_ws+ii);
+    }
+}
+
+
+
 int ocp_qp_partial_condensing(void *qp_in_, void *pcond_qp_in_, void *opts_, void *mem_, void *work)
 {
     ocp_qp_in *qp_in = qp_in_;
@@ -528,7 +679,10 @@ int ocp_qp_partial_condensing(void *qp_in_, void *pcond_qp_in_, void *opts_, voi
 //exit(1);
 
     // convert to partially condensed qp structure
-    d_part_cond_qp_cond(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
+    if (opts->parallel)
+        ocp_qp_partial_condensing_blocks(mem->red_qp, pcond_qp_in, 1, 1, opts, mem);
+    else
+        d_part_cond_qp_cond(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
 
     // stop timer
     mem->time_qp_xcond = acados_toc(&timer);
@@ -554,7 +708,10 @@ int ocp_qp_partial_condensing_condense_lhs(void *qp_in_, void *pcond_qp_in_, voi
     acados_tic(&timer);
 
     d_ocp_qp_reduce_eq_dof_lhs(qp_in, mem->red_qp, opts->hpipm_red_opts, mem->hpipm_red_work);
-    d_part_cond_qp_cond_lhs(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
+    if (opts->parallel)
+        ocp_qp_partial_condensing_blocks(mem->red_qp, pcond_qp_in, 1, 0, opts, mem);
+    else
+        d_part_cond_qp_cond_lhs(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
 
     mem->time_qp_xcond = acados_toc(&timer);
 
@@ -585,7 +742,10 @@ int ocp_qp_partial_condensing_condense_rhs(void *qp_in_, void *pcond_qp_in_, voi
     d_ocp_qp_reduce_eq_dof_rhs(qp_in, mem->red_qp, opts->hpipm_red_opts, mem->hpipm_red_work);
 
     // convert to partially condensed qp structure
-    d_part_cond_qp_cond_rhs(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
+    if (opts->parallel)
+        ocp_qp_partial_condensing_blocks(mem->red_qp, pcond_qp_in, 0, 1, opts, mem);
+    else
+        d_part_cond_qp_cond_rhs(mem->red_qp, pcond_qp_in, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
 
     // stop timer
     mem->time_qp_xcond += acados_toc(&timer);
@@ -611,7 +771,10 @@ int ocp_qp_partial_expansion(void *pcond_qp_out_, void *qp_out_, void *opts_, vo
 
     // expand solution
     // TODO only if N2<N
-    d_part_cond_qp_expand_sol(mem->red_qp, mem->ptr_pcond_qp_in, pcond_qp_out, mem->red_sol, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
+    if (opts->parallel)
+        ocp_qp_partial_expansion_blocks(mem->red_qp, pcond_qp_out, mem->red_sol, opts, mem);
+    else
+        d_part_cond_qp_expand_sol(mem->red_qp, mem->ptr_pcond_qp_in, pcond_qp_out, mem->red_sol, opts->hpipm_pcond_opts, mem->hpipm_pcond_work);
 
     // restore solution
     d_ocp_qp_restore_eq_dof(mem->ptr_qp_in, mem->red_sol, qp_out, opts->hpipm_red_opts, mem->hpipm_red_work);
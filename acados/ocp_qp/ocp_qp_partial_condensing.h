@@ -68,6 +68,7 @@ typedef struct ocp_qp_partial_condensing_opts_
     bool block_size_was_set;
     int ric_alg;
     int mem_qp_in; // allocate qp_in in memory
+    int parallel; // condense and expand the blocks in parallel (with ACADOS_WITH_OPENMP)
 } ocp_qp_partial_condensing_opts;
 
 
@@ -85,6 +86,9 @@ typedef struct ocp_qp_partial_condensing_memory_
     ocp_qp_in *ptr_qp_in;
     ocp_qp_in *ptr_pcond_qp_in;
     qp_info *qp_out_info; // info in pcond_qp_in
+    // horizon and first stage of the blocks, N2+1 entries
+    int *block_size;
+    int *block_start;
     double time_qp_xcond;
 } ocp_qp_partial_condensing_memory;
 
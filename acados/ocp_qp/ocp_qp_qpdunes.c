@@ -254,6 +254,19 @@ void ocp_qp_qpdunes_opts_set(void *config_, void *opts_, const char *field, void
         int *iter_max = value;
         opts->options.maxIter = *iter_max;
     }
+    else if (!strcmp(field, "linear_mpc"))
+    {
+        int *linear_mpc = value;
+        opts->isLinearMPC = *linear_mpc;
+    }
+    else if (!strcmp(field, "time_limit"))
+    {
+        // not implemented, the solver runs until convergence or iter_max
+    }
+    else if (!strcmp(field, "lhs_unchanged"))
+    {
+        // not implemented, the QP matrices are factorized in every call
+    }
     else
     {
         printf("\nerror: ocp_qp_qpdunes_opts_set: wrong field: %s\n", field);
@@ -271,9 +284,27 @@ void ocp_qp_qpdunes_opts_set(void *config_, void *opts_, const char *field, void
 
 acados_size_t ocp_qp_qpdunes_memory_calculate_size(void *config_, ocp_qp_dims *dims, void *opts_)
 {
+    int N = dims->N;
+    int nx = dims->nx[0];
+    int nu = dims->nu[0];
+    int nDmax = get_maximum_number_of_inequality_constraints(dims);
+    int nz = nx + nu;
+
     // NOTE(dimitris): calculate size does NOT include the memory required by qpDUNES
     acados_size_t size = 0;
     size += sizeof(ocp_qp_qpdunes_memory);
+
+    size += (N + 1) * nz * nz * sizeof(double);     // H
+    size += N * nx * nz * sizeof(double);           // ABt
+    size += (N + 1) * nDmax * nz * sizeof(double);  // Ct
+    size += (N + 1) * nz * sizeof(double);          // g
+    size += N * nx * sizeof(double);                // b
+    size += 2 * (N + 1) * nz * sizeof(double);      // zLow, zUpp
+    size += 2 * (N + 1) * nDmax * sizeof(double);   // lc, uc
+    size += (N + 1) * sizeof(int);                  // stage_changed
+
+    size += 8;
+
     return size;
 }
 
@@ -299,10 +330,30 @@ void *ocp_qp_qpdunes_memory_assign(void *config_, ocp_qp_dims *dims, void *opts_
     nu = dims->nu[0];
 
     mem->firstRun = 1;
+    mem->N = N;
     mem->nx = nx;
     mem->nu = nu;
     mem->nz = nx + nu;
     mem->nDmax = get_maximum_number_of_inequality_constraints(dims);
+    mem->n_stage_updates = 0;
+    mem->is_lti = 0;
+
+    int nz = mem->nz;
+    int nDmax = mem->nDmax;
+
+    align_char_to(8, &c_ptr);
+    assign_and_advance_double((N + 1) * nz * nz, &mem->H, &c_ptr);
+    assign_and_advance_double(N * nx * nz, &mem->ABt, &c_ptr);
+    assign_and_advance_double((N + 1) * nDmax * nz, &mem->Ct, &c_ptr);
+    assign_and_advance_double((N + 1) * nz, &mem->g, &c_ptr);
+    assign_and_advance_double(N * nx, &mem->b, &c_ptr);
+    assign_and_advance_double((N + 1) * nz, &mem->zLow, &c_ptr);
+    assign_and_advance_double((N + 1) * nz, &mem->zUpp, &c_ptr);
+    assign_and_advance_double((N + 1) * nDmax, &mem->lc, &c_ptr);
+    assign_and_advance_double((N + 1) * nDmax, &mem->uc, &c_ptr);
+    assign_and_advance_int(N + 1, &mem->stage_changed, &c_ptr);
+
+    assert((char *) raw_memory + ocp_qp_qpdunes_memory_calculate_size(config_, dims, opts_) >= c_ptr);
 
     // Check on dimensions
     for (int kk = 1; kk < N; kk++)
@@ -372,6 +423,16 @@ void ocp_qp_qpdunes_memory_get(void *config_, void *mem_, const char *field, voi
         int *tmp_ptr = value;
         *tmp_ptr = mem->status;
     }
+    else if (!strcmp(field, "n_stage_updates"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->n_stage_updates;
+    }
+    else if (!strcmp(field, "is_lti"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->is_lti;
+    }
     else
     {
         printf("\nerror: ocp_qp_qpdunes_memory_get: field %s not available\n", field);
@@ -393,6 +454,19 @@ void ocp_qp_qpdunes_memory_reset(void *config_, void *qp_in_, void *qp_out_, voi
 
 
 
+void ocp_qp_qpdunes_memory_reset_warm_start(void *config_, void *qp_out_, void *opts_, void *mem_)
+{
+    ocp_qp_qpdunes_memory *mem = mem_;
+
+    ocp_qp_out_set_zero(qp_out_);
+
+    // qpDUNES warm starts from the multipliers of the dynamics
+    for (int ii = 0; ii < mem->N * mem->nx; ii++)
+        mem->qpData.lambda.data[ii] = 0.0;
+}
+
+
+
 static void form_H(double *H, int nx, int nu, struct blasfeo_dmat *sRSQrq)
 {
     // make Q full
@@ -532,6 +606,7 @@ static void form_inequalities(double *Ct, double *lc, double *uc, int nx, int nu
 
 acados_size_t ocp_qp_qpdunes_workspace_calculate_size(void *config_, ocp_qp_dims *dims, void *opts_)
 {
+    int N = dims->N;
     int nx = dims->nx[0];
     int nu = dims->nu[0];
     int nDmax = get_maximum_number_of_inequality_constraints(dims);
@@ -549,6 +624,9 @@ acados_size_t ocp_qp_qpdunes_workspace_calculate_size(void *config_, ocp_qp_dims
     size += nDmax * nz * sizeof(double);  // Ct
     size += 2 * nDmax * sizeof(double);   // lc, uc
     size += 2 * nz * sizeof(double);      // zLow, zUpp
+    size += (N + 1) * nz * nz * sizeof(double);     // H_stage
+    size += N * nx * nz * sizeof(double);           // ABt_stage
+    size += (N + 1) * nDmax * nz * sizeof(double);  // Ct_stage
 
     return size;
 }
@@ -560,6 +638,7 @@ static void ocp_qp_qpdunes_cast_workspace(ocp_qp_qpdunes_workspace *work, ocp_qp
     char *c_ptr = (char *) work;
     c_ptr += sizeof(ocp_qp_qpdunes_workspace);
 
+    int N = mem->N;
     int nx = mem->nx;
     int nu = mem->nu;
     int nz = mem->nz;
@@ -577,6 +656,89 @@ static void ocp_qp_qpdunes_cast_workspace(ocp_qp_qpdunes_workspace *work, ocp_qp
     assign_and_advance_double(nDmax, &work->uc, &c_ptr);
     assign_and_advance_double(nz, &work->zLow, &c_ptr);
     assign_and_advance_double(nz, &work->zUpp, &c_ptr);
+    assign_and_advance_double((N + 1) * nz * nz, &work->H_stage, &c_ptr);
+    assign_and_advance_double(N * nx * nz, &work->ABt_stage, &c_ptr);
+    assign_and_advance_double((N + 1) * nDmax * nz, &work->Ct_stage, &c_ptr);
+}
+
+
+
+static int copy_if_changed(int n, double *src, double *dst)
+{
+    int changed = 0;
+    for (int ii = 0; ii < n; ii++)
+    {
+        if (src[ii] != dst[ii])
+        {
+            changed = 1;
+            break;
+        }
+    }
+    if (changed)
+        memcpy(dst, src, n * sizeof(double));
+    return changed;
+}
+
+
+
+// converts stage kk into the qpDUNES layout: vectors directly into memory, matrices into the
+// workspace first, and returns whether the matrices differ from the ones in memory
+static int form_stage(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdunes_memory *mem,
+                      ocp_qp_qpdunes_workspace *work, int kk)
+{
+    int N = mem->N;
+    int nx = mem->nx;
+    int nz = mem->nz;
+    int nDmax = mem->nDmax;
+    int nu = kk < N ? mem->nu : 0;
+    int nb = in->dim->nb[kk];
+    int ng = in->dim->ng[kk];
+
+    double *H = work->H_stage + kk * nz * nz;
+    double *Ct = work->Ct_stage + kk * nDmax * nz;
+
+    int changed = 0;
+
+    form_g(mem->g + kk * nz, nx, nu, &in->rqz[kk]);
+    form_bounds(mem->zLow + kk * nz, mem->zUpp + kk * nz, nx, nu, nb, ng, in->idxb[kk],
+                &in->d[kk], opts->options.QPDUNES_INFTY);
+
+    if (kk < N)
+    {
+        double *ABt = work->ABt_stage + kk * nx * nz;
+        form_H(H, nx, nu, &in->RSQrq[kk]);
+        form_dynamics(ABt, mem->b + kk * nx, nx, nu, &in->BAbt[kk], &in->b[kk]);
+        changed |= copy_if_changed(nx * nz, ABt, mem->ABt + kk * nx * nz);
+    }
+    else
+    {
+        form_RSQ(NULL, NULL, H, nx, 0, &in->RSQrq[N]);
+    }
+    changed |= copy_if_changed((nx + nu) * (nx + nu), H, mem->H + kk * nz * nz);
+
+    if (ng > 0)
+    {
+        form_inequalities(Ct, mem->lc + kk * nDmax, mem->uc + kk * nDmax, nx, nu, nb, ng,
+                          &in->DCt[kk], &in->d[kk]);
+        changed |= copy_if_changed(ng * (nx + nu), Ct, mem->Ct + kk * nDmax * nz);
+    }
+
+    return changed;
+}
+
+
+
+// converts all stages, in parallel if available
+static void form_all_stages(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdunes_memory *mem,
+                            ocp_qp_qpdunes_workspace *work)
+{
+    int N = mem->N;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int kk = 0; kk <= N; kk++)
+        mem->stage_changed[kk] = form_stage(in, opts, mem, work, kk);
 }
 
 
@@ -584,13 +746,15 @@ static void ocp_qp_qpdunes_cast_workspace(ocp_qp_qpdunes_workspace *work, ocp_qp
 static int update_memory(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdunes_memory *mem,
                          ocp_qp_qpdunes_workspace *work)
 {
-    boolean_t isLTI;  // TODO(dimitris): use isLTI flag for LTI systems
+    boolean_t isLTI = QPDUNES_FALSE;
     return_t value = 0;
     qpdunes_stage_qp_solver_t stageQps;
 
     int N = in->dim->N;
     int nx = in->dim->nx[0];
     int nu = in->dim->nu[0];
+    int nz = mem->nz;
+    int nDmax = mem->nDmax;
     int *nb = in->dim->nb;
     int *ng = in->dim->ng;
 
@@ -622,6 +786,28 @@ static int update_memory(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdune
             BLASFEO_DMATEL(&in->RSQrq[N], 1, 0) += 1e-8;
         }
 
+        // store the stage data in qpDUNES layout to detect changes in later calls
+        form_all_stages(in, opts, mem, work);
+        mem->n_stage_updates = N + 1;
+
+        // with constant matrices (linear MPC), the stage QPs can share factorizations if all
+        // intervals are identical
+        if (opts->isLinearMPC)
+        {
+            isLTI = QPDUNES_TRUE;
+            for (int kk = 1; kk < N && isLTI == QPDUNES_TRUE; kk++)
+            {
+                if (ng[kk] != ng[0] || nb[kk] != nb[0] ||
+                    memcmp(mem->H, mem->H + kk * nz * nz, nz * nz * sizeof(double)) ||
+                    memcmp(mem->ABt, mem->ABt + kk * nx * nz, nx * nz * sizeof(double)) ||
+                    memcmp(mem->Ct, mem->Ct + kk * nDmax * nz, ng[0] * nz * sizeof(double)))
+                {
+                    isLTI = QPDUNES_FALSE;
+                }
+            }
+        }
+        mem->is_lti = isLTI == QPDUNES_TRUE;
+
         // setup of intervals
         for (int kk = 0; kk < N; ++kk)
         {
@@ -686,7 +872,7 @@ static int update_memory(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdune
         }
 
         // setup of stage QPs
-        value = qpDUNES_setupAllLocalQPs(&(mem->qpData), isLTI = QPDUNES_FALSE);
+        value = qpDUNES_setupAllLocalQPs(&(mem->qpData), isLTI);
         if (value != QPDUNES_OK)
         {
             printf("Setup of qpDUNES failed on initialization of stage QPs\n");
@@ -697,57 +883,30 @@ static int update_memory(ocp_qp_in *in, ocp_qp_qpdunes_opts *opts, ocp_qp_qpdune
     {  // if mem->firstRun == 0
         if (opts->isLinearMPC == 0)
         {
-            for (int kk = 0; kk < N; kk++)
-            {
-                form_H(work->H, nx, nu, &in->RSQrq[kk]);
-                form_g(work->g, nx, nu, &in->rqz[kk]);
-                form_dynamics(work->ABt, work->b, nx, nu, &in->BAbt[kk], &in->b[kk]);
+            form_all_stages(in, opts, mem, work);
 
-                form_bounds(work->zLow, work->zUpp, nx, nu, nb[kk], ng[kk], in->idxb[kk],
-                            &in->d[kk], opts->options.QPDUNES_INFTY);
-                if (ng[kk] == 0)
-                {
-                    value = qpDUNES_updateIntervalData(&(mem->qpData), mem->qpData.intervals[kk],
-                                                       work->H, work->g, work->ABt, work->b,
-                                                       work->zLow, work->zUpp, 0, 0, 0, 0);
-                }
-                else
-                {
-                    form_inequalities(work->Ct, work->lc, work->uc, nx, nu, nb[kk], ng[kk],
-                                      &in->DCt[kk], &in->d[kk]);
-                    value = qpDUNES_updateIntervalData(
-                        &(mem->qpData), mem->qpData.intervals[kk], work->H, work->g, work->ABt,
-                        work->b, work->zLow, work->zUpp, work->Ct, work->lc, work->uc, 0);
-                }
+            // push the vectors of all stages, the matrices only where they changed, such that
+            // qpDUNES keeps the stage factorizations of the others
+            mem->n_stage_updates = 0;
+            for (int kk = 0; kk <= N; kk++)
+            {
+                int changed = mem->stage_changed[kk];
+                double *H = changed ? mem->H + kk * nz * nz : 0;
+                double *Ct = (changed && ng[kk] > 0) ? mem->Ct + kk * nDmax * nz : 0;
+                double *lc = ng[kk] > 0 ? mem->lc + kk * nDmax : 0;
+                double *uc = ng[kk] > 0 ? mem->uc + kk * nDmax : 0;
+                double *ABt = (changed && kk < N) ? mem->ABt + kk * nx * nz : 0;
+                double *b = kk < N ? mem->b + kk * nx : 0;
+
+                value = qpDUNES_updateIntervalData(&(mem->qpData), mem->qpData.intervals[kk], H,
+                                                   mem->g + kk * nz, ABt, b, mem->zLow + kk * nz,
+                                                   mem->zUpp + kk * nz, Ct, lc, uc, 0);
                 if (value != QPDUNES_OK)
                 {
                     printf("Update of qpDUNES failed on interval %d\n", kk);
                     return (int) value;
                 }
-                // qpDUNES_printMatrixData( work->ABt, nx, nx+nu, "AB[%d]", kk);
-            }
-            form_bounds(work->zLow, work->zUpp, nx, 0, nb[N], ng[N], in->idxb[N], &in->d[N],
-                        opts->options.QPDUNES_INFTY);
-            form_RSQ(work->R, work->S, work->Q, nx, 0, &in->RSQrq[N]);
-            form_g(work->g, nx, 0, &in->rqz[N]);  // work->g = q
-            if (ng[N] == 0)
-            {
-                value =
-                    qpDUNES_updateIntervalData(&(mem->qpData), mem->qpData.intervals[N], work->Q,
-                                               work->g, 0, 0, work->zLow, work->zUpp, 0, 0, 0, 0);
-            }
-            else
-            {
-                form_inequalities(work->Ct, work->lc, work->uc, nx, 0, nb[N], ng[N], &in->DCt[N],
-                                  &in->d[N]);
-                value = qpDUNES_updateIntervalData(&(mem->qpData), mem->qpData.intervals[N],
-                                                   work->Q, work->g, 0, 0, work->zLow, work->zUpp,
-                                                   work->Ct, work->lc, work->uc, 0);
-            }
-            if (value != QPDUNES_OK)
-            {
-                printf("Update of qpDUNES failed on last interval\n");
-                return (int) value;
+                mem->n_stage_updates += changed;
             }
         }
         else
@@ -950,6 +1109,7 @@ void ocp_qp_qpdunes_config_initialize_default(void *config_)
         (void *(*) (void *, void *, void *, void *) ) & ocp_qp_qpdunes_memory_assign;
     config->memory_get = &ocp_qp_qpdunes_memory_get;
     config->memory_reset = &ocp_qp_qpdunes_memory_reset;
+    config->memory_reset_warm_start = &ocp_qp_qpdunes_memory_reset_warm_start;
     config->workspace_calculate_size =
         (acados_size_t (*)(void *, void *, void *)) & ocp_qp_qpdunes_workspace_calculate_size;
     config->evaluate = (int (*)(void *, void *, void *, void *, void *, void *)) & ocp_qp_qpdunes;
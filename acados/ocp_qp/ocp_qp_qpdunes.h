@@ -61,6 +61,7 @@ typedef struct ocp_qp_qpdunes_opts_
 typedef struct ocp_qp_qpdunes_memory_
 {
     int firstRun;
+    int N;
     int nx;
     int nu;
     int nz;
@@ -69,6 +70,19 @@ typedef struct ocp_qp_qpdunes_memory_
     double time_qp_solver_call;
     int iter;
     int status;
+    // stage data in qpDUNES layout as last passed to qpDUNES, stacked over stages
+    double *H;     // nz x nz, Q at the terminal stage
+    double *ABt;   // nx x nz
+    double *Ct;    // nDmax x nz
+    double *g;
+    double *b;
+    double *zLow;
+    double *zUpp;
+    double *lc;
+    double *uc;
+    int *stage_changed;  // matrices of stage changed since the last solve
+    int n_stage_updates; // number of stages with updated matrices in the last solve
+    int is_lti;          // linear MPC with identical intervals, stage QPs set up as LTI
 
 } ocp_qp_qpdunes_memory;
 
@@ -86,6 +100,10 @@ typedef struct ocp_qp_qpdunes_workspace_
     double *uc;
     double *zLow;
     double *zUpp;
+    // matrices of all stages in qpDUNES layout, compared against the ones in memory
+    double *H_stage;
+    double *ABt_stage;
+    double *Ct_stage;
 } ocp_qp_qpdunes_workspace;
 
 //
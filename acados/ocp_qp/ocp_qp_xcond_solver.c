@@ -250,6 +250,8 @@ void ocp_qp_xcond_solver_opts_initialize_default(void *config_, ocp_qp_xcond_sol
     xcond->opts_initialize_default(dims->xcond_dims, opts->xcond_opts);
     // qp solver opts
     qp_solver->opts_initialize_default(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+
+    opts->lhs_unchanged = 0;
 }
 
 
@@ -301,6 +303,12 @@ void ocp_qp_xcond_solver_opts_set_(void *config_, void *opts_, const char *field
     {
         xcond->opts_set(opts->xcond_opts, field+module_length+1, value);
     }
+    else if (!strcmp(field, "lhs_unchanged")) // used here and by the QP module
+    {
+        int *lhs_unchanged = value;
+        opts->lhs_unchanged = *lhs_unchanged;
+        qp_solver->opts_set(qp_solver, opts->qp_solver_opts, field, value);
+    }
     else // pass options to QP module
     {
         qp_solver->opts_set(qp_solver, opts->qp_solver_opts, field, value);
@@ -398,6 +406,20 @@ void ocp_qp_xcond_solver_memory_reset(void *config_, ocp_qp_xcond_solver_dims *d
 }
 
 
+
+// resets the warm start of the QP solver, but keeps its setup
+void ocp_qp_xcond_solver_memory_reset_warm_start(void *config_, void *opts_, void *mem_)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+    qp_solver_config *qp_solver = config->qp_solver;
+    ocp_qp_xcond_solver_opts *opts = opts_;
+    ocp_qp_xcond_solver_memory *mem = mem_;
+
+    qp_solver->memory_reset_warm_start(qp_solver, mem->xcond_qp_out, opts->qp_solver_opts,
+                                       mem->solver_memory);
+}
+
+
 void ocp_qp_xcond_solver_get(void *config_, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2)
 {
     // cast data structures
@@ -436,7 +458,14 @@ void ocp_qp_xcond_solver_memory_get(void *config_, void *mem_, const char *field
     {
         qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
     }
-    else if (!strcmp(field, "time_qp_xcond"))
+    else if (!strcmp(field, "iter_single") || !strcmp(field, "mixed_precision_used") ||
+             !strcmp(field, "cache_hits") || !strcmp(field, "stat") ||
+             !strcmp(field, "stat_m") || !strcmp(field, "stat_n") || !strcmp(field, "fact_reused") ||
+             !strcmp(field, "num_setup") || !strcmp(field, "n_stage_updates") || !strcmp(field, "is_lti"))
+    {
+        qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
+    }
+    else if (!strcmp(field, "time_qp_xcond") || !strcmp(field, "n_stages_cond"))
     {
         xcond->memory_get(xcond, mem->xcond_memory, field, value);
     }
@@ -532,9 +561,12 @@ int ocp_qp_xcond_solve(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in
 
     int solver_status = ACADOS_SUCCESS;
 
-    // condensing
+    // condensing, the condensed matrices of the last call are kept if the lhs is unchanged
     acados_tic(&cond_timer);
-    xcond->condensing(qp_in, memory->xcond_qp_in, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+    if (opts->lhs_unchanged)
+        xcond->condense_rhs(qp_in, memory->xcond_qp_in, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+    else
+        xcond->condensing(qp_in, memory->xcond_qp_in, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
     info->condensing_time = acados_toc(&cond_timer);
 
     // solve qp
@@ -722,6 +754,7 @@ void ocp_qp_xcond_solver_config_initialize_default(void *config_)
     config->memory_get = &ocp_qp_xcond_solver_memory_get;
     config->solver_get = &ocp_qp_xcond_solver_get;
     config->memory_reset = &ocp_qp_xcond_solver_memory_reset; // TODO: unused?
+    config->memory_reset_warm_start = &ocp_qp_xcond_solver_memory_reset_warm_start;
     config->workspace_calculate_size = &ocp_qp_xcond_solver_workspace_calculate_size;
     config->evaluate = &ocp_qp_xcond_solve;
     config->condense_lhs = &ocp_qp_xcond_condense_lhs;
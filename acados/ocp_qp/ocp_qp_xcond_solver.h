@@ -54,6 +54,7 @@ typedef struct ocp_qp_xcond_solver_opts_
 {
     void *xcond_opts;
     void *qp_solver_opts;
+    int lhs_unchanged;  // QP matrices equal those of the last call: skip their condensing, forwarded to the QP solver
 } ocp_qp_xcond_solver_opts;
 
 
@@ -92,6 +93,7 @@ typedef struct
     void (*memory_get)(void *config_, void *mem_, const char *field, void* value);
     void (*solver_get)(void *config_, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts_, void *mem_, const char *field, int stage, void* value, int size1, int size2);
     void (*memory_reset)(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts, void *mem, void *work);
+    void (*memory_reset_warm_start)(void *config, void *opts, void *mem);
     acados_size_t (*workspace_calculate_size)(void *config, ocp_qp_xcond_solver_dims *dims, void *opts);
     int (*evaluate)(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts, void *mem, void *work);
     int (*condense_lhs)(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts, void *mem, void *work);
@@ -35,6 +35,9 @@
 #include <stdlib.h>
 #include <string.h>
 // acados
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+
 #include "acados/sim/sim_common.h"
 #include "acados/utils/mem.h"
 #include "acados/utils/print.h"
@@ -331,6 +334,9 @@ sim_out *sim_out_assign(void *config_, void *dims, void *raw_memory)
     assign_and_advance_double(nz, &out->zn, &c_ptr);
     assign_and_advance_double(nz * NF, &out->S_algebraic, &c_ptr);
 
+    out->S_forw_tran = NULL;
+    out->S_algebraic_tran = NULL;
+
     assert((char *) raw_memory + sim_out_calculate_size(config_, dims) >= c_ptr);
 
     return out;
@@ -338,6 +344,54 @@ sim_out *sim_out_assign(void *config_, void *dims, void *raw_memory)
 
 
 
+void sim_in_pack_S_forw(int nx, int nu, sim_in *in, struct blasfeo_dmat *sA, int ai, int aj)
+{
+    if (in->identity_seed)
+    {
+        // S_forw = [eye(nx), zeros(nx x nu)], in->S_forw is not read
+        blasfeo_dgese(nx, nx + nu, 0.0, sA, ai, aj);
+        blasfeo_ddiare(nx, 1.0, sA, ai, aj);
+    }
+    else
+    {
+        blasfeo_pack_dmat(nx, nx + nu, in->S_forw, nx, sA, ai, aj);
+    }
+}
+
+
+
+void sim_out_unpack_S_forw(int nx, int nu, struct blasfeo_dmat *sA, int ai, int aj, sim_out *out)
+{
+    if (out->S_forw_tran != NULL)
+    {
+        // Su^T
+        blasfeo_dgetr(nx, nu, sA, ai, aj + nx, out->S_forw_tran, 0, 0);
+        // Sx^T
+        blasfeo_dgetr(nx, nx, sA, ai, aj, out->S_forw_tran, nu, 0);
+    }
+    else
+    {
+        blasfeo_unpack_dmat(nx, nx + nu, sA, ai, aj, out->S_forw, nx);
+    }
+}
+
+
+
+void sim_out_unpack_S_algebraic(int nx, int nu, int nz, struct blasfeo_dmat *sA, int ai, int aj, sim_out *out)
+{
+    if (out->S_algebraic_tran != NULL)
+    {
+        blasfeo_dgetr(nz, nu, sA, ai, aj + nx, out->S_algebraic_tran, 0, 0);
+        blasfeo_dgetr(nz, nx, sA, ai, aj, out->S_algebraic_tran, nu, 0);
+    }
+    else
+    {
+        blasfeo_unpack_dmat(nz, nx + nu, sA, ai, aj, out->S_algebraic, nz);
+    }
+}
+
+
+
 int sim_out_get_(void *config_, void *dims_, sim_out *out, const char *field, void *value)
 {
     sim_config *config = config_;
@@ -34,6 +34,9 @@
 
 #include <stdbool.h>
 
+// blasfeo
+#include "blasfeo/include/blasfeo_common.h"
+
 #include "acados/sim/sim_collocation_utils.h"
 #include "acados/utils/timing.h"
 #include "acados/utils/types.h"
@@ -112,6 +115,11 @@ typedef struct
 
     double *grad;  // gradient correction
 
+    // optional blasfeo targets: if not NULL, the integrator writes the forward sensitivities
+    // transposed and in [u; x] row order here, instead of to S_forw / S_algebraic
+    struct blasfeo_dmat *S_forw_tran;       // (nu+nx) x nx, holds [Su, Sx]^T
+    struct blasfeo_dmat *S_algebraic_tran;  // (nu+nx) x nz, holds [dz_du, dz_dx]^T
+
     sim_info *info;
 
 } sim_out;
@@ -216,6 +224,12 @@ acados_size_t sim_out_calculate_size(void *config, void *dims);
 sim_out *sim_out_assign(void *config, void *dims, void *raw_memory);
 //
 int sim_out_get_(void *config, void *dims, sim_out *out, const char *field, void *value);
+// initializes the forward seed sA[ai:ai+nx, aj:aj+nx+nu] from in->S_forw, or as [eye(nx), 0] if in->identity_seed
+void sim_in_pack_S_forw(int nx, int nu, sim_in *in, struct blasfeo_dmat *sA, int ai, int aj);
+// writes the forward sensitivities sA[ai:ai+nx, aj:aj+nx+nu] to out->S_forw_tran if set, otherwise to out->S_forw
+void sim_out_unpack_S_forw(int nx, int nu, struct blasfeo_dmat *sA, int ai, int aj, sim_out *out);
+// writes the algebraic sensitivities sA[ai:ai+nz, aj:aj+nx+nu] to out->S_algebraic_tran if set, otherwise to out->S_algebraic
+void sim_out_unpack_S_algebraic(int nx, int nu, int nz, struct blasfeo_dmat *sA, int ai, int aj, sim_out *out);
 
 /* opts */
 //
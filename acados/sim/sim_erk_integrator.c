@@ -34,6 +34,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
 // acados
 #include "acados/sim/sim_common.h"
 #include "acados/sim/sim_collocation_utils.h"
@@ -663,7 +665,23 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     for (i = 0; i < nx; i++) forw_traj[i] = x[i];  // x0
     if (opts->sens_forw)
     {
-        for (i = 0; i < nx * nf; i++) forw_traj[nx + i] = S_forw_in[i];  // sensitivities
+        if (out->S_forw_tran != NULL && nf != nx + nu)
+        {
+            // S_forw_tran holds [Su, Sx]^T, i.e. the sensitivities w.r.t. all of x and u
+            printf("\nerror: sim_erk: S_forw_tran requires num_forw_sens = nx + nu = %d, got %d.\n",
+                   nx + nu, nf);
+            exit(1);
+        }
+        if (in->identity_seed)
+        {
+            // S_forw = [eye(nx), zeros(nx x nu)], without reading S_forw_in
+            for (i = 0; i < nx * nf; i++) forw_traj[nx + i] = 0.0;
+            for (i = 0; i < nx && i < nf; i++) forw_traj[nx + i * (nx + 1)] = 1.0;
+        }
+        else
+        {
+            for (i = 0; i < nx * nf; i++) forw_traj[nx + i] = S_forw_in[i];  // sensitivities
+        }
     }
     for (i = 0; i < nu; i++) rhs_forw_in[nX + i] = u[i];  // controls
 
@@ -727,7 +745,16 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     // store forward sensitivities
     if (opts->sens_forw)
     {
-        for (i = 0; i < nx * nf; i++) S_forw_out[i] = forw_traj[nx + i];
+        if (out->S_forw_tran != NULL)
+        {
+            // Su^T, Sx^T
+            blasfeo_pack_tran_dmat(nx, nu, forw_traj + nx + nx * nx, nx, out->S_forw_tran, 0, 0);
+            blasfeo_pack_tran_dmat(nx, nx, forw_traj + nx, nx, out->S_forw_tran, nu, 0);
+        }
+        else
+        {
+            for (i = 0; i < nx * nf; i++) S_forw_out[i] = forw_traj[nx + i];
+        }
     }
 
     /************************************************
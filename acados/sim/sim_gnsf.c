@@ -2028,7 +2028,7 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
     else
     {
         // pack seed into S_forw, permute
-        blasfeo_pack_dmat(nx, nx + nu, &in->S_forw[0], nx, S_forw, 0, 0);
+        sim_in_pack_S_forw(nx, nu, in, S_forw, 0, 0);
         blasfeo_drowpe(nx, ipiv_x, S_forw);
         blasfeo_dcolpe(nx, ipiv_x, S_forw);
 
@@ -2939,7 +2939,7 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
     {
         blasfeo_drowpei(nx, ipiv_x, S_forw_new);
         blasfeo_dcolpei(nx, ipiv_x, S_forw_new);
-        blasfeo_unpack_dmat(nx, nx + nu, S_forw_new, 0, 0, out->S_forw, nx);
+        sim_out_unpack_S_forw(nx, nu, S_forw_new, 0, 0, out);
     }
     if (opts->sens_adj)
     {
@@ -2952,7 +2952,7 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
         blasfeo_dgecp(nz, nx+nu, S_algebraic, 0, 0, S_algebraic_aux, 0, 0);
         blasfeo_drowpei(nz, ipiv_z, S_algebraic_aux);
         blasfeo_dcolpei(nx, ipiv_x, S_algebraic_aux);
-        blasfeo_unpack_dmat(nz, nx+nu, S_algebraic_aux, 0, 0, out->S_algebraic, nz);
+        sim_out_unpack_S_algebraic(nx, nu, nz, S_algebraic_aux, 0, 0, out);
     }
     if (opts->output_z)
     {
@@ -937,7 +937,6 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     struct blasfeo_dmat *Hess = &workspace->Hess;
 
     double *x_out = out->xn;
-    double *S_forw_out = out->S_forw;
     double *S_adj_out = out->S_adj;
     double *S_algebraic = out->S_algebraic;
 
@@ -1067,7 +1066,7 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
 
     // pack
     blasfeo_pack_dvec(nx, in->x, 1, xn, 0);
-    blasfeo_pack_dmat(nx, nx + nu, in->S_forw, nx, S_forw, 0, 0);
+    sim_in_pack_S_forw(nx, nu, in, S_forw, 0, 0);
     blasfeo_pack_dvec(nx + nu, in->S_adj, 1, lambda, 0); // TODO set to zero u-part ???
 
     // initialize integration variables
@@ -1686,7 +1685,11 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
                         }
                         neville_algorithm(0.0, ns - 1, opts->c_vec, Z_work, &interpolated_value);
                                     // eval polynomial through vals in Z_work at 0.
-                        S_algebraic[ii+jj*nz] = -interpolated_value;
+                        if (out->S_algebraic_tran != NULL)
+                            blasfeo_dgein1(-interpolated_value, out->S_algebraic_tran,
+                                           jj < nx ? nu + jj : jj - nx, ii);
+                        else
+                            S_algebraic[ii+jj*nz] = -interpolated_value;
                         // printf("\ndz[ii=%d]_dxu[jj=%d] = %e\n", ii, jj, interpolated_value);
                         // blasfeo_pack_dvec(1, &interpolated_value, 1, xtdot, ii);
                     }
@@ -1796,7 +1799,7 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
                     blasfeo_dgesc(nx + nz, nx + nu, -1.0, dk0_dxu, 0, 0);
 
                     // extract output
-                    blasfeo_unpack_dmat(nz, nx + nu, dk0_dxu, nx, 0, S_algebraic, nz);
+                    sim_out_unpack_S_algebraic(nx, nu, nz, dk0_dxu, nx, 0, out);
                 } // if sens_algebraic
                 // Reset impl_ode inputs
                 impl_ode_type_in[0] = BLASFEO_DVEC;       // xt
@@ -1819,7 +1822,7 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     blasfeo_unpack_dvec(nx, xn, 0, x_out, 1);
 
     if  ( opts->sens_forw || opts->sens_hess )
-        blasfeo_unpack_dmat(nx, nx + nu, S_forw_ss, 0, 0, S_forw_out, nx);
+        sim_out_unpack_S_forw(nx, nu, S_forw_ss, 0, 0, out);
 
 /*****************************************************************************
 * Backward Sweep
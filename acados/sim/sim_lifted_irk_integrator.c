@@ -686,7 +686,6 @@ int sim_lifted_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *m
 
     double *x = in->x;
     double *u = in->u;
-    double *S_forw_in = in->S_forw;
 
     // int newton_iter = opts->newton_iter; // not used; always 1 in lifted
 
@@ -718,7 +717,6 @@ int sim_lifted_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *m
     struct blasfeo_dvec *w = workspace->w;
 
     double *x_out = out->xn;
-    double *S_forw_out = out->S_forw;
 
     struct blasfeo_dvec_args ext_fun_in_K;
 
@@ -767,7 +765,7 @@ int sim_lifted_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *m
 
     blasfeo_dvecse(nx * ns, 0.0, rG, 0);
 
-    if (update_sens) blasfeo_pack_dmat(nx, nx + nu, S_forw_in, nx, S_forw, 0, 0);
+    if (update_sens) sim_in_pack_S_forw(nx, nu, in, S_forw, 0, 0);
 
     blasfeo_dvecse(nx * ns, 0.0, rG, 0);
     blasfeo_pack_dvec(nx, x, 1, xn, 0);
@@ -955,7 +953,7 @@ int sim_lifted_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *m
     // extract output
     blasfeo_unpack_dvec(nx, xn_out, 0, x_out, 1);
 
-    blasfeo_unpack_dmat(nx, nx + nu, S_forw, 0, 0, S_forw_out, nx);
+    sim_out_unpack_S_forw(nx, nu, S_forw, 0, 0, out);
 
     out->info->CPUtime = acados_toc(&timer);
     out->info->ADtime = timing_ad;
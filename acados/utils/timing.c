@@ -29,6 +29,11 @@
  */
 
 
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+// clock_gettime and CLOCK_MONOTONIC are POSIX and hidden in strict C99 mode
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "acados/utils/timing.h"
 
 
@@ -91,14 +96,28 @@ real_t acados_toc(acados_timer* t) { return ds1401_tic_read() - t->time; }
 
 #if (__STDC_VERSION__ >= 199901L) && !(defined __MINGW32__ || defined __MINGW64__) // C99 Mode
 
+#if defined(CLOCK_MONOTONIC)
+/* read monotonic time: not affected by wall clock adjustments and, on Linux,
+ * served by the vDSO without entering the kernel */
+static void acados_timer_now(struct timeval *tv)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    tv->tv_sec = ts.tv_sec;
+    tv->tv_usec = ts.tv_nsec / 1000;
+}
+#else
+static void acados_timer_now(struct timeval *tv) { gettimeofday(tv, 0); }
+#endif
+
 /* read current time */
-void acados_tic(acados_timer* t) { gettimeofday(&t->tic, 0); }
+void acados_tic(acados_timer* t) { acados_timer_now(&t->tic); }
 /* return time passed since last call to tic on this timer */
 real_t acados_toc(acados_timer* t)
 {
     struct timeval temp;
 
-    gettimeofday(&t->toc, 0);
+    acados_timer_now(&t->toc);
 
     if ((t->toc.tv_usec - t->tic.tv_usec) < 0)
     {
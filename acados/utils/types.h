@@ -80,6 +80,7 @@ enum return_values
     ACADOS_QP_FAILURE,
     ACADOS_READY,
     ACADOS_UNBOUNDED,
+    ACADOS_TIMEOUT,
 };
 
 
@@ -95,6 +96,23 @@ typedef enum
 
 
 
+/// Columns of the per-iteration statistics of the HPIPM interfaces, see memory_get "stat".
+enum qp_stat_columns
+{
+    QP_STAT_ALPHA_PRIM,
+    QP_STAT_ALPHA_DUAL,
+    QP_STAT_MU,
+    QP_STAT_RES_STAT,
+    QP_STAT_RES_EQ,
+    QP_STAT_RES_INEQ,
+    QP_STAT_RES_COMP,
+    QP_STAT_ITREF_PRED,  // iterative refinement steps in the predictor
+    QP_STAT_ITREF_CORR,  // iterative refinement steps in the corrector
+    QP_STAT_N,
+};
+
+
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
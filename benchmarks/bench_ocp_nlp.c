@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+
+// Latency benchmark of the nlp solvers on the hanging chain problem.
+// SQP, SQP_RTI and DDP are run with ERK dynamics, linear least squares cost and an initial
+// state constraint (the only constraint type supported by DDP), for a sweep of masses and
+// horizon lengths.
+
+// external
+#include <stdio.h>
+#include <stdlib.h>
+
+// acados
+#include "acados/utils/timing.h"
+#include "acados_c/external_function_interface.h"
+#include "acados_c/ocp_nlp_interface.h"
+
+#include "benchmarks/bench_utils.h"
+
+// chain model
+#include "examples/c/chain_model/chain_model.h"
+
+// x0 and xN
+#include "examples/c/chain_model/x0_nm2.c"
+#include "examples/c/chain_model/x0_nm3.c"
+#include "examples/c/chain_model/x0_nm4.c"
+#include "examples/c/chain_model/xN_nm2.c"
+#include "examples/c/chain_model/xN_nm3.c"
+#include "examples/c/chain_model/xN_nm4.c"
+
+#define NU 3
+#define TS 0.2
+
+
+
+typedef struct
+{
+    ocp_nlp_solver_t solver;
+    const char *name;
+} nlp_solver_entry;
+
+
+
+static const nlp_solver_entry nlp_solvers[] =
+{
+    {SQP, "SQP"},
+    {SQP_RTI, "SQP_RTI"},
+    {DDP, "DDP"},
+};
+
+// number of masses, including the fixed one
+static const int nm_values[] = {2, 3, 4};
+static const int N_values[] = {10, 20, 40};
+
+#define NUM_PHASES 6
+
+
+
+static void select_chain_model(int nm, external_function_casadi *expl_vde_for, double **x0, double **xN)
+{
+    switch (nm)
+    {
+        case 2:
+            BENCH_CASADI_FUN(expl_vde_for, vde_chain_nm2);
+            *x0 = x0_nm2;
+            *xN = xN_nm2;
+            break;
+        case 3:
+            BENCH_CASADI_FUN(expl_vde_for, vde_chain_nm3);
+            *x0 = x0_nm3;
+            *xN = xN_nm3;
+            break;
+        case 4:
+            BENCH_CASADI_FUN(expl_vde_for, vde_chain_nm4);
+            *x0 = x0_nm4;
+            *xN = xN_nm4;
+            break;
+        default:
+            printf("\nerror: bench_ocp_nlp: chain with %d masses not available\n", nm);
+            exit(1);
+    }
+}
+
+
+
+int main(int argc, char **argv)
+{
+    bench_args args;
+    bench_parse_args(argc, argv, &args);
+
+    int num_solvers = sizeof(nlp_solvers) / sizeof(nlp_solvers[0]);
+    int num_nm = sizeof(nm_values) / sizeof(nm_values[0]);
+    int num_N = sizeof(N_values) / sizeof(N_values[0]);
+
+    bench_series phases[NUM_PHASES];
+    bench_series_init(phases+0, "wall", args.num_rep);
+    bench_series_init(phases+1, "total", args.num_rep);
+    bench_series_init(phases+2, "lin", args.num_rep);
+    bench_series_init(phases+3, "sim", args.num_rep);
+    bench_series_init(phases+4, "qp_sol", args.num_rep);
+    bench_series_init(phases+5, "reg", args.num_rep);
+
+    bench_report report;
+    bench_report_open(&report, args.output, "ocp_nlp");
+
+    acados_timer timer;
+    char id[256];
+    int acados_return = 0;
+
+    for (int is = 0; is < num_solvers; is++)
+    {
+        for (int im = 0; im < num_nm; im++)
+        {
+            for (int iN = 0; iN < num_N; iN++)
+            {
+                int nm = nm_values[im];
+                int N = N_values[iN];
+                int nx_ = 6*(nm-1);
+                int ny_ = nx_ + NU;
+
+                double *x0, *xN;
+                external_function_casadi *expl_vde_for = malloc(N*sizeof(external_function_casadi));
+                for (int i = 0; i < N; i++)
+                    select_chain_model(nm, expl_vde_for+i, &x0, &xN);
+                external_function_casadi_create_array(N, expl_vde_for);
+
+                /************************************************
+                * plan + config
+                ************************************************/
+
+                ocp_nlp_plan_t *plan = ocp_nlp_plan_create(N);
+                plan->nlp_solver = nlp_solvers[is].solver;
+                plan->regularization = NO_REGULARIZE;
+                plan->ocp_qp_solver_plan.qp_solver = PARTIAL_CONDENSING_HPIPM;
+                for (int i = 0; i <= N; i++)
+                {
+                    plan->nlp_cost[i] = LINEAR_LS;
+                    plan->nlp_constraints[i] = BGH;
+                }
+                for (int i = 0; i < N; i++)
+                {
+                    plan->nlp_dynamics[i] = CONTINUOUS_MODEL;
+                    plan->sim_solver_plan[i].sim_solver = ERK;
+                }
+
+                ocp_nlp_config *config = ocp_nlp_config_create(*plan);
+
+                /************************************************
+                * dims
+                ************************************************/
+
+                int *nx = malloc((N+1)*sizeof(int));
+                int *nu = malloc((N+1)*sizeof(int));
+                int *zeros = calloc(N+1, sizeof(int));
+                for (int i = 0; i <= N; i++)
+                {
+                    nx[i] = nx_;
+                    nu[i] = i < N ? NU : 0;
+                }
+
+                ocp_nlp_dims *dims = ocp_nlp_dims_create(config);
+                ocp_nlp_dims_set_opt_vars(config, dims, "nx", nx);
+                ocp_nlp_dims_set_opt_vars(config, dims, "nu", nu);
+                ocp_nlp_dims_set_opt_vars(config, dims, "nz", zeros);
+                ocp_nlp_dims_set_opt_vars(config, dims, "ns", zeros);
+
+                for (int i = 0; i <= N; i++)
+                {
+                    int ny = i < N ? ny_ : nx_;
+                    int nbx = i == 0 ? nx_ : 0;
+                    ocp_nlp_dims_set_cost(config, dims, i, "ny", &ny);
+                    ocp_nlp_dims_set_constraints(config, dims, i, "nbx", &nbx);
+                    ocp_nlp_dims_set_constraints(config, dims, i, "nbu", zeros);
+                    ocp_nlp_dims_set_constraints(config, dims, i, "ng", zeros);
+                    ocp_nlp_dims_set_constraints(config, dims, i, "nh", zeros);
+                }
+
+                /************************************************
+                * nlp_in
+                ************************************************/
+
+                ocp_nlp_in *nlp_in = ocp_nlp_in_create(config, dims);
+
+                double Ts = TS;
+                for (int i = 0; i < N; i++)
+                    ocp_nlp_in_set(config, dims, nlp_in, i, "Ts", &Ts);
+
+                // y = [x; u], tracking the resting position
+                double *Cyt = calloc((nx_+NU)*ny_, sizeof(double));
+                double *W = calloc(ny_*ny_, sizeof(double));
+                double *yref = calloc(ny_, sizeof(double));
+                for (int j = 0; j < NU; j++)
+                    Cyt[j+(nx_+NU)*(nx_+j)] = 1.0;
+                for (int j = 0; j < nx_; j++)
+                    Cyt[NU+j+(nx_+NU)*j] = 1.0;
+                for (int j = 0; j < nx_; j++)
+                    W[j*(ny_+1)] = 1e-2;
+                for (int j = 0; j < NU; j++)
+                    W[(nx_+j)*(ny_+1)] = 1.0;
+                for (int j = 0; j < nx_; j++)
+                    yref[j] = xN[j];
+
+                double *CytN = calloc(nx_*nx_, sizeof(double));
+                double *WN = calloc(nx_*nx_, sizeof(double));
+                for (int j = 0; j < nx_; j++)
+                {
+                    CytN[j*(nx_+1)] = 1.0;
+                    WN[j*(nx_+1)] = 1e-2;
+                }
+
+                for (int i = 0; i < N; i++)
+                {
+                    ocp_nlp_cost_model_set(config, dims, nlp_in, i, "Cyt", Cyt);
+                    ocp_nlp_cost_model_set(config, dims, nlp_in, i, "W", W);
+                    ocp_nlp_cost_model_set(config, dims, nlp_in, i, "yref", yref);
+                }
+                ocp_nlp_cost_model_set(config, dims, nlp_in, N, "Cyt", CytN);
+                ocp_nlp_cost_model_set(config, dims, nlp_in, N, "W", WN);
+                ocp_nlp_cost_model_set(config, dims, nlp_in, N, "yref", yref);
+
+                for (int i = 0; i < N; i++)
+                {
+                    if (ocp_nlp_dynamics_model_set(config, dims, nlp_in, i, "expl_vde_for", expl_vde_for+i))
+                        exit(1);
+                }
+
+                int *idxbx0 = malloc(nx_*sizeof(int));
+                for (int j = 0; j < nx_; j++)
+                    idxbx0[j] = j;
+                ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "idxbx", idxbx0);
+                ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "lbx", x0);
+                ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "ubx", x0);
+
+                /************************************************
+                * opts + solver
+                ************************************************/
+
+                void *nlp_opts = ocp_nlp_solver_opts_create(config, dims);
+
+                int ns = 4;
+                for (int i = 0; i < N; i++)
+                    ocp_nlp_solver_opts_set_at_stage(config, nlp_opts, i, "dynamics_ns", &ns);
+
+                if (plan->nlp_solver != SQP_RTI)
+                {
+                    int max_iter = 50;
+                    double tol = 1e-6;
+                    ocp_nlp_solver_opts_set(config, nlp_opts, "max_iter", &max_iter);
+                    ocp_nlp_solver_opts_set(config, nlp_opts, "tol_stat", &tol);
+                    ocp_nlp_solver_opts_set(config, nlp_opts, "tol_eq", &tol);
+                    ocp_nlp_solver_opts_set(config, nlp_opts, "tol_ineq", &tol);
+                    ocp_nlp_solver_opts_set(config, nlp_opts, "tol_comp", &tol);
+                }
+
+                ocp_nlp_out *nlp_out = ocp_nlp_out_create(config, dims);
+                ocp_nlp_solver *solver = ocp_nlp_solver_create(config, dims, nlp_opts);
+                if (ocp_nlp_precompute(solver, nlp_in, nlp_out))
+                {
+                    printf("\nerror: bench_ocp_nlp: precompute failed for %s\n", nlp_solvers[is].name);
+                    exit(1);
+                }
+
+                /************************************************
+                * benchmark
+                ************************************************/
+
+                double *u0 = calloc(NU, sizeof(double));
+
+                for (int rep = 0; rep < args.num_warmup + args.num_rep; rep++)
+                {
+                    // same initial guess in every repetition
+                    for (int i = 0; i <= N; i++)
+                    {
+                        ocp_nlp_out_set(config, dims, nlp_out, i, "x", x0);
+                        if (i < N)
+                            ocp_nlp_out_set(config, dims, nlp_out, i, "u", u0);
+                    }
+                    ocp_nlp_solver_reset_qp_memory(solver, nlp_in, nlp_out);
+
+                    if (rep == args.num_warmup)
+                    {
+                        for (int ii = 0; ii < NUM_PHASES; ii++)
+                            bench_series_reset(phases+ii);
+                    }
+
+                    acados_tic(&timer);
+                    int nlp_return = ocp_nlp_solve(solver, nlp_in, nlp_out);
+                    double wall = acados_toc(&timer);
+
+                    if (nlp_return != ACADOS_SUCCESS && nlp_return != ACADOS_MAXITER)
+                        acados_return = nlp_return;
+
+                    if (rep >= args.num_warmup)
+                    {
+                        double time_tot, time_lin, time_sim, time_qp_sol, time_reg;
+                        ocp_nlp_get(config, solver, "time_tot", &time_tot);
+                        ocp_nlp_get(config, solver, "time_lin", &time_lin);
+                        ocp_nlp_get(config, solver, "time_sim", &time_sim);
+                        ocp_nlp_get(config, solver, "time_qp_sol", &time_qp_sol);
+                        ocp_nlp_get(config, solver, "time_reg", &time_reg);
+
+                        bench_series_push(phases+0, wall);
+                        bench_series_push(phases+1, time_tot);
+                        bench_series_push(phases+2, time_lin);
+                        bench_series_push(phases+3, time_sim);
+                        bench_series_push(phases+4, time_qp_sol);
+                        bench_series_push(phases+5, time_reg);
+                    }
+                }
+
+                snprintf(id, sizeof(id), "%s/chain_nm%d/N%d", nlp_solvers[is].name, nm, N);
+                bench_report_case(&report, id, NUM_PHASES, phases);
+                printf("%-50s p50 %10.3f us\n", id, 1e6*phases[0].samples[phases[0].n/2]);
+
+                free(u0);
+                ocp_nlp_solver_destroy(solver);
+                ocp_nlp_out_destroy(nlp_out);
+                ocp_nlp_solver_opts_destroy(nlp_opts);
+                ocp_nlp_in_destroy(nlp_in);
+                ocp_nlp_dims_destroy(dims);
+                ocp_nlp_config_destroy(config);
+                ocp_nlp_plan_destroy(plan);
+                external_function_casadi_free_array(N, expl_vde_for);
+                free(expl_vde_for);
+                free(idxbx0);
+                free(Cyt);
+                free(W);
+                free(yref);
+                free(CytN);
+                free(WN);
+                free(nx);
+                free(nu);
+                free(zeros);
+            }
+        }
+    }
+
+    bench_report_close(&report);
+
+    for (int ii = 0; ii < NUM_PHASES; ii++)
+        bench_series_free(phases+ii);
+
+    if (acados_return != 0)
+    {
+        printf("\nerror: at least one nlp solve failed, last status %d\n", acados_return);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+
+// Latency benchmark of the ocp qp solvers on the mass spring test problem.
+// Every available backend is run on a sweep of horizon lengths and state dimensions.
+// The hpipm and the blocked Hessian condensing of FULL_CONDENSING_HPIPM are compared on long horizons.
+
+// external
+#include <stdio.h>
+#include <stdlib.h>
+
+// acados
+#include "acados/utils/timing.h"
+#include "acados_c/ocp_qp_interface.h"
+
+#include "benchmarks/bench_utils.h"
+
+// mass spring helper functions
+ocp_qp_xcond_solver_dims *create_ocp_qp_dims_mass_spring(ocp_qp_xcond_solver_config *config, int N, int nx_, int nu_, int nb_, int ng_, int ngN);
+ocp_qp_in *create_ocp_qp_in_mass_spring(ocp_qp_dims *dims);
+
+
+
+typedef struct
+{
+    ocp_qp_solver_t solver;
+    const char *name;
+} qp_solver_entry;
+
+
+
+static const qp_solver_entry qp_solvers[] =
+{
+    {PARTIAL_CONDENSING_HPIPM, "PARTIAL_CONDENSING_HPIPM"},
+    {FULL_CONDENSING_HPIPM, "FULL_CONDENSING_HPIPM"},
+    {PARTIAL_CONDENSING_ADMM, "PARTIAL_CONDENSING_ADMM"},
+#ifdef ACADOS_WITH_HPMPC
+    {PARTIAL_CONDENSING_HPMPC, "PARTIAL_CONDENSING_HPMPC"},
+#endif
+#ifdef ACADOS_WITH_QPDUNES
+    {PARTIAL_CONDENSING_QPDUNES, "PARTIAL_CONDENSING_QPDUNES"},
+#endif
+#ifdef ACADOS_WITH_OOQP
+    {PARTIAL_CONDENSING_OOQP, "PARTIAL_CONDENSING_OOQP"},
+    {FULL_CONDENSING_OOQP, "FULL_CONDENSING_OOQP"},
+#endif
+#ifdef ACADOS_WITH_OSQP
+    {PARTIAL_CONDENSING_OSQP, "PARTIAL_CONDENSING_OSQP"},
+#endif
+#ifdef ACADOS_WITH_QPOASES
+    {FULL_CONDENSING_QPOASES, "FULL_CONDENSING_QPOASES"},
+#endif
+#ifdef ACADOS_WITH_DAQP
+    {FULL_CONDENSING_DAQP, "FULL_CONDENSING_DAQP"},
+#endif
+#ifdef ACADOS_WITH_QORE
+    {FULL_CONDENSING_QORE, "FULL_CONDENSING_QORE"},
+#endif
+};
+
+// horizon lengths
+static const int N_values[] = {10, 20, 40};
+// (nx, nu) pairs, nx even and nu <= nx/2 as required by the mass spring system
+static const int nx_values[] = {4, 8, 16};
+static const int nu_values[] = {2, 3, 4};
+
+// horizon lengths for the comparison of the full condensing algorithms
+static const int N_cond_values[] = {20, 50, 100, 200};
+// hess_alg of the full condensing, 0 hpipm, 1 blocked
+static const char *hess_alg_names[] = {"HPIPM", "BLOCKED"};
+
+#define NUM_PHASES 5
+
+
+
+static void set_solver_opts(ocp_qp_xcond_solver_config *config, void *opts, ocp_qp_solver_t solver, int N)
+{
+    int iter_max = 100;
+    int warm_start = 0;
+
+    switch (solver)
+    {
+        case PARTIAL_CONDENSING_HPIPM:
+            config->opts_set(config, opts, "iter_max", &iter_max);
+            break;
+        case FULL_CONDENSING_HPIPM:
+            config->opts_set(config, opts, "iter_max", &iter_max);
+            break;
+#ifdef ACADOS_WITH_HPMPC
+        case PARTIAL_CONDENSING_HPMPC:
+            config->opts_set(config, opts, "iter_max", &iter_max);
+            break;
+#endif
+#ifdef ACADOS_WITH_QPDUNES
+        case PARTIAL_CONDENSING_QPDUNES:
+        {
+            // no general constraints, no partial condensing: clipping applies
+            int clipping = 1;
+            config->opts_set(config, opts, "cond_N", &N);
+            config->opts_set(config, opts, "clipping", &clipping);
+            config->opts_set(config, opts, "warm_start", &warm_start);
+            break;
+        }
+#endif
+#ifdef ACADOS_WITH_QPOASES
+        case FULL_CONDENSING_QPOASES:
+            config->opts_set(config, opts, "warm_start", &warm_start);
+            break;
+#endif
+        default:
+            // default options
+            break;
+    }
+}
+
+
+
+// runs one benchmark case and stores it in the report under id,
+// hess_alg >= 0 is passed to the full condensing; returns the last failed qp status, 0 otherwise
+static int bench_case(ocp_qp_xcond_solver_config *config, ocp_qp_solver_t qp_solver, int N, int nx, int nu,
+                      int hess_alg, bench_args *args, bench_series *phases, bench_report *report, const char *id)
+{
+    int nb = nx + nu;
+    int acados_return = 0;
+    acados_timer timer;
+
+    ocp_qp_xcond_solver_dims *dims = create_ocp_qp_dims_mass_spring(config, N, nx, nu, nb, 0, 0);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(dims->orig_dims);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, dims);
+    set_solver_opts(config, opts, qp_solver, N);
+    if (hess_alg >= 0)
+        config->opts_set(config, opts, "cond_hess_alg", &hess_alg);
+
+    ocp_qp_solver *solver = ocp_qp_create(config, dims, opts);
+    qp_info *info = (qp_info *) qp_out->misc;
+
+    for (int rep = 0; rep < args->num_warmup; rep++)
+        ocp_qp_solve(solver, qp_in, qp_out);
+
+    for (int ii = 0; ii < NUM_PHASES; ii++)
+        bench_series_reset(phases+ii);
+
+    for (int rep = 0; rep < args->num_rep; rep++)
+    {
+        acados_tic(&timer);
+        int qp_return = ocp_qp_solve(solver, qp_in, qp_out);
+        double wall = acados_toc(&timer);
+
+        if (qp_return != ACADOS_SUCCESS && qp_return != ACADOS_MAXITER)
+            acados_return = qp_return;
+
+        bench_series_push(phases+0, wall);
+        bench_series_push(phases+1, info->total_time);
+        bench_series_push(phases+2, info->condensing_time);
+        bench_series_push(phases+3, info->solve_QP_time);
+        bench_series_push(phases+4, info->interface_time);
+    }
+
+    bench_report_case(report, id, NUM_PHASES, phases);
+    printf("%-50s p50 %10.3f us\n", id, 1e6*phases[0].samples[phases[0].n/2]);
+
+    ocp_qp_solver_destroy(solver);
+    ocp_qp_xcond_solver_opts_free(opts);
+    ocp_qp_out_free(qp_out);
+    ocp_qp_in_free(qp_in);
+    ocp_qp_xcond_solver_dims_free(dims);
+
+    return acados_return;
+}
+
+
+
+int main(int argc, char **argv)
+{
+    bench_args args;
+    bench_parse_args(argc, argv, &args);
+
+    int num_solvers = sizeof(qp_solvers) / sizeof(qp_solvers[0]);
+    int num_N = sizeof(N_values) / sizeof(N_values[0]);
+    int num_nx = sizeof(nx_values) / sizeof(nx_values[0]);
+
+    bench_series phases[NUM_PHASES];
+    bench_series_init(phases+0, "wall", args.num_rep);
+    bench_series_init(phases+1, "total", args.num_rep);
+    bench_series_init(phases+2, "condensing", args.num_rep);
+    bench_series_init(phases+3, "qp_solver", args.num_rep);
+    bench_series_init(phases+4, "interface", args.num_rep);
+
+    bench_report report;
+    bench_report_open(&report, args.output, "ocp_qp");
+
+    char id[256];
+    int acados_return = 0;
+
+    for (int is = 0; is < num_solvers; is++)
+    {
+        ocp_qp_solver_plan_t plan;
+        plan.qp_solver = qp_solvers[is].solver;
+
+        ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+
+        for (int iN = 0; iN < num_N; iN++)
+        {
+            for (int ix = 0; ix < num_nx; ix++)
+            {
+                int N = N_values[iN];
+                int nx = nx_values[ix];
+                int nu = nu_values[ix];
+
+                snprintf(id, sizeof(id), "%s/N%d_nx%d_nu%d", qp_solvers[is].name, N, nx, nu);
+                int qp_return = bench_case(config, plan.qp_solver, N, nx, nu, -1, &args, phases, &report, id);
+                if (qp_return != 0)
+                    acados_return = qp_return;
+            }
+        }
+
+        ocp_qp_xcond_solver_config_free(config);
+    }
+
+    // full condensing: hpipm and blocked Hessian condensing
+    {
+        ocp_qp_solver_plan_t plan;
+        plan.qp_solver = FULL_CONDENSING_HPIPM;
+
+        ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+
+        int num_N_cond = sizeof(N_cond_values) / sizeof(N_cond_values[0]);
+
+        for (int hess_alg = 0; hess_alg < 2; hess_alg++)
+        {
+            for (int iN = 0; iN < num_N_cond; iN++)
+            {
+                for (int ix = 0; ix < num_nx; ix++)
+                {
+                    int N = N_cond_values[iN];
+                    int nx = nx_values[ix];
+                    int nu = nu_values[ix];
+
+                    snprintf(id, sizeof(id), "FULL_CONDENSING_%s/N%d_nx%d_nu%d", hess_alg_names[hess_alg], N, nx, nu);
+                    int qp_return = bench_case(config, plan.qp_solver, N, nx, nu, hess_alg, &args, phases, &report, id);
+                    if (qp_return != 0)
+                        acados_return = qp_return;
+                }
+            }
+        }
+
+        ocp_qp_xcond_solver_config_free(config);
+    }
+
+    bench_report_close(&report);
+
+    for (int ii = 0; ii < NUM_PHASES; ii++)
+        bench_series_free(phases+ii);
+
+    if (acados_return != 0)
+    {
+        printf("\nerror: at least one qp solve failed, last status %d\n", acados_return);
+        return 1;
+    }
+    return 0;
+}
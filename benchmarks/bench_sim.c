@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+// Latency benchmark of the integrators with forward sensitivities for a sweep of step counts on
+// - the wind turbine model (nx = 3, nu = 4): ERK, IRK, LIFTED_IRK and GNSF
+// - the pendulum model (nx = 4, nu = 1): ERK, IRK and LIFTED_IRK
+// - the crane DAE model (nx = 9, nu = 2, nz = 2): IRK and GNSF
+
+// external
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// acados
+#include "acados/utils/external_function_generic.h"
+#include "acados/utils/timing.h"
+#include "acados_c/external_function_interface.h"
+#include "acados_c/sim_interface.h"
+
+#include "benchmarks/bench_utils.h"
+
+// models
+#include "examples/c/wt_model_nx3/wt_model.h"
+#include "examples/c/pendulum_model/pendulum_model.h"
+#include "examples/c/crane_dae_model/crane_dae_model.h"
+
+// x0 and u for simulation of the wind turbine
+#include "examples/c/wt_model_nx3/u_x0.c"
+
+
+
+typedef struct
+{
+    sim_solver_t solver;
+    const char *name;
+} sim_solver_entry;
+
+
+
+static const sim_solver_entry sim_solvers[] =
+{
+    {ERK, "ERK"},
+    {IRK, "IRK"},
+    {LIFTED_IRK, "LIFTED_IRK"},
+    {GNSF, "GNSF"},
+};
+
+static const int num_steps_values[] = {1, 2, 4};
+
+#define NUM_PHASES 4
+
+
+
+// model functions, the integrators that need a function not provided by a model are skipped
+typedef struct
+{
+    const char *name;
+    int nx;
+    int nu;
+    int nz;
+    // gnsf structure
+    int nx1;
+    int nz1;
+    int nout;
+    int ny;
+    int nuhat;
+    double T;
+    const double *x0;
+    const double *u;
+
+    bool with_erk;
+    bool with_irk;
+    bool with_lifted_irk;
+    bool with_gnsf;
+
+    external_function_casadi expl_vde_for;
+    external_function_casadi impl_ode_fun;
+    external_function_casadi impl_ode_fun_jac_x_xdot;
+    external_function_casadi impl_ode_jac_x_xdot_u;
+    external_function_casadi impl_ode_fun_jac_x_xdot_u;
+    external_function_casadi phi_fun;
+    external_function_casadi phi_fun_jac_y;
+    external_function_casadi phi_jac_y_uhat;
+    external_function_casadi f_lo_fun_jac_x1k1uz;
+    external_function_casadi get_matrices_fun;
+} sim_bench_model;
+
+
+
+static const double x0_pendulum[] = {0.0, 0.5, 0.0, 0.0};
+static const double u_pendulum[] = {0.1};
+
+// xL = 0.8, from test/sim/sim_test_dae.cpp
+static const double x0_crane_dae[] = {0.8, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+static const double u_crane_dae[] = {40.108149413030752, -50.446662212534974};
+
+
+
+static void sim_bench_model_wt_nx3(sim_bench_model *model)
+{
+    model->name = "wt_nx3";
+    model->nx = 3;
+    model->nu = 4;
+    model->nz = 0;
+    model->nx1 = 3;
+    model->nz1 = 0;
+    model->nout = 1;
+    model->ny = 3;
+    model->nuhat = 4;
+    model->T = 0.05;
+    model->x0 = x0;
+    model->u = u_sim;
+
+    model->with_erk = true;
+    model->with_irk = true;
+    model->with_lifted_irk = true;
+    model->with_gnsf = true;
+
+    BENCH_CASADI_FUN(&model->expl_vde_for, casadi_expl_vde_for);
+    BENCH_CASADI_FUN(&model->impl_ode_fun, casadi_impl_ode_fun);
+    BENCH_CASADI_FUN(&model->impl_ode_fun_jac_x_xdot, casadi_impl_ode_fun_jac_x_xdot);
+    BENCH_CASADI_FUN(&model->impl_ode_jac_x_xdot_u, casadi_impl_ode_jac_x_xdot_u);
+    BENCH_CASADI_FUN(&model->impl_ode_fun_jac_x_xdot_u, casadi_impl_ode_fun_jac_x_xdot_u);
+    BENCH_CASADI_FUN(&model->phi_fun, casadi_phi_fun);
+    BENCH_CASADI_FUN(&model->phi_fun_jac_y, casadi_phi_fun_jac_y);
+    BENCH_CASADI_FUN(&model->phi_jac_y_uhat, casadi_phi_jac_y_uhat);
+    BENCH_CASADI_FUN(&model->f_lo_fun_jac_x1k1uz, casadi_f_lo_fun_jac_x1k1uz);
+    BENCH_CASADI_FUN(&model->get_matrices_fun, casadi_get_matrices_fun);
+}
+
+
+
+static void sim_bench_model_pendulum(sim_bench_model *model)
+{
+    model->name = "pendulum";
+    model->nx = 4;
+    model->nu = 1;
+    model->nz = 0;
+    model->T = 0.1;
+    model->x0 = x0_pendulum;
+    model->u = u_pendulum;
+
+    model->with_erk = true;
+    model->with_irk = true;
+    model->with_lifted_irk = true;
+    model->with_gnsf = false;
+
+    BENCH_CASADI_FUN(&model->expl_vde_for, pendulum_ode_expl_vde_forw);
+    BENCH_CASADI_FUN(&model->impl_ode_fun, pendulum_ode_impl_ode_fun);
+    BENCH_CASADI_FUN(&model->impl_ode_fun_jac_x_xdot, pendulum_ode_impl_ode_fun_jac_x_xdot_z);
+    BENCH_CASADI_FUN(&model->impl_ode_jac_x_xdot_u, pendulum_ode_impl_ode_jac_x_xdot_u_z);
+    BENCH_CASADI_FUN(&model->impl_ode_fun_jac_x_xdot_u, pendulum_ode_impl_ode_fun_jac_x_xdot_u);
+}
+
+
+
+static void sim_bench_model_crane_dae(sim_bench_model *model)
+{
+    model->name = "crane_dae";
+    model->nx = 9;
+    model->nu = 2;
+    model->nz = 2;
+    model->nx1 = 5;
+    model->nz1 = 0;
+    model->nout = 1;
+    model->ny = 4;
+    model->nuhat = 1;
+    model->T = 0.01;
+    model->x0 = x0_crane_dae;
+    model->u = u_crane_dae;
+
+    // LIFTED_IRK does not support algebraic variables
+    model->with_erk = false;
+    model->with_irk = true;
+    model->with_lifted_irk = false;
+    model->with_gnsf = true;
+
+    BENCH_CASADI_FUN(&model->impl_ode_fun, crane_dae_impl_ode_fun);
+    BENCH_CASADI_FUN(&model->impl_ode_fun_jac_x_xdot, crane_dae_impl_ode_fun_jac_x_xdot);
+    BENCH_CASADI_FUN(&model->impl_ode_jac_x_xdot_u, crane_dae_impl_ode_jac_x_xdot_u);
+    BENCH_CASADI_FUN(&model->phi_fun, crane_dae_phi_fun);
+    BENCH_CASADI_FUN(&model->phi_fun_jac_y, crane_dae_phi_fun_jac_y);
+    BENCH_CASADI_FUN(&model->phi_jac_y_uhat, crane_dae_phi_jac_y_uhat);
+    BENCH_CASADI_FUN(&model->f_lo_fun_jac_x1k1uz, crane_dae_f_lo_fun_jac_x1k1uz);
+    BENCH_CASADI_FUN(&model->get_matrices_fun, crane_dae_get_matrices_fun);
+}
+
+
+
+static void sim_bench_model_create(sim_bench_model *model)
+{
+    if (model->with_erk)
+        external_function_casadi_create(&model->expl_vde_for);
+    if (model->with_irk)
+    {
+        external_function_casadi_create(&model->impl_ode_fun);
+        external_function_casadi_create(&model->impl_ode_fun_jac_x_xdot);
+        external_function_casadi_create(&model->impl_ode_jac_x_xdot_u);
+    }
+    if (model->with_lifted_irk)
+    {
+        if (!model->with_irk)
+            external_function_casadi_create(&model->impl_ode_fun);
+        external_function_casadi_create(&model->impl_ode_fun_jac_x_xdot_u);
+    }
+    if (model->with_gnsf)
+    {
+        external_function_casadi_create(&model->phi_fun);
+        external_function_casadi_create(&model->phi_fun_jac_y);
+        external_function_casadi_create(&model->phi_jac_y_uhat);
+        external_function_casadi_create(&model->f_lo_fun_jac_x1k1uz);
+        external_function_casadi_create(&model->get_matrices_fun);
+    }
+}
+
+
+
+static void sim_bench_model_free(sim_bench_model *model)
+{
+    if (model->with_erk)
+        external_function_casadi_free(&model->expl_vde_for);
+    if (model->with_irk)
+    {
+        external_function_casadi_free(&model->impl_ode_fun);
+        external_function_casadi_free(&model->impl_ode_fun_jac_x_xdot);
+        external_function_casadi_free(&model->impl_ode_jac_x_xdot_u);
+    }
+    if (model->with_lifted_irk)
+    {
+        if (!model->with_irk)
+            external_function_casadi_free(&model->impl_ode_fun);
+        external_function_casadi_free(&model->impl_ode_fun_jac_x_xdot_u);
+    }
+    if (model->with_gnsf)
+    {
+        external_function_casadi_free(&model->phi_fun);
+        external_function_casadi_free(&model->phi_fun_jac_y);
+        external_function_casadi_free(&model->phi_jac_y_uhat);
+        external_function_casadi_free(&model->f_lo_fun_jac_x1k1uz);
+        external_function_casadi_free(&model->get_matrices_fun);
+    }
+}
+
+
+
+static bool sim_bench_model_supports(sim_bench_model *model, sim_solver_t solver)
+{
+    switch (solver)
+    {
+        case ERK:
+            return model->with_erk;
+        case IRK:
+            return model->with_irk;
+        case LIFTED_IRK:
+            return model->with_lifted_irk;
+        case GNSF:
+            return model->with_gnsf;
+        default:
+            return false;
+    }
+}
+
+
+
+int main(int argc, char **argv)
+{
+    bench_args args;
+    bench_parse_args(argc, argv, &args);
+
+    /************************************************
+    * models
+    ************************************************/
+
+    sim_bench_model models[3];
+    sim_bench_model_wt_nx3(models+0);
+    sim_bench_model_pendulum(models+1);
+    sim_bench_model_crane_dae(models+2);
+    int num_models = sizeof(models) / sizeof(models[0]);
+
+    for (int im = 0; im < num_models; im++)
+        sim_bench_model_create(models+im);
+
+    /************************************************
+    * benchmark
+    ************************************************/
+
+    int num_solvers = sizeof(sim_solvers) / sizeof(sim_solvers[0]);
+    int num_steps_cases = sizeof(num_steps_values) / sizeof(num_steps_values[0]);
+
+    bench_series phases[NUM_PHASES];
+    bench_series_init(phases+0, "wall", args.num_rep);
+    bench_series_init(phases+1, "cpu", args.num_rep);
+    bench_series_init(phases+2, "la", args.num_rep);
+    bench_series_init(phases+3, "ad", args.num_rep);
+
+    bench_report report;
+    bench_report_open(&report, args.output, "sim");
+
+    acados_timer timer;
+    char id[256];
+    int acados_return = 0;
+
+    for (int im = 0; im < num_models; im++)
+    {
+        sim_bench_model *model = models+im;
+        int nx = model->nx;
+        int nu = model->nu;
+        int nz = model->nz;
+
+        for (int is = 0; is < num_solvers; is++)
+        {
+            if (!sim_bench_model_supports(model, sim_solvers[is].solver))
+                continue;
+
+            for (int ik = 0; ik < num_steps_cases; ik++)
+            {
+                sim_solver_plan_t plan;
+                plan.sim_solver = sim_solvers[is].solver;
+
+                sim_config *config = sim_config_create(plan);
+
+                void *dims = sim_dims_create(config);
+                sim_dims_set(config, dims, "nx", &nx);
+                sim_dims_set(config, dims, "nu", &nu);
+                sim_dims_set(config, dims, "nz", &nz);
+
+                if (plan.sim_solver == GNSF)
+                {
+                    sim_dims_set(config, dims, "nx1", &model->nx1);
+                    sim_dims_set(config, dims, "nz1", &model->nz1);
+                    sim_dims_set(config, dims, "nout", &model->nout);
+                    sim_dims_set(config, dims, "ny", &model->ny);
+                    sim_dims_set(config, dims, "nuhat", &model->nuhat);
+                }
+
+                sim_opts *opts = sim_opts_create(config, dims);
+                opts->sens_forw = true;
+                opts->sens_adj = false;
+                opts->num_steps = num_steps_values[ik];
+                opts->ns = plan.sim_solver == ERK ? 4 : 2;
+                if (plan.sim_solver == GNSF)
+                {
+                    opts->jac_reuse = true;
+                    opts->newton_iter = 3;
+                }
+
+                sim_in *in = sim_in_create(config, dims);
+                sim_out *out = sim_out_create(config, dims);
+
+                in->T = model->T;
+
+                switch (plan.sim_solver)
+                {
+                    case ERK:
+                        config->model_set(in->model, "expl_vde_for", &model->expl_vde_for);
+                        break;
+                    case IRK:
+                        config->model_set(in->model, "impl_ode_fun", &model->impl_ode_fun);
+                        config->model_set(in->model, "impl_ode_fun_jac_x_xdot", &model->impl_ode_fun_jac_x_xdot);
+                        config->model_set(in->model, "impl_ode_jac_x_xdot_u", &model->impl_ode_jac_x_xdot_u);
+                        break;
+                    case LIFTED_IRK:
+                        config->model_set(in->model, "impl_ode_fun", &model->impl_ode_fun);
+                        config->model_set(in->model, "impl_ode_fun_jac_x_xdot_u", &model->impl_ode_fun_jac_x_xdot_u);
+                        break;
+                    case GNSF:
+                        config->model_set(in->model, "phi_fun", &model->phi_fun);
+                        config->model_set(in->model, "phi_fun_jac_y", &model->phi_fun_jac_y);
+                        config->model_set(in->model, "phi_jac_y_uhat", &model->phi_jac_y_uhat);
+                        config->model_set(in->model, "f_lo_jac_x1_x1dot_u_z", &model->f_lo_fun_jac_x1k1uz);
+                        config->model_set(in->model, "get_gnsf_matrices", &model->get_matrices_fun);
+                        break;
+                    default:
+                        printf("\nerror: bench_sim: integrator not covered\n");
+                        exit(1);
+                }
+
+                // identity forward seed
+                for (int ii = 0; ii < nx*(nx+nu); ii++)
+                    in->S_forw[ii] = 0.0;
+                for (int ii = 0; ii < nx; ii++)
+                    in->S_forw[ii*(nx+1)] = 1.0;
+
+                sim_solver *solver = sim_solver_create(config, dims, opts);
+                sim_precompute(solver, in, out);
+
+                for (int rep = 0; rep < args.num_warmup + args.num_rep; rep++)
+                {
+                    // same integration interval in every repetition
+                    for (int jj = 0; jj < nx; jj++)
+                        in->x[jj] = model->x0[jj];
+                    for (int jj = 0; jj < nu; jj++)
+                        in->u[jj] = model->u[jj];
+
+                    if (rep == args.num_warmup)
+                    {
+                        for (int ii = 0; ii < NUM_PHASES; ii++)
+                            bench_series_reset(phases+ii);
+                    }
+
+                    acados_tic(&timer);
+                    int sim_return = sim_solve(solver, in, out);
+                    double wall = acados_toc(&timer);
+
+                    if (sim_return != ACADOS_SUCCESS)
+                        acados_return = sim_return;
+
+                    if (rep >= args.num_warmup)
+                    {
+                        bench_series_push(phases+0, wall);
+                        bench_series_push(phases+1, out->info->CPUtime);
+                        bench_series_push(phases+2, out->info->LAtime);
+                        bench_series_push(phases+3, out->info->ADtime);
+                    }
+                }
+
+                snprintf(id, sizeof(id), "%s/%s/num_steps%d", sim_solvers[is].name, model->name,
+                         opts->num_steps);
+                bench_report_case(&report, id, NUM_PHASES, phases);
+                printf("%-50s p50 %10.3f us\n", id, 1e6*phases[0].samples[phases[0].n/2]);
+
+                sim_solver_destroy(solver);
+                sim_out_destroy(out);
+                sim_in_destroy(in);
+                sim_opts_destroy(opts);
+                sim_dims_destroy(dims);
+                sim_config_destroy(config);
+            }
+        }
+    }
+
+    bench_report_close(&report);
+
+    for (int ii = 0; ii < NUM_PHASES; ii++)
+        bench_series_free(phases+ii);
+
+    for (int im = 0; im < num_models; im++)
+        sim_bench_model_free(models+im);
+
+    if (acados_return != 0)
+    {
+        printf("\nerror: at least one integration failed, last status %d\n", acados_return);
+        return 1;
+    }
+    return 0;
+}
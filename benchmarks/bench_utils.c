@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+
+#include "benchmarks/bench_utils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+void bench_parse_args(int argc, char **argv, bench_args *args)
+{
+    args->output = NULL;
+    args->num_rep = 200;
+    args->num_warmup = 10;
+
+    for (int ii = 1; ii < argc; ii++)
+    {
+        if (!strcmp(argv[ii], "--rep") && ii+1 < argc)
+        {
+            args->num_rep = atoi(argv[++ii]);
+        }
+        else if (!strcmp(argv[ii], "--warmup") && ii+1 < argc)
+        {
+            args->num_warmup = atoi(argv[++ii]);
+        }
+        else if (argv[ii][0] != '-')
+        {
+            args->output = argv[ii];
+        }
+        else
+        {
+            printf("\nerror: bench_parse_args: unknown argument %s\n", argv[ii]);
+            printf("usage: %s [output.json] [--rep N] [--warmup N]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    if (args->num_rep < 1)
+    {
+        printf("\nerror: bench_parse_args: --rep has to be positive, got %d\n", args->num_rep);
+        exit(1);
+    }
+    if (args->num_warmup < 0)
+        args->num_warmup = 0;
+}
+
+
+
+void bench_series_init(bench_series *series, const char *name, int capacity)
+{
+    series->name = name;
+    series->n = 0;
+    series->capacity = capacity;
+    series->samples = malloc(capacity*sizeof(double));
+}
+
+
+
+void bench_series_free(bench_series *series)
+{
+    free(series->samples);
+    series->samples = NULL;
+    series->n = 0;
+    series->capacity = 0;
+}
+
+
+
+void bench_series_reset(bench_series *series)
+{
+    series->n = 0;
+}
+
+
+
+void bench_series_push(bench_series *series, double value)
+{
+    if (series->n >= series->capacity)
+    {
+        printf("\nerror: bench_series_push: series %s is full (capacity %d)\n",
+               series->name, series->capacity);
+        exit(1);
+    }
+    series->samples[series->n] = value;
+    series->n++;
+}
+
+
+
+static int compare_double(const void *a, const void *b)
+{
+    double da = *(const double *) a;
+    double db = *(const double *) b;
+    return (da > db) - (da < db);
+}
+
+
+
+static double percentile_sorted(const double *sorted, int n, double p)
+{
+    int idx = (int) ceil(p*n) - 1;
+    if (idx < 0)
+        idx = 0;
+    if (idx > n-1)
+        idx = n-1;
+    return sorted[idx];
+}
+
+
+
+void bench_series_stats(bench_series *series, bench_stats *stats)
+{
+    int n = series->n;
+    stats->n = n;
+
+    if (n == 0)
+    {
+        stats->p50 = 0.0;
+        stats->p99 = 0.0;
+        stats->max = 0.0;
+        stats->mean = 0.0;
+        return;
+    }
+
+    qsort(series->samples, n, sizeof(double), compare_double);
+
+    double sum = 0.0;
+    for (int ii = 0; ii < n; ii++)
+        sum += series->samples[ii];
+
+    stats->p50 = percentile_sorted(series->samples, n, 0.50);
+    stats->p99 = percentile_sorted(series->samples, n, 0.99);
+    stats->max = series->samples[n-1];
+    stats->mean = sum / n;
+}
+
+
+
+void bench_report_open(bench_report *report, const char *path, const char *suite)
+{
+    char default_path[256];
+    if (path == NULL)
+    {
+        snprintf(default_path, sizeof(default_path), "bench_%s.json", suite);
+        path = default_path;
+    }
+
+    report->file = fopen(path, "w");
+    if (report->file == NULL)
+    {
+        printf("\nerror: bench_report_open: cannot open %s\n", path);
+        exit(1);
+    }
+    report->num_cases = 0;
+
+    fprintf(report->file, "{\n  \"suite\": \"%s\",\n  \"unit\": \"s\",\n  \"benchmarks\": [", suite);
+}
+
+
+
+void bench_report_case(bench_report *report, const char *id, int num_series, bench_series *series)
+{
+    FILE *file = report->file;
+    bench_stats stats;
+
+    fprintf(file, "%s\n    {\n      \"id\": \"%s\",\n      \"phases\": {", report->num_cases > 0 ? "," : "", id);
+    for (int ii = 0; ii < num_series; ii++)
+    {
+        bench_series_stats(series+ii, &stats);
+        fprintf(file, "%s\n        \"%s\": {\"p50\": %.9e, \"p99\": %.9e, \"max\": %.9e, \"mean\": %.9e, \"n\": %d}",
+                ii > 0 ? "," : "", series[ii].name, stats.p50, stats.p99, stats.max, stats.mean, stats.n);
+    }
+    fprintf(file, "\n      }\n    }");
+    fflush(file);
+
+    report->num_cases++;
+}
+
+
+
+void bench_report_close(bench_report *report)
+{
+    fprintf(report->file, "\n  ]\n}\n");
+    fclose(report->file);
+    report->file = NULL;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+
+#ifndef BENCHMARKS_BENCH_UTILS_H_
+#define BENCHMARKS_BENCH_UTILS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+
+
+// samples of one timed phase, in seconds
+typedef struct
+{
+    const char *name;
+    double *samples;
+    int n;
+    int capacity;
+} bench_series;
+
+
+
+typedef struct
+{
+    double p50;
+    double p99;
+    double max;
+    double mean;
+    int n;
+} bench_stats;
+
+
+
+// benchmark settings parsed from the command line
+typedef struct
+{
+    const char *output;  // JSON output file, NULL writes bench_<suite>.json
+    int num_rep;         // timed repetitions per case
+    int num_warmup;      // untimed repetitions before the timed ones
+} bench_args;
+
+
+
+typedef struct
+{
+    FILE *file;
+    int num_cases;
+} bench_report;
+
+
+
+// fill an external_function_casadi from the functions generated with the given prefix
+#define BENCH_CASADI_FUN(fun, prefix)                   \
+    do                                                  \
+    {                                                   \
+        (fun)->casadi_fun = &prefix;                    \
+        (fun)->casadi_work = &prefix##_work;            \
+        (fun)->casadi_sparsity_in = &prefix##_sparsity_in;   \
+        (fun)->casadi_sparsity_out = &prefix##_sparsity_out; \
+        (fun)->casadi_n_in = &prefix##_n_in;            \
+        (fun)->casadi_n_out = &prefix##_n_out;          \
+    } while (0)
+
+
+
+// usage: <bench> [output.json] [--rep N] [--warmup N]
+void bench_parse_args(int argc, char **argv, bench_args *args);
+//
+void bench_series_init(bench_series *series, const char *name, int capacity);
+//
+void bench_series_free(bench_series *series);
+//
+void bench_series_reset(bench_series *series);
+//
+void bench_series_push(bench_series *series, double value);
+// sorts the samples in place; percentiles use the nearest-rank definition
+void bench_series_stats(bench_series *series, bench_stats *stats);
+//
+void bench_report_open(bench_report *report, const char *path, const char *suite);
+// writes one benchmark case with the stats of all its phases
+void bench_report_case(bench_report *report, const char *id, int num_series, bench_series *series);
+//
+void bench_report_close(bench_report *report);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // BENCHMARKS_BENCH_UTILS_H_
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+"""
+Compare benchmark results written by the acados benchmark executables against a stored baseline.
+
+A phase regresses if its p50 exceeds the baseline p50 by more than --tol-p50, or its p99 exceeds
+the baseline p99 by more than --tol-p99 (relative). Phases whose baseline p50 is below --min-time
+are too short to be timed reliably and are only reported.
+A missing baseline directory is an error. Result files and cases without a baseline fail the
+comparison as well, unless --allow-missing is given.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import sys
+
+
+def load_suites(directory):
+    suites = {}
+    if not os.path.isdir(directory):
+        return suites
+    for filename in sorted(os.listdir(directory)):
+        if filename.endswith('.json'):
+            with open(os.path.join(directory, filename), 'r') as f:
+                suites[filename] = json.load(f)
+    return suites
+
+
+def index_cases(suite):
+    return {case['id']: case['phases'] for case in suite['benchmarks']}
+
+
+def compare(baseline, results, tol_p50, tol_p99, min_time):
+    regressions = []
+    missing = []
+    for filename, suite in results.items():
+        if filename not in baseline:
+            print(f'{filename}: MISSING baseline')
+            missing.append((filename, None))
+            continue
+        base_cases = index_cases(baseline[filename])
+        for case_id, phases in index_cases(suite).items():
+            if case_id not in base_cases:
+                print(f'{case_id:50s} MISSING baseline')
+                missing.append((filename, case_id))
+                continue
+            for phase, stats in phases.items():
+                base = base_cases[case_id].get(phase)
+                if base is None or base['p50'] < min_time:
+                    continue
+                ratio_p50 = stats['p50'] / base['p50']
+                ratio_p99 = stats['p99'] / base['p99'] if base['p99'] > 0 else 1.0
+                status = 'ok'
+                if ratio_p50 > 1.0 + tol_p50 or ratio_p99 > 1.0 + tol_p99:
+                    status = 'REGRESSION'
+                    regressions.append((filename, case_id, phase))
+                print(f'{case_id:50s} {phase:12s} p50 {ratio_p50:6.2f}x  p99 {ratio_p99:6.2f}x  {status}')
+    return regressions, missing
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--baseline', required=True, help='directory with the baseline json files')
+    parser.add_argument('--results', required=True, help='directory with the current json files')
+    parser.add_argument('--tol-p50', type=float, default=0.15, help='allowed relative p50 increase')
+    parser.add_argument('--tol-p99', type=float, default=0.50, help='allowed relative p99 increase')
+    parser.add_argument('--min-time', type=float, default=1e-6, help='ignore phases with baseline p50 below this [s]')
+    parser.add_argument('--update', action='store_true', help='store the current results as new baseline')
+    parser.add_argument('--allow-missing', action='store_true', help='only report result files and cases without baseline')
+    args = parser.parse_args()
+
+    results = load_suites(args.results)
+    if not results:
+        print(f'error: no benchmark results found in {args.results}')
+        return 1
+
+    if args.update:
+        os.makedirs(args.baseline, exist_ok=True)
+        for filename in results:
+            shutil.copy(os.path.join(args.results, filename), os.path.join(args.baseline, filename))
+        print(f'stored {len(results)} result files as baseline in {args.baseline}')
+        return 0
+
+    baseline = load_suites(args.baseline)
+    if not baseline:
+        print(f'error: no baseline found in {args.baseline}, run the update_benchmark_baseline target first')
+        return 1
+
+    regressions, missing = compare(baseline, results, args.tol_p50, args.tol_p99, args.min_time)
+    failed = False
+    if missing:
+        print(f'\n{"warning" if args.allow_missing else "error"}: {len(missing)} result file(s) or case(s) without baseline, '
+              'run the update_benchmark_baseline target to record them')
+        failed = not args.allow_missing
+    if regressions:
+        print(f'\n{len(regressions)} phase(s) regressed')
+        failed = True
+    if failed:
+        return 1
+    print('\nno regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
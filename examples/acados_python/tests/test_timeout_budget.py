@@ -0,0 +1,141 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+import numpy as np
+import scipy.linalg
+
+ACADOS_TIMEOUT = 7
+
+
+def create_solver(qp_solver: str):
+    ocp = AcadosOcp()
+
+    model = export_pendulum_ode_model()
+    ocp.model = model
+
+    N = 20
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+
+    # set cost
+    Q_mat = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    R_mat = 2*np.diag([1e-2])
+
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(Q_mat, R_mat)
+    ocp.cost.W_e = Q_mat
+
+    nx = model.x.rows()
+    nu = model.u.rows()
+    ny = nx + nu
+    ocp.cost.Vx = np.zeros((ny, nx))
+    ocp.cost.Vx[:nx, :nx] = np.eye(nx)
+    ocp.cost.Vu = np.zeros((ny, nu))
+    ocp.cost.Vu[nx:, :] = np.eye(nu)
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((ny, ))
+    ocp.cost.yref_e = np.zeros((nx, ))
+
+    # set constraints
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, np.pi, 0.0, 0.0])
+
+    # set options
+    ocp.solver_options.qp_solver = qp_solver
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.globalization = 'MERIT_BACKTRACKING'
+    ocp.solver_options.globalization_use_SOC = 1
+    ocp.solver_options.nlp_solver_max_iter = 200
+    ocp.solver_options.tol = 1e-8
+
+    return AcadosOcpSolver(ocp, json_file=f'acados_ocp_timeout_{qp_solver}.json')
+
+
+def main(qp_solver: str):
+    ocp_solver = create_solver(qp_solver)
+
+    # reference solve without budget
+    status = ocp_solver.solve()
+    sqp_iter_ref = ocp_solver.get_stats('sqp_iter')
+    time_ref = ocp_solver.get_stats('time_tot')
+    x_ref = np.array([ocp_solver.get(i, 'x') for i in range(21)])
+    if status != 0:
+        raise Exception(f'reference solve failed with status {status}')
+    if sqp_iter_ref < 5:
+        raise Exception(f'test problem too easy, converged in {sqp_iter_ref} iterations')
+
+    # a fraction of the time needed does not suffice
+    budget = 0.3 * time_ref
+    ocp_solver.reset()
+    ocp_solver.options_set('timeout_budget', budget)
+    status = ocp_solver.solve()
+    sqp_iter = ocp_solver.get_stats('sqp_iter')
+    time_tot = ocp_solver.get_stats('time_tot')
+    print(f'{qp_solver}: budget {budget:.2e} s, status {status}, {sqp_iter} / {sqp_iter_ref} iterations, time {time_tot:.2e} s')
+    if status != ACADOS_TIMEOUT:
+        raise Exception(f'expected status {ACADOS_TIMEOUT} (timeout), got {status}')
+    if sqp_iter >= sqp_iter_ref:
+        raise Exception(f'timeout after {sqp_iter} iterations, reference needs {sqp_iter_ref}')
+    # iterations are stopped on a predicted overrun, QP, SOC and line search on the remaining time;
+    # allow for timing noise of about one iteration
+    if time_tot > budget + 2 * time_ref / sqp_iter_ref:
+        raise Exception(f'time {time_tot} exceeds budget {budget} by more than one iteration')
+    for i in range(21):
+        if np.any(np.isnan(ocp_solver.get(i, 'x'))):
+            raise Exception('timeout returned NaN iterate')
+
+    # disabling the budget restores the full solve
+    ocp_solver.reset()
+    ocp_solver.options_set('timeout_budget', 0.0)
+    status = ocp_solver.solve()
+    x = np.array([ocp_solver.get(i, 'x') for i in range(21)])
+    if status != 0:
+        raise Exception(f'solve without budget failed with status {status}')
+    if np.max(np.abs(x - x_ref)) > 1e-6:
+        raise Exception('solution without budget differs from reference')
+
+    print(f'{qp_solver}: test_timeout_budget passed')
+
+
+if __name__ == '__main__':
+    # both HPIPM interfaces get the remaining time as QP time_limit
+    for qp_solver in ['PARTIAL_CONDENSING_HPIPM', 'FULL_CONDENSING_HPIPM']:
+        main(qp_solver)
@@ -0,0 +1,187 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+import numpy as np
+import scipy.linalg
+
+N = 20
+TOL = 1e-12
+
+
+def create_ocp() -> AcadosOcp:
+    ocp = AcadosOcp()
+
+    model = export_pendulum_ode_model()
+    ocp.model = model
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+
+    # set cost
+    Q_mat = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    R_mat = 2*np.diag([1e-2])
+
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(Q_mat, R_mat)
+    ocp.cost.W_e = Q_mat
+
+    nx = model.x.rows()
+    nu = model.u.rows()
+    ny = nx + nu
+    ocp.cost.Vx = np.zeros((ny, nx))
+    ocp.cost.Vx[:nx, :nx] = np.eye(nx)
+    ocp.cost.Vu = np.zeros((ny, nu))
+    ocp.cost.Vu[nx:, :] = np.eye(nu)
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((ny, ))
+    ocp.cost.yref_e = np.zeros((nx, ))
+
+    # set constraints
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, np.pi, 0.0, 0.0])
+
+    # set options
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+
+    return ocp
+
+
+def check_out_fields(ocp_solver):
+    # bulk get equals the per-stage get, entries beyond the stage dimension stay zero
+    for field, n_stages in [('x', N+1), ('u', N+1), ('pi', N), ('lam', N+1)]:
+        traj = ocp_solver.get_trajectory(field)
+        if traj.shape[0] != n_stages:
+            raise Exception(f'get_trajectory({field}): expected {n_stages} rows, got {traj.shape[0]}')
+        for i in range(n_stages):
+            val = ocp_solver.get(i, field)
+            if np.max(np.abs(traj[i, :val.size] - val), initial=0.0) > TOL:
+                raise Exception(f'get_trajectory({field}) differs from get() at stage {i}')
+            if np.any(traj[i, val.size:] != 0.0):
+                raise Exception(f'get_trajectory({field}) wrote beyond the dimension at stage {i}')
+
+    # stage range and out array
+    out = np.empty((5, 4))
+    traj = ocp_solver.get_trajectory('x', 3, 8, out=out)
+    if traj is not out:
+        raise Exception('get_trajectory() did not fill the given out array')
+    for i in range(3, 8):
+        if np.max(np.abs(out[i-3, :] - ocp_solver.get(i, 'x'))) > TOL:
+            raise Exception(f'get_trajectory(x, 3, 8) differs from get() at stage {i}')
+
+    # invalid arguments are rejected
+    for args, kwargs in [(('x', 0, N+2), {}), (('pi', 0, N+1), {}), (('x',), {'out': np.empty((N+1, 3))}), (('foo',), {})]:
+        try:
+            ocp_solver.get_trajectory(*args, **kwargs)
+        except Exception:
+            continue
+        raise Exception(f'get_trajectory{args} {kwargs} should raise')
+
+
+def check_set_fields(ocp_solver):
+    # bulk set equals the per-stage set
+    x_traj = np.outer(np.linspace(1.0, 2.0, N+1), np.array([0.1, 0.2, 0.3, 0.4]))
+    ocp_solver.set_trajectory('x', x_traj)
+    for i in range(N+1):
+        if np.max(np.abs(ocp_solver.get(i, 'x') - x_traj[i, :])) > TOL:
+            raise Exception(f'set_trajectory(x) differs from set() at stage {i}')
+
+    ubu_traj = np.linspace(50.0, 70.0, N).reshape((N, 1))
+    ocp_solver.set_trajectory('ubu', ubu_traj)
+    if np.max(np.abs(ocp_solver.get_trajectory('ubu', 0, N) - ubu_traj)) > TOL:
+        raise Exception('get_trajectory(ubu) does not return the values set')
+
+    # rows longer than the stage dimension: the terminal yref has dimension nx
+    yref_traj = np.zeros((N+1, 5))
+    yref_traj[:, 0] = 0.1
+    yref_traj[:, 4] = 1.0
+    ocp_solver.set_trajectory('yref', yref_traj)
+    yref = ocp_solver.get_trajectory('yref')
+    if np.max(np.abs(yref[:N, :] - yref_traj[:N, :])) > TOL or np.max(np.abs(yref[N, :4] - yref_traj[N, :4])) > TOL:
+        raise Exception('get_trajectory(yref) does not return the values set')
+
+
+def set_per_stage(ocp_solver, yref_0: float, yref_4: float, ubu_start: float, ubu_end: float):
+    for i in range(N):
+        ocp_solver.cost_set(i, 'yref', np.array([yref_0, 0.0, 0.0, 0.0, yref_4]))
+        ocp_solver.constraints_set(i, 'ubu', np.array([ubu_start + (ubu_end - ubu_start) * i / (N-1)]))
+    ocp_solver.cost_set(N, 'yref', np.array([yref_0, 0.0, 0.0, 0.0]))
+
+
+def main(interface_type: str):
+    ocp = create_ocp()
+    json_file = f'acados_ocp_trajectory_{interface_type}.json'
+    if interface_type == 'cython':
+        AcadosOcpSolver.generate(ocp, json_file=json_file)
+        AcadosOcpSolver.build(ocp.code_export_directory, with_cython=True)
+        ocp_solver = AcadosOcpSolver.create_cython_solver(json_file)
+    else:
+        ocp_solver = AcadosOcpSolver(ocp, json_file=json_file)
+
+    status = ocp_solver.solve()
+    if status != 0:
+        raise Exception(f'acados returned status {status}.')
+    check_out_fields(ocp_solver)
+
+    # same data set per stage and in bulk gives the same solution
+    set_per_stage(ocp_solver, 0.1, 1.0, 50.0, 70.0)
+    ocp_solver.reset()
+    status = ocp_solver.solve()
+    if status != 0:
+        raise Exception(f'acados returned status {status}.')
+    x_ref = np.array([ocp_solver.get(i, 'x') for i in range(N+1)])
+
+    set_per_stage(ocp_solver, 0.0, 0.0, 80.0, 80.0)
+    check_set_fields(ocp_solver)
+    ocp_solver.reset()
+    status = ocp_solver.solve()
+    if status != 0:
+        raise Exception(f'acados returned status {status}.')
+    if np.max(np.abs(ocp_solver.get_trajectory('x') - x_ref)) > TOL:
+        raise Exception('solution after set_trajectory differs from per-stage set')
+
+    print(f'{interface_type}: test_trajectory_get_set passed')
+
+
+if __name__ == '__main__':
+    for interface_type in ['ctypes', 'cython']:
+        main(interface_type)
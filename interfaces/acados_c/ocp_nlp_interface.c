@@ -673,6 +673,229 @@ void ocp_nlp_out_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *ou
 
 
 
+static void ocp_nlp_check_stage(ocp_nlp_dims *dims, int stage, const char *fun_name, const char *field)
+{
+    if (stage < 0 || stage > dims->N)
+    {
+        printf("\nerror: %s: invalid stage %d for field %s, N = %d\n", fun_name, stage, field, dims->N);
+        exit(1);
+    }
+}
+
+
+
+ocp_nlp_field_handle ocp_nlp_in_field_handle(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, int stage, const char *field)
+{
+    ocp_nlp_check_stage(dims, stage, "ocp_nlp_in_field_handle", field);
+
+    ocp_nlp_field_handle handle;
+    struct blasfeo_dvec *vec = NULL;
+    int offset = 0;
+
+    if (!strcmp(field, "p") || !strcmp(field, "parameter_values"))
+    {
+        handle.ptr = in->parameter_values[stage];
+        handle.size = dims->np[stage];
+        return handle;
+    }
+    else if (!strcmp(field, "yref") || !strcmp(field, "y_ref"))
+    {
+        ocp_nlp_cost_config *cost_config = config->cost[stage];
+        if (cost_config->model_get_y_ref_ptr != NULL)
+        {
+            vec = cost_config->model_get_y_ref_ptr(in->cost[stage]);
+            cost_config->dims_get(cost_config, dims->cost[stage], "ny", &handle.size);
+        }
+    }
+    else
+    {
+        ocp_nlp_constraints_config *constr_config = config->constraints[stage];
+        if (constr_config->model_get_vec_ptr != NULL)
+        {
+            vec = constr_config->model_get_vec_ptr(constr_config, dims->constraints[stage],
+                    in->constraints[stage], field, &offset, &handle.size);
+        }
+    }
+
+    if (vec == NULL)
+    {
+        printf("\nerror: ocp_nlp_in_field_handle: field %s not available at stage %d\n", field, stage);
+        exit(1);
+    }
+    handle.ptr = &BLASFEO_DVECEL(vec, offset);
+
+    return handle;
+}
+
+
+
+ocp_nlp_field_handle ocp_nlp_out_field_handle(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_out *out, int stage, const char *field)
+{
+    ocp_nlp_check_stage(dims, stage, "ocp_nlp_out_field_handle", field);
+
+    ocp_nlp_field_handle handle;
+    int nu = dims->nu[stage];
+    int nx = dims->nx[stage];
+    int ns = dims->ns[stage];
+
+    if (!strcmp(field, "x"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->ux+stage, nu);
+        handle.size = nx;
+    }
+    else if (!strcmp(field, "u"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->ux+stage, 0);
+        handle.size = nu;
+    }
+    else if (!strcmp(field, "sl"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->ux+stage, nu+nx);
+        handle.size = ns;
+    }
+    else if (!strcmp(field, "su"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->ux+stage, nu+nx+ns);
+        handle.size = ns;
+    }
+    else if (!strcmp(field, "z"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->z+stage, 0);
+        handle.size = dims->nz[stage];
+    }
+    else if (!strcmp(field, "pi") && stage < dims->N)
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->pi+stage, 0);
+        handle.size = dims->nx[stage+1];
+    }
+    else if (!strcmp(field, "lam"))
+    {
+        handle.ptr = &BLASFEO_DVECEL(out->lam+stage, 0);
+        handle.size = 2*dims->ni[stage];
+    }
+    else
+    {
+        printf("\nerror: ocp_nlp_out_field_handle: field %s not available at stage %d\n", field, stage);
+        exit(1);
+    }
+
+    return handle;
+}
+
+
+
+void ocp_nlp_field_handle_set(const ocp_nlp_field_handle *handle, const double *value, int n)
+{
+    if (n != handle->size)
+    {
+        printf("\nerror: ocp_nlp_field_handle_set: got %d values, field has size %d\n", n, handle->size);
+        exit(1);
+    }
+    memcpy(handle->ptr, value, n*sizeof(double));
+}
+
+
+
+void ocp_nlp_field_handle_get(const ocp_nlp_field_handle *handle, double *value, int n)
+{
+    if (n != handle->size)
+    {
+        printf("\nerror: ocp_nlp_field_handle_get: got memory for %d values, field has size %d\n", n, handle->size);
+        exit(1);
+    }
+    memcpy(value, handle->ptr, n*sizeof(double));
+}
+
+
+
+static void ocp_nlp_check_stage_range(ocp_nlp_dims *dims, int stage_start, int stage_end,
+        const char *fun_name, const char *field)
+{
+    if (stage_start < 0 || stage_end > dims->N+1 || stage_start > stage_end)
+    {
+        printf("\nerror: %s: invalid stage range [%d, %d) for field %s, N = %d\n",
+               fun_name, stage_start, stage_end, field, dims->N);
+        exit(1);
+    }
+}
+
+
+
+static void ocp_nlp_check_stride(ocp_nlp_field_handle *handle, int stride, int stage,
+        const char *fun_name, const char *field)
+{
+    if (handle->size > stride)
+    {
+        printf("\nerror: %s: stride %d smaller than size %d of field %s at stage %d\n",
+               fun_name, stride, handle->size, field, stage);
+        exit(1);
+    }
+}
+
+
+
+void ocp_nlp_out_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, double *value, int stride)
+{
+    ocp_nlp_check_stage_range(dims, stage_start, stage_end, "ocp_nlp_out_get_stages", field);
+
+    for (int stage = stage_start; stage < stage_end; stage++)
+    {
+        ocp_nlp_field_handle handle = ocp_nlp_out_field_handle(config, dims, out, stage, field);
+        ocp_nlp_check_stride(&handle, stride, stage, "ocp_nlp_out_get_stages", field);
+        ocp_nlp_field_handle_get(&handle, value + (stage-stage_start)*stride, handle.size);
+    }
+}
+
+
+
+void ocp_nlp_out_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, const double *value, int stride)
+{
+    ocp_nlp_check_stage_range(dims, stage_start, stage_end, "ocp_nlp_out_set_stages", field);
+
+    for (int stage = stage_start; stage < stage_end; stage++)
+    {
+        ocp_nlp_field_handle handle = ocp_nlp_out_field_handle(config, dims, out, stage, field);
+        ocp_nlp_check_stride(&handle, stride, stage, "ocp_nlp_out_set_stages", field);
+        ocp_nlp_field_handle_set(&handle, value + (stage-stage_start)*stride, handle.size);
+    }
+}
+
+
+
+void ocp_nlp_in_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+        int stage_start, int stage_end, const char *field, double *value, int stride)
+{
+    ocp_nlp_check_stage_range(dims, stage_start, stage_end, "ocp_nlp_in_get_stages", field);
+
+    for (int stage = stage_start; stage < stage_end; stage++)
+    {
+        ocp_nlp_field_handle handle = ocp_nlp_in_field_handle(config, dims, in, stage, field);
+        ocp_nlp_check_stride(&handle, stride, stage, "ocp_nlp_in_get_stages", field);
+        ocp_nlp_field_handle_get(&handle, value + (stage-stage_start)*stride, handle.size);
+    }
+}
+
+
+
+void ocp_nlp_in_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+        int stage_start, int stage_end, const char *field, const double *value, int stride)
+{
+    ocp_nlp_check_stage_range(dims, stage_start, stage_end, "ocp_nlp_in_set_stages", field);
+
+    for (int stage = stage_start; stage < stage_end; stage++)
+    {
+        ocp_nlp_field_handle handle = ocp_nlp_in_field_handle(config, dims, in, stage, field);
+        ocp_nlp_check_stride(&handle, stride, stage, "ocp_nlp_in_set_stages", field);
+        ocp_nlp_field_handle_set(&handle, value + (stage-stage_start)*stride, handle.size);
+    }
+}
+
+
+
 int ocp_nlp_dims_get_from_attr(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field)
 {
@@ -1155,6 +1378,112 @@ int ocp_nlp_precompute(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *
 
 
 
+int ocp_nlp_rti_pipelined_preparation(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out)
+{
+    if (solver->config->evaluate != &ocp_nlp_sqp_rti)
+    {
+        printf("\nerror: ocp_nlp_rti_pipelined_preparation: only supported for SQP_RTI solver.\n");
+        exit(1);
+    }
+    return ocp_nlp_sqp_rti_pipelined_preparation(solver->config, solver->dims, nlp_in, nlp_out,
+                                                 solver->opts, solver->mem, solver->work);
+}
+
+
+
+int ocp_nlp_rti_pipelined_feedback(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out)
+{
+    if (solver->config->evaluate != &ocp_nlp_sqp_rti)
+    {
+        printf("\nerror: ocp_nlp_rti_pipelined_feedback: only supported for SQP_RTI solver.\n");
+        exit(1);
+    }
+    return ocp_nlp_sqp_rti_pipelined_feedback(solver->config, solver->dims, nlp_in, nlp_out,
+                                              solver->opts, solver->mem, solver->work);
+}
+
+
+
+// read and write back one byte per page, such that all pages are mapped before the first solve
+static void touch_memory(void *ptr, acados_size_t bytes)
+{
+    volatile char *c_ptr = (volatile char *) ptr;
+
+    if (ptr == NULL || bytes == 0)
+        return;
+
+    for (acados_size_t ii = 0; ii < bytes; ii += 4096)
+        c_ptr[ii] = c_ptr[ii];
+    c_ptr[bytes-1] = c_ptr[bytes-1];
+}
+
+
+
+int ocp_nlp_solver_prewarm(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_dims *dims = solver->dims;
+    int status;
+
+    ocp_nlp_opts *nlp_opts;
+    config->opts_get(config, dims, solver->opts, "nlp_opts", &nlp_opts);
+    if (nlp_opts->print_level > 0)
+    {
+        printf("\nerror: ocp_nlp_solver_prewarm: print_level > 0 prints from within the solve call.\n");
+        exit(1);
+    }
+
+    // fault in all solver, input and output pages
+    touch_memory(solver, ocp_nlp_calculate_size(config, dims, solver->opts));
+    touch_memory(nlp_in->raw_memory, ocp_nlp_in_calculate_size(config, dims));
+    touch_memory(nlp_out->raw_memory, ocp_nlp_out_calculate_size(config, dims));
+
+    // run the solve path once, such that lazy setup of the QP solvers
+    // (e.g. OSQP on the first call) happens here, then restore the iterate
+    ocp_nlp_out *nlp_out_bkp = ocp_nlp_out_create(config, dims);
+    copy_ocp_nlp_out(dims, nlp_out, nlp_out_bkp);
+
+    if (config->evaluate == &ocp_nlp_sqp_rti)
+    {
+        ocp_nlp_sqp_rti_opts *rti_opts = solver->opts;
+        int rti_phase = rti_opts->rti_phase;
+
+        if (rti_opts->rti_pipelining)
+        {
+            ocp_nlp_rti_pipelined_preparation(solver, nlp_in, nlp_out);
+            status = ocp_nlp_rti_pipelined_feedback(solver, nlp_in, nlp_out);
+        }
+        else if (rti_phase == PREPARATION_AND_FEEDBACK)
+        {
+            status = ocp_nlp_solve(solver, nlp_in, nlp_out);
+        }
+        else
+        {
+            int tmp_phase = PREPARATION;
+            ocp_nlp_solver_opts_set(config, solver->opts, "rti_phase", &tmp_phase);
+            ocp_nlp_solve(solver, nlp_in, nlp_out);
+            tmp_phase = FEEDBACK;
+            ocp_nlp_solver_opts_set(config, solver->opts, "rti_phase", &tmp_phase);
+            status = ocp_nlp_solve(solver, nlp_in, nlp_out);
+            ocp_nlp_solver_opts_set(config, solver->opts, "rti_phase", &rti_phase);
+        }
+    }
+    else
+    {
+        status = ocp_nlp_solve(solver, nlp_in, nlp_out);
+    }
+
+    copy_ocp_nlp_out(dims, nlp_out_bkp, nlp_out);
+    ocp_nlp_out_destroy(nlp_out_bkp);
+
+    // drop the warm start of the prewarm solve, but keep the QP solver setup
+    config->memory_reset_qp_warm_start(config, dims, solver->opts, solver->mem);
+
+    return status;
+}
+
+
+
 void ocp_nlp_eval_param_sens(ocp_nlp_solver *solver, char *field, int stage, int index,
                              ocp_nlp_out *sens_nlp_out)
 {
@@ -1365,6 +1694,11 @@ void ocp_nlp_get_at_stage(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_so
         ocp_nlp_get(config, solver, "qp_xcond_in", &pcond_qp_in);
         d_ocp_qp_get_S(stage, pcond_qp_in, value);
     }
+    else if (!strcmp(field, "jac_h_eval_count") || !strcmp(field, "jac_h_skip_count"))
+    {
+        config->constraints[stage]->memory_get(config->constraints[stage],
+            dims->constraints[stage], nlp_mem->constraints[stage], field, value);
+    }
     else
     {
         printf("\nerror: ocp_nlp_get_at_stage: field %s not available\n", field);
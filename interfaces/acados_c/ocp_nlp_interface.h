@@ -291,6 +291,73 @@ ACADOS_SYMBOL_EXPORT void ocp_nlp_out_set(ocp_nlp_config *config, ocp_nlp_dims *
 ACADOS_SYMBOL_EXPORT void ocp_nlp_out_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field, void *value);
 
+
+/// Handle to a vector-valued field at one stage, obtained from ocp_nlp_in_field_handle or
+/// ocp_nlp_out_field_handle. It points directly into the memory of the struct it was resolved for
+/// and stays valid as long as that struct is not destroyed.
+typedef struct
+{
+    double *ptr;  ///< first element of the field
+    int size;     ///< number of elements of the field
+} ocp_nlp_field_handle;
+
+/// Resolves a field of the input struct once, to be set or read repeatedly with
+/// ocp_nlp_field_handle_set and ocp_nlp_field_handle_get without string comparisons.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param in The inputs struct.
+/// \param stage Stage number.
+/// \param field The name of the field: p (parameter_values), yref (cost),
+///        lbx, ubx, lbu, ubu, lg, ug, lh, uh, lphi, uphi (constraints).
+ACADOS_SYMBOL_EXPORT ocp_nlp_field_handle ocp_nlp_in_field_handle(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, int stage, const char *field);
+
+/// Resolves a field of the output struct once, see ocp_nlp_in_field_handle.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param out The output struct.
+/// \param stage Stage number.
+/// \param field The name of the field: x, u, z, sl, su, pi, lam.
+ACADOS_SYMBOL_EXPORT ocp_nlp_field_handle ocp_nlp_out_field_handle(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_out *out, int stage, const char *field);
+
+/// Copies n values into the field referenced by the handle, n has to match the field size.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_field_handle_set(const ocp_nlp_field_handle *handle, const double *value, int n);
+
+/// Copies the n values of the field referenced by the handle, n has to match the field size.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_field_handle_get(const ocp_nlp_field_handle *handle, double *value, int n);
+
+
+/// Gets a field of the output struct for the stages stage_start, ..., stage_end-1 in one call.
+/// The values of stage stage_start+k are written to value + k*stride, stride has to be at least
+/// the largest field size in the range.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param out The output struct.
+/// \param stage_start First stage.
+/// \param stage_end One past the last stage.
+/// \param field The name of the field, see ocp_nlp_out_field_handle.
+/// \param value Pointer to the output memory, of size (stage_end-stage_start)*stride.
+/// \param stride Distance between the values of consecutive stages.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_out_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, double *value, int stride);
+
+/// Sets a field of the output struct for a range of stages, see ocp_nlp_out_get_stages.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_out_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, const double *value, int stride);
+
+/// Gets a field of the input struct for a range of stages, see ocp_nlp_out_get_stages and
+/// ocp_nlp_in_field_handle for the available fields.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_in_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+        int stage_start, int stage_end, const char *field, double *value, int stride);
+
+/// Sets a field of the input struct for a range of stages, see ocp_nlp_in_get_stages.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_in_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+        int stage_start, int stage_end, const char *field, const double *value, int stride);
+
 //
 ACADOS_SYMBOL_EXPORT void ocp_nlp_get_at_stage(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_solver *solver,
         int stage, const char *field, void *value);
@@ -386,6 +453,39 @@ ACADOS_SYMBOL_EXPORT void ocp_nlp_solver_reset_qp_memory(ocp_nlp_solver *solver,
 /// \param nlp_out The output struct.
 ACADOS_SYMBOL_EXPORT int ocp_nlp_precompute(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out);
 
+/// Pipelined RTI (SQP_RTI with option rti_pipelining): linearizes the NLP at the
+/// latest feedback result into the back buffer. Can run concurrently with
+/// ocp_nlp_rti_pipelined_feedback, e.g. in a separate thread.
+///
+/// \param solver The solver struct.
+/// \param nlp_in The inputs struct.
+/// \param nlp_out The output struct.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_rti_pipelined_preparation(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out);
+
+/// Pipelined RTI: swaps in the most recently prepared QP, if any, and
+/// performs a feedback step on it.
+///
+/// \param solver The solver struct.
+/// \param nlp_in The inputs struct.
+/// \param nlp_out The output struct.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_rti_pipelined_feedback(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out);
+
+/// Prepares the solver for real-time use, to be called after ocp_nlp_precompute.
+/// Touches all pages of the solver, input and output memory and runs the solve
+/// path once, such that lazy setup inside the QP solvers happens here. The iterate
+/// in nlp_out is restored and the warm start of the QP solver is reset afterwards,
+/// while its setup is kept.
+/// Subsequent calls to ocp_nlp_solve do not allocate heap memory, use stdio or
+/// enter the kernel, provided that print_level is 0, acados is built with
+/// ACADOS_SILENT (error messages on QP failures) and without OpenMP, and the
+/// clock source allows a vDSO clock_gettime.
+///
+/// \param solver The solver struct.
+/// \param nlp_in The inputs struct.
+/// \param nlp_out The output struct.
+/// \return The status of the warm-up solve.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_solver_prewarm(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out);
+
 
 /// Computes cost function value.
 ///
@@ -56,6 +56,7 @@
 #include "acados/dense_qp/dense_qp_daqp.h"
 #endif
 
+#include "acados/ocp_qp/ocp_qp_admm.h"
 #include "acados/ocp_qp/ocp_qp_hpipm.h"
 #ifdef ACADOS_WITH_HPMPC
 #include "acados/ocp_qp/ocp_qp_hpmpc.h"
@@ -115,6 +116,11 @@ void ocp_qp_xcond_solver_config_initialize_from_plan(
             ocp_qp_partial_condensing_config_initialize_default(solver_config->xcond);
             break;
 #endif
+        case PARTIAL_CONDENSING_ADMM:
+            ocp_qp_xcond_solver_config_initialize_default(solver_config);
+            ocp_qp_admm_config_initialize_default(solver_config->qp_solver);
+            ocp_qp_partial_condensing_config_initialize_default(solver_config->xcond);
+            break;
         case FULL_CONDENSING_HPIPM:
             ocp_qp_xcond_solver_config_initialize_default(solver_config);
             dense_qp_hpipm_config_initialize_default(solver_config->qp_solver);
@@ -48,6 +48,7 @@ extern "C" {
 ///   PARTIAL_CONDENSING_OOQP
 ///   PARTIAL_CONDENSING_OSQP
 ///   PARTIAL_CONDENSING_QPDUNES
+///   PARTIAL_CONDENSING_ADMM
 ///   FULL_CONDENSING_HPIPM
 ///   FULL_CONDENSING_QPOASES
 ///   FULL_CONDENSING_QORE
@@ -78,6 +79,7 @@ typedef enum {
 #else
     PARTIAL_CONDENSING_QPDUNES_NOT_AVAILABLE,
 #endif
+    PARTIAL_CONDENSING_ADMM,
     FULL_CONDENSING_HPIPM,
 #ifdef ACADOS_WITH_QPOASES
     FULL_CONDENSING_QPOASES,
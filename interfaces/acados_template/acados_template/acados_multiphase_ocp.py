@@ -236,6 +236,8 @@ class AcadosMultiphaseOcp:
 
         # check options
         self.mocp_opts.make_consistent(self.solver_options, n_phases=self.n_phases)
+        if self.solver_options.hessian_approx == 'BLOCK_BFGS':
+            raise Exception("AcadosMultiphaseOcp: hessian_approx 'BLOCK_BFGS' is not supported.")
 
         # check phases formulation objects are distinct
         warning = "\nNOTE: this can happen if set_phase() is called with the same ocp object for multiple phases."
@@ -205,9 +205,9 @@ class AcadosOcp:
                 raise Exception('inconsistent dimension: regarding yref_0 and cost_y_expr_0, cost_r_in_psi_0.')
             dims.ny_0 = ny_0
 
-            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx != 'GAUSS_NEWTON':
+            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx not in ['GAUSS_NEWTON', 'BLOCK_BFGS']:
                 raise Exception("\nWith CONVEX_OVER_NONLINEAR cost type, possible Hessian approximations are:\n"
-                "GAUSS_NEWTON or EXACT with 'exact_hess_cost' == False.\n")
+                "GAUSS_NEWTON, BLOCK_BFGS or EXACT with 'exact_hess_cost' == False.\n")
 
         elif cost.cost_type_0 == 'EXTERNAL':
             if opts.hessian_approx == 'GAUSS_NEWTON' and opts.ext_cost_num_hess == 0 and model.cost_expr_ext_cost_custom_hess_0 is None:
@@ -258,9 +258,9 @@ class AcadosOcp:
                 raise Exception('inconsistent dimension: regarding yref and cost_y_expr, cost_r_in_psi.')
             dims.ny = ny
 
-            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx != 'GAUSS_NEWTON':
+            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx not in ['GAUSS_NEWTON', 'BLOCK_BFGS']:
                 raise Exception("\nWith CONVEX_OVER_NONLINEAR cost type, possible Hessian approximations are:\n"
-                "GAUSS_NEWTON or EXACT with 'exact_hess_cost' == False.\n")
+                "GAUSS_NEWTON, BLOCK_BFGS or EXACT with 'exact_hess_cost' == False.\n")
 
         elif cost.cost_type == 'EXTERNAL':
             if opts.hessian_approx == 'GAUSS_NEWTON' and opts.ext_cost_num_hess == 0 and model.cost_expr_ext_cost_custom_hess is None:
@@ -305,9 +305,9 @@ class AcadosOcp:
                 raise Exception('inconsistent dimension: regarding yref_e and cost_y_expr_e, cost_r_in_psi_e.')
             dims.ny_e = ny_e
 
-            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx != 'GAUSS_NEWTON':
+            if not (opts.hessian_approx=='EXACT' and opts.exact_hess_cost==False) and opts.hessian_approx not in ['GAUSS_NEWTON', 'BLOCK_BFGS']:
                 raise Exception("\nWith CONVEX_OVER_NONLINEAR cost type, possible Hessian approximations are:\n"
-                "GAUSS_NEWTON or EXACT with 'exact_hess_cost' == False.\n")
+                "GAUSS_NEWTON, BLOCK_BFGS or EXACT with 'exact_hess_cost' == False.\n")
 
         elif cost.cost_type_e == 'EXTERNAL':
             if opts.hessian_approx == 'GAUSS_NEWTON' and opts.ext_cost_num_hess == 0 and model.cost_expr_ext_cost_custom_hess_e is None:
@@ -877,6 +877,12 @@ class AcadosOcp:
             else:
                 opts.full_step_dual = 0
 
+        if opts.hessian_approx == 'BLOCK_BFGS':
+            if opts.nlp_solver_type != 'SQP':
+                raise Exception('hessian_approx BLOCK_BFGS only supports SQP.')
+            if opts.fixed_hess:
+                raise Exception('fixed_hess is not compatible with hessian_approx == BLOCK_BFGS.')
+
         # sanity check for Funnel globalization and SQP
         if opts.globalization == 'FUNNEL_L1PEN_LINESEARCH' and opts.nlp_solver_type != 'SQP':
             raise Exception('FUNNEL_L1PEN_LINESEARCH only supports SQP.')
@@ -931,6 +937,8 @@ class AcadosOcp:
         template_list.append(('main.in.c', f'main_{name}.c'))
         template_list.append(('acados_solver.in.c', f'acados_solver_{name}.c'))
         template_list.append(('acados_solver.in.h', f'acados_solver_{name}.h'))
+        if self.solver_options.generate_cpp_header:
+            template_list.append(('acados_solver.in.hpp', f'acados_solver_{name}.hpp'))
         template_list.append(('acados_solver.in.pxd', f'acados_solver.pxd'))
         if cmake_builder is not None:
             template_list.append(('CMakeLists.in.txt', 'CMakeLists.txt'))
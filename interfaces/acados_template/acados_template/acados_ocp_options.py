@@ -96,6 +96,8 @@ class AcadosOcpOptions:
         self.__funnel_fraction_switching_condition = 1e-3
         self.__funnel_initial_penalty_parameter = 1.0
         self.__ext_cost_num_hess = 0
+        self.__block_bfgs_memory = 0
+        self.__reuse_qp_fact = 0
         self.__alpha_min = None
         self.__alpha_reduction = None
         self.__line_search_use_sufficient_descent = 0
@@ -120,12 +122,14 @@ class AcadosOcpOptions:
         self.__custom_update_header_filename = ''
         self.__custom_templates = []
         self.__custom_update_copy = True
+        self.__generate_cpp_header = False
+        self.__specialized_glue = False
         self.__num_threads_in_batch_solve: int = 1
 
     @property
     def qp_solver(self):
         """QP solver to be used in the NLP solver.
-        String in ('PARTIAL_CONDENSING_HPIPM', 'FULL_CONDENSING_QPOASES', 'FULL_CONDENSING_HPIPM', 'PARTIAL_CONDENSING_QPDUNES', 'PARTIAL_CONDENSING_OSQP', 'FULL_CONDENSING_DAQP').
+        String in ('PARTIAL_CONDENSING_HPIPM', 'FULL_CONDENSING_QPOASES', 'FULL_CONDENSING_HPIPM', 'PARTIAL_CONDENSING_QPDUNES', 'PARTIAL_CONDENSING_OSQP', 'FULL_CONDENSING_DAQP', 'PARTIAL_CONDENSING_ADMM').
         Default: 'PARTIAL_CONDENSING_HPIPM'.
         """
         return self.__qp_solver
@@ -204,6 +208,30 @@ class AcadosOcpOptions:
         """
         return self.__custom_update_copy
 
+    @property
+    def generate_cpp_header(self):
+        """
+        Boolean;
+        If True, the C++17 header `acados_solver_[model.name].hpp` is generated next to the C solver.
+        It provides the dimensions as `constexpr` constants, a move-only solver class and
+        fixed-size views into the stage vectors of `nlp_in`/`nlp_out`, which are resolved once at construction.
+        Default: False.
+        """
+        return self.__generate_cpp_header
+
+    @property
+    def specialized_glue(self):
+        """
+        Boolean;
+        If True, the generated solver contains a version of the SQP variable update (used for every step and
+        line search trial point) in which all dimensions are compile-time constants, such that the compiler can unroll
+        and vectorize the stage loops.
+        It replaces the generic implementation via `nlp_config->update_variables` if the dimensions at creation
+        match the ones used for code generation, otherwise the generic implementation is used.
+        Default: False.
+        """
+        return self.__specialized_glue
+
 
     @property
     def hpipm_mode(self):
@@ -223,7 +251,9 @@ class AcadosOcpOptions:
     @property
     def hessian_approx(self):
         """Hessian approximation.
-        String in ('GAUSS_NEWTON', 'EXACT').
+        String in ('GAUSS_NEWTON', 'EXACT', 'BLOCK_BFGS').
+        'BLOCK_BFGS' approximates the Hessian of the Lagrangian by damped BFGS updates on each stage block,
+        starting from the Gauss-Newton Hessian; only supported with nlp_solver_type 'SQP'.
         Default: 'GAUSS_NEWTON'.
         """
         return self.__hessian_approx
@@ -404,7 +434,8 @@ class AcadosOcpOptions:
     def qp_solver_warm_start(self):
         """
         QP solver: Warm starting.
-        0: no warm start; 1: warm start; 2: hot start.
+        0: no warm start; 1: warm start; 2: hot start;
+        3: hot start with changing data matrices, transferring the working set between SQP iterations (only FULL_CONDENSING_QPOASES and FULL_CONDENSING_DAQP).
         Default: 0
         """
         return self.__qp_solver_warm_start
@@ -888,6 +919,27 @@ class AcadosOcpOptions:
         """
         return self.__ext_cost_num_hess
 
+    @property
+    def block_bfgs_memory(self):
+        """
+        Number of stored pairs for the limited-memory BFGS update in case of hessian_approx == 'BLOCK_BFGS'.
+        For 0, the full damped BFGS update is applied to each stage block.
+        Type: int >= 0.
+        Default: 0.
+        """
+        return self.__block_bfgs_memory
+
+    @property
+    def reuse_qp_fact(self):
+        """
+        Indicates if the QP matrices are compared with the ones of the previous QP (1) or not (0).\n
+        If they are unchanged, e.g. for LTI dynamics with fixed_hess, their condensing is skipped
+        and HPIPM reuses its KKT factorization for QPs without inequality constraints.
+        The other QP solvers always factorize. In SQP_RTI only for as_rti_level == 4.
+        Default: 0
+        """
+        return self.__reuse_qp_fact
+
     @property
     def cost_discretization(self):
         """
@@ -927,7 +979,7 @@ class AcadosOcpOptions:
         qp_solvers = ('PARTIAL_CONDENSING_HPIPM', \
                 'FULL_CONDENSING_QPOASES', 'FULL_CONDENSING_HPIPM', \
                 'PARTIAL_CONDENSING_QPDUNES', 'PARTIAL_CONDENSING_OSQP', \
-                'FULL_CONDENSING_DAQP')
+                'FULL_CONDENSING_DAQP', 'PARTIAL_CONDENSING_ADMM')
         if qp_solver in qp_solvers:
             self.__qp_solver = qp_solver
         else:
@@ -1017,9 +1069,23 @@ class AcadosOcpOptions:
         else:
             raise Exception('Invalid custom_update_copy, expected a bool.\n')
 
+    @generate_cpp_header.setter
+    def generate_cpp_header(self, generate_cpp_header):
+        if isinstance(generate_cpp_header, bool):
+            self.__generate_cpp_header = generate_cpp_header
+        else:
+            raise Exception('Invalid generate_cpp_header, expected a bool.')
+
+    @specialized_glue.setter
+    def specialized_glue(self, specialized_glue):
+        if isinstance(specialized_glue, bool):
+            self.__specialized_glue = specialized_glue
+        else:
+            raise Exception('Invalid specialized_glue, expected a bool.')
+
     @hessian_approx.setter
     def hessian_approx(self, hessian_approx):
-        hessian_approxs = ('GAUSS_NEWTON', 'EXACT')
+        hessian_approxs = ('GAUSS_NEWTON', 'EXACT', 'BLOCK_BFGS')
         if hessian_approx in hessian_approxs:
             self.__hessian_approx = hessian_approx
         else:
@@ -1331,10 +1397,10 @@ class AcadosOcpOptions:
 
     @qp_solver_warm_start.setter
     def qp_solver_warm_start(self, qp_solver_warm_start):
-        if qp_solver_warm_start in [0, 1, 2]:
+        if qp_solver_warm_start in [0, 1, 2, 3]:
             self.__qp_solver_warm_start = qp_solver_warm_start
         else:
-            raise Exception('Invalid qp_solver_warm_start value. qp_solver_warm_start must be 0 or 1 or 2.')
+            raise Exception('Invalid qp_solver_warm_start value. qp_solver_warm_start must be 0, 1, 2 or 3.')
 
     @qp_tol.setter
     def qp_tol(self, qp_tol):
@@ -1503,6 +1569,20 @@ class AcadosOcpOptions:
         else:
             raise Exception('Invalid ext_cost_num_hess value. ext_cost_num_hess takes one of the values 0, 1.')
 
+    @block_bfgs_memory.setter
+    def block_bfgs_memory(self, block_bfgs_memory):
+        if isinstance(block_bfgs_memory, int) and block_bfgs_memory >= 0:
+            self.__block_bfgs_memory = block_bfgs_memory
+        else:
+            raise Exception('Invalid block_bfgs_memory value, expected a non-negative integer.')
+
+    @reuse_qp_fact.setter
+    def reuse_qp_fact(self, reuse_qp_fact):
+        if reuse_qp_fact in [0, 1]:
+            self.__reuse_qp_fact = reuse_qp_fact
+        else:
+            raise Exception('Invalid reuse_qp_fact value. reuse_qp_fact takes one of the values 0, 1.')
+
     @num_threads_in_batch_solve.setter
     def num_threads_in_batch_solve(self, num_threads_in_batch_solve):
         if isinstance(num_threads_in_batch_solve, int) and num_threads_in_batch_solve > 0:
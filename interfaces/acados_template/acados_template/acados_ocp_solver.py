@@ -44,7 +44,7 @@ if os.name == 'nt':
 else:
     from ctypes import CDLL as DllLoader
 from datetime import datetime
-from typing import Union, List, Tuple
+from typing import Union, List, Tuple, Optional
 
 import numpy as np
 import scipy.linalg
@@ -261,6 +261,9 @@ class AcadosOcpSolver:
         self.__qp_constraint_fields = ['C', 'D', 'lg', 'ug', 'lbx', 'ubx', 'lbu', 'ubu']
         self.__qp_pc_hpipm_fields = ['P', 'K', 'Lr', 'p']
         self.__qp_pc_fields = ['pcond_Q', 'pcond_R', 'pcond_S']
+        self.__trajectory_out_fields = ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su']
+        self.__trajectory_in_fields = ['p', 'yref', 'y_ref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+        self.__stage_dims = dict()
 
         # set arg and res types
         self.__acados_lib.ocp_nlp_dims_get_from_attr.argtypes = [c_void_p, c_void_p, c_void_p, c_int, c_char_p]
@@ -295,6 +298,10 @@ class AcadosOcpSolver:
 
         self.__acados_lib.ocp_nlp_get_at_stage.argtypes = [c_void_p, c_void_p, c_void_p, c_int, c_char_p, c_void_p]
 
+        for fun in ['ocp_nlp_out_get_stages', 'ocp_nlp_out_set_stages', 'ocp_nlp_in_get_stages', 'ocp_nlp_in_set_stages']:
+            getattr(self.__acados_lib, fun).argtypes = [c_void_p, c_void_p, c_void_p, c_int, c_int, c_char_p, POINTER(c_double), c_int]
+            getattr(self.__acados_lib, fun).restype = None
+
 
         getattr(self.shared_lib, f"{self.name}_acados_solve").argtypes = [c_void_p]
         getattr(self.shared_lib, f"{self.name}_acados_solve").restype = c_int
@@ -767,6 +774,88 @@ class AcadosOcpSolver:
         return out
 
 
+    def __get_stage_dims(self, field_: str) -> np.ndarray:
+        # dimensions of a field at all stages, queried once per field
+        if field_ not in self.__stage_dims:
+            field = field_.encode('utf-8')
+            n_stages = self.N if field_ == 'pi' else self.N+1
+            self.__stage_dims[field_] = np.array([self.__acados_lib.ocp_nlp_dims_get_from_attr(
+                self.nlp_config, self.nlp_dims, self.nlp_out, i, field) for i in range(n_stages)], dtype=np.int64)
+        return self.__stage_dims[field_]
+
+
+    def __check_trajectory_args(self, method: str, field_: str, stage_start: int, stage_end: int):
+        all_fields = self.__trajectory_out_fields + self.__trajectory_in_fields
+        if field_ not in all_fields:
+            raise Exception(f'AcadosOcpSolver.{method}(): \'{field_}\' is an invalid argument.\n Possible values are {all_fields}.')
+
+        n_stages = self.N if field_ == 'pi' else self.N+1
+        if stage_start < 0 or stage_end > n_stages or stage_start > stage_end:
+            raise Exception(f'AcadosOcpSolver.{method}(): invalid stage range [{stage_start}, {stage_end}) for field {field_}, must be within [0, {n_stages}).')
+
+
+    def get_trajectory(self, field_: str, stage_start: int = 0, stage_end: Optional[int] = None, out: Optional[np.ndarray] = None) -> np.ndarray:
+        """
+        Get a field for the stages stage_start, ..., stage_end-1 with a single call into the C library.
+
+            :param field: string in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su', 'p', 'yref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+            :param stage_start: first stage, default: 0
+            :param stage_end: one past the last stage, default: N for 'pi', N+1 otherwise
+            :param out: optional C-contiguous float64 array of shape (stage_end-stage_start, max. dimension of the field),
+                which is filled in place, e.g. to reuse the same memory in every control cycle.
+            :returns: array with one row per stage; entries beyond the dimension of a stage are not written (zero if out is not given).
+        """
+        if stage_end is None:
+            stage_end = self.N if field_ == 'pi' else self.N+1
+        self.__check_trajectory_args('get_trajectory', field_, stage_start, stage_end)
+
+        stride = int(np.max(self.__get_stage_dims(field_)[stage_start:stage_end], initial=0))
+        shape = (stage_end - stage_start, stride)
+        if out is None:
+            out = np.zeros(shape)
+        elif out.shape != shape or out.dtype != np.float64 or not out.flags['C_CONTIGUOUS']:
+            raise Exception(f'AcadosOcpSolver.get_trajectory(): out must be a C-contiguous float64 array of shape {shape}.')
+
+        field = field_.encode('utf-8')
+        out_data = cast(out.ctypes.data, POINTER(c_double))
+        if field_ in self.__trajectory_out_fields:
+            self.__acados_lib.ocp_nlp_out_get_stages(self.nlp_config, self.nlp_dims, self.nlp_out,
+                                                     stage_start, stage_end, field, out_data, stride)
+        else:
+            self.__acados_lib.ocp_nlp_in_get_stages(self.nlp_config, self.nlp_dims, self.nlp_in,
+                                                    stage_start, stage_end, field, out_data, stride)
+        return out
+
+
+    def set_trajectory(self, field_: str, value_: np.ndarray, stage_start: int = 0) -> None:
+        """
+        Set a field for the stages stage_start, ..., stage_start+value_.shape[0]-1 with a single call into the C library.
+
+            :param field: string in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su', 'p', 'yref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+            :param value: 2D array with one row per stage; rows may be longer than the dimension of a stage, remaining entries are ignored.
+            :param stage_start: first stage, default: 0
+        """
+        value_ = np.atleast_2d(value_)
+        stage_end = stage_start + value_.shape[0]
+        self.__check_trajectory_args('set_trajectory', field_, stage_start, stage_end)
+
+        max_dim = int(np.max(self.__get_stage_dims(field_)[stage_start:stage_end], initial=0))
+        if value_.shape[1] < max_dim:
+            raise Exception(f'AcadosOcpSolver.set_trajectory(): rows of value must have at least {max_dim} entries for field {field_}, got {value_.shape[1]}.')
+
+        # no copy if value_ is already a C-contiguous float64 array
+        value = np.ascontiguousarray(value_, dtype=np.float64)
+        field = field_.encode('utf-8')
+        value_data = cast(value.ctypes.data, POINTER(c_double))
+        if field_ in self.__trajectory_out_fields:
+            self.__acados_lib.ocp_nlp_out_set_stages(self.nlp_config, self.nlp_dims, self.nlp_out,
+                                                     stage_start, stage_end, field, value_data, value.shape[1])
+        else:
+            self.__acados_lib.ocp_nlp_in_set_stages(self.nlp_config, self.nlp_dims, self.nlp_in,
+                                                    stage_start, stage_end, field, value_data, value.shape[1])
+        return
+
+
     def print_statistics(self):
         """
         prints statistics of previous solver run as a table:
@@ -959,6 +1048,7 @@ class AcadosOcpSolver:
         4 - QP solver failed (ACADOS_QP_FAILURE)
         5 - Solver created (ACADOS_READY)
         6 - Problem unbounded (ACADOS_UNBOUNDED)
+        7 - Time budget exhausted (ACADOS_TIMEOUT)
 
         See `return_values` in https://github.com/acados/acados/blob/master/acados/utils/types.h
         """
@@ -1461,11 +1551,13 @@ class AcadosOcpSolver:
             - qp_mu0: for HPIPM QP solvers: initial value for complementarity slackness
             - warm_start_first_qp: indicates if first QP in SQP is warm_started
             - rti_phase: 0: PREPARATION_AND_FEEDBACK, 1: PREPARATION, 2: FEEDBACK
+            - timeout_budget: SQP only: wall-clock budget of a solver call in seconds, <= 0 disables it; when exhausted, the last accepted iterate is returned with status 7 (ACADOS_TIMEOUT)
         """
         int_fields = ['print_level', 'rti_phase', 'qp_warm_start',
                       'line_search_use_sufficient_descent', 'full_step_dual', 'globalization_use_SOC', 'warm_start_first_qp', "as_rti_level", "max_iter", "qp_print_level"]
         double_fields = ['step_length', 'tol_eq', 'tol_stat', 'tol_ineq', 'tol_comp', 'alpha_min', 'alpha_reduction',
-                         'eps_sufficient_descent', 'qp_tol_stat', 'qp_tol_eq', 'qp_tol_ineq', 'qp_tol_comp', 'qp_tau_min', 'qp_mu0']
+                         'eps_sufficient_descent', 'qp_tol_stat', 'qp_tol_eq', 'qp_tol_ineq', 'qp_tol_comp', 'qp_tau_min', 'qp_mu0',
+                         'timeout_budget']
         string_fields = ['globalization']
 
         # check field availability and type
@@ -1505,6 +1597,10 @@ class AcadosOcpSolver:
                 raise Exception('AcadosOcpSolver.options_set(): argument \'rti_phase\' can '
                     'take only value 0 for SQP-type solvers')
 
+        if field_ == 'timeout_budget' and self.__solver_options['nlp_solver_type'] != 'SQP':
+            raise Exception('AcadosOcpSolver.options_set(): argument \'timeout_budget\' '
+                'is only supported for nlp_solver_type SQP')
+
         # encode
         field = field_.encode('utf-8')
 
@@ -71,6 +71,7 @@ cdef class AcadosOcpSolverCython:
     cdef double time_value_grad
 
     cdef str nlp_solver_type
+    cdef dict stage_dims
 
     def __cinit__(self, model_name, nlp_solver_type, N):
 
@@ -80,6 +81,7 @@ cdef class AcadosOcpSolverCython:
         self.N = N
         self.model_name = model_name
         self.nlp_solver_type = nlp_solver_type
+        self.stage_dims = dict()
 
         # create capsule
         self.capsule = acados_solver.acados_create_capsule()
@@ -486,6 +488,86 @@ cdef class AcadosOcpSolverCython:
         return out
 
 
+    def __get_stage_dims(self, str field_):
+        # dimensions of a field at all stages, queried once per field
+        if field_ not in self.stage_dims:
+            field = field_.encode('utf-8')
+            n_stages = self.N if field_ == 'pi' else self.N+1
+            self.stage_dims[field_] = np.array([acados_solver_common.ocp_nlp_dims_get_from_attr(self.nlp_config,
+                self.nlp_dims, self.nlp_out, i, field) for i in range(n_stages)], dtype=np.int64)
+        return self.stage_dims[field_]
+
+
+    def __check_trajectory_args(self, str method, str field_, int stage_start, int stage_end):
+        all_fields = ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su', 'p', 'yref', 'y_ref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+        if field_ not in all_fields:
+            raise Exception(f'AcadosOcpSolverCython.{method}(): \'{field_}\' is an invalid argument.\n Possible values are {all_fields}.')
+
+        n_stages = self.N if field_ == 'pi' else self.N+1
+        if stage_start < 0 or stage_end > n_stages or stage_start > stage_end:
+            raise Exception(f'AcadosOcpSolverCython.{method}(): invalid stage range [{stage_start}, {stage_end}) for field {field_}, must be within [0, {n_stages}).')
+
+
+    def get_trajectory(self, str field_, int stage_start=0, stage_end=None, out=None):
+        """
+        Get a field for the stages stage_start, ..., stage_end-1 with a single call into the C library.
+
+            :param field: string in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su', 'p', 'yref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+            :param stage_start: first stage, default: 0
+            :param stage_end: one past the last stage, default: N for 'pi', N+1 otherwise
+            :param out: optional C-contiguous float64 array of shape (stage_end-stage_start, max. dimension of the field),
+                which is filled in place, e.g. to reuse the same memory in every control cycle.
+            :returns: array with one row per stage; entries beyond the dimension of a stage are not written (zero if out is not given).
+        """
+        if stage_end is None:
+            stage_end = self.N if field_ == 'pi' else self.N+1
+        self.__check_trajectory_args('get_trajectory', field_, stage_start, stage_end)
+
+        cdef int stride = int(np.max(self.__get_stage_dims(field_)[stage_start:stage_end], initial=0))
+        shape = (stage_end - stage_start, stride)
+        if out is None:
+            out = np.zeros(shape)
+        elif out.shape != shape or out.dtype != np.float64 or not out.flags['C_CONTIGUOUS']:
+            raise Exception(f'AcadosOcpSolverCython.get_trajectory(): out must be a C-contiguous float64 array of shape {shape}.')
+
+        cdef cnp.ndarray[cnp.float64_t, ndim=2] out_ = out
+        field = field_.encode('utf-8')
+        if field_ in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su']:
+            acados_solver_common.ocp_nlp_out_get_stages(self.nlp_config, self.nlp_dims, self.nlp_out,
+                stage_start, stage_end, field, <double *> out_.data, stride)
+        else:
+            acados_solver_common.ocp_nlp_in_get_stages(self.nlp_config, self.nlp_dims, self.nlp_in,
+                stage_start, stage_end, field, <double *> out_.data, stride)
+        return out
+
+
+    def set_trajectory(self, str field_, value_, int stage_start=0):
+        """
+        Set a field for the stages stage_start, ..., stage_start+value_.shape[0]-1 with a single call into the C library.
+
+            :param field: string in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su', 'p', 'yref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'lh', 'uh']
+            :param value: 2D array with one row per stage; rows may be longer than the dimension of a stage, remaining entries are ignored.
+            :param stage_start: first stage, default: 0
+        """
+        value_ = np.atleast_2d(value_)
+        cdef int stage_end = stage_start + value_.shape[0]
+        self.__check_trajectory_args('set_trajectory', field_, stage_start, stage_end)
+
+        max_dim = int(np.max(self.__get_stage_dims(field_)[stage_start:stage_end], initial=0))
+        if value_.shape[1] < max_dim:
+            raise Exception(f'AcadosOcpSolverCython.set_trajectory(): rows of value must have at least {max_dim} entries for field {field_}, got {value_.shape[1]}.')
+
+        # no copy if value_ is already a C-contiguous float64 array
+        cdef cnp.ndarray[cnp.float64_t, ndim=2] value = np.ascontiguousarray(value_, dtype=np.float64)
+        field = field_.encode('utf-8')
+        if field_ in ['x', 'u', 'z', 'pi', 'lam', 'sl', 'su']:
+            acados_solver_common.ocp_nlp_out_set_stages(self.nlp_config, self.nlp_dims, self.nlp_out,
+                stage_start, stage_end, field, <double *> value.data, value.shape[1])
+        else:
+            acados_solver_common.ocp_nlp_in_set_stages(self.nlp_config, self.nlp_dims, self.nlp_in,
+                stage_start, stage_end, field, <double *> value.data, value.shape[1])
+
+
     def print_statistics(self):
         """
         prints statistics of previous solver run as a table:
@@ -887,10 +969,11 @@ cdef class AcadosOcpSolverCython:
             - qp_tau_min: for HPIPM QP solvers: minimum value of barrier parameter in HPIPM
             - qp_mu0: for HPIPM QP solvers: initial value for complementarity slackness
             - warm_start_first_qp: indicates if first QP in SQP is warm_started
+            - timeout_budget: SQP only: wall-clock budget of a solver call in seconds, <= 0 disables it; when exhausted, the last accepted iterate is returned with status 7 (ACADOS_TIMEOUT)
         """
         int_fields = ['print_level', 'rti_phase', 'qp_warm_start', 'line_search_use_sufficient_descent', 'full_step_dual', 'globalization_use_SOC', 'warm_start_first_qp']
         double_fields = ['step_length', 'tol_eq', 'tol_stat', 'tol_ineq', 'tol_comp', 'alpha_min', 'alpha_reduction', 'eps_sufficient_descent',
-        'qp_tol_stat', 'qp_tol_eq', 'qp_tol_ineq', 'qp_tol_comp', 'qp_tau_min', 'qp_mu0']
+        'qp_tol_stat', 'qp_tol_eq', 'qp_tol_ineq', 'qp_tol_comp', 'qp_tau_min', 'qp_mu0', 'timeout_budget']
         string_fields = ['globalization']
 
         # encode
@@ -920,6 +1003,10 @@ cdef class AcadosOcpSolverCython:
             if not isinstance(value_, float):
                 raise Exception('solver option {} must be of type float. You have {}.'.format(field_, type(value_)))
 
+            if field_ == 'timeout_budget' and self.nlp_solver_type != 'SQP':
+                raise Exception('AcadosOcpSolverCython.options_set(): argument \'timeout_budget\' '
+                    'is only supported for nlp_solver_type SQP')
+
             double_value = value_
             acados_solver_common.ocp_nlp_solver_opts_set(self.nlp_config, self.nlp_opts, field, <void *> &double_value)
 
@@ -78,6 +78,10 @@ cdef extern from "acados_c/ocp_nlp_interface.h":
         int stage, const char *field, void *value)
     void ocp_nlp_get_at_stage(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_solver *solver,
         int stage, const char *field, void *value)
+    void ocp_nlp_out_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, double *value, int stride)
+    void ocp_nlp_out_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage_start, int stage_end, const char *field, const double *value, int stride)
     int ocp_nlp_dims_get_from_attr(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field)
     void ocp_nlp_constraint_dims_get_from_attr(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
@@ -92,6 +96,10 @@ cdef extern from "acados_c/ocp_nlp_interface.h":
         int stage, const char *field, void *value)
     void ocp_nlp_in_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
         int stage, const char *field, void *value)
+    void ocp_nlp_in_get_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+        int stage_start, int stage_end, const char *field, double *value, int stride)
+    void ocp_nlp_in_set_stages(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+        int stage_start, int stage_end, const char *field, const double *value, int stride)
 
     # opts
     void ocp_nlp_solver_opts_set(ocp_nlp_config *config, void *opts_, const char *field, void* value)
@@ -37,6 +37,12 @@
 #include "acados_c/ocp_nlp_interface.h"
 #include "acados_c/external_function_interface.h"
 
+{%- if solver_options.specialized_glue %}
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+#include "blasfeo/include/blasfeo_d_blas.h"
+{%- endif %}
+
 {%- if solver_options.num_threads_in_batch_solve > 1 %}
 // openmp
 #include <omp.h>
@@ -111,6 +117,118 @@
 #define NSGN   {{ model.name | upper }}_NSGN
 #define NSBXN  {{ model.name | upper }}_NSBXN
 
+{%- if solver_options.specialized_glue %}
+
+// ** dimension-specialized glue **
+{%- if constraints.constr_type_0 == "BGP" %}
+#define NI0    (NBX0 + NBU + NG + NPHI0 + NS0)
+{%- else %}
+#define NI0    (NBX0 + NBU + NG + NH0 + NS0)
+{%- endif %}
+{%- if constraints.constr_type == "BGP" %}
+#define NI     (NBX + NBU + NG + NPHI + NS)
+{%- else %}
+#define NI     (NBX + NBU + NG + NH + NS)
+{%- endif %}
+{%- if constraints.constr_type_e == "BGP" %}
+#define NIN    (NBXN + NGN + NPHIN + NSN)
+{%- else %}
+#define NIN    (NBXN + NGN + NHN + NSN)
+{%- endif %}
+#define NV0    (NX + NU + 2 * NS0)
+#define NV     (NX + NU + 2 * NS)
+#define NVN    (NX + 2 * NSN)
+
+/**
+ * Returns 1 if the nlp dimensions match the ones used for code generation, i.e. the specialized glue can be used.
+ */
+static int {{ model.name }}_acados_check_specialized_dims(ocp_nlp_dims *dims)
+{
+    if (dims->N != {{ model.name | upper }}_N)
+        return 0;
+    for (int i = 0; i <= dims->N; i++)
+    {
+        int nv = i == 0 ? NV0 : i < dims->N ? NV : NVN;
+        int ni = i == 0 ? NI0 : i < dims->N ? NI : NIN;
+        int nu = i < dims->N ? NU : 0;
+        int nz = i < dims->N ? NZ : 0;
+        if (dims->nv[i] != nv || dims->ni[i] != ni || dims->nx[i] != NX || dims->nu[i] != nu || dims->nz[i] != nz)
+            return 0;
+    }
+    return 1;
+}
+
+
+// called with constant dimensions only, so that the loops below get fixed trip counts
+static inline void {{ model.name }}_acados_update_variables_stage(const int nv, const int ni, const int nx_next,
+            const int nux, const int nz, double alpha, int full_step_dual,
+            struct blasfeo_dvec *ux_start, struct blasfeo_dvec *lam_start, struct blasfeo_dvec *pi_start,
+            struct blasfeo_dvec *d_ux, struct blasfeo_dvec *d_lam, struct blasfeo_dvec *d_pi,
+            struct blasfeo_dmat *dzduxt, struct blasfeo_dvec *z_alg,
+            struct blasfeo_dvec *ux, struct blasfeo_dvec *lam, struct blasfeo_dvec *pi, struct blasfeo_dvec *z)
+{
+    int j;
+
+    // step in primal variables
+    for (j = 0; j < nv; j++)
+        BLASFEO_DVECEL(ux, j) = BLASFEO_DVECEL(ux_start, j) + alpha * BLASFEO_DVECEL(d_ux, j);
+
+    // update dual variables
+    if (full_step_dual)
+    {
+        for (j = 0; j < 2 * ni; j++)
+            BLASFEO_DVECEL(lam, j) = BLASFEO_DVECEL(d_lam, j);
+        for (j = 0; j < nx_next; j++)
+            BLASFEO_DVECEL(pi, j) = BLASFEO_DVECEL(d_pi, j);
+    }
+    else
+    {
+        for (j = 0; j < 2 * ni; j++)
+            BLASFEO_DVECEL(lam, j) = (1.0 - alpha) * BLASFEO_DVECEL(lam_start, j) + alpha * BLASFEO_DVECEL(d_lam, j);
+        for (j = 0; j < nx_next; j++)
+            BLASFEO_DVECEL(pi, j) = (1.0 - alpha) * BLASFEO_DVECEL(pi_start, j) + alpha * BLASFEO_DVECEL(d_pi, j);
+    }
+
+    // z = z_alg + alpha * dzdux * d_ux
+    if (nz > 0)
+        blasfeo_dgemv_t(nux, nz, alpha, dzduxt, 0, 0, d_ux, 0, 1.0, z_alg, 0, z, 0);
+}
+
+
+/**
+ * Replaces ocp_nlp_update_variables_sqp, see nlp_config->update_variables.
+ */
+static void {{ model.name }}_acados_update_variables(void *config_, void *dims_, void *in_, void *out_start_,
+            void *opts_, void *mem_, void *work_, void *out_destination_, double alpha)
+{
+    ocp_nlp_opts *opts = opts_;
+    ocp_nlp_memory *mem = mem_;
+    ocp_nlp_out *out_start = out_start_;
+    ocp_nlp_out *out = out_destination_;
+    ocp_qp_out *qp_out = mem->qp_out;
+    int full_step_dual = opts->full_step_dual;
+
+    {{ model.name }}_acados_update_variables_stage(NV0, NI0, NX, NU + NX, NZ, alpha, full_step_dual,
+        out_start->ux, out_start->lam, out_start->pi, qp_out->ux, qp_out->lam, qp_out->pi,
+        mem->dzduxt, mem->z_alg, out->ux, out->lam, out->pi, out->z);
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 1; i < {{ model.name | upper }}_N; i++)
+    {
+        {{ model.name }}_acados_update_variables_stage(NV, NI, NX, NU + NX, NZ, alpha, full_step_dual,
+            out_start->ux+i, out_start->lam+i, out_start->pi+i, qp_out->ux+i, qp_out->lam+i, qp_out->pi+i,
+            mem->dzduxt+i, mem->z_alg+i, out->ux+i, out->lam+i, out->pi+i, out->z+i);
+    }
+
+    {{ model.name }}_acados_update_variables_stage(NVN, NIN, 0, NX, 0, alpha, full_step_dual,
+        out_start->ux+{{ model.name | upper }}_N, out_start->lam+{{ model.name | upper }}_N, NULL,
+        qp_out->ux+{{ model.name | upper }}_N, qp_out->lam+{{ model.name | upper }}_N, NULL,
+        NULL, NULL, out->ux+{{ model.name | upper }}_N, out->lam+{{ model.name | upper }}_N, NULL, NULL);
+}
+{%- endif %}
+
 
 
 // ** solver data **
@@ -1238,6 +1356,28 @@ void {{ model.name }}_acados_setup_nlp_in({{ model.name }}_solver_capsule* capsu
     {% endif %}
 {%- endif %}
 
+{%- if solver_options.hessian_approx == "BLOCK_BFGS" and (cost.cost_type_0 == "EXTERNAL" or cost.cost_type == "EXTERNAL" or cost.cost_type_e == "EXTERNAL") %}
+    // identity as initial block BFGS approximation for the EXTERNAL cost terms
+    double* ext_cost_hess_init = calloc((NX+NU)*(NX+NU), sizeof(double));
+    for (int j = 0; j < NX+NU; j++)
+        ext_cost_hess_init[j*(NX+NU)+j] = 1.0;
+  {%- if cost.cost_type_0 == "EXTERNAL" %}
+    ocp_nlp_cost_model_set(nlp_config, nlp_dims, nlp_in, 0, "ext_cost_num_hess", ext_cost_hess_init);
+  {%- endif %}
+  {%- if cost.cost_type == "EXTERNAL" %}
+    for (int i = 1; i < N; i++)
+        ocp_nlp_cost_model_set(nlp_config, nlp_dims, nlp_in, i, "ext_cost_num_hess", ext_cost_hess_init);
+  {%- endif %}
+  {%- if cost.cost_type_e == "EXTERNAL" %}
+    for (int j = 0; j < NX*NX; j++)
+        ext_cost_hess_init[j] = 0.0;
+    for (int j = 0; j < NX; j++)
+        ext_cost_hess_init[j*NX+j] = 1.0;
+    ocp_nlp_cost_model_set(nlp_config, nlp_dims, nlp_in, N, "ext_cost_num_hess", ext_cost_hess_init);
+  {%- endif %}
+    free(ext_cost_hess_init);
+{%- endif %}
+
 
 {% if dims.ns_0 > 0 %}
     // slacks initial
@@ -2051,6 +2191,9 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     int fixed_hess = {{ solver_options.fixed_hess }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "fixed_hess", &fixed_hess);
 
+    int reuse_qp_fact = {{ solver_options.reuse_qp_fact }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "reuse_qp_fact", &reuse_qp_fact);
+
 {%- if solver_options.globalization == "FIXED_STEP" %}
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization", "fixed_step");
 {% else %}
@@ -2358,7 +2501,16 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_ric_alg", &qp_solver_ric_alg);
 {% endif %}
 
+{%- if solver_options.hessian_approx == "BLOCK_BFGS" %}
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "hess_approx", "block_bfgs");
+    int block_bfgs_memory = {{ solver_options.block_bfgs_memory }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "block_bfgs_memory", &block_bfgs_memory);
+
+    // the cost Hessian of EXTERNAL cost terms is only used as initial approximation
+    int ext_cost_num_hess = 1;
+{%- else %}
     int ext_cost_num_hess = {{ solver_options.ext_cost_num_hess }};
+{%- endif %}
 {%- if cost.cost_type == "EXTERNAL" %}
     for (int i = 0; i < N; i++)
     {
@@ -2453,6 +2605,11 @@ int {{ model.name }}_acados_create_with_discretization({{ model.name }}_solver_c
 
     // 2) create and set dimensions
     capsule->nlp_dims = {{ model.name }}_acados_create_setup_dimensions(capsule);
+{%- if solver_options.specialized_glue %}
+    // use the dimension-specialized glue if the discretization matches the generated one
+    if ({{ model.name }}_acados_check_specialized_dims(capsule->nlp_dims))
+        capsule->nlp_config->update_variables = &{{ model.name }}_acados_update_variables;
+{%- endif %}
 
     // 3) create and set nlp_opts
     capsule->nlp_opts = ocp_nlp_solver_opts_create(capsule->nlp_config, capsule->nlp_dims);
@@ -2635,6 +2792,13 @@ int {{ model.name }}_acados_solve({{ model.name }}_solver_capsule* capsule)
 }
 
 
+int {{ model.name }}_acados_prewarm({{ model.name }}_solver_capsule* capsule)
+{
+    // map all solver memory and run lazy QP solver setup outside of the real-time loop
+    return ocp_nlp_solver_prewarm(capsule->nlp_solver, capsule->nlp_in, capsule->nlp_out);
+}
+
+
 void {{ model.name }}_acados_batch_solve({{ model.name }}_solver_capsule ** capsules, int N_batch)
 {
 {% if solver_options.num_threads_in_batch_solve > 1 %}
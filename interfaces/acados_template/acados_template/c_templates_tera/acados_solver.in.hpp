@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+// C++17 wrapper around the generated solver acados_solver_{{ model.name }}.h.
+// All stage vectors are resolved once at construction, the accessors are unchecked
+// (except for assertions on the stage index) and point directly into nlp_in / nlp_out.
+
+#ifndef ACADOS_SOLVER_{{ model.name }}_HPP_
+#define ACADOS_SOLVER_{{ model.name }}_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "acados_solver_{{ model.name }}.h"
+
+namespace acados
+{
+namespace {{ model.name }}
+{
+
+constexpr int NX = {{ dims.nx }};
+constexpr int NZ = {{ dims.nz }};
+constexpr int NU = {{ dims.nu }};
+constexpr int NP = {{ dims.np }};
+constexpr int NBX0 = {{ dims.nbx_0 }};
+constexpr int NY0 = {{ dims.ny_0 }};
+constexpr int NY = {{ dims.ny }};
+constexpr int NYN = {{ dims.ny_e }};
+constexpr int N = {{ solver_options.N_horizon }};
+
+
+// non-owning view of a stage vector with compile-time size, similar to std::span<double, Size>
+template <int Size>
+class Vector
+{
+public:
+    explicit Vector(double *data) : data_(data) {}
+
+    static constexpr std::size_t size() { return Size; }
+    double *data() const { return data_; }
+    double *begin() const { return data_; }
+    double *end() const { return data_ + Size; }
+    double &operator[](std::size_t i) const { return data_[i]; }
+
+    void assign(const std::array<double, Size> &value) const
+    {
+        std::copy(value.begin(), value.end(), data_);
+    }
+
+    std::array<double, Size> to_array() const
+    {
+        std::array<double, Size> value;
+        std::copy(data_, data_ + Size, value.begin());
+        return value;
+    }
+
+private:
+    double *data_;
+};
+
+
+class Solver
+{
+public:
+    Solver()
+    {
+        capsule_ = {{ model.name }}_acados_create_capsule();
+        int status = {{ model.name }}_acados_create(capsule_);
+        if (status)
+        {
+            {{ model.name }}_acados_free_capsule(capsule_);
+            capsule_ = nullptr;
+            throw std::runtime_error("{{ model.name }}_acados_create() returned status " + std::to_string(status));
+        }
+        resolve_fields();
+    }
+
+    ~Solver()
+    {
+        release();
+    }
+
+    Solver(const Solver &) = delete;
+    Solver &operator=(const Solver &) = delete;
+
+    Solver(Solver &&other) noexcept
+    {
+        move_from(other);
+    }
+
+    Solver &operator=(Solver &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    int solve()
+    {
+        return {{ model.name }}_acados_solve(capsule_);
+    }
+
+    int reset(bool reset_qp_solver_mem = true)
+    {
+        return {{ model.name }}_acados_reset(capsule_, reset_qp_solver_mem ? 1 : 0);
+    }
+
+    // call once before solving in a real-time loop
+    int prewarm()
+    {
+        return {{ model.name }}_acados_prewarm(capsule_);
+    }
+
+{%- if dims.nbx_0 > 0 %}
+    // sets lbx = ubx = x0 at stage 0
+    void set_x0(const std::array<double, NBX0> &x0)
+    {
+        Vector<NBX0>(lbx_0_).assign(x0);
+        Vector<NBX0>(ubx_0_).assign(x0);
+    }
+{%- endif %}
+
+    // nlp_out
+    Vector<NX> x(int stage) const
+    {
+        assert(stage >= 0 && stage <= N);
+        return Vector<NX>(x_[stage]);
+    }
+{%- if dims.nu > 0 %}
+
+    Vector<NU> u(int stage) const
+    {
+        assert(stage >= 0 && stage < N);
+        return Vector<NU>(u_[stage]);
+    }
+{%- endif %}
+{%- if dims.nz > 0 %}
+
+    Vector<NZ> z(int stage) const
+    {
+        assert(stage >= 0 && stage < N);
+        return Vector<NZ>(z_[stage]);
+    }
+{%- endif %}
+
+    Vector<NX> pi(int stage) const
+    {
+        assert(stage >= 0 && stage < N);
+        return Vector<NX>(pi_[stage]);
+    }
+{%- if dims.np > 0 %}
+
+    // nlp_in
+    Vector<NP> p(int stage) const
+    {
+        assert(stage >= 0 && stage <= N);
+        return Vector<NP>(p_[stage]);
+    }
+{%- endif %}
+{%- if dims.ny_0 > 0 %}
+
+    Vector<NY0> yref_0() const
+    {
+        return Vector<NY0>(yref_0_);
+    }
+{%- endif %}
+{%- if dims.ny > 0 %}
+
+    // stages 1, ..., N-1
+    Vector<NY> yref(int stage) const
+    {
+        assert(stage >= 1 && stage < N);
+        return Vector<NY>(yref_[stage]);
+    }
+{%- endif %}
+{%- if dims.ny_e > 0 %}
+
+    Vector<NYN> yref_e() const
+    {
+        return Vector<NYN>(yref_e_);
+    }
+{%- endif %}
+
+    {{ model.name }}_solver_capsule *capsule() const { return capsule_; }
+
+private:
+    double *field(ocp_nlp_in *in, int stage, const char *name)
+    {
+        return ocp_nlp_in_field_handle(capsule_->nlp_config, capsule_->nlp_dims, in, stage, name).ptr;
+    }
+
+    double *field(ocp_nlp_out *out, int stage, const char *name)
+    {
+        return ocp_nlp_out_field_handle(capsule_->nlp_config, capsule_->nlp_dims, out, stage, name).ptr;
+    }
+
+    void resolve_fields()
+    {
+        ocp_nlp_in *in = capsule_->nlp_in;
+        ocp_nlp_out *out = capsule_->nlp_out;
+
+        for (int stage = 0; stage <= N; stage++)
+        {
+            x_[stage] = field(out, stage, "x");
+{%- if dims.np > 0 %}
+            p_[stage] = field(in, stage, "p");
+{%- endif %}
+        }
+        for (int stage = 0; stage < N; stage++)
+        {
+{%- if dims.nu > 0 %}
+            u_[stage] = field(out, stage, "u");
+{%- endif %}
+{%- if dims.nz > 0 %}
+            z_[stage] = field(out, stage, "z");
+{%- endif %}
+            pi_[stage] = field(out, stage, "pi");
+        }
+{%- if dims.ny > 0 %}
+        for (int stage = 1; stage < N; stage++)
+            yref_[stage] = field(in, stage, "yref");
+{%- endif %}
+{%- if dims.ny_0 > 0 %}
+        yref_0_ = field(in, 0, "yref");
+{%- endif %}
+{%- if dims.ny_e > 0 %}
+        yref_e_ = field(in, N, "yref");
+{%- endif %}
+{%- if dims.nbx_0 > 0 %}
+        lbx_0_ = field(in, 0, "lbx");
+        ubx_0_ = field(in, 0, "ubx");
+{%- endif %}
+    }
+
+    void move_from(Solver &other)
+    {
+        capsule_ = std::exchange(other.capsule_, nullptr);
+        x_ = other.x_;
+        pi_ = other.pi_;
+{%- if dims.nu > 0 %}
+        u_ = other.u_;
+{%- endif %}
+{%- if dims.nz > 0 %}
+        z_ = other.z_;
+{%- endif %}
+{%- if dims.np > 0 %}
+        p_ = other.p_;
+{%- endif %}
+{%- if dims.ny_0 > 0 %}
+        yref_0_ = other.yref_0_;
+{%- endif %}
+{%- if dims.ny > 0 %}
+        yref_ = other.yref_;
+{%- endif %}
+{%- if dims.ny_e > 0 %}
+        yref_e_ = other.yref_e_;
+{%- endif %}
+        lbx_0_ = other.lbx_0_;
+        ubx_0_ = other.ubx_0_;
+    }
+
+    void release()
+    {
+        if (capsule_)
+        {
+            {{ model.name }}_acados_free(capsule_);
+            {{ model.name }}_acados_free_capsule(capsule_);
+            capsule_ = nullptr;
+        }
+    }
+
+    {{ model.name }}_solver_capsule *capsule_ = nullptr;
+
+    std::array<double *, N + 1> x_{};
+    std::array<double *, N> pi_{};
+{%- if dims.nu > 0 %}
+    std::array<double *, N> u_{};
+{%- endif %}
+{%- if dims.nz > 0 %}
+    std::array<double *, N> z_{};
+{%- endif %}
+{%- if dims.np > 0 %}
+    std::array<double *, N + 1> p_{};
+{%- endif %}
+{%- if dims.ny_0 > 0 %}
+    double *yref_0_ = nullptr;
+{%- endif %}
+{%- if dims.ny > 0 %}
+    std::array<double *, N> yref_{};
+{%- endif %}
+{%- if dims.ny_e > 0 %}
+    double *yref_e_ = nullptr;
+{%- endif %}
+    double *lbx_0_ = nullptr;
+    double *ubx_0_ = nullptr;
+};
+
+}  // namespace {{ model.name }}
+}  // namespace acados
+
+#endif  // ACADOS_SOLVER_{{ model.name }}_HPP_
@@ -69,6 +69,7 @@ setup(name='acados_template',
         'c_templates_tera/acados_sim_solver.in.pxd',
         'c_templates_tera/acados_solver.in.c',
         'c_templates_tera/acados_solver.in.h',
+        'c_templates_tera/acados_solver.in.hpp',
         'c_templates_tera/acados_solver.in.pxd',
         'c_templates_tera/constraints.in.h',
         'c_templates_tera/cost.in.h',
@@ -0,0 +1,743 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// Tests of ocp_nlp solver options on the chain example with 3 masses.
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "catch/include/catch.hpp"
+
+#include "blasfeo/include/blasfeo_d_aux.h"
+
+#include "acados/ocp_nlp/ocp_nlp_sqp.h"
+
+#include "acados_c/external_function_interface.h"
+#include "acados_c/ocp_nlp_interface.h"
+
+#include "examples/c/chain_model/chain_model.h"
+
+// x0, xN
+#include "examples/c/chain_model/x0_nm3.c"
+#include "examples/c/chain_model/xN_nm3.c"
+
+#define CHAIN_N 20
+#define CHAIN_NX 12
+#define CHAIN_NU 3
+#define CHAIN_TOL 1e-6
+
+
+
+/************************************************
+* nonlinear constraint h(x, u) = u' * u
+************************************************/
+
+static void chain_h_eval(ext_fun_arg_t *type_in, void **in, void **out, int with_jac)
+{
+    struct blasfeo_dvec_args *u_in = (struct blasfeo_dvec_args *) in[1];
+    struct blasfeo_dvec_args *fun_out = (struct blasfeo_dvec_args *) out[0];
+
+    double h = 0.0;
+    for (int j = 0; j < CHAIN_NU; j++)
+    {
+        double u_j = blasfeo_dvecex1(u_in->x, u_in->xi+j);
+        h += u_j * u_j;
+    }
+    blasfeo_dvecin1(h, fun_out->x, fun_out->xi);
+
+    if (with_jac)
+    {
+        // jac_ux': (nu+nx) * 1
+        struct blasfeo_dmat_args *jac_out = (struct blasfeo_dmat_args *) out[1];
+        for (int j = 0; j < CHAIN_NU; j++)
+        {
+            double u_j = blasfeo_dvecex1(u_in->x, u_in->xi+j);
+            blasfeo_dgein1(2.0 * u_j, jac_out->A, jac_out->ai+j, jac_out->aj);
+        }
+        for (int j = 0; j < CHAIN_NX; j++)
+            blasfeo_dgein1(0.0, jac_out->A, jac_out->ai+CHAIN_NU+j, jac_out->aj);
+        // jac_z' is empty, nz = 0
+    }
+}
+
+
+
+static void chain_h_fun(void *self, ext_fun_arg_t *type_in, void **in, ext_fun_arg_t *type_out,
+                        void **out)
+{
+    chain_h_eval(type_in, in, out, 0);
+}
+
+
+
+static void chain_h_fun_jac(void *self, ext_fun_arg_t *type_in, void **in, ext_fun_arg_t *type_out,
+                            void **out)
+{
+    chain_h_eval(type_in, in, out, 1);
+}
+
+
+
+/************************************************
+* chain OCP fixture
+************************************************/
+
+// Explicit ERK dynamics, linear least squares cost, bounds on u and x0 and, optionally, the
+// nonlinear constraint u' * u <= uh on the stages 0, ..., N-1. With DDP, which only supports
+// initial state constraints, the bounds on u are left out.
+typedef struct
+{
+    ocp_nlp_plan_t *plan;
+    ocp_nlp_config *config;
+    ocp_nlp_dims *dims;
+    ocp_nlp_in *in;
+    ocp_nlp_out *out;
+    void *opts;
+    ocp_nlp_solver *solver;
+    external_function_casadi expl_vde_for[CHAIN_N];
+    external_function_generic h_fun;
+    external_function_generic h_fun_jac;
+} chain_ocp;
+
+
+
+// creates everything up to the solver options, which can be set before chain_ocp_create_solver
+static void chain_ocp_create(chain_ocp *ocp, ocp_nlp_solver_t nlp_solver, ocp_qp_solver_t qp_solver,
+                             double uh)
+{
+    int N = CHAIN_N;
+    int NX = CHAIN_NX;
+    int NU = CHAIN_NU;
+    int with_bu = nlp_solver != DDP;
+
+    int nx[CHAIN_N+1], nu[CHAIN_N+1], zeros[CHAIN_N+1];
+    for (int i = 0; i <= N; i++)
+    {
+        nx[i] = NX;
+        nu[i] = i < N ? NU : 0;
+        zeros[i] = 0;
+    }
+
+    // plan + config
+    ocp->plan = ocp_nlp_plan_create(N);
+    ocp->plan->nlp_solver = nlp_solver;
+    ocp->plan->regularization = NO_REGULARIZE;
+    ocp->plan->ocp_qp_solver_plan.qp_solver = qp_solver;
+    for (int i = 0; i <= N; i++)
+    {
+        ocp->plan->nlp_cost[i] = LINEAR_LS;
+        ocp->plan->nlp_constraints[i] = BGH;
+    }
+    for (int i = 0; i < N; i++)
+    {
+        ocp->plan->nlp_dynamics[i] = CONTINUOUS_MODEL;
+        ocp->plan->sim_solver_plan[i].sim_solver = ERK;
+    }
+    ocp->config = ocp_nlp_config_create(*ocp->plan);
+    ocp_nlp_config *config = ocp->config;
+
+    // dims
+    ocp->dims = ocp_nlp_dims_create(config);
+    ocp_nlp_dims *dims = ocp->dims;
+    ocp_nlp_dims_set_opt_vars(config, dims, "nx", nx);
+    ocp_nlp_dims_set_opt_vars(config, dims, "nu", nu);
+    ocp_nlp_dims_set_opt_vars(config, dims, "nz", zeros);
+    ocp_nlp_dims_set_opt_vars(config, dims, "ns", zeros);
+    for (int i = 0; i <= N; i++)
+    {
+        int ny = i < N ? NX+NU : NX;
+        int nbx = i == 0 ? NX : 0;
+        int nbu = (with_bu && i < N) ? NU : 0;
+        int nh = (uh > 0.0 && i < N) ? 1 : 0;
+        ocp_nlp_dims_set_cost(config, dims, i, "ny", &ny);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nbx", &nbx);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nbu", &nbu);
+        ocp_nlp_dims_set_constraints(config, dims, i, "ng", &zeros[i]);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nh", &nh);
+    }
+
+    // dynamics
+    for (int i = 0; i < N; i++)
+    {
+        ocp->expl_vde_for[i].casadi_fun = &vde_chain_nm3;
+        ocp->expl_vde_for[i].casadi_work = &vde_chain_nm3_work;
+        ocp->expl_vde_for[i].casadi_sparsity_in = &vde_chain_nm3_sparsity_in;
+        ocp->expl_vde_for[i].casadi_sparsity_out = &vde_chain_nm3_sparsity_out;
+        ocp->expl_vde_for[i].casadi_n_in = &vde_chain_nm3_n_in;
+        ocp->expl_vde_for[i].casadi_n_out = &vde_chain_nm3_n_out;
+    }
+    external_function_casadi_create_array(N, ocp->expl_vde_for);
+
+    // nonlinear constraint
+    ocp->h_fun.evaluate = &chain_h_fun;
+    ocp->h_fun_jac.evaluate = &chain_h_fun_jac;
+
+    // nlp_in
+    ocp->in = ocp_nlp_in_create(config, dims);
+    ocp_nlp_in *nlp_in = ocp->in;
+
+    double Ts = 0.2;
+    double Cyt[(CHAIN_NX+CHAIN_NU)*(CHAIN_NX+CHAIN_NU)] = {0};
+    double W[(CHAIN_NX+CHAIN_NU)*(CHAIN_NX+CHAIN_NU)] = {0};
+    double CytN[CHAIN_NX*CHAIN_NX] = {0};
+    double WN[CHAIN_NX*CHAIN_NX] = {0};
+    double yref[CHAIN_NX+CHAIN_NU] = {0};
+    for (int j = 0; j < NU; j++)
+    {
+        Cyt[j+(NX+NU)*(NX+j)] = 1.0;
+        W[(NX+j)*(NX+NU+1)] = 1.0;
+    }
+    for (int j = 0; j < NX; j++)
+    {
+        Cyt[NU+j+(NX+NU)*j] = 1.0;
+        W[j*(NX+NU+1)] = 1e-2;
+        CytN[j*(NX+1)] = 1.0;
+        WN[j*(NX+1)] = 1e-2;
+        yref[j] = xN_nm3[j];
+    }
+
+    int idxbx0[CHAIN_NX], idxbu[CHAIN_NU];
+    double lbu[CHAIN_NU], ubu[CHAIN_NU];
+    for (int j = 0; j < NX; j++)
+        idxbx0[j] = j;
+    for (int j = 0; j < NU; j++)
+    {
+        idxbu[j] = j;
+        lbu[j] = -1.0;
+        ubu[j] = 1.0;
+    }
+    double lh = -1.0;
+
+    for (int i = 0; i < N; i++)
+    {
+        ocp_nlp_in_set(config, dims, nlp_in, i, "Ts", &Ts);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "Cyt", Cyt);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "W", W);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "yref", yref);
+        ocp_nlp_dynamics_model_set(config, dims, nlp_in, i, "expl_vde_for", &ocp->expl_vde_for[i]);
+        if (with_bu)
+        {
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "idxbu", idxbu);
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "lbu", lbu);
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "ubu", ubu);
+        }
+        if (uh > 0.0)
+        {
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "nl_constr_h_fun", &ocp->h_fun);
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "nl_constr_h_fun_jac",
+                                          &ocp->h_fun_jac);
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "lh", &lh);
+            ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "uh", &uh);
+        }
+    }
+    ocp_nlp_cost_model_set(config, dims, nlp_in, N, "Cyt", CytN);
+    ocp_nlp_cost_model_set(config, dims, nlp_in, N, "W", WN);
+    ocp_nlp_cost_model_set(config, dims, nlp_in, N, "yref", yref);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "idxbx", idxbx0);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "lbx", x0_nm3);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "ubx", x0_nm3);
+
+    ocp->opts = ocp_nlp_solver_opts_create(config, dims);
+    ocp->out = NULL;
+    ocp->solver = NULL;
+}
+
+
+
+// sets the initial guess x = x0, u = 0
+static void chain_ocp_reset_out(chain_ocp *ocp)
+{
+    double u0[CHAIN_NU] = {0};
+    for (int i = 0; i <= CHAIN_N; i++)
+    {
+        ocp_nlp_out_set(ocp->config, ocp->dims, ocp->out, i, "x", x0_nm3);
+        if (i < CHAIN_N)
+            ocp_nlp_out_set(ocp->config, ocp->dims, ocp->out, i, "u", u0);
+    }
+}
+
+
+
+// creates solver and output with the options set so far and initializes x with x0
+static void chain_ocp_create_solver(chain_ocp *ocp)
+{
+    ocp->out = ocp_nlp_out_create(ocp->config, ocp->dims);
+    ocp->solver = ocp_nlp_solver_create(ocp->config, ocp->dims, ocp->opts);
+
+    chain_ocp_reset_out(ocp);
+
+    REQUIRE(ocp_nlp_precompute(ocp->solver, ocp->in, ocp->out) == 0);
+}
+
+
+
+// max abs difference of the primal trajectories
+static double chain_ocp_diff_ux(chain_ocp *ocp_a, chain_ocp *ocp_b)
+{
+    double x_a[CHAIN_NX], x_b[CHAIN_NX];
+    double diff = 0.0;
+    for (int i = 0; i <= CHAIN_N; i++)
+    {
+        ocp_nlp_out_get(ocp_a->config, ocp_a->dims, ocp_a->out, i, "x", x_a);
+        ocp_nlp_out_get(ocp_b->config, ocp_b->dims, ocp_b->out, i, "x", x_b);
+        for (int j = 0; j < CHAIN_NX; j++)
+            diff = fmax(diff, fabs(x_a[j] - x_b[j]));
+        if (i < CHAIN_N)
+        {
+            ocp_nlp_out_get(ocp_a->config, ocp_a->dims, ocp_a->out, i, "u", x_a);
+            ocp_nlp_out_get(ocp_b->config, ocp_b->dims, ocp_b->out, i, "u", x_b);
+            for (int j = 0; j < CHAIN_NU; j++)
+                diff = fmax(diff, fabs(x_a[j] - x_b[j]));
+        }
+    }
+    return diff;
+}
+
+
+
+static void chain_ocp_free(chain_ocp *ocp)
+{
+    if (ocp->solver)
+        ocp_nlp_solver_destroy(ocp->solver);
+    if (ocp->out)
+        ocp_nlp_out_destroy(ocp->out);
+    ocp_nlp_solver_opts_destroy(ocp->opts);
+    ocp_nlp_in_destroy(ocp->in);
+    ocp_nlp_dims_destroy(ocp->dims);
+    ocp_nlp_config_destroy(ocp->config);
+    ocp_nlp_plan_destroy(ocp->plan);
+    external_function_casadi_free_array(CHAIN_N, ocp->expl_vde_for);
+}
+
+
+
+/************************************************
+* TEST CASES
+************************************************/
+
+TEST_CASE("chain example lazy constraint Jacobian", "[NLP solver]")
+{
+    chain_ocp eager, lazy;
+    int max_iter = 100;
+    int lazy_jac_h = 1;
+
+    chain_ocp_create(&eager, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    chain_ocp_create(&lazy, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    ocp_nlp_solver_opts_set(eager.config, eager.opts, "max_iter", &max_iter);
+    ocp_nlp_solver_opts_set(lazy.config, lazy.opts, "max_iter", &max_iter);
+    for (int i = 0; i < CHAIN_N; i++)
+        ocp_nlp_solver_opts_set_at_stage(lazy.config, lazy.opts, i, "constraints_lazy_jac_h", &lazy_jac_h);
+    chain_ocp_create_solver(&eager);
+    chain_ocp_create_solver(&lazy);
+
+    REQUIRE(ocp_nlp_solve(eager.solver, eager.in, eager.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(lazy.solver, lazy.in, lazy.out) == ACADOS_SUCCESS);
+
+    int eval_eager = 0, skip_eager = 0, eval_lazy = 0, skip_lazy = 0;
+    for (int i = 0; i < CHAIN_N; i++)
+    {
+        int count;
+        ocp_nlp_get_at_stage(eager.config, eager.dims, eager.solver, i, "jac_h_eval_count", &count);
+        eval_eager += count;
+        ocp_nlp_get_at_stage(eager.config, eager.dims, eager.solver, i, "jac_h_skip_count", &count);
+        skip_eager += count;
+        ocp_nlp_get_at_stage(lazy.config, lazy.dims, lazy.solver, i, "jac_h_eval_count", &count);
+        eval_lazy += count;
+        ocp_nlp_get_at_stage(lazy.config, lazy.dims, lazy.solver, i, "jac_h_skip_count", &count);
+        skip_lazy += count;
+    }
+
+    // Jacobians are reused only for inactive constraints, hence the same solution
+    REQUIRE(chain_ocp_diff_ux(&eager, &lazy) <= CHAIN_TOL);
+    REQUIRE(skip_eager == 0);
+    REQUIRE(skip_lazy > 0);
+    REQUIRE(eval_lazy < eval_eager);
+
+    chain_ocp_free(&eager);
+    chain_ocp_free(&lazy);
+}
+
+
+
+TEST_CASE("chain example pipelined RTI", "[NLP solver]")
+{
+    chain_ocp sequential, pipelined;
+    int rti_pipelining = 1;
+    int num_rti_steps = 50;
+
+    chain_ocp_create(&sequential, SQP_RTI, PARTIAL_CONDENSING_HPIPM, 0.0);
+    chain_ocp_create(&pipelined, SQP_RTI, PARTIAL_CONDENSING_HPIPM, 0.0);
+    ocp_nlp_solver_opts_set(pipelined.config, pipelined.opts, "rti_pipelining", &rti_pipelining);
+    chain_ocp_create_solver(&sequential);
+    chain_ocp_create_solver(&pipelined);
+
+    SECTION("alternating calls")
+    {
+        // preparation on the last feedback result, then feedback: same iterates as sequential RTI
+        for (int k = 0; k < num_rti_steps; k++)
+        {
+            REQUIRE(ocp_nlp_solve(sequential.solver, sequential.in, sequential.out) == ACADOS_SUCCESS);
+            REQUIRE(ocp_nlp_rti_pipelined_preparation(pipelined.solver, pipelined.in, pipelined.out) == ACADOS_SUCCESS);
+            REQUIRE(ocp_nlp_rti_pipelined_feedback(pipelined.solver, pipelined.in, pipelined.out) == ACADOS_SUCCESS);
+            REQUIRE(chain_ocp_diff_ux(&sequential, &pipelined) <= CHAIN_TOL);
+        }
+    }
+
+    SECTION("concurrent preparation")
+    {
+        for (int k = 0; k < num_rti_steps; k++)
+            REQUIRE(ocp_nlp_solve(sequential.solver, sequential.in, sequential.out) == ACADOS_SUCCESS);
+
+        // the first preparation reads nlp_out, hence it runs before the feedback thread starts
+        REQUIRE(ocp_nlp_rti_pipelined_preparation(pipelined.solver, pipelined.in, pipelined.out) == ACADOS_SUCCESS);
+
+        std::atomic<bool> stop(false);
+        std::thread preparation_thread([&]()
+        {
+            while (!stop.load())
+                ocp_nlp_rti_pipelined_preparation(pipelined.solver, pipelined.in, pipelined.out);
+        });
+
+        int num_failed = 0;
+        int num_feedback = 0;
+        for (int k = 0; k < 4 * num_rti_steps; k++)
+        {
+            int status = ocp_nlp_rti_pipelined_feedback(pipelined.solver, pipelined.in, pipelined.out);
+            if (status == ACADOS_SUCCESS)
+                num_feedback++;
+            else if (status != ACADOS_READY)
+                num_failed++;
+        }
+        stop.store(true);
+        preparation_thread.join();
+
+        REQUIRE(num_failed == 0);
+        REQUIRE(num_feedback > 0);
+
+        // converge the pipelined iterates, RTI has the NLP solution as fixed point
+        for (int k = 0; k < num_rti_steps; k++)
+        {
+            REQUIRE(ocp_nlp_rti_pipelined_preparation(pipelined.solver, pipelined.in, pipelined.out) == ACADOS_SUCCESS);
+            REQUIRE(ocp_nlp_rti_pipelined_feedback(pipelined.solver, pipelined.in, pipelined.out) == ACADOS_SUCCESS);
+        }
+        REQUIRE(chain_ocp_diff_ux(&sequential, &pipelined) <= CHAIN_TOL);
+    }
+
+    chain_ocp_free(&sequential);
+    chain_ocp_free(&pipelined);
+}
+
+
+
+TEST_CASE("chain example Hessian reuse with Levenberg-Marquardt term", "[NLP solver]")
+{
+    chain_ocp reference, reuse;
+    int max_iter = 200;
+    double tol = 1e-8;
+    double levenberg_marquardt = 1e-1;
+    int hess_reuse_period = 3;
+    int hess_reuse_update = HESS_UPDATE_DAMPED_BFGS;
+
+    SECTION("damped BFGS") { hess_reuse_update = HESS_UPDATE_DAMPED_BFGS; }
+    SECTION("SR1") { hess_reuse_update = HESS_UPDATE_SR1; }
+
+    chain_ocp_create(&reference, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    chain_ocp_create(&reuse, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    for (chain_ocp *ocp : {&reference, &reuse})
+    {
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "max_iter", &max_iter);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_stat", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_eq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_ineq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_comp", &tol);
+    }
+    // the quasi-Newton updates see the QP Hessian including the Levenberg-Marquardt term
+    ocp_nlp_solver_opts_set(reuse.config, reuse.opts, "levenberg_marquardt", &levenberg_marquardt);
+    ocp_nlp_solver_opts_set(reuse.config, reuse.opts, "hess_reuse_period", &hess_reuse_period);
+    ocp_nlp_solver_opts_set(reuse.config, reuse.opts, "hess_reuse_update", &hess_reuse_update);
+    chain_ocp_create_solver(&reference);
+    chain_ocp_create_solver(&reuse);
+
+    REQUIRE(ocp_nlp_solve(reference.solver, reference.in, reference.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(reuse.solver, reuse.in, reuse.out) == ACADOS_SUCCESS);
+
+    int sqp_iter;
+    ocp_nlp_get(reuse.config, reuse.solver, "sqp_iter", &sqp_iter);
+    REQUIRE(sqp_iter < max_iter);
+    REQUIRE(chain_ocp_diff_ux(&reference, &reuse) <= 1e2 * CHAIN_TOL);
+
+    chain_ocp_free(&reference);
+    chain_ocp_free(&reuse);
+}
+
+
+
+TEST_CASE("chain example block BFGS with Levenberg-Marquardt term", "[NLP solver]")
+{
+    chain_ocp reference, block_bfgs;
+    int max_iter = 200;
+    double tol = 1e-8;
+    double levenberg_marquardt = 1e-1;
+    int block_bfgs_memory = 0;
+
+    SECTION("full memory") { block_bfgs_memory = 0; }
+    SECTION("limited memory") { block_bfgs_memory = 5; }
+
+    chain_ocp_create(&reference, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    chain_ocp_create(&block_bfgs, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    for (chain_ocp *ocp : {&reference, &block_bfgs})
+    {
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "max_iter", &max_iter);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_stat", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_eq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_ineq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_comp", &tol);
+    }
+    // the block updates see the QP Hessian including the Levenberg-Marquardt term
+    ocp_nlp_solver_opts_set(block_bfgs.config, block_bfgs.opts, "levenberg_marquardt", &levenberg_marquardt);
+    ocp_nlp_solver_opts_set(block_bfgs.config, block_bfgs.opts, "hess_approx", (void *) "block_bfgs");
+    ocp_nlp_solver_opts_set(block_bfgs.config, block_bfgs.opts, "block_bfgs_memory", &block_bfgs_memory);
+    chain_ocp_create_solver(&reference);
+    chain_ocp_create_solver(&block_bfgs);
+
+    REQUIRE(ocp_nlp_solve(reference.solver, reference.in, reference.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(block_bfgs.solver, block_bfgs.in, block_bfgs.out) == ACADOS_SUCCESS);
+
+    int sqp_iter;
+    ocp_nlp_get(block_bfgs.config, block_bfgs.solver, "sqp_iter", &sqp_iter);
+    REQUIRE(sqp_iter < max_iter);
+    REQUIRE(chain_ocp_diff_ux(&reference, &block_bfgs) <= 1e2 * CHAIN_TOL);
+
+    chain_ocp_free(&reference);
+    chain_ocp_free(&block_bfgs);
+}
+
+
+
+TEST_CASE("chain example DDP with multiple shooting segments", "[NLP solver]")
+{
+    chain_ocp single, multiple;
+    int max_iter = 200;
+    double tol = 1e-8;
+    int num_shooting_segments = 2;
+    int linesearch_num_candidates = 1;
+
+    SECTION("2 segments") { num_shooting_segments = 2; }
+    SECTION("one segment per stage") { num_shooting_segments = CHAIN_N; }
+    SECTION("4 segments, 3 line search candidates")
+    {
+        num_shooting_segments = 4;
+        linesearch_num_candidates = 3;
+    }
+
+    chain_ocp_create(&single, DDP, PARTIAL_CONDENSING_HPIPM, 0.0);
+    chain_ocp_create(&multiple, DDP, PARTIAL_CONDENSING_HPIPM, 0.0);
+    for (chain_ocp *ocp : {&single, &multiple})
+    {
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "max_iter", &max_iter);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_stat", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_eq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_ineq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_comp", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "globalization", (void *) "merit_backtracking");
+    }
+    ocp_nlp_solver_opts_set(multiple.config, multiple.opts, "num_shooting_segments", &num_shooting_segments);
+    ocp_nlp_solver_opts_set(multiple.config, multiple.opts, "linesearch_num_candidates",
+                            &linesearch_num_candidates);
+    chain_ocp_create_solver(&single);
+    chain_ocp_create_solver(&multiple);
+
+    REQUIRE(ocp_nlp_solve(single.solver, single.in, single.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(multiple.solver, multiple.in, multiple.out) == ACADOS_SUCCESS);
+
+    // the defects between the segments are closed at convergence, hence the same solution
+    int ddp_iter;
+    ocp_nlp_get(multiple.config, multiple.solver, "ddp_iter", &ddp_iter);
+    REQUIRE(ddp_iter < max_iter);
+    REQUIRE(chain_ocp_diff_ux(&single, &multiple) <= 1e2 * CHAIN_TOL);
+
+    chain_ocp_free(&single);
+    chain_ocp_free(&multiple);
+}
+
+
+
+TEST_CASE("chain example merit line search with several candidates", "[NLP solver]")
+{
+    chain_ocp sequential, batched;
+    int max_iter = 200;
+    double tol = 1e-8;
+    int line_search_num_candidates = 3;
+
+    chain_ocp_create(&sequential, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    chain_ocp_create(&batched, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    for (chain_ocp *ocp : {&sequential, &batched})
+    {
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "max_iter", &max_iter);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_stat", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_eq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_ineq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_comp", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "globalization", (void *) "merit_backtracking");
+    }
+    ocp_nlp_solver_opts_set(batched.config, batched.opts, "line_search_num_candidates",
+                            &line_search_num_candidates);
+    chain_ocp_create_solver(&sequential);
+    chain_ocp_create_solver(&batched);
+
+    REQUIRE(ocp_nlp_solve(sequential.solver, sequential.in, sequential.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(batched.solver, batched.in, batched.out) == ACADOS_SUCCESS);
+
+    // the first accepted candidate of a batch is the step size the sequential search accepts
+    int iter_sequential, iter_batched;
+    ocp_nlp_get(sequential.config, sequential.solver, "sqp_iter", &iter_sequential);
+    ocp_nlp_get(batched.config, batched.solver, "sqp_iter", &iter_batched);
+    REQUIRE(iter_batched == iter_sequential);
+    REQUIRE(chain_ocp_diff_ux(&sequential, &batched) <= CHAIN_TOL);
+
+    chain_ocp_free(&sequential);
+    chain_ocp_free(&batched);
+}
+
+
+
+TEST_CASE("chain example speculative second-order correction", "[NLP solver]")
+{
+#if defined(ACADOS_WITH_OPENMP)
+    chain_ocp sequential, speculative;
+    int max_iter = 200;
+    double tol = 1e-8;
+    int use_soc = 1;
+    int num_threads = 2;
+    bool soc_speculative = true;
+
+    chain_ocp_create(&sequential, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    chain_ocp_create(&speculative, SQP, PARTIAL_CONDENSING_HPIPM, 0.5);
+    for (chain_ocp *ocp : {&sequential, &speculative})
+    {
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "max_iter", &max_iter);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_stat", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_eq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_ineq", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "tol_comp", &tol);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "globalization", (void *) "merit_backtracking");
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "globalization_use_SOC", &use_soc);
+        ocp_nlp_solver_opts_set(ocp->config, ocp->opts, "num_threads", &num_threads);
+    }
+    ocp_nlp_solver_opts_set(speculative.config, speculative.opts, "soc_speculative", &soc_speculative);
+    chain_ocp_create_solver(&sequential);
+    chain_ocp_create_solver(&speculative);
+
+    REQUIRE(ocp_nlp_solve(sequential.solver, sequential.in, sequential.out) == ACADOS_SUCCESS);
+    REQUIRE(ocp_nlp_solve(speculative.solver, speculative.in, speculative.out) == ACADOS_SUCCESS);
+
+    // the speculative SOC solution is used exactly when the sequential one would be computed
+    int iter_sequential, iter_speculative;
+    ocp_nlp_get(sequential.config, sequential.solver, "sqp_iter", &iter_sequential);
+    ocp_nlp_get(speculative.config, speculative.solver, "sqp_iter", &iter_speculative);
+    REQUIRE(iter_speculative == iter_sequential);
+    REQUIRE(chain_ocp_diff_ux(&sequential, &speculative) <= CHAIN_TOL);
+
+    chain_ocp_free(&sequential);
+    chain_ocp_free(&speculative);
+#else
+    WARN("speculative second-order correction not tested: acados built without OpenMP");
+#endif
+}
+
+
+
+TEST_CASE("chain example QP working set transfer", "[NLP solver]")
+{
+    std::vector<ocp_qp_solver_t> qp_solvers = {
+#ifdef ACADOS_WITH_QPOASES
+                                               FULL_CONDENSING_QPOASES,
+#endif
+#ifdef ACADOS_WITH_DAQP
+                                               FULL_CONDENSING_DAQP,
+#endif
+                                              };
+
+    if (qp_solvers.empty())
+    {
+        WARN("working set transfer not tested: acados built without qpOASES and DAQP");
+        return;
+    }
+
+    for (ocp_qp_solver_t qp_solver : qp_solvers)
+    {
+        chain_ocp cold, transfer;
+        int max_iter = 200;
+        double tol = 1e-8;
+        int qp_warm_start[2] = {0, 3};
+        chain_ocp *ocps[2] = {&cold, &transfer};
+
+        // the first QP is solved cold in both cases
+        for (int k = 0; k < 2; k++)
+        {
+            chain_ocp_create(ocps[k], SQP, qp_solver, 0.5);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "max_iter", &max_iter);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "tol_stat", &tol);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "tol_eq", &tol);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "tol_ineq", &tol);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "tol_comp", &tol);
+            ocp_nlp_solver_opts_set(ocps[k]->config, ocps[k]->opts, "qp_warm_start", &qp_warm_start[k]);
+            chain_ocp_create_solver(ocps[k]);
+        }
+
+        // active-set iterations of the QPs from the second SQP iteration onward
+        int qp_iter[2];
+        for (int k = 0; k < 2; k++)
+        {
+            REQUIRE(ocp_nlp_solve(ocps[k]->solver, ocps[k]->in, ocps[k]->out) == ACADOS_SUCCESS);
+
+            int sqp_iter, stat_n;
+            double *stat;
+            ocp_nlp_get(ocps[k]->config, ocps[k]->solver, "sqp_iter", &sqp_iter);
+            ocp_nlp_get(ocps[k]->config, ocps[k]->solver, "stat_n", &stat_n);
+            ocp_nlp_get(ocps[k]->config, ocps[k]->solver, "stat", &stat);
+            REQUIRE(sqp_iter >= 2);
+
+            qp_iter[k] = 0;
+            for (int ii = 2; ii <= sqp_iter; ii++)
+                qp_iter[k] += (int) stat[ii*stat_n+5];
+        }
+
+        REQUIRE(qp_iter[1] < qp_iter[0]);
+        REQUIRE(chain_ocp_diff_ux(&cold, &transfer) <= CHAIN_TOL);
+
+        chain_ocp_free(&cold);
+        chain_ocp_free(&transfer);
+    }
+}
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+
+// Verifies the real-time guarantees of ocp_nlp_solve after ocp_nlp_solver_prewarm:
+// no heap allocation, no stdio and no syscalls. Allocation and stdio functions are
+// interposed and counted; syscalls are trapped with a seccomp filter in a forked child
+// that runs the solves. Linux only.
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/audit.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "acados_c/external_function_interface.h"
+#include "acados_c/ocp_nlp_interface.h"
+
+#include "examples/c/chain_model/chain_model.h"
+#include "examples/c/chain_model/x0_nm3.c"
+#include "examples/c/chain_model/xN_nm3.c"
+
+#define NN 20
+#define NX 12
+#define NU 3
+#define NREP 50
+
+#if defined(__x86_64__)
+#define RT_AUDIT_ARCH AUDIT_ARCH_X86_64
+#elif defined(__i386__)
+#define RT_AUDIT_ARCH AUDIT_ARCH_I386
+#elif defined(__aarch64__)
+#define RT_AUDIT_ARCH AUDIT_ARCH_AARCH64
+#elif defined(__arm__)
+#define RT_AUDIT_ARCH AUDIT_ARCH_ARM
+#elif defined(__powerpc64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define RT_AUDIT_ARCH AUDIT_ARCH_PPC64LE
+#elif defined(__riscv) && __riscv_xlen == 64
+#define RT_AUDIT_ARCH AUDIT_ARCH_RISCV64
+#else
+#error "test_realtime: syscall architecture not supported"
+#endif
+
+
+
+/************************************************
+* interposition
+************************************************/
+
+typedef struct
+{
+    int num_alloc;
+    int num_free;
+    int num_stdio;
+    int num_syscall;
+    int num_timer_syscall;
+    int first_syscall;
+    int num_solve_failed;
+    int num_qp_setup;
+} rt_report;
+
+static volatile int rt_armed = 0;
+static rt_report report;
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t nitems, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size)
+{
+    if (rt_armed) report.num_alloc++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nitems, size_t size)
+{
+    if (rt_armed) report.num_alloc++;
+    return __libc_calloc(nitems, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    if (rt_armed) report.num_alloc++;
+    return __libc_realloc(ptr, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+    if (rt_armed) report.num_alloc++;
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr == NULL ? ENOMEM : 0;
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    if (rt_armed) report.num_alloc++;
+    return __libc_memalign(alignment, size);
+}
+
+void free(void *ptr)
+{
+    if (rt_armed) report.num_free++;
+    __libc_free(ptr);
+}
+
+// the compiler lowers printf to puts and putchar where possible
+int printf(const char *format, ...)
+{
+    if (rt_armed) report.num_stdio++;
+    va_list args;
+    va_start(args, format);
+    int ret = vfprintf(stdout, format, args);
+    va_end(args);
+    return ret;
+}
+
+int puts(const char *s)
+{
+    if (rt_armed) report.num_stdio++;
+    if (fputs(s, stdout) == EOF)
+        return EOF;
+    return fputc('\n', stdout);
+}
+
+int putchar(int c)
+{
+    if (rt_armed) report.num_stdio++;
+    return fputc(c, stdout);
+}
+
+
+
+/************************************************
+* syscall trap
+************************************************/
+
+static int report_fd = -1;
+
+static void sigsys_handler(int sig, siginfo_t *info, void *ucontext)
+{
+    (void) sig;
+    (void) ucontext;
+    // clock_gettime only enters the kernel if the clock source has no vDSO support
+    if (info->si_syscall == __NR_clock_gettime || info->si_syscall == __NR_gettimeofday)
+    {
+        report.num_timer_syscall++;
+        return;
+    }
+    // the trapped syscall returns garbage, so report and stop right away
+    report.num_syscall++;
+    report.first_syscall = info->si_syscall;
+    ssize_t written = write(report_fd, &report, sizeof(report));
+    _exit(written == sizeof(report) ? 0 : 3);
+}
+
+
+
+// trap every syscall, except writes to fd and the ones needed to return from
+// the signal handler and to exit; syscall numbers are only meaningful for the
+// native architecture, so anything else kills the process
+static int install_syscall_trap(int fd)
+{
+    report_fd = fd;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &sigsys_handler;
+    action.sa_flags = SA_SIGINFO;
+    if (sigaction(SIGSYS, &action, NULL))
+        return -1;
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    const int arg0_low = offsetof(struct seccomp_data, args[0]) + 4;
+#else
+    const int arg0_low = offsetof(struct seccomp_data, args[0]);
+#endif
+
+    struct sock_filter filter[] =
+    {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, arch)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, RT_AUDIT_ARCH, 1, 0),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_KILL),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_rt_sigreturn, 4, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_exit_group, 3, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_write, 0, 3),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, arg0_low),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, report_fd, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_TRAP),
+    };
+    struct sock_fprog prog = {sizeof(filter) / sizeof(filter[0]), filter};
+
+    if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0))
+        return -1;
+    return prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &prog);
+}
+
+
+
+/************************************************
+* real-time solves
+************************************************/
+
+// returns 0 if the solves after prewarm are real-time safe with the given QP solver;
+// with check_qp_setup, the QP solver must report that its setup happened in prewarm only
+static int test_realtime(ocp_qp_solver_t qp_solver, const char *name, int check_qp_setup)
+{
+    // dims
+    int nx[NN+1], nu[NN+1], zeros[NN+1];
+    for (int i = 0; i <= NN; i++)
+    {
+        nx[i] = NX;
+        nu[i] = i < NN ? NU : 0;
+        zeros[i] = 0;
+    }
+
+    // plan + config
+    ocp_nlp_plan_t *plan = ocp_nlp_plan_create(NN);
+    plan->nlp_solver = SQP_RTI;
+    plan->regularization = NO_REGULARIZE;
+    plan->ocp_qp_solver_plan.qp_solver = qp_solver;
+    for (int i = 0; i <= NN; i++)
+    {
+        plan->nlp_cost[i] = LINEAR_LS;
+        plan->nlp_constraints[i] = BGH;
+    }
+    for (int i = 0; i < NN; i++)
+    {
+        plan->nlp_dynamics[i] = CONTINUOUS_MODEL;
+        plan->sim_solver_plan[i].sim_solver = ERK;
+    }
+    ocp_nlp_config *config = ocp_nlp_config_create(*plan);
+
+    ocp_nlp_dims *dims = ocp_nlp_dims_create(config);
+    ocp_nlp_dims_set_opt_vars(config, dims, "nx", nx);
+    ocp_nlp_dims_set_opt_vars(config, dims, "nu", nu);
+    ocp_nlp_dims_set_opt_vars(config, dims, "nz", zeros);
+    ocp_nlp_dims_set_opt_vars(config, dims, "ns", zeros);
+    for (int i = 0; i <= NN; i++)
+    {
+        int ny = i < NN ? NX+NU : NX;
+        int nbx = i == 0 ? NX : 0;
+        int nbu = i < NN ? NU : 0;
+        ocp_nlp_dims_set_cost(config, dims, i, "ny", &ny);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nbx", &nbx);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nbu", &nbu);
+        ocp_nlp_dims_set_constraints(config, dims, i, "ng", &zeros[i]);
+        ocp_nlp_dims_set_constraints(config, dims, i, "nh", &zeros[i]);
+    }
+
+    // dynamics
+    external_function_casadi expl_vde_for[NN];
+    for (int i = 0; i < NN; i++)
+    {
+        expl_vde_for[i].casadi_fun = &vde_chain_nm3;
+        expl_vde_for[i].casadi_work = &vde_chain_nm3_work;
+        expl_vde_for[i].casadi_sparsity_in = &vde_chain_nm3_sparsity_in;
+        expl_vde_for[i].casadi_sparsity_out = &vde_chain_nm3_sparsity_out;
+        expl_vde_for[i].casadi_n_in = &vde_chain_nm3_n_in;
+        expl_vde_for[i].casadi_n_out = &vde_chain_nm3_n_out;
+    }
+    external_function_casadi_create_array(NN, expl_vde_for);
+
+    // nlp_in
+    ocp_nlp_in *nlp_in = ocp_nlp_in_create(config, dims);
+
+    double Ts = 0.2;
+    double Cyt[(NX+NU)*(NX+NU)] = {0};
+    double W[(NX+NU)*(NX+NU)] = {0};
+    double CytN[NX*NX] = {0};
+    double WN[NX*NX] = {0};
+    double yref[NX+NU] = {0};
+    for (int j = 0; j < NU; j++)
+    {
+        Cyt[j+(NX+NU)*(NX+j)] = 1.0;
+        W[(NX+j)*(NX+NU+1)] = 1.0;
+    }
+    for (int j = 0; j < NX; j++)
+    {
+        Cyt[NU+j+(NX+NU)*j] = 1.0;
+        W[j*(NX+NU+1)] = 1e-2;
+        CytN[j*(NX+1)] = 1.0;
+        WN[j*(NX+1)] = 1e-2;
+        yref[j] = xN_nm3[j];
+    }
+
+    int idxbx0[NX], idxbu[NU];
+    double lbu[NU], ubu[NU];
+    for (int j = 0; j < NX; j++)
+        idxbx0[j] = j;
+    for (int j = 0; j < NU; j++)
+    {
+        idxbu[j] = j;
+        lbu[j] = -1.0;
+        ubu[j] = 1.0;
+    }
+
+    for (int i = 0; i < NN; i++)
+    {
+        ocp_nlp_in_set(config, dims, nlp_in, i, "Ts", &Ts);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "Cyt", Cyt);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "W", W);
+        ocp_nlp_cost_model_set(config, dims, nlp_in, i, "yref", yref);
+        ocp_nlp_dynamics_model_set(config, dims, nlp_in, i, "expl_vde_for", &expl_vde_for[i]);
+        ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "idxbu", idxbu);
+        ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "lbu", lbu);
+        ocp_nlp_constraints_model_set(config, dims, nlp_in, i, "ubu", ubu);
+    }
+    ocp_nlp_cost_model_set(config, dims, nlp_in, NN, "Cyt", CytN);
+    ocp_nlp_cost_model_set(config, dims, nlp_in, NN, "W", WN);
+    ocp_nlp_cost_model_set(config, dims, nlp_in, NN, "yref", yref);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "idxbx", idxbx0);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "lbx", x0_nm3);
+    ocp_nlp_constraints_model_set(config, dims, nlp_in, 0, "ubx", x0_nm3);
+
+    // solver
+    void *nlp_opts = ocp_nlp_solver_opts_create(config, dims);
+    ocp_nlp_out *nlp_out = ocp_nlp_out_create(config, dims);
+    ocp_nlp_solver *solver = ocp_nlp_solver_create(config, dims, nlp_opts);
+    for (int i = 0; i <= NN; i++)
+        ocp_nlp_out_set(config, dims, nlp_out, i, "x", x0_nm3);
+
+    if (ocp_nlp_precompute(solver, nlp_in, nlp_out))
+    {
+        printf("\ntest_realtime %s: precompute failed\n", name);
+        return 1;
+    }
+    int status = ocp_nlp_solver_prewarm(solver, nlp_in, nlp_out);
+    if (status != ACADOS_SUCCESS)
+    {
+        printf("\ntest_realtime %s: prewarm solve failed with status %d\n", name, status);
+        return 1;
+    }
+
+    // the QP solver setup done in prewarm must not be repeated in the real-time solves
+    int num_qp_setup = 0;
+    if (check_qp_setup)
+    {
+        ocp_nlp_get(config, solver, "qp_num_setup", &num_qp_setup);
+        if (num_qp_setup != 1)
+        {
+            printf("\ntest_realtime %s: %d QP solver setups in prewarm, expected 1\n", name, num_qp_setup);
+            return 1;
+        }
+    }
+
+    // real-time solves in a child process
+
+    int pipe_fd[2];
+    if (pipe(pipe_fd))
+    {
+        printf("\ntest_realtime %s: pipe failed\n", name);
+        return 1;
+    }
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(pipe_fd[0]);
+        memset(&report, 0, sizeof(report));
+        report.first_syscall = -1;
+
+        if (install_syscall_trap(pipe_fd[1]))
+            _exit(2);
+
+        rt_armed = 1;
+        for (int rep = 0; rep < NREP; rep++)
+        {
+            if (ocp_nlp_solve(solver, nlp_in, nlp_out) != ACADOS_SUCCESS)
+                report.num_solve_failed++;
+        }
+        rt_armed = 0;
+
+        if (check_qp_setup)
+            ocp_nlp_get(config, solver, "qp_num_setup", &report.num_qp_setup);
+
+        ssize_t written = write(pipe_fd[1], &report, sizeof(report));
+        _exit(written == sizeof(report) ? 0 : 3);
+    }
+
+    close(pipe_fd[1]);
+    rt_report child_report;
+    ssize_t num_read = read(pipe_fd[0], &child_report, sizeof(child_report));
+    int child_status;
+    waitpid(pid, &child_status, 0);
+
+    if (num_read != sizeof(child_report) || !WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0)
+    {
+        printf("\ntest_realtime %s: child failed (read %zd bytes, status %d)\n", name, num_read, child_status);
+        return 1;
+    }
+
+    printf("\ntest_realtime %s: %d solves: %d allocations, %d frees, %d stdio calls, %d syscalls (first %d), %d failed solves\n",
+           name, NREP, child_report.num_alloc, child_report.num_free, child_report.num_stdio,
+           child_report.num_syscall, child_report.first_syscall, child_report.num_solve_failed);
+    if (child_report.num_timer_syscall > 0)
+        printf("test_realtime %s: warning: %d timer calls entered the kernel (no vDSO clock source)\n",
+               name, child_report.num_timer_syscall);
+
+    int failed = child_report.num_alloc || child_report.num_free || child_report.num_stdio ||
+                 child_report.num_syscall || child_report.num_solve_failed;
+    if (check_qp_setup && child_report.num_qp_setup != num_qp_setup)
+    {
+        printf("test_realtime %s: QP solver set up again in the real-time solves\n", name);
+        failed = 1;
+    }
+
+    ocp_nlp_solver_destroy(solver);
+    ocp_nlp_out_destroy(nlp_out);
+    ocp_nlp_solver_opts_destroy(nlp_opts);
+    ocp_nlp_in_destroy(nlp_in);
+    ocp_nlp_dims_destroy(dims);
+    ocp_nlp_config_destroy(config);
+    ocp_nlp_plan_destroy(plan);
+    external_function_casadi_free_array(NN, expl_vde_for);
+
+    printf("test_realtime %s: %s\n", name, failed ? "FAILED" : "passed");
+    return failed;
+}
+
+
+
+/************************************************
+* main
+************************************************/
+
+int main()
+{
+    int failed = test_realtime(PARTIAL_CONDENSING_HPIPM, "PARTIAL_CONDENSING_HPIPM", 0);
+#ifdef ACADOS_WITH_OSQP
+    // OSQP sets up its workspace on the first call, which has to happen in prewarm
+    failed |= test_realtime(PARTIAL_CONDENSING_OSQP, "PARTIAL_CONDENSING_OSQP", 1);
+#endif
+    return failed;
+}
@@ -29,6 +29,7 @@
  */
 
 
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -51,6 +52,7 @@ ocp_qp_solver_t hashit(std::string const &inString)
 {
     if (inString == "SPARSE_HPIPM") return PARTIAL_CONDENSING_HPIPM;
     if (inString == "DENSE_HPIPM") return FULL_CONDENSING_HPIPM;
+    if (inString == "SPARSE_ADMM") return PARTIAL_CONDENSING_ADMM;
 #ifdef ACADOS_WITH_HPMPC
     if (inString == "SPARSE_HPMPC") return PARTIAL_CONDENSING_HPMPC;
 #endif
@@ -82,7 +84,7 @@ double solver_tolerance(std::string const &inString)
 {
     if (inString == "SPARSE_HPIPM") return 1e-8;
     if (inString == "SPARSE_HPMPC") return 1e-5;
-    // if (inString == "SPARSE_QPDUNES") return 1e-8;
+    if (inString == "SPARSE_QPDUNES") return 1e-6;
     if (inString == "DENSE_HPIPM") return 1e-8;
     if (inString == "DENSE_QPOASES") return 1e-10;
     if (inString == "DENSE_DAQP") return 1e-10;
@@ -90,6 +92,7 @@ double solver_tolerance(std::string const &inString)
     if (inString == "SPARSE_OOQP") return 1e-5;
     if (inString == "DENSE_OOQP") return 1e-5;
     if (inString == "SPARSE_OSQP") return 1e-8;
+    if (inString == "SPARSE_ADMM") return 1e-5;
 
     return -1;
 }
@@ -100,7 +103,7 @@ void set_N2(std::string const &inString, ocp_qp_xcond_solver_config *config, voi
 {
     bool option_found = false;
 
-    if ( inString=="SPARSE_HPIPM" | inString=="SPARSE_HPMPC" | inString == "SPARSE_OOQP" | inString == "SPARSE_OSQP" )
+    if ( inString=="SPARSE_HPIPM" | inString=="SPARSE_HPMPC" | inString == "SPARSE_OOQP" | inString == "SPARSE_OSQP" | inString == "SPARSE_ADMM" )
     {
 		config->opts_set(config, opts, "cond_N", &N2);
     }
@@ -114,10 +117,81 @@ void set_N2(std::string const &inString, ocp_qp_xcond_solver_config *config, voi
 
 
 
+// mass spring QP shared by the solver option tests: nx = 8, nu = 3, N = 15, N2 = 5 for sparse solvers
+#define MASS_SPRING_N 15
+
+struct mass_spring_qp
+{
+    std::string solver;
+    ocp_qp_xcond_solver_config *config;
+    ocp_qp_xcond_solver_dims *dims;
+    ocp_qp_in *qp_in;
+    ocp_qp_out *qp_out;
+    void *opts;
+    ocp_qp_solver *qp_solver;  // created at the first solve, after the options are set
+};
+
+
+
+// without eliminate_x0, x0 is kept as a bound of stage 0, e.g. for qpDUNES, which needs nx constant over stages
+void mass_spring_qp_create(mass_spring_qp *qp, std::string const &solver, int nb_, bool eliminate_x0 = true)
+{
+    ocp_qp_solver_plan_t plan;
+    plan.qp_solver = hashit(solver);
+
+    qp->solver = solver;
+    qp->config = ocp_qp_xcond_solver_config_create(plan);
+    qp->dims = create_ocp_qp_dims_mass_spring(qp->config, MASS_SPRING_N, 8, 3, nb_, 0, 0);
+    if (!eliminate_x0)
+    {
+        int nbxe0 = 0;
+        qp->config->dims_set(qp->config, qp->dims, 0, "nbxe", &nbxe0);
+    }
+    qp->qp_in = create_ocp_qp_in_mass_spring(qp->dims->orig_dims);
+    qp->qp_out = ocp_qp_out_create(qp->dims->orig_dims);
+    qp->opts = ocp_qp_xcond_solver_opts_create(qp->config, qp->dims);
+    qp->qp_solver = NULL;
+
+    set_N2(solver, qp->config, qp->opts, 5, MASS_SPRING_N);
+}
+
+
+
+// solve and check the residuals against the solver tolerance
+void mass_spring_qp_solve(mass_spring_qp *qp)
+{
+    double res[4];
+
+    if (qp->qp_solver == NULL)
+        qp->qp_solver = ocp_qp_create(qp->config, qp->dims, qp->opts);
+
+    int acados_return = ocp_qp_solve(qp->qp_solver, qp->qp_in, qp->qp_out);
+    REQUIRE(acados_return == 0);
+
+    ocp_qp_inf_norm_residuals(qp->dims->orig_dims, qp->qp_in, qp->qp_out, res);
+    for (int ii = 0; ii < 4; ii++)
+        REQUIRE(res[ii] <= solver_tolerance(qp->solver));
+}
+
+
+
+void mass_spring_qp_free(mass_spring_qp *qp)
+{
+    free(qp->qp_solver);
+    free(qp->qp_out);
+    free(qp->qp_in);
+    free(qp->dims);
+    free(qp->opts);
+    free(qp->config);
+}
+
+
+
 TEST_CASE("mass spring example", "[QP solvers]")
 {
     vector<std::string> solvers = {"DENSE_HPIPM",
-                                   "SPARSE_HPIPM"
+                                   "SPARSE_HPIPM",
+                                   "SPARSE_ADMM"
 #ifdef ACADOS_WITH_HPMPC
                                    ,
                                    "SPARSE_HPMPC"
@@ -266,3 +340,278 @@ TEST_CASE("mass spring example", "[QP solvers]")
     }  // END_FOR_SOLVERS
 
 }  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example mixed precision", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int mixed_precision = 1;
+    int mixed_precision_used;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            mass_spring_qp qp;
+            mass_spring_qp_create(&qp, solver, 11);
+            qp.config->opts_set(qp.config, qp.opts, "mixed_precision", &mixed_precision);
+
+            // double-precision tolerances after the refinement
+            mass_spring_qp_solve(&qp);
+
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "mixed_precision_used", &mixed_precision_used);
+            REQUIRE(mixed_precision_used == 1);
+
+            mass_spring_qp_free(&qp);
+        }
+    }
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example HPIPM statistics", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int log_stat = 1;
+    int iter, stat_m, stat_n;
+    double *stat;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            mass_spring_qp qp;
+            mass_spring_qp_create(&qp, solver, 11);
+            qp.config->opts_set(qp.config, qp.opts, "log_stat", &log_stat);
+
+            mass_spring_qp_solve(&qp);
+
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "iter", &iter);
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "stat", &stat);
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "stat_m", &stat_m);
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "stat_n", &stat_n);
+
+            // initial point and one row per IPM iteration
+            REQUIRE(stat_m == iter + 1);
+            REQUIRE(stat_n == QP_STAT_N);
+            REQUIRE(stat[(stat_m - 1) * stat_n + QP_STAT_RES_EQ] <= solver_tolerance(solver));
+
+            mass_spring_qp_free(&qp);
+        }
+    }
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example factorization reuse", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int lhs_unchanged = 1;
+    int fact_reused;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            // no bounds besides the eliminated initial state: the solved QP has no inequality constraints
+            mass_spring_qp qp[2];
+            for (int ii = 0; ii < 2; ii++)
+                mass_spring_qp_create(&qp[ii], solver, 0);
+
+            mass_spring_qp_solve(&qp[0]);
+            qp[0].config->memory_get(qp[0].config, qp[0].qp_solver->mem, "fact_reused", &fact_reused);
+            REQUIRE(fact_reused == 0);
+
+            // new initial state, same matrices: halve lower and upper bound on x0 in both QPs
+            ocp_qp_dims *dims = qp[0].dims->orig_dims;
+            for (int ii = 0; ii < 2; ii++)
+                for (int jj = 0; jj < 2*(dims->nb[0]+dims->ng[0]); jj++)
+                    BLASFEO_DVECEL(qp[ii].qp_in->d, jj) *= 0.5;
+
+            // only the rhs is condensed and solved with the stored factorization
+            qp[0].config->opts_set(qp[0].config, qp[0].opts, "lhs_unchanged", &lhs_unchanged);
+            mass_spring_qp_solve(&qp[0]);
+            qp[0].config->memory_get(qp[0].config, qp[0].qp_solver->mem, "fact_reused", &fact_reused);
+            REQUIRE(fact_reused == 1);
+
+            // reference: full solve of the modified QP
+            mass_spring_qp_solve(&qp[1]);
+
+            for (int ii = 0; ii <= dims->N; ii++)
+            {
+                int nv = dims->nu[ii] + dims->nx[ii];
+                for (int jj = 0; jj < nv; jj++)
+                    REQUIRE(std::abs(BLASFEO_DVECEL(qp[0].qp_out->ux+ii, jj) - BLASFEO_DVECEL(qp[1].qp_out->ux+ii, jj))
+                            <= solver_tolerance(solver));
+            }
+
+            mass_spring_qp_free(&qp[0]);
+            mass_spring_qp_free(&qp[1]);
+        }
+    }
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example active-set cache", "[QP solvers]")
+{
+    // the cache is only implemented for the active-set solvers
+    vector<std::string> solvers = {
+#ifdef ACADOS_WITH_QPOASES
+                                   "DENSE_QPOASES",
+#endif
+#ifdef ACADOS_WITH_DAQP
+                                   "DENSE_DAQP",
+#endif
+                                  };
+
+    if (solvers.empty())
+    {
+        WARN("active-set cache not tested: acados built without qpOASES and DAQP");
+        return;
+    }
+
+    int cache_size = 4;
+    int cache_hits;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            mass_spring_qp qp;
+            mass_spring_qp_create(&qp, solver, 11);
+
+            double cache_tol = solver_tolerance(solver);
+            qp.config->opts_set(qp.config, qp.opts, "cache_size", &cache_size);
+            qp.config->opts_set(qp.config, qp.opts, "cache_tol", &cache_tol);
+
+            // first solve fills the cache, second one is served from it
+            for (int rep = 0; rep < 2; rep++)
+                mass_spring_qp_solve(&qp);
+
+            qp.config->memory_get(qp.config, qp.qp_solver->mem, "cache_hits", &cache_hits);
+            REQUIRE(cache_hits == 1);
+
+            mass_spring_qp_free(&qp);
+        }
+    }
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example incremental condensing", "[QP solvers]")
+{
+    int N = MASS_SPRING_N;
+    int incremental = 1;
+    int n_stages_cond;
+
+    mass_spring_qp qp;
+    mass_spring_qp_create(&qp, "DENSE_HPIPM", 11);
+    qp.config->opts_set(qp.config, qp.opts, "cond_incremental", &incremental);
+
+    // expected number of recondensed stages: all, none, only the modified terminal stage
+    int n_stages_expected[3] = {N+1, 0, 1};
+
+    for (int rep = 0; rep < 3; rep++)
+    {
+        if (rep == 2)
+            BLASFEO_DMATEL(qp.qp_in->RSQrq+N, 0, 0) *= 2.0;
+
+        mass_spring_qp_solve(&qp);
+
+        qp.config->memory_get(qp.config, qp.qp_solver->mem, "n_stages_cond", &n_stages_cond);
+        REQUIRE(n_stages_cond == n_stages_expected[rep]);
+    }
+
+    mass_spring_qp_free(&qp);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example blocked full condensing", "[QP solvers]")
+{
+    std::string solver = "DENSE_HPIPM";
+    mass_spring_qp qp[2];
+
+    // one block row per segment
+    int l2_size = 1;
+
+    // hpipm and blocked Hessian condensing
+    for (int hess_alg = 0; hess_alg < 2; hess_alg++)
+    {
+        mass_spring_qp_create(&qp[hess_alg], solver, 11);
+        qp[hess_alg].config->opts_set(qp[hess_alg].config, qp[hess_alg].opts, "cond_hess_alg", &hess_alg);
+        qp[hess_alg].config->opts_set(qp[hess_alg].config, qp[hess_alg].opts, "cond_l2_size", &l2_size);
+        mass_spring_qp_solve(&qp[hess_alg]);
+    }
+
+    ocp_qp_dims *dims = qp[0].dims->orig_dims;
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        int nv = dims->nu[ii] + dims->nx[ii];
+        for (int jj = 0; jj < nv; jj++)
+            REQUIRE(std::abs(BLASFEO_DVECEL(qp[0].qp_out->ux+ii, jj) - BLASFEO_DVECEL(qp[1].qp_out->ux+ii, jj))
+                    <= solver_tolerance(solver));
+    }
+
+    mass_spring_qp_free(&qp[0]);
+    mass_spring_qp_free(&qp[1]);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example parallel partial condensing", "[QP solvers]")
+{
+    mass_spring_qp qp[2];
+
+    // sequential and block-parallel condensing and expansion
+    for (int parallel = 0; parallel < 2; parallel++)
+    {
+        mass_spring_qp_create(&qp[parallel], "SPARSE_HPIPM", 11);
+        qp[parallel].config->opts_set(qp[parallel].config, qp[parallel].opts, "cond_parallel", &parallel);
+        mass_spring_qp_solve(&qp[parallel]);
+    }
+
+    ocp_qp_dims *dims = qp[0].dims->orig_dims;
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        int nv = dims->nu[ii] + dims->nx[ii];
+        for (int jj = 0; jj < nv; jj++)
+            REQUIRE(BLASFEO_DVECEL(qp[0].qp_out->ux+ii, jj) == BLASFEO_DVECEL(qp[1].qp_out->ux+ii, jj));
+    }
+
+    mass_spring_qp_free(&qp[0]);
+    mass_spring_qp_free(&qp[1]);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example qpDUNES linear MPC", "[QP solvers]")
+{
+#ifdef ACADOS_WITH_QPDUNES
+    int linear_mpc = 1;
+    int is_lti;
+
+    mass_spring_qp qp;
+    mass_spring_qp_create(&qp, "SPARSE_QPDUNES", 11, false);
+    qp.config->opts_set(qp.config, qp.opts, "linear_mpc", &linear_mpc);
+
+    // identical partially condensed intervals: the stage QPs are set up as LTI in the first solve,
+    // the second one only updates the bounds of the first interval
+    for (int rep = 0; rep < 2; rep++)
+    {
+        mass_spring_qp_solve(&qp);
+
+        qp.config->memory_get(qp.config, qp.qp_solver->mem, "is_lti", &is_lti);
+        REQUIRE(is_lti == 1);
+    }
+
+    mass_spring_qp_free(&qp);
+#else
+    WARN("qpDUNES linear MPC not tested: acados built without qpDUNES");
+#endif
+}  // END_TEST_CASE